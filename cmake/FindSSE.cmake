@@ -50,6 +50,26 @@ IF (ARCH MATCHES "i386" OR ARCH MATCHES "x86_64")
         set(SSE4_2_FOUND false CACHE BOOL "SSE4.2 available on host")
      ENDIF (SSE42_TRUE)
 
+     STRING(REGEX REPLACE "^.*(bmi2).*$" "\\1" SSE_THERE ${CPUINFO})
+     STRING(COMPARE EQUAL "bmi2" "${SSE_THERE}" BMI2_TRUE)
+     IF (BMI2_TRUE)
+        set(BMI2_FOUND true CACHE BOOL "BMI2 available on host")
+     ELSE (BMI2_TRUE)
+        set(BMI2_FOUND false CACHE BOOL "BMI2 available on host")
+     ENDIF (BMI2_TRUE)
+
+     # AMD family 17h (Zen, Zen+ and Zen 2) and Hygon family 18h
+     # processors run pdep and pext in microcode, much slower than shifts
+     # and masks
+     STRING(REGEX MATCH "(AuthenticAMD|HygonGenuine)" BMI2_VENDOR ${CPUINFO})
+     STRING(REGEX MATCH "cpu family[ \t]*:[ \t]*(23|24)[^0-9]"
+        BMI2_FAMILY ${CPUINFO})
+     IF (BMI2_VENDOR AND BMI2_FAMILY)
+        set(BMI2_SLOW true CACHE BOOL "BMI2 microcoded on host")
+     ELSE ()
+        set(BMI2_SLOW false CACHE BOOL "BMI2 microcoded on host")
+     ENDIF ()
+
   ELSEIF(CMAKE_SYSTEM_NAME MATCHES "Darwin")
      EXEC_PROGRAM("/usr/sbin/sysctl -n machdep.cpu.features" OUTPUT_VARIABLE
         CPUINFO)
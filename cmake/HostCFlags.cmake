@@ -25,3 +25,13 @@ else()
   message(STATUS "\nSSE4 disabled.\n")
 endif()
 
+# Bit deposit and extract instructions, used by the Morton codes of
+# SpaceFillingCurve.hh. USE_BMI2 (default TRUE) can turn them off, and
+# they are left off on processors where they are microcoded.
+if (BMI2_FOUND AND (NOT DEFINED USE_BMI2 OR USE_BMI2))
+  if (BMI2_SLOW)
+    message(STATUS "BMI2 disabled, pdep and pext are slow on this host")
+  else()
+    set (CMAKE_C_FLAGS_ALL "-mbmi2 ${CMAKE_C_FLAGS_ALL}")
+  endif()
+endif()
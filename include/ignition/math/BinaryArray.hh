@@ -0,0 +1,325 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_BINARYARRAY_HH_
+#define IGNITION_MATH_BINARYARRAY_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Quaternion.hh>
+#include <ignition/math/Vector3.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Forward declare private data
+    class BinaryArrayWriterPrivate;
+    class BinaryArrayReaderPrivate;
+
+    /// \enum BinaryArrayType
+    /// \brief Type of the elements stored in a binary array file.
+    enum BinaryArrayType
+    {
+      /// \brief No valid type.
+      BINARY_ARRAY_INVALID = 0,
+
+      /// \brief Vector3d, stored as x, y, z.
+      BINARY_ARRAY_VECTOR3D = 1,
+
+      /// \brief Quaterniond, stored as w, x, y, z.
+      BINARY_ARRAY_QUATERNIOND = 2,
+
+      /// \brief Pose3d, stored as x, y, z, qw, qx, qy, qz.
+      BINARY_ARRAY_POSE3D = 3
+    };
+
+    /// \class BinaryArraySpan BinaryArray.hh ignition/math/BinaryArray.hh
+    /// \brief Read only view of math types stored as consecutive doubles,
+    /// such as the memory mapped contents of a binary array file. Elements
+    /// are built on access, the underlying data is never copied.
+    /// \tparam T Vector3d, Quaterniond or Pose3d.
+    template<typename T>
+    class BinaryArraySpan
+    {
+      /// \brief Constructor, creates an empty span.
+      public: BinaryArraySpan() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _data First double of the first element.
+      /// \param[in] _size Number of elements.
+      public: BinaryArraySpan(const double *_data, const size_t _size)
+      : data(_data), size(_size)
+      {
+      }
+
+      /// \brief Get the number of elements.
+      /// \return Number of elements.
+      public: size_t Size() const
+      {
+        return this->size;
+      }
+
+      /// \brief Check whether the span has no element.
+      /// \return True if the span is empty.
+      public: bool Empty() const
+      {
+        return this->size == 0;
+      }
+
+      /// \brief Get the raw doubles of the span, Stride() per element.
+      /// \return Pointer to the first double, or nullptr for an empty span.
+      public: const double *Data() const
+      {
+        return this->data;
+      }
+
+      /// \brief Get the number of doubles of each element.
+      /// \return 3 for Vector3d, 4 for Quaterniond and 7 for Pose3d.
+      public: static size_t Stride()
+      {
+        return StrideOf(static_cast<const T *>(nullptr));
+      }
+
+      /// \brief Get an element.
+      /// \param[in] _index Element index, must be less than Size().
+      /// \return The element.
+      public: T operator[](const size_t _index) const
+      {
+        T value;
+        Load(this->data + _index * Stride(), value);
+        return value;
+      }
+
+      /// \brief Number of doubles of a Vector3d.
+      private: static size_t StrideOf(const Vector3d *)
+      {
+        return 3;
+      }
+
+      /// \brief Number of doubles of a Quaterniond.
+      private: static size_t StrideOf(const Quaterniond *)
+      {
+        return 4;
+      }
+
+      /// \brief Number of doubles of a Pose3d.
+      private: static size_t StrideOf(const Pose3d *)
+      {
+        return 7;
+      }
+
+      /// \brief Build a Vector3d from x, y, z.
+      /// \param[in] _d Doubles of the element.
+      /// \param[out] _v Vector.
+      private: static void Load(const double *_d, Vector3d &_v)
+      {
+        _v.Set(_d[0], _d[1], _d[2]);
+      }
+
+      /// \brief Build a Quaterniond from w, x, y, z.
+      /// \param[in] _d Doubles of the element.
+      /// \param[out] _q Quaternion.
+      private: static void Load(const double *_d, Quaterniond &_q)
+      {
+        _q.Set(_d[0], _d[1], _d[2], _d[3]);
+      }
+
+      /// \brief Build a Pose3d from x, y, z, qw, qx, qy, qz.
+      /// \param[in] _d Doubles of the element.
+      /// \param[out] _p Pose.
+      private: static void Load(const double *_d, Pose3d &_p)
+      {
+        _p.Pos().Set(_d[0], _d[1], _d[2]);
+        _p.Rot().Set(_d[3], _d[4], _d[5], _d[6]);
+      }
+
+      /// \brief First double of the first element.
+      private: const double *data = nullptr;
+
+      /// \brief Number of elements.
+      private: size_t size = 0;
+    };
+
+    typedef BinaryArraySpan<Vector3d> Vector3dSpan;
+    typedef BinaryArraySpan<Quaterniond> QuaterniondSpan;
+    typedef BinaryArraySpan<Pose3d> Pose3dSpan;
+
+    /// \class BinaryArrayWriter BinaryArray.hh ignition/math/BinaryArray.hh
+    /// \brief Writes a binary array file one element or one block at a
+    /// time, for example to record a trajectory.
+    ///
+    /// A binary array file has a 32 byte header followed by the elements,
+    /// stored as doubles in the byte order of the machine that wrote
+    /// them. The header holds the magic string "IGNARRAY", a byte order
+    /// mark, the format version, the element type and the element size.
+    /// The number of elements is given by the file size, so a file is
+    /// valid at any time during recording.
+    /// \sa BinaryArrayReader
+    class IGNITION_VISIBLE BinaryArrayWriter
+    {
+      /// \brief Constructor.
+      public: BinaryArrayWriter();
+
+      /// \brief Destructor, closes the file.
+      public: ~BinaryArrayWriter();
+
+      /// \brief Create a file, or append to an existing one.
+      /// \param[in] _path Path of the file.
+      /// \param[in] _type Type of the elements.
+      /// \param[in] _append True to add elements to an existing file of
+      /// the same type written on a machine with the same byte order. A
+      /// partially written last element is discarded. If the file does
+      /// not exist it is created.
+      /// \return True on success.
+      public: bool Open(const std::string &_path, const BinaryArrayType _type,
+                        const bool _append = false);
+
+      /// \brief Check whether a file is open.
+      /// \return True if a file is open.
+      public: bool IsOpen() const;
+
+      /// \brief Flush and close the file.
+      public: void Close();
+
+      /// \brief Write buffered elements to the file.
+      /// \return True on success.
+      public: bool Flush();
+
+      /// \brief Get the type of the elements.
+      /// \return Element type, BINARY_ARRAY_INVALID if no file is open.
+      public: BinaryArrayType Type() const;
+
+      /// \brief Get the number of elements in the file, including the
+      /// ones written before it was opened for appending.
+      /// \return Number of elements.
+      public: uint64_t Count() const;
+
+      /// \brief Append vectors. Fails if the file holds another type.
+      /// \param[in] _v Vectors.
+      /// \param[in] _n Number of vectors.
+      /// \return True on success.
+      public: bool Write(const Vector3d *_v, const size_t _n = 1);
+
+      /// \brief Append quaternions. Fails if the file holds another type.
+      /// \param[in] _q Quaternions.
+      /// \param[in] _n Number of quaternions.
+      /// \return True on success.
+      public: bool Write(const Quaterniond *_q, const size_t _n = 1);
+
+      /// \brief Append poses. Fails if the file holds another type.
+      /// \param[in] _p Poses.
+      /// \param[in] _n Number of poses.
+      /// \return True on success.
+      public: bool Write(const Pose3d *_p, const size_t _n = 1);
+
+      /// \brief Append elements given as raw doubles, in the layout
+      /// described by BinaryArrayType.
+      /// \param[in] _data Doubles, _n times the size of an element.
+      /// \param[in] _n Number of elements.
+      /// \return True on success.
+      public: bool WriteRaw(const double *_data, const size_t _n);
+
+      /// \brief Copy constructor is not allowed.
+      private: BinaryArrayWriter(const BinaryArrayWriter &) = delete;
+
+      /// \brief Assignment is not allowed.
+      private: BinaryArrayWriter &operator=(
+                   const BinaryArrayWriter &) = delete;
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<BinaryArrayWriterPrivate> dataPtr;
+    };
+
+    /// \class BinaryArrayReader BinaryArray.hh ignition/math/BinaryArray.hh
+    /// \brief Reads a binary array file written by BinaryArrayWriter.
+    /// On POSIX systems the file is memory mapped and the spans point
+    /// directly into the mapping, so opening a file costs the same
+    /// whatever its size. Files written with the other byte order, and
+    /// all files on Windows, are read into memory instead.
+    class IGNITION_VISIBLE BinaryArrayReader
+    {
+      /// \brief Constructor.
+      public: BinaryArrayReader();
+
+      /// \brief Destructor, closes the file.
+      public: ~BinaryArrayReader();
+
+      /// \brief Open a file. Any previously open file is closed, which
+      /// invalidates its spans.
+      /// \param[in] _path Path of the file.
+      /// \return True on success, false if the file cannot be read, is
+      /// not a binary array file, or has a newer version.
+      public: bool Open(const std::string &_path);
+
+      /// \brief Check whether a file is open.
+      /// \return True if a file is open.
+      public: bool IsOpen() const;
+
+      /// \brief Close the file. Spans of the file become invalid.
+      public: void Close();
+
+      /// \brief Check whether the elements are read directly from a
+      /// memory mapping of the file.
+      /// \return True if no copy of the data was made.
+      public: bool IsMapped() const;
+
+      /// \brief Get the format version of the file.
+      /// \return Version, 0 if no file is open.
+      public: uint32_t Version() const;
+
+      /// \brief Get the type of the elements.
+      /// \return Element type, BINARY_ARRAY_INVALID if no file is open.
+      public: BinaryArrayType Type() const;
+
+      /// \brief Get the number of complete elements in the file.
+      /// \return Number of elements.
+      public: size_t Count() const;
+
+      /// \brief Get the elements as raw doubles.
+      /// \return Pointer to the first double, or nullptr if the file is
+      /// empty or not open.
+      public: const double *Data() const;
+
+      /// \brief Get the vectors of the file.
+      /// \return Span of the vectors, empty if the file holds another type.
+      public: Vector3dSpan Vector3ds() const;
+
+      /// \brief Get the quaternions of the file.
+      /// \return Span of the quaternions, empty if the file holds another
+      /// type.
+      public: QuaterniondSpan Quaternionds() const;
+
+      /// \brief Get the poses of the file.
+      /// \return Span of the poses, empty if the file holds another type.
+      public: Pose3dSpan Pose3ds() const;
+
+      /// \brief Copy constructor is not allowed.
+      private: BinaryArrayReader(const BinaryArrayReader &) = delete;
+
+      /// \brief Assignment is not allowed.
+      private: BinaryArrayReader &operator=(
+                   const BinaryArrayReader &) = delete;
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<BinaryArrayReaderPrivate> dataPtr;
+    };
+  }
+}
+#endif
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_BOXTREE_HH_
+#define IGNITION_MATH_BOXTREE_HH_
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <ignition/math/Box.hh>
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Vector3.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Forward declare private data
+    class BoxTreePrivate;
+
+    /// \class BoxTree BoxTree.hh ignition/math/BoxTree.hh
+    /// \brief A dynamic bounding volume tree of axis aligned boxes, used as
+    /// a collision broad phase to find the boxes which overlap without
+    /// testing all pairs.
+    ///
+    /// Each box is stored in a leaf with a fat box, which is the box
+    /// grown by a margin on every side and by the expected displacement.
+    /// Moving a box within its fat box does not change the tree. Otherwise
+    /// the leaf is removed and inserted again at the place which least
+    /// increases the surface area of the tree, and the tree is rebalanced
+    /// with rotations on the way up, so that its height stays O(log n).
+    ///
+    /// Queries descend the fat boxes of the tree, and only report the
+    /// boxes themselves which overlap, so results do not depend on the
+    /// margin. Boxes which touch overlap, as in Box::Intersects.
+    ///
+    /// Boxes are identified by the id returned by Add, which stays valid
+    /// until the box is removed. Ids of removed boxes are reused.
+    class IGNITION_VISIBLE BoxTree
+    {
+      /// \brief Id returned when a box cannot be added.
+      public: static const size_t NullId;
+
+      /// \brief Constructor, creates an empty tree with a margin of 0.1.
+      public: BoxTree();
+
+      /// \brief Constructor.
+      /// \param[in] _margin Distance by which the fat boxes extend the
+      /// boxes on every side.
+      public: explicit BoxTree(const double _margin);
+
+      /// \brief Copy constructor.
+      /// \param[in] _tree Tree to copy.
+      public: BoxTree(const BoxTree &_tree);
+
+      /// \brief Destructor.
+      public: ~BoxTree();
+
+      /// \brief Assignment operator.
+      /// \param[in] _tree Tree to copy.
+      /// \return Reference to this object.
+      public: BoxTree &operator=(const BoxTree &_tree);
+
+      /// \brief Set the margin of the fat boxes. It applies to boxes added
+      /// or moved afterwards.
+      /// \param[in] _margin Margin, non negative and finite.
+      /// \return False if _margin is invalid, in which case nothing is
+      /// changed.
+      public: bool SetMargin(const double _margin);
+
+      /// \brief Get the margin of the fat boxes.
+      /// \return Margin.
+      public: double Margin() const;
+
+      /// \brief Add a box.
+      /// \param[in] _box Box to add.
+      /// \return Id of the box, or NullId if _box has a non finite
+      /// coordinate.
+      public: size_t Add(const Box &_box);
+
+      /// \brief Remove a box.
+      /// \param[in] _id Id of the box.
+      /// \return False if _id is not the id of a box.
+      public: bool Remove(const size_t _id);
+
+      /// \brief Move a box.
+      /// \param[in] _id Id of the box.
+      /// \param[in] _box New box.
+      /// \return True if the tree changed, false if _box is still within
+      /// its fat box, or if _id or _box is invalid.
+      public: bool Move(const size_t _id, const Box &_box);
+
+      /// \brief Move a box, extending its fat box in the direction of
+      /// motion so that it changes the tree less often.
+      /// \param[in] _id Id of the box.
+      /// \param[in] _box New box.
+      /// \param[in] _displacement Expected displacement of the box before
+      /// it moves again, for example its velocity times the time step.
+      /// \return True if the tree changed, false if _box is still within
+      /// its fat box, or if _id or _box is invalid.
+      public: bool Move(const size_t _id, const Box &_box,
+                        const Vector3d &_displacement);
+
+      /// \brief Check if an id is the id of a box.
+      /// \param[in] _id Id.
+      /// \return True if _id is the id of a box in the tree.
+      public: bool Valid(const size_t _id) const;
+
+      /// \brief Get a box.
+      /// \param[in] _id Id of the box.
+      /// \return The box, or an empty box if _id is invalid.
+      public: Box BoxOf(const size_t _id) const;
+
+      /// \brief Get the fat box of a box.
+      /// \param[in] _id Id of the box.
+      /// \return The fat box, or an empty box if _id is invalid.
+      public: Box FatBox(const size_t _id) const;
+
+      /// \brief Remove all boxes.
+      public: void Clear();
+
+      /// \brief Get the number of boxes.
+      /// \return Number of boxes.
+      public: size_t Size() const;
+
+      /// \brief Get the height of the tree, 0 when it is empty and 1 when
+      /// it holds a single box.
+      /// \return Height of the tree.
+      public: size_t Height() const;
+
+      /// \brief Find the boxes which overlap a box.
+      /// \param[in] _box Box to test.
+      /// \param[out] _ids Ids of the boxes, in no particular order.
+      /// \return Number of boxes found.
+      public: size_t Overlaps(const Box &_box,
+                              std::vector<size_t> &_ids) const;
+
+      /// \brief Find all pairs of boxes which overlap.
+      /// \param[out] _pairs Pairs of ids, with the lower id first, in no
+      /// particular order. The vector is cleared first, and keeps its
+      /// memory from one call to the next.
+      /// \return Number of pairs found.
+      public: size_t Pairs(
+                  std::vector<std::pair<size_t, size_t>> &_pairs) const;
+
+      /// \brief Find the boxes hit by a ray.
+      /// \param[in] _origin Origin of the ray.
+      /// \param[in] _dir Direction of the ray, need not be normalized.
+      /// \param[in] _max Maximum distance along the ray, in units of the
+      /// length of _dir.
+      /// \param[out] _ids Ids of the boxes, in no particular order.
+      /// \return Number of boxes found, 0 if _origin or _dir has a non
+      /// finite component.
+      public: size_t Raycast(const Vector3d &_origin, const Vector3d &_dir,
+                             const double _max,
+                             std::vector<size_t> &_ids) const;
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<BoxTreePrivate> dataPtr;
+    };
+  }
+}
+#endif
@@ -17,6 +17,7 @@
 #ifndef IGNITION_MATH_COLOR_HH_
 #define IGNITION_MATH_COLOR_HH_
 
+#include <cstddef>
 #include <iostream>
 
 #include <ignition/math/Helpers.hh>
@@ -64,6 +65,24 @@ namespace ignition
       /// \brief A ABGR packed value as an unsigned int
       public: typedef unsigned int ABGR;
 
+      /// \enum PixelFormat
+      /// \brief Channel order of a packed 32-bit color, from the most
+      /// significant byte to the least significant byte.
+      public: enum PixelFormat
+      {
+        /// \brief Red, green, blue, alpha. Same as AsRGBA.
+        PIXEL_RGBA = 0,
+
+        /// \brief Blue, green, red, alpha. Same as AsBGRA.
+        PIXEL_BGRA = 1,
+
+        /// \brief Alpha, red, green, blue. Same as AsARGB.
+        PIXEL_ARGB = 2,
+
+        /// \brief Alpha, blue, green, red. Same as AsABGR.
+        PIXEL_ABGR = 3
+      };
+
       /// \brief Constructor
       public: Color();
 
@@ -158,6 +177,71 @@ namespace ignition
       /// \param[in] _v the new color
       public: void SetFromABGR(const ABGR _v);
 
+      /// \brief Convert an array of packed 32-bit colors to floating point
+      /// RGBA. Each output pixel takes four floats, in red, green, blue,
+      /// alpha order, with the same values as SetFromRGBA and friends.
+      /// \param[in] _in Packed colors.
+      /// \param[out] _out Float RGBA values, 4 * _n elements.
+      /// \param[in] _n Number of pixels.
+      /// \param[in] _format Channel order of _in.
+      public: static void PackedToFloat(const unsigned int *_in, float *_out,
+                  const size_t _n, const PixelFormat _format = PIXEL_RGBA);
+
+      /// \brief Convert an array of floating point RGBA colors to packed
+      /// 32-bit colors. Components are saturated to [0, 1], with NaN
+      /// mapped to 0, and then truncated to 8 bits like AsRGBA.
+      /// \param[in] _in Float RGBA values, 4 * _n elements.
+      /// \param[out] _out Packed colors.
+      /// \param[in] _n Number of pixels.
+      /// \param[in] _format Channel order of _out.
+      public: static void FloatToPacked(const float *_in, unsigned int *_out,
+                  const size_t _n, const PixelFormat _format = PIXEL_RGBA);
+
+      /// \brief Reorder the channels of an array of packed 32-bit colors.
+      /// _in and _out may be the same array.
+      /// \param[in] _in Packed colors.
+      /// \param[out] _out Reordered colors.
+      /// \param[in] _n Number of pixels.
+      /// \param[in] _from Channel order of _in.
+      /// \param[in] _to Channel order of _out.
+      public: static void ConvertPacked(const unsigned int *_in,
+                  unsigned int *_out, const size_t _n,
+                  const PixelFormat _from, const PixelFormat _to);
+
+      /// \brief Convert an array of floating point RGBA colors to HSV.
+      /// Each output pixel takes three floats with the same values as HSV().
+      /// \param[in] _rgba Float RGBA values, 4 * _n elements.
+      /// \param[out] _hsv HSV values, 3 * _n elements.
+      /// \param[in] _n Number of pixels.
+      public: static void RGBAToHSV(const float *_rgba, float *_hsv,
+                                    const size_t _n);
+
+      /// \brief Convert an array of HSV colors to floating point RGBA, with
+      /// the same values as SetFromHSV, including its clamping of red,
+      /// green and blue values above 1. Alpha is set to 1.
+      /// \param[in] _hsv HSV values, 3 * _n elements. Hue is in degrees,
+      /// saturation and value in [0, 1].
+      /// \param[out] _rgba Float RGBA values, 4 * _n elements.
+      /// \param[in] _n Number of pixels.
+      public: static void HSVToRGBA(const float *_hsv, float *_rgba,
+                                    const size_t _n);
+
+      /// \brief Convert an array of floating point RGBA colors to YUV.
+      /// Each output pixel takes three floats with the same values as YUV().
+      /// \param[in] _rgba Float RGBA values, 4 * _n elements.
+      /// \param[out] _yuv YUV values, 3 * _n elements.
+      /// \param[in] _n Number of pixels.
+      public: static void RGBAToYUV(const float *_rgba, float *_yuv,
+                                    const size_t _n);
+
+      /// \brief Convert an array of YUV colors to floating point RGBA, with
+      /// the same formula and clamping as SetFromYUV. Alpha is set to 1.
+      /// \param[in] _yuv YUV values, 3 * _n elements.
+      /// \param[out] _rgba Float RGBA values, 4 * _n elements.
+      /// \param[in] _n Number of pixels.
+      public: static void YUVToRGBA(const float *_yuv, float *_rgba,
+                                    const size_t _n);
+
       /// \brief Addition operator (this + _pt)
       /// \param[in] _pt Color to add
       /// \return The resulting color
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_COLORMAP_HH_
+#define IGNITION_MATH_COLORMAP_HH_
+
+#include <memory>
+#include <vector>
+#include <ignition/math/Color.hh>
+#include <ignition/math/Helpers.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Forward declare private data
+    class ColorMapPrivate;
+
+    /// \class ColorMap ColorMap.hh ignition/math/ColorMap.hh
+    /// \brief Maps scalar values to colors, for example to colorize depth
+    /// or intensity images. The map is defined by a gradient of color
+    /// stops, either one of the built in presets or a custom one, and is
+    /// baked into a lookup table so that mapping a value costs one table
+    /// read. Values are first normalized with the range set by SetRange.
+    class IGNITION_VISIBLE ColorMap
+    {
+      /// \enum Preset
+      /// \brief Built in color maps.
+      public: enum Preset
+      {
+        /// \brief Black to white.
+        GRAYSCALE = 0,
+
+        /// \brief Dark blue, blue, cyan, yellow, red, dark red.
+        JET = 1,
+
+        /// \brief Black, red, yellow, white.
+        HOT = 2,
+
+        /// \brief Hue from 0 to 300 degrees at full saturation and value,
+        /// as given by Color::SetFromHSV.
+        HSV = 3,
+
+        /// \brief Piecewise linear approximation of the perceptually
+        /// uniform viridis map, dark purple to yellow.
+        VIRIDIS = 4
+      };
+
+      /// \brief Constructor, creates a GRAYSCALE map with 256 entries and
+      /// a [0, 1] range.
+      public: ColorMap();
+
+      /// \brief Constructor with a built in map and a [0, 1] range.
+      /// \param[in] _preset Built in color map.
+      /// \param[in] _size Number of entries of the lookup table, at
+      /// least 2.
+      public: explicit ColorMap(const Preset _preset, const size_t _size = 256);
+
+      /// \brief Copy constructor.
+      /// \param[in] _map Color map to copy.
+      public: ColorMap(const ColorMap &_map);
+
+      /// \brief Destructor.
+      public: ~ColorMap();
+
+      /// \brief Assignment operator.
+      /// \param[in] _map Color map to copy.
+      /// \return Reference to this object.
+      public: ColorMap &operator=(const ColorMap &_map);
+
+      /// \brief Use a built in color map.
+      /// \param[in] _preset Built in color map.
+      public: void SetPreset(const Preset _preset);
+
+      /// \brief Use a gradient of evenly spaced color stops.
+      /// \param[in] _colors Color stops, at least 2.
+      /// \return True on success, false if there are fewer than 2 stops.
+      public: bool SetGradient(const std::vector<Color> &_colors);
+
+      /// \brief Use a gradient of color stops at given positions. Colors
+      /// are interpolated linearly between stops, and normalized values
+      /// before the first stop or after the last one take the color of
+      /// that stop.
+      /// \param[in] _positions Normalized position of each stop, in [0, 1]
+      /// and non-decreasing.
+      /// \param[in] _colors Color of each stop.
+      /// \return True on success, false if the arrays differ in size,
+      /// are empty, or the positions are invalid. The map is not modified
+      /// on failure.
+      public: bool SetGradient(const std::vector<double> &_positions,
+                               const std::vector<Color> &_colors);
+
+      /// \brief Set the number of entries of the lookup table.
+      /// \param[in] _size Number of entries, typically 256 or 4096.
+      /// \return True on success, false if _size is less than 2.
+      public: bool SetSize(const size_t _size);
+
+      /// \brief Get the number of entries of the lookup table.
+      /// \return Number of entries.
+      public: size_t Size() const;
+
+      /// \brief Set the range of values mapped to the first and last
+      /// entries of the table. Values outside the range are clamped.
+      /// _min may be greater than _max to reverse the map.
+      /// \param[in] _min Value mapped to the first entry.
+      /// \param[in] _max Value mapped to the last entry.
+      /// \return True on success, false if the bounds are equal or not
+      /// finite.
+      public: bool SetRange(const double _min, const double _max);
+
+      /// \brief Get the value mapped to the first entry.
+      /// \return Lower end of the range.
+      public: double Min() const;
+
+      /// \brief Get the value mapped to the last entry.
+      /// \return Upper end of the range.
+      public: double Max() const;
+
+      /// \brief Set the color given to NaN values.
+      /// \param[in] _color Color for NaN values.
+      public: void SetInvalidColor(const Color &_color);
+
+      /// \brief Get the color given to NaN values. The default is
+      /// transparent black.
+      /// \return Color for NaN values.
+      public: Color InvalidColor() const;
+
+      /// \brief Get the color of a value.
+      /// \param[in] _value Value to map.
+      /// \return Color of the nearest table entry.
+      public: Color Value(const double _value) const;
+
+      /// \brief Map an array of values to packed colors.
+      /// \param[in] _values Values to map.
+      /// \param[out] _out Packed colors, one per value.
+      /// \param[in] _n Number of values.
+      /// \param[in] _format Channel order of _out.
+      public: void Apply(const float *_values, unsigned int *_out,
+                  const size_t _n,
+                  const Color::PixelFormat _format = Color::PIXEL_RGBA) const;
+
+      /// \brief Map an array of values to packed colors.
+      /// \param[in] _values Values to map.
+      /// \param[out] _out Packed colors, one per value.
+      /// \param[in] _n Number of values.
+      /// \param[in] _format Channel order of _out.
+      public: void Apply(const double *_values, unsigned int *_out,
+                  const size_t _n,
+                  const Color::PixelFormat _format = Color::PIXEL_RGBA) const;
+
+      /// \brief Map an array of values to float RGBA colors.
+      /// \param[in] _values Values to map.
+      /// \param[out] _out Float RGBA values, 4 * _n elements.
+      /// \param[in] _n Number of values.
+      public: void Apply(const float *_values, float *_out,
+                         const size_t _n) const;
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ColorMapPrivate> dataPtr;
+    };
+  }
+}
+#endif
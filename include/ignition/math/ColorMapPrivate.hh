@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_COLORMAPPRIVATE_HH_
+#define IGNITION_MATH_COLORMAPPRIVATE_HH_
+
+#include <cmath>
+#include <vector>
+#include "ignition/math/Color.hh"
+
+namespace ignition
+{
+  namespace math
+  {
+    /// \internal
+    /// \brief Private data for ColorMap class.
+    class ColorMapPrivate
+    {
+      /// \brief Fill the lookup tables from the gradient.
+      public: void Bake();
+
+      /// \brief Table index of a value. NaN values give Size().
+      /// \param[in] _value Value to map.
+      /// \return Index in [0, Size()].
+      public: size_t Index(const double _value) const
+      {
+        // Written so that NaN fails both comparisons
+        const double x = (_value - this->min) * this->scale;
+        const double clamped = x > 0 ? (x < this->last ? x : this->last) : 0;
+        return std::isnan(_value) ? this->size :
+          static_cast<size_t>(clamped + 0.5);
+      }
+
+      /// \brief Positions of the gradient stops.
+      public: std::vector<double> positions;
+
+      /// \brief Colors of the gradient stops.
+      public: std::vector<Color> colors;
+
+      /// \brief Number of table entries.
+      public: size_t size = 256;
+
+      /// \brief Value mapped to the first entry.
+      public: double min = 0;
+
+      /// \brief Value mapped to the last entry.
+      public: double max = 1;
+
+      /// \brief (size - 1) / (max - min).
+      public: double scale = 255;
+
+      /// \brief Index of the last entry, size - 1.
+      public: double last = 255;
+
+      /// \brief Color of NaN values.
+      public: Color invalid = Color(0, 0, 0, 0);
+
+      /// \brief Float RGBA table, 4 * (size + 1) values. The extra entry
+      /// holds the invalid color.
+      public: std::vector<float> table;
+
+      /// \brief Packed table for each Color::PixelFormat, size + 1
+      /// values each.
+      public: std::vector<unsigned int> packed[4];
+    };
+  }
+}
+#endif
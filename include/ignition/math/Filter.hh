@@ -17,6 +17,8 @@
 #ifndef IGNITION_MATH_FILTER_HH_
 #define IGNITION_MATH_FILTER_HH_
 
+#include <vector>
+
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Vector3.hh>
 #include <ignition/math/Quaternion.hh>
@@ -89,6 +91,24 @@ namespace ignition
         return this->y0;
       }
 
+      /// \brief Process a block of consecutive samples. This is equivalent
+      /// to calling Process(const T&) on each sample in turn.
+      /// \param[in] _in Input samples.
+      /// \param[out] _out Output samples. May be the same buffer as _in.
+      /// \param[in] _n Number of samples.
+      public: void Process(const T *_in, T *_out, const size_t _n)
+      {
+        const double ca0 = this->a0;
+        const double cb1 = this->b1;
+        T y = this->y0;
+        for (size_t i = 0; i < _n; ++i)
+        {
+          y = ca0 * _in[i] + cb1 * y;
+          _out[i] = y;
+        }
+        this->y0 = y;
+      }
+
       /// \brief Input gain control.
       protected: double a0 = 0;
 
@@ -124,6 +144,22 @@ namespace ignition
         y0 = math::Quaterniond::Slerp(a0, y0, _x);
         return y0;
       }
+
+      /// \brief Process a block of consecutive samples. This is equivalent
+      /// to calling Process(const math::Quaterniond&) on each sample in
+      /// turn.
+      /// \param[in] _in Input samples.
+      /// \param[out] _out Output samples. May be the same buffer as _in.
+      /// \param[in] _n Number of samples.
+      public: void Process(const math::Quaterniond *_in,
+                           math::Quaterniond *_out, const size_t _n)
+      {
+        for (size_t i = 0; i < _n; ++i)
+        {
+          y0 = math::Quaterniond::Slerp(a0, y0, _in[i]);
+          _out[i] = y0;
+        }
+      }
     };
 
     /// \class OnePoleVector3 Filter.hh ignition/math/Filter.hh
@@ -210,6 +246,46 @@ namespace ignition
         return this->y0;
       }
 
+      /// \brief Process a block of consecutive samples. This is equivalent
+      /// to calling BiQuad::Process(const T&) on each sample in turn, but
+      /// keeps the filter state in locals and avoids a virtual call per
+      /// sample.
+      /// \param[in] _in Input samples.
+      /// \param[out] _out Output samples. May be the same buffer as _in.
+      /// \param[in] _n Number of samples.
+      public: void Process(const T *_in, T *_out, const size_t _n)
+      {
+        if (_n == 0)
+          return;
+
+        const double ca0 = this->a0;
+        const double ca1 = this->a1;
+        const double ca2 = this->a2;
+        const double cb1 = this->b1;
+        const double cb2 = this->b2;
+        T sx1 = this->x1;
+        T sx2 = this->x2;
+        T sy1 = this->y1;
+        T sy2 = this->y2;
+
+        for (size_t i = 0; i < _n; ++i)
+        {
+          const T x = _in[i];
+          const T y = ca0 * x + ca1 * sx1 + ca2 * sx2 - cb1 * sy1 - cb2 * sy2;
+          sx2 = sx1;
+          sx1 = x;
+          sy2 = sy1;
+          sy1 = y;
+          _out[i] = y;
+        }
+
+        this->x1 = sx1;
+        this->x2 = sx2;
+        this->y1 = sy1;
+        this->y2 = sy2;
+        this->y0 = sy1;
+      }
+
       /// \brief Input gain control coefficients.
       protected: double a0 = 0,
                         a1 = 0,
@@ -241,6 +317,297 @@ namespace ignition
         this->Set(math::Vector3d(0, 0, 0));
       }
     };
+
+    /// \class BiQuadCascade Filter.hh ignition/math/Filter.hh
+    /// \brief A higher-order filter made of second-order sections in
+    /// series. The output of each BiQuad section is the input of the next
+    /// one, so a cascade of N sections is a filter of order 2N.
+    template <class T>
+    class BiQuadCascade : public Filter<T>
+    {
+      /// \brief Constructor.
+      public: BiQuadCascade() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _sections Number of second-order sections.
+      public: explicit BiQuadCascade(const size_t _sections)
+      : sections(_sections)
+      {
+      }
+
+      /// \brief Constructor.
+      /// \param[in] _sections Number of second-order sections.
+      /// \param[in] _fc Cutoff frequency.
+      /// \param[in] _fs Sample rate.
+      public: BiQuadCascade(const size_t _sections, double _fc, double _fs)
+      : sections(_sections)
+      {
+        this->Fc(_fc, _fs);
+      }
+
+      /// \brief Get the number of second-order sections.
+      /// \return Number of sections.
+      public: size_t Sections() const
+      {
+        return this->sections.size();
+      }
+
+      /// \brief Set the cutoff frequency and sample rate. The Q
+      /// coefficients of the sections are chosen so that the cascade is a
+      /// Butterworth low-pass filter of order 2 * Sections().
+      /// \param[in] _fc Cutoff frequency.
+      /// \param[in] _fs Sample rate.
+      public: virtual void Fc(double _fc, double _fs)
+      {
+        const size_t n = this->Sections();
+        for (size_t i = 0; i < n; ++i)
+        {
+          double q = 1.0 / (2.0 * cos(IGN_PI * (2 * i + 1) / (4.0 * n)));
+          this->sections[i].Fc(_fc, _fs, q);
+        }
+      }
+
+      /// \brief Set the cutoff frequency, sample rate and Q coefficient
+      /// of one section.
+      /// \param[in] _section Section index, must be less than Sections().
+      /// \param[in] _fc Cutoff frequency.
+      /// \param[in] _fs Sample rate.
+      /// \param[in] _q Q coefficient.
+      public: void SectionFc(const size_t _section, double _fc, double _fs,
+                             double _q)
+      {
+        this->sections[_section].Fc(_fc, _fs, _q);
+      }
+
+      /// \brief Set the output and history of every section.
+      /// \param[in] _val New filter output.
+      public: virtual void Set(const T &_val)
+      {
+        for (auto &section : this->sections)
+          section.Set(_val);
+        this->y0 = _val;
+      }
+
+      /// \brief Update the filter's output.
+      /// \param[in] _x Input value.
+      /// \return The filter's current output.
+      public: const T &Process(const T &_x)
+      {
+        T x = _x;
+        for (auto &section : this->sections)
+          x = section.Process(x);
+        this->y0 = x;
+        return this->y0;
+      }
+
+      /// \brief Process a block of consecutive samples. Each section
+      /// filters the whole block before the next one runs.
+      /// \param[in] _in Input samples.
+      /// \param[out] _out Output samples. May be the same buffer as _in.
+      /// \param[in] _n Number of samples.
+      public: void Process(const T *_in, T *_out, const size_t _n)
+      {
+        if (_n == 0)
+          return;
+
+        if (this->sections.empty())
+        {
+          for (size_t i = 0; i < _n; ++i)
+            _out[i] = _in[i];
+        }
+        else
+        {
+          this->sections[0].Process(_in, _out, _n);
+          for (size_t i = 1; i < this->sections.size(); ++i)
+            this->sections[i].Process(_out, _out, _n);
+        }
+        this->y0 = _out[_n - 1];
+      }
+
+      /// \brief Second-order sections, in processing order.
+      private: std::vector<BiQuad<T>> sections;
+    };
+
+    /// \class BiQuadBank Filter.hh ignition/math/Filter.hh
+    /// \brief A bank of independent scalar bi-quad filters, one per
+    /// channel. Coefficients and state are stored per channel in
+    /// contiguous arrays, so that a whole frame (one sample for every
+    /// channel) is processed in a single non-virtual call whose inner
+    /// loop runs across channels and can be vectorized by the compiler.
+    /// Each channel behaves exactly like a BiQuad<T>.
+    /// \sa BiQuad
+    template <class T>
+    class BiQuadBank
+    {
+      /// \brief Constructor.
+      public: BiQuadBank() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _channels Number of channels.
+      public: explicit BiQuadBank(const size_t _channels)
+      {
+        this->Resize(_channels);
+      }
+
+      /// \brief Constructor.
+      /// \param[in] _channels Number of channels.
+      /// \param[in] _fc Cutoff frequency of every channel.
+      /// \param[in] _fs Sample rate of every channel.
+      public: BiQuadBank(const size_t _channels, double _fc, double _fs)
+      {
+        this->Resize(_channels);
+        this->Fc(_fc, _fs);
+      }
+
+      /// \brief Get the number of channels.
+      /// \return Number of channels.
+      public: size_t Channels() const
+      {
+        return this->y1.size();
+      }
+
+      /// \brief Change the number of channels. New channels have zero
+      /// coefficients and state.
+      /// \param[in] _channels Number of channels.
+      public: void Resize(const size_t _channels)
+      {
+        this->a0.resize(_channels, 0);
+        this->a1.resize(_channels, 0);
+        this->a2.resize(_channels, 0);
+        this->b1.resize(_channels, 0);
+        this->b2.resize(_channels, 0);
+        this->x1.resize(_channels, 0);
+        this->x2.resize(_channels, 0);
+        this->y1.resize(_channels, 0);
+        this->y2.resize(_channels, 0);
+      }
+
+      /// \brief Set the cutoff frequency and sample rate of every channel.
+      /// \param[in] _fc Cutoff frequency.
+      /// \param[in] _fs Sample rate.
+      public: void Fc(double _fc, double _fs)
+      {
+        this->Fc(_fc, _fs, 0.5);
+      }
+
+      /// \brief Set the cutoff frequency, sample rate and Q coefficient of
+      /// every channel.
+      /// \param[in] _fc Cutoff frequency.
+      /// \param[in] _fs Sample rate.
+      /// \param[in] _q Q coefficient.
+      public: void Fc(double _fc, double _fs, double _q)
+      {
+        for (size_t i = 0; i < this->Channels(); ++i)
+          this->ChannelFc(i, _fc, _fs, _q);
+      }
+
+      /// \brief Set the cutoff frequency, sample rate and Q coefficient of
+      /// one channel.
+      /// \param[in] _channel Channel index, must be less than Channels().
+      /// \param[in] _fc Cutoff frequency.
+      /// \param[in] _fs Sample rate.
+      /// \param[in] _q Q coefficient.
+      public: void ChannelFc(const size_t _channel, double _fc, double _fs,
+                             double _q = 0.5)
+      {
+        double k = tan(IGN_PI * _fc / _fs);
+        double kQuadDenom = k * k + k / _q + 1.0;
+        double gain = k * k / kQuadDenom;
+        this->a0[_channel] = static_cast<T>(gain);
+        this->a1[_channel] = static_cast<T>(2 * gain);
+        this->a2[_channel] = static_cast<T>(gain);
+        this->b1[_channel] = static_cast<T>(2 * (k * k - 1.0) / kQuadDenom);
+        this->b2[_channel] = static_cast<T>((k * k - k / _q + 1.0) /
+            kQuadDenom);
+      }
+
+      /// \brief Set the output and history of every channel.
+      /// \param[in] _val New filter output.
+      public: void Set(const T &_val)
+      {
+        for (size_t i = 0; i < this->Channels(); ++i)
+          this->Set(i, _val);
+      }
+
+      /// \brief Set the output and history of one channel.
+      /// \param[in] _channel Channel index, must be less than Channels().
+      /// \param[in] _val New filter output.
+      public: void Set(const size_t _channel, const T &_val)
+      {
+        this->x1[_channel] = this->x2[_channel] = _val;
+        this->y1[_channel] = this->y2[_channel] = _val;
+      }
+
+      /// \brief Get the output of one channel.
+      /// \param[in] _channel Channel index, must be less than Channels().
+      /// \return The channel's current output.
+      public: T Value(const size_t _channel) const
+      {
+        return this->y1[_channel];
+      }
+
+      /// \brief Get the outputs of all channels.
+      /// \return Pointer to Channels() contiguous outputs.
+      public: const T *Values() const
+      {
+        return this->y1.data();
+      }
+
+      /// \brief Process one frame, made of one sample for every channel.
+      /// \param[in] _in Channels() input samples.
+      /// \param[out] _out Channels() output samples. May be the same
+      /// buffer as _in.
+      public: void Process(const T *_in, T *_out)
+      {
+        const size_t n = this->Channels();
+        const T *ca0 = this->a0.data();
+        const T *ca1 = this->a1.data();
+        const T *ca2 = this->a2.data();
+        const T *cb1 = this->b1.data();
+        const T *cb2 = this->b2.data();
+        T *sx1 = this->x1.data();
+        T *sx2 = this->x2.data();
+        T *sy1 = this->y1.data();
+        T *sy2 = this->y2.data();
+
+        for (size_t i = 0; i < n; ++i)
+        {
+          const T x = _in[i];
+          const T y = ca0[i] * x + ca1[i] * sx1[i] + ca2[i] * sx2[i] -
+                      cb1[i] * sy1[i] - cb2[i] * sy2[i];
+          sx2[i] = sx1[i];
+          sx1[i] = x;
+          sy2[i] = sy1[i];
+          sy1[i] = y;
+          _out[i] = y;
+        }
+      }
+
+      /// \brief Process several consecutive frames.
+      /// \param[in] _in _frames * Channels() input samples, frame by
+      /// frame (sample c of frame f is at index f * Channels() + c).
+      /// \param[out] _out Output samples, in the same layout as _in. May
+      /// be the same buffer as _in.
+      /// \param[in] _frames Number of frames.
+      public: void Process(const T *_in, T *_out, const size_t _frames)
+      {
+        const size_t n = this->Channels();
+        for (size_t f = 0; f < _frames; ++f)
+          this->Process(_in + f * n, _out + f * n);
+      }
+
+      /// \brief Input gain coefficients.
+      private: std::vector<T> a0, a1, a2;
+
+      /// \brief Feedback coefficients.
+      private: std::vector<T> b1, b2;
+
+      /// \brief Previous inputs and outputs.
+      private: std::vector<T> x1, x2, y1, y2;
+    };
+
+    typedef BiQuadBank<double> BiQuadBankd;
+    typedef BiQuadBank<float> BiQuadBankf;
   }
 }
 
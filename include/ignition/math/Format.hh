@@ -0,0 +1,289 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_FORMAT_HH_
+#define IGNITION_MATH_FORMAT_HH_
+
+#include <cstring>
+#include <type_traits>
+
+#include <ignition/math/Angle.hh>
+#include <ignition/math/Box.hh>
+#include <ignition/math/Color.hh>
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Line2.hh>
+#include <ignition/math/Line3.hh>
+#include <ignition/math/Matrix3.hh>
+#include <ignition/math/Matrix4.hh>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Quaternion.hh>
+#include <ignition/math/Vector2.hh>
+#include <ignition/math/Vector3.hh>
+#include <ignition/math/Vector4.hh>
+
+// Text formatting of the math types into caller supplied buffers. Each
+// function writes the same values as the type's operator<<, separated by
+// single spaces, using formatFloat for the numbers. Nothing is allocated
+// and the output does not depend on the locale. Every function returns
+// the number of characters written, not counting the null terminator, or
+// 0 if the buffer is too small.
+//
+// The _precision parameter is the number of decimal places, or a negative
+// value for the shortest text that parses back to the same number. The
+// numbers of float types, such as Vector3f and Color, are parsed back as
+// floats, so that 0.1f is written "0.1".
+
+namespace ignition
+{
+  namespace math
+  {
+    /// \brief Type in which the numbers of a type with T components are
+    /// written: float for float, and double otherwise.
+    template<typename T>
+    using FormatValue = typename std::conditional<
+      std::is_same<T, float>::value, float, double>::type;
+
+    /// \brief Write an angle, in radians.
+    /// \param[out] _buffer Destination buffer.
+    /// \param[in] _size Size of _buffer.
+    /// \param[in] _a Angle to write.
+    /// \param[in] _precision Number of decimal places, or -1.
+    /// \return Number of characters written, or 0 if _buffer is too small.
+    inline size_t format(char *_buffer, const size_t _size, const Angle &_a,
+                         const int _precision = -1)
+    {
+      return formatFloat(_buffer, _size, _a.Radian(), _precision);
+    }
+
+    /// \brief Write a two dimensional vector.
+    /// \param[out] _buffer Destination buffer.
+    /// \param[in] _size Size of _buffer.
+    /// \param[in] _v Vector to write.
+    /// \param[in] _precision Number of decimal places, or -1.
+    /// \return Number of characters written, or 0 if _buffer is too small.
+    template<typename T>
+    inline size_t format(char *_buffer, const size_t _size,
+                         const Vector2<T> &_v, const int _precision = -1)
+    {
+      using Value = FormatValue<T>;
+      const Value values[2] = {static_cast<Value>(_v.X()),
+                               static_cast<Value>(_v.Y())};
+      return formatFloats(_buffer, _size, values, 2, _precision);
+    }
+
+    /// \brief Write a three dimensional vector.
+    /// \param[out] _buffer Destination buffer.
+    /// \param[in] _size Size of _buffer.
+    /// \param[in] _v Vector to write.
+    /// \param[in] _precision Number of decimal places, or -1.
+    /// \return Number of characters written, or 0 if _buffer is too small.
+    template<typename T>
+    inline size_t format(char *_buffer, const size_t _size,
+                         const Vector3<T> &_v, const int _precision = -1)
+    {
+      using Value = FormatValue<T>;
+      const Value values[3] = {static_cast<Value>(_v.X()),
+                               static_cast<Value>(_v.Y()),
+                               static_cast<Value>(_v.Z())};
+      return formatFloats(_buffer, _size, values, 3, _precision);
+    }
+
+    /// \brief Write a four dimensional vector.
+    /// \param[out] _buffer Destination buffer.
+    /// \param[in] _size Size of _buffer.
+    /// \param[in] _v Vector to write.
+    /// \param[in] _precision Number of decimal places, or -1.
+    /// \return Number of characters written, or 0 if _buffer is too small.
+    template<typename T>
+    inline size_t format(char *_buffer, const size_t _size,
+                         const Vector4<T> &_v, const int _precision = -1)
+    {
+      using Value = FormatValue<T>;
+      const Value values[4] = {static_cast<Value>(_v.X()),
+                               static_cast<Value>(_v.Y()),
+                               static_cast<Value>(_v.Z()),
+                               static_cast<Value>(_v.W())};
+      return formatFloats(_buffer, _size, values, 4, _precision);
+    }
+
+    /// \brief Write a quaternion as roll, pitch and yaw angles.
+    /// \param[out] _buffer Destination buffer.
+    /// \param[in] _size Size of _buffer.
+    /// \param[in] _q Quaternion to write.
+    /// \param[in] _precision Number of decimal places, or -1.
+    /// \return Number of characters written, or 0 if _buffer is too small.
+    template<typename T>
+    inline size_t format(char *_buffer, const size_t _size,
+                         const Quaternion<T> &_q, const int _precision = -1)
+    {
+      return format(_buffer, _size, _q.Euler(), _precision);
+    }
+
+    /// \brief Write a pose as x, y, z, roll, pitch and yaw.
+    /// \param[out] _buffer Destination buffer.
+    /// \param[in] _size Size of _buffer.
+    /// \param[in] _pose Pose to write.
+    /// \param[in] _precision Number of decimal places, or -1.
+    /// \return Number of characters written, or 0 if _buffer is too small.
+    template<typename T>
+    inline size_t format(char *_buffer, const size_t _size,
+                         const Pose3<T> &_pose, const int _precision = -1)
+    {
+      const Vector3<T> euler = _pose.Rot().Euler();
+      using Value = FormatValue<T>;
+      const Value values[6] = {static_cast<Value>(_pose.Pos().X()),
+                               static_cast<Value>(_pose.Pos().Y()),
+                               static_cast<Value>(_pose.Pos().Z()),
+                               static_cast<Value>(euler.X()),
+                               static_cast<Value>(euler.Y()),
+                               static_cast<Value>(euler.Z())};
+      return formatFloats(_buffer, _size, values, 6, _precision);
+    }
+
+    /// \brief Write a 3x3 matrix in row major order.
+    /// \param[out] _buffer Destination buffer.
+    /// \param[in] _size Size of _buffer.
+    /// \param[in] _m Matrix to write.
+    /// \param[in] _precision Number of decimal places, or -1.
+    /// \return Number of characters written, or 0 if _buffer is too small.
+    template<typename T>
+    inline size_t format(char *_buffer, const size_t _size,
+                         const Matrix3<T> &_m, const int _precision = -1)
+    {
+      using Value = FormatValue<T>;
+      Value values[9];
+      for (size_t i = 0; i < 9; ++i)
+        values[i] = static_cast<Value>(_m(i / 3, i % 3));
+      return formatFloats(_buffer, _size, values, 9, _precision);
+    }
+
+    /// \brief Write a 4x4 matrix in row major order.
+    /// \param[out] _buffer Destination buffer.
+    /// \param[in] _size Size of _buffer.
+    /// \param[in] _m Matrix to write.
+    /// \param[in] _precision Number of decimal places, or -1.
+    /// \return Number of characters written, or 0 if _buffer is too small.
+    template<typename T>
+    inline size_t format(char *_buffer, const size_t _size,
+                         const Matrix4<T> &_m, const int _precision = -1)
+    {
+      using Value = FormatValue<T>;
+      Value values[16];
+      for (size_t i = 0; i < 16; ++i)
+        values[i] = static_cast<Value>(_m(i / 4, i % 4));
+      return formatFloats(_buffer, _size, values, 16, _precision);
+    }
+
+    /// \brief Write a two dimensional line segment as its start and end
+    /// points.
+    /// \param[out] _buffer Destination buffer.
+    /// \param[in] _size Size of _buffer.
+    /// \param[in] _line Line to write.
+    /// \param[in] _precision Number of decimal places, or -1.
+    /// \return Number of characters written, or 0 if _buffer is too small.
+    template<typename T>
+    inline size_t format(char *_buffer, const size_t _size,
+                         const Line2<T> &_line, const int _precision = -1)
+    {
+      using Value = FormatValue<T>;
+      const Value values[4] = {static_cast<Value>(_line[0].X()),
+                               static_cast<Value>(_line[0].Y()),
+                               static_cast<Value>(_line[1].X()),
+                               static_cast<Value>(_line[1].Y())};
+      return formatFloats(_buffer, _size, values, 4, _precision);
+    }
+
+    /// \brief Write a three dimensional line segment as its start and end
+    /// points.
+    /// \param[out] _buffer Destination buffer.
+    /// \param[in] _size Size of _buffer.
+    /// \param[in] _line Line to write.
+    /// \param[in] _precision Number of decimal places, or -1.
+    /// \return Number of characters written, or 0 if _buffer is too small.
+    template<typename T>
+    inline size_t format(char *_buffer, const size_t _size,
+                         const Line3<T> &_line, const int _precision = -1)
+    {
+      using Value = FormatValue<T>;
+      const Value values[6] = {static_cast<Value>(_line[0].X()),
+                               static_cast<Value>(_line[0].Y()),
+                               static_cast<Value>(_line[0].Z()),
+                               static_cast<Value>(_line[1].X()),
+                               static_cast<Value>(_line[1].Y()),
+                               static_cast<Value>(_line[1].Z())};
+      return formatFloats(_buffer, _size, values, 6, _precision);
+    }
+
+    /// \brief Write a color as red, green, blue and alpha.
+    /// \param[out] _buffer Destination buffer.
+    /// \param[in] _size Size of _buffer.
+    /// \param[in] _color Color to write.
+    /// \param[in] _precision Number of decimal places, or -1.
+    /// \return Number of characters written, or 0 if _buffer is too small.
+    inline size_t format(char *_buffer, const size_t _size,
+                         const Color &_color, const int _precision = -1)
+    {
+      const float values[4] = {_color.R(), _color.G(), _color.B(),
+                               _color.A()};
+      return formatFloats(_buffer, _size, values, 4, _precision);
+    }
+
+    /// \brief Write a box as "Min[x y z] Max[x y z]".
+    /// \param[out] _buffer Destination buffer.
+    /// \param[in] _size Size of _buffer.
+    /// \param[in] _box Box to write.
+    /// \param[in] _precision Number of decimal places, or -1.
+    /// \return Number of characters written, or 0 if _buffer is too small.
+    inline size_t format(char *_buffer, const size_t _size, const Box &_box,
+                         const int _precision = -1)
+    {
+      // Room for "Min[", "] Max[" and "]" around the corners
+      if (_size < 12)
+      {
+        if (_size > 0)
+          _buffer[0] = '\0';
+        return 0;
+      }
+
+      size_t len = 0;
+      std::memcpy(_buffer, "Min[", 4);
+      len += 4;
+
+      size_t n = format(_buffer + len, _size - len - 7, _box.Min(),
+                        _precision);
+      if (n == 0)
+      {
+        _buffer[0] = '\0';
+        return 0;
+      }
+      len += n;
+      std::memcpy(_buffer + len, "] Max[", 6);
+      len += 6;
+
+      n = format(_buffer + len, _size - len - 1, _box.Max(), _precision);
+      if (n == 0)
+      {
+        _buffer[0] = '\0';
+        return 0;
+      }
+      len += n;
+      _buffer[len++] = ']';
+      _buffer[len] = '\0';
+      return len;
+    }
+  }
+}
+#endif
@@ -728,6 +728,115 @@ namespace ignition
       return s * acc;
     }
 
+    /// \brief Parse an integer from a range of characters, without
+    /// allocation and independently of the locale. Leading white spaces
+    /// and commas are skipped, and the number must be followed by a white
+    /// space, a comma or the end of the range.
+    /// \param[in,out] _pos Start of the text. On success it is moved past
+    /// the number, on failure it points to the invalid token, or to _end
+    /// if there is no number left.
+    /// \param[in] _end End of the text.
+    /// \param[out] _value Parsed value, not modified on failure.
+    /// \return True on success, false if the token is not an integer or
+    /// does not fit in an int.
+    bool IGNITION_VISIBLE parseInt(const char *&_pos, const char *_end,
+                                   int &_value);
+
+    /// \brief Parse a floating point number from a range of characters,
+    /// without allocation and independently of the locale. Accepts decimal
+    /// and scientific notation, "nan" and "inf". The result is correctly
+    /// rounded. Separators are handled as in parseInt(const char *&,
+    /// const char *, int &).
+    /// \param[in,out] _pos Start of the text. On success it is moved past
+    /// the number, on failure it points to the invalid token, or to _end
+    /// if there is no number left.
+    /// \param[in] _end End of the text.
+    /// \param[out] _value Parsed value, not modified on failure.
+    /// \return True on success.
+    bool IGNITION_VISIBLE parseFloat(const char *&_pos, const char *_end,
+                                     double &_value);
+
+    /// \brief Parse a list of integers separated by white spaces or
+    /// commas, such as a line of a CSV file.
+    /// \param[in,out] _pos Start of the text. It is moved past the last
+    /// parsed number. If fewer than _max numbers are parsed, it points to
+    /// the invalid token, or to _end if the text ran out.
+    /// \param[in] _end End of the text.
+    /// \param[out] _values Parsed values.
+    /// \param[in] _max Maximum number of values to parse.
+    /// \return Number of values parsed.
+    size_t IGNITION_VISIBLE parseInts(const char *&_pos, const char *_end,
+                                      int *_values, const size_t _max);
+
+    /// \brief Parse a list of floating point numbers separated by white
+    /// spaces or commas, such as a line of a CSV file.
+    /// \param[in,out] _pos Start of the text. It is moved past the last
+    /// parsed number. If fewer than _max numbers are parsed, it points to
+    /// the invalid token, or to _end if the text ran out.
+    /// \param[in] _end End of the text.
+    /// \param[out] _values Parsed values.
+    /// \param[in] _max Maximum number of values to parse.
+    /// \return Number of values parsed.
+    size_t IGNITION_VISIBLE parseFloats(const char *&_pos, const char *_end,
+                                        double *_values, const size_t _max);
+
+    /// \brief Write a floating point number into a character buffer,
+    /// without allocation and independently of the locale. With a
+    /// negative precision the shortest text that parses back to the same
+    /// double is written, such as "0.1", "-2.5e-7" or "1e+30". Otherwise
+    /// the number is written with _precision decimal places, like the
+    /// "%.*f" printf format. NaN and infinite values are written as "nan",
+    /// "inf" and "-inf". The text is always null terminated when _size is
+    /// not zero.
+    /// \param[out] _buffer Destination buffer. 25 characters are enough
+    /// for any value with a negative precision.
+    /// \param[in] _size Size of _buffer.
+    /// \param[in] _value Number to write.
+    /// \param[in] _precision Number of decimal places, at most 17, or a
+    /// negative value for the shortest round trip text.
+    /// \return Number of characters written, not counting the null
+    /// terminator, or 0 if the buffer is too small.
+    /// \sa parseFloat
+    size_t IGNITION_VISIBLE formatFloat(char *_buffer, const size_t _size,
+                                        const double _value,
+                                        const int _precision = -1);
+
+    /// \brief Write a list of floating point numbers into a character
+    /// buffer, as formatFloat does, separated by a single character.
+    /// \param[out] _buffer Destination buffer.
+    /// \param[in] _size Size of _buffer.
+    /// \param[in] _values Numbers to write.
+    /// \param[in] _n Number of values.
+    /// \param[in] _precision Number of decimal places, or a negative value
+    /// for the shortest round trip text.
+    /// \param[in] _separator Character written between values.
+    /// \return Number of characters written, not counting the null
+    /// terminator, or 0 if the buffer is too small.
+    size_t IGNITION_VISIBLE formatFloats(char *_buffer, const size_t _size,
+                                         const double *_values,
+                                         const size_t _n,
+                                         const int _precision = -1,
+                                         const char _separator = ' ');
+
+    /// \brief Write a list of single precision numbers into a character
+    /// buffer, as formatFloats does for doubles, except that the shortest
+    /// text is the shortest that parses back to the same float. 0.1f is
+    /// written "0.1" rather than "0.10000000149011612".
+    /// \param[out] _buffer Destination buffer.
+    /// \param[in] _size Size of _buffer.
+    /// \param[in] _values Numbers to write.
+    /// \param[in] _n Number of values.
+    /// \param[in] _precision Number of decimal places, or a negative value
+    /// for the shortest round trip text.
+    /// \param[in] _separator Character written between values.
+    /// \return Number of characters written, not counting the null
+    /// terminator, or 0 if the buffer is too small.
+    size_t IGNITION_VISIBLE formatFloats(char *_buffer, const size_t _size,
+                                         const float *_values,
+                                         const size_t _n,
+                                         const int _precision = -1,
+                                         const char _separator = ' ');
+
 
     // Degrade precision on Windows, which cannot handle 'long double'
     // values properly. See the implementation of Unpair.
@@ -17,6 +17,8 @@
 #ifndef IGNITION_MATH_INERTIAL_HH_
 #define IGNITION_MATH_INERTIAL_HH_
 
+#include <vector>
+
 #include "ignition/math/MassMatrix3.hh"
 #include "ignition/math/Pose3.hh"
 
@@ -199,18 +201,18 @@ namespace ignition
           ixxyyzz.X() += m1 * (std::pow(dc[1], 2) + std::pow(dc[2], 2));
           ixxyyzz.Y() += m1 * (std::pow(dc[2], 2) + std::pow(dc[0], 2));
           ixxyyzz.Z() += m1 * (std::pow(dc[0], 2) + std::pow(dc[1], 2));
-          ixxyyzz.X() -= m1 * dc[0] * dc[1];
-          ixxyyzz.Y() -= m1 * dc[0] * dc[2];
-          ixxyyzz.Z() -= m1 * dc[1] * dc[2];
+          ixyxzyz.X() -= m1 * dc[0] * dc[1];
+          ixyxzyz.Y() -= m1 * dc[0] * dc[2];
+          ixyxzyz.Z() -= m1 * dc[1] * dc[2];
         }
         {
           auto dc = com2 - com;
           ixxyyzz.X() += m2 * (std::pow(dc[1], 2) + std::pow(dc[2], 2));
           ixxyyzz.Y() += m2 * (std::pow(dc[2], 2) + std::pow(dc[0], 2));
           ixxyyzz.Z() += m2 * (std::pow(dc[0], 2) + std::pow(dc[1], 2));
-          ixxyyzz.X() -= m2 * dc[0] * dc[1];
-          ixxyyzz.Y() -= m2 * dc[0] * dc[2];
-          ixxyyzz.Z() -= m2 * dc[1] * dc[2];
+          ixyxzyz.X() -= m2 * dc[0] * dc[1];
+          ixyxzyz.Y() -= m2 * dc[0] * dc[2];
+          ixyxzyz.Z() -= m2 * dc[1] * dc[2];
         }
         this->massMatrix = MassMatrix3<T>(mass, ixxyyzz, ixyxzyz);
         this->pose = Pose3<T>(com, Quaternion<T>::Identity);
@@ -228,6 +230,74 @@ namespace ignition
         return Inertial<T>(*this) += _inertial;
       }
 
+      /// \brief Combine the inertial properties of many bodies in a single
+      /// pass. This gives the same result as summing them pairwise with
+      /// operator+, but rotates each moment of inertia only once and
+      /// applies the parallel axis theorem once for the whole set.
+      /// \param[in] _inertials Inertials to combine, with poses expressed
+      /// in a common base frame.
+      /// \param[out] _result Combined inertial. Its center of mass frame is
+      /// aligned with the base frame.
+      /// \return True if the total mass is positive, otherwise false and
+      /// _result is not modified.
+      public: static bool Combine(const std::vector<Inertial<T>> &_inertials,
+                                  Inertial<T> &_result)
+      {
+        if (_inertials.empty())
+          return false;
+
+        // Accumulate moments about a reference point close to the bodies
+        // to limit cancellation when the assembly is far from the origin.
+        const Vector3<T> ref = _inertials[0].Pose().Pos();
+
+        T mass = 0;
+        Vector3<T> first;
+        Matrix3<T> moi = Matrix3<T>::Zero;
+        // Second moments of the point masses, sum(m * d * d^T)
+        T dxx = 0, dyy = 0, dzz = 0, dxy = 0, dxz = 0, dyz = 0;
+        for (const auto &inertial : _inertials)
+        {
+          const T m = inertial.MassMatrix().Mass();
+          const Vector3<T> d = inertial.Pose().Pos() - ref;
+          mass += m;
+          first += m * d;
+          moi = moi + inertial.MOI();
+          dxx += m * d[0] * d[0];
+          dyy += m * d[1] * d[1];
+          dzz += m * d[2] * d[2];
+          dxy += m * d[0] * d[1];
+          dxz += m * d[0] * d[2];
+          dyz += m * d[1] * d[2];
+        }
+
+        // Only continue if total mass is positive
+        if (mass <= 0)
+          return false;
+
+        // Center of mass relative to ref
+        const Vector3<T> c = first / mass;
+
+        // Parallel axis theorem: moments of the point masses about ref,
+        // minus the total mass located at the center of mass
+        dxx -= mass * c[0] * c[0];
+        dyy -= mass * c[1] * c[1];
+        dzz -= mass * c[2] * c[2];
+        dxy -= mass * c[0] * c[1];
+        dxz -= mass * c[0] * c[2];
+        dyz -= mass * c[1] * c[2];
+
+        const Vector3<T> ixxyyzz(moi(0, 0) + dyy + dzz,
+                                 moi(1, 1) + dzz + dxx,
+                                 moi(2, 2) + dxx + dyy);
+        const Vector3<T> ixyxzyz(moi(0, 1) - dxy,
+                                 moi(0, 2) - dxz,
+                                 moi(1, 2) - dyz);
+
+        _result.massMatrix = MassMatrix3<T>(mass, ixxyyzz, ixyxzyz);
+        _result.pose = Pose3<T>(ref + c, Quaternion<T>::Identity);
+        return true;
+      }
+
       /// \brief Mass and inertia matrix of the object expressed in the
       /// center of mass reference frame.
       private: MassMatrix3<T> massMatrix;
@@ -0,0 +1,467 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_KDTREE_HH_
+#define IGNITION_MATH_KDTREE_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <ignition/math/Vector3.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    /// \class KdTree KdTree.hh ignition/math/KdTree.hh
+    /// \brief A static k-d tree over a set of points, used to find the
+    /// points closest to a location in O(log n).
+    ///
+    /// The nodes are stored in a single array in depth first order, so
+    /// the left child of a node directly follows it. Leaves hold up to
+    /// eight points, and the points are copied in structure-of-arrays
+    /// layout sorted by leaf. The tree must be built again when the
+    /// points change.
+    ///
+    /// Queries accept a relative error _epsilon. With a positive
+    /// _epsilon the search skips the parts of the tree which cannot hold
+    /// a point (1 + _epsilon) times closer than the ones already found:
+    /// the i-th returned distance is at most (1 + _epsilon) times the
+    /// exact i-th distance, and large trees are searched faster.
+    ///
+    /// Points with a non finite coordinate are never returned by queries.
+    /// Queries return indices in the array given to Build.
+    /// \tparam T float or double.
+    template<typename T>
+    class KdTree
+    {
+      /// \brief Default constructor, creates an empty tree.
+      public: KdTree() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _points Points of the tree.
+      public: explicit KdTree(const std::vector<Vector3<T>> &_points)
+      {
+        this->Build(_points);
+      }
+
+      /// \brief Replace the points of the tree.
+      /// \param[in] _points Points of the tree.
+      public: void Build(const std::vector<Vector3<T>> &_points)
+      {
+        this->Build(_points.data(), _points.size());
+      }
+
+      /// \brief Replace the points of the tree.
+      /// \param[in] _points Array of points.
+      /// \param[in] _count Number of points.
+      public: void Build(const Vector3<T> *_points, const size_t _count)
+      {
+        this->size = _count;
+        this->nodes.clear();
+
+        // Copy the finite points, in their original order
+        std::vector<T> coords[3];
+        this->index.clear();
+        for (size_t i = 0; i < _count; ++i)
+        {
+          const Vector3<T> &p = _points[i];
+          if (!std::isfinite(p.X()) || !std::isfinite(p.Y()) ||
+              !std::isfinite(p.Z()))
+          {
+            continue;
+          }
+          this->index.push_back(i);
+          for (int j = 0; j < 3; ++j)
+            coords[j].push_back(p[j]);
+        }
+
+        // Sort the point order into the tree, with positions in coords
+        std::vector<size_t> order(this->index.size());
+        for (size_t i = 0; i < order.size(); ++i)
+          order[i] = i;
+        if (!order.empty())
+        {
+          this->nodes.reserve(2 * (order.size() / kLeafSize) + 1);
+          this->BuildNode(coords, order, 0, order.size());
+        }
+
+        // Copy the points in tree order
+        for (int j = 0; j < 3; ++j)
+          this->coord[j].resize(order.size());
+        std::vector<size_t> sortedIndex(order.size());
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+          for (int j = 0; j < 3; ++j)
+            this->coord[j][i] = coords[j][order[i]];
+          sortedIndex[i] = this->index[order[i]];
+        }
+        this->index.swap(sortedIndex);
+      }
+
+      /// \brief Remove all points.
+      public: void Clear()
+      {
+        this->Build(nullptr, 0);
+      }
+
+      /// \brief Get the number of points given to Build.
+      /// \return Number of points.
+      public: size_t Size() const
+      {
+        return this->size;
+      }
+
+      /// \brief Find the point closest to a location.
+      /// \param[in] _point Location of the query.
+      /// \param[in] _epsilon Allowed relative error on the distance, 0 for
+      /// an exact search.
+      /// \return Index of the closest point, Size() if the tree has no
+      /// finite point or _point is not finite.
+      public: size_t Nearest(const Vector3<T> &_point,
+                             const T _epsilon = 0) const
+      {
+        std::vector<Candidate> heap;
+        if (!this->Search(_point, 1, _epsilon, heap))
+          return this->size;
+        return heap.front().index;
+      }
+
+      /// \brief Find the points closest to a location.
+      /// \param[in] _point Location of the query.
+      /// \param[in] _k Number of points to find.
+      /// \param[out] _indices Indices of the closest points, sorted by
+      /// increasing distance. Fewer than _k points are found when the
+      /// tree is smaller.
+      /// \param[out] _distances Distance of each point to _point.
+      /// \param[in] _epsilon Allowed relative error on the distances, 0
+      /// for an exact search.
+      /// \return Number of points found.
+      public: size_t Nearest(const Vector3<T> &_point, const size_t _k,
+                             std::vector<size_t> &_indices,
+                             std::vector<T> &_distances,
+                             const T _epsilon = 0) const
+      {
+        std::vector<Candidate> heap;
+        this->Search(_point, _k, _epsilon, heap);
+        std::sort_heap(heap.begin(), heap.end());
+        _indices.resize(heap.size());
+        _distances.resize(heap.size());
+        for (size_t i = 0; i < heap.size(); ++i)
+        {
+          _indices[i] = heap[i].index;
+          _distances[i] = std::sqrt(heap[i].distance);
+        }
+        return heap.size();
+      }
+
+      /// \brief Find the points closest to many locations.
+      /// \param[in] _points Array of query locations.
+      /// \param[in] _count Number of queries.
+      /// \param[in] _k Number of points to find for each query.
+      /// \param[out] _indices Indices of the closest points, _k per query
+      /// sorted by increasing distance. Missing points are set to Size().
+      /// \param[out] _distances Distance of each point to its query,
+      /// infinite for missing points.
+      /// \param[in] _epsilon Allowed relative error on the distances, 0
+      /// for an exact search.
+      public: void Nearest(const Vector3<T> *_points, const size_t _count,
+                           const size_t _k, std::vector<size_t> &_indices,
+                           std::vector<T> &_distances,
+                           const T _epsilon = 0) const
+      {
+        _indices.assign(_count * _k, this->size);
+        _distances.assign(_count * _k, std::numeric_limits<T>::infinity());
+
+        // The heap is reused by all queries
+        std::vector<Candidate> heap;
+        heap.reserve(_k);
+        for (size_t q = 0; q < _count; ++q)
+        {
+          heap.clear();
+          this->Search(_points[q], _k, _epsilon, heap);
+          std::sort_heap(heap.begin(), heap.end());
+          for (size_t i = 0; i < heap.size(); ++i)
+          {
+            _indices[q * _k + i] = heap[i].index;
+            _distances[q * _k + i] = std::sqrt(heap[i].distance);
+          }
+        }
+      }
+
+      /// \brief Find the points within a distance of a location.
+      /// \param[in] _center Center of the query.
+      /// \param[in] _radius Maximum distance to _center, inclusive.
+      /// \param[out] _indices Indices of the points, in no particular
+      /// order.
+      /// \return Number of points found.
+      public: size_t Radius(const Vector3<T> &_center, const T _radius,
+                            std::vector<size_t> &_indices) const
+      {
+        _indices.clear();
+        if (this->nodes.empty() || !(_radius >= 0))
+          return 0;
+
+        const T query[3] = {_center.X(), _center.Y(), _center.Z()};
+        T offset[3] = {0, 0, 0};
+        this->SearchRadius(0, query, _radius * _radius, 0, offset, _indices);
+        return _indices.size();
+      }
+
+      /// \brief A point found by a nearest neighbor query.
+      private: struct Candidate
+      {
+        /// \brief Squared distance to the query point.
+        T distance;
+
+        /// \brief Index of the point.
+        size_t index;
+
+        /// \brief Order by distance, then by index.
+        /// \param[in] _other Candidate to compare with.
+        /// \return True if this candidate is closer.
+        bool operator<(const Candidate &_other) const
+        {
+          return this->distance < _other.distance ||
+            (!(_other.distance < this->distance) &&
+             this->index < _other.index);
+        }
+      };
+
+      /// \brief Node of the tree. The left child of a node directly
+      /// follows it.
+      private: struct Node
+      {
+        /// \brief Position of the splitting plane along the axis.
+        T split;
+
+        /// \brief Axis of the splitting plane, 3 for a leaf.
+        int axis;
+
+        /// \brief First point of a leaf, or index of the right child.
+        size_t first;
+
+        /// \brief End of the points of a leaf.
+        size_t last;
+      };
+
+      /// \brief Build the subtree over a range of points.
+      /// \param[in] _coords Coordinates of the points.
+      /// \param[in,out] _order Point order, the range is reordered.
+      /// \param[in] _begin Start of the range.
+      /// \param[in] _end End of the range.
+      private: void BuildNode(const std::vector<T> (&_coords)[3],
+                              std::vector<size_t> &_order,
+                              const size_t _begin, const size_t _end)
+      {
+        const size_t id = this->nodes.size();
+        this->nodes.push_back(Node());
+        this->nodes[id].split = 0;
+        this->nodes[id].axis = 3;
+        this->nodes[id].first = _begin;
+        this->nodes[id].last = _end;
+        if (_end - _begin <= kLeafSize)
+          return;
+
+        // Split the widest extent at the median
+        int axis = 0;
+        T widest = -1;
+        for (int j = 0; j < 3; ++j)
+        {
+          T low = _coords[j][_order[_begin]];
+          T high = low;
+          for (size_t i = _begin + 1; i < _end; ++i)
+          {
+            low = std::min(low, _coords[j][_order[i]]);
+            high = std::max(high, _coords[j][_order[i]]);
+          }
+          if (high - low > widest)
+          {
+            widest = high - low;
+            axis = j;
+          }
+        }
+
+        const std::vector<T> &values = _coords[axis];
+        const size_t middle = _begin + (_end - _begin) / 2;
+        std::nth_element(_order.begin() + _begin, _order.begin() + middle,
+            _order.begin() + _end,
+            [&values](const size_t _a, const size_t _b)
+            {
+              return values[_a] < values[_b];
+            });
+
+        this->nodes[id].split = values[_order[middle]];
+        this->nodes[id].axis = axis;
+        this->BuildNode(_coords, _order, _begin, middle);
+        this->nodes[id].first = this->nodes.size();
+        this->BuildNode(_coords, _order, middle, _end);
+      }
+
+      /// \brief Find the points closest to a location.
+      /// \param[in] _point Location of the query.
+      /// \param[in] _k Number of points to find.
+      /// \param[in] _epsilon Allowed relative error on the distances.
+      /// \param[out] _heap Max heap of the closest points.
+      /// \return True if a point was found.
+      private: bool Search(const Vector3<T> &_point, const size_t _k,
+                           const T _epsilon,
+                           std::vector<Candidate> &_heap) const
+      {
+        if (this->nodes.empty() || _k == 0 || !std::isfinite(_point.X()) ||
+            !std::isfinite(_point.Y()) || !std::isfinite(_point.Z()))
+        {
+          return false;
+        }
+
+        const T query[3] = {_point.X(), _point.Y(), _point.Z()};
+        T offset[3] = {0, 0, 0};
+        const T factor = (1 + std::max(_epsilon, T(0))) *
+                         (1 + std::max(_epsilon, T(0)));
+        this->SearchNearest(0, query, _k, factor, 0, offset, _heap);
+        return !_heap.empty();
+      }
+
+      /// \brief Search a subtree for the closest points.
+      /// \param[in] _node Root of the subtree.
+      /// \param[in] _query Coordinates of the query.
+      /// \param[in] _k Number of points to find.
+      /// \param[in] _factor Square of one plus the allowed relative error.
+      /// \param[in] _bound Squared distance from the query to the cell of
+      /// the subtree.
+      /// \param[in,out] _offset Distance from the query to the cell of the
+      /// subtree along each axis.
+      /// \param[in,out] _heap Max heap of the closest points so far.
+      private: void SearchNearest(const size_t _node, const T (&_query)[3],
+                                  const size_t _k, const T _factor,
+                                  const T _bound, T (&_offset)[3],
+                                  std::vector<Candidate> &_heap) const
+      {
+        const Node &node = this->nodes[_node];
+        if (node.axis == 3)
+        {
+          for (size_t i = node.first; i < node.last; ++i)
+          {
+            const T dx = this->coord[0][i] - _query[0];
+            const T dy = this->coord[1][i] - _query[1];
+            const T dz = this->coord[2][i] - _query[2];
+            const Candidate candidate = {dx * dx + dy * dy + dz * dz,
+                                         this->index[i]};
+            if (_heap.size() < _k)
+            {
+              _heap.push_back(candidate);
+              std::push_heap(_heap.begin(), _heap.end());
+            }
+            else if (candidate < _heap.front())
+            {
+              std::pop_heap(_heap.begin(), _heap.end());
+              _heap.back() = candidate;
+              std::push_heap(_heap.begin(), _heap.end());
+            }
+          }
+          return;
+        }
+
+        // Visit the side of the query first
+        const T diff = _query[node.axis] - node.split;
+        const size_t left = _node + 1;
+        const size_t right = node.first;
+        this->SearchNearest(diff < 0 ? left : right, _query, _k, _factor,
+            _bound, _offset, _heap);
+
+        // The other side is at least the distance to the plane away. It is
+        // also visited on a tie, so that the lowest index wins.
+        const T old = _offset[node.axis];
+        const T bound = _bound - old * old + diff * diff;
+        if (_heap.size() < _k || !(_heap.front().distance < bound * _factor))
+        {
+          _offset[node.axis] = diff;
+          this->SearchNearest(diff < 0 ? right : left, _query, _k, _factor,
+              bound, _offset, _heap);
+          _offset[node.axis] = old;
+        }
+      }
+
+      /// \brief Search a subtree for the points within a distance.
+      /// \param[in] _node Root of the subtree.
+      /// \param[in] _query Coordinates of the query.
+      /// \param[in] _radius2 Square of the radius.
+      /// \param[in] _bound Squared distance from the query to the cell of
+      /// the subtree.
+      /// \param[in,out] _offset Distance from the query to the cell of the
+      /// subtree along each axis.
+      /// \param[in,out] _indices Points found so far.
+      private: void SearchRadius(const size_t _node, const T (&_query)[3],
+                                 const T _radius2, const T _bound,
+                                 T (&_offset)[3],
+                                 std::vector<size_t> &_indices) const
+      {
+        const Node &node = this->nodes[_node];
+        if (node.axis == 3)
+        {
+          for (size_t i = node.first; i < node.last; ++i)
+          {
+            const T dx = this->coord[0][i] - _query[0];
+            const T dy = this->coord[1][i] - _query[1];
+            const T dz = this->coord[2][i] - _query[2];
+            if (dx * dx + dy * dy + dz * dz <= _radius2)
+              _indices.push_back(this->index[i]);
+          }
+          return;
+        }
+
+        const T diff = _query[node.axis] - node.split;
+        const size_t left = _node + 1;
+        const size_t right = node.first;
+        this->SearchRadius(diff < 0 ? left : right, _query, _radius2,
+            _bound, _offset, _indices);
+
+        const T old = _offset[node.axis];
+        const T bound = _bound - old * old + diff * diff;
+        if (bound <= _radius2)
+        {
+          _offset[node.axis] = diff;
+          this->SearchRadius(diff < 0 ? right : left, _query, _radius2,
+              bound, _offset, _indices);
+          _offset[node.axis] = old;
+        }
+      }
+
+      /// \brief Maximum number of points of a leaf.
+      private: static const size_t kLeafSize = 8;
+
+      /// \brief Number of points given to Build.
+      private: size_t size = 0;
+
+      /// \brief Nodes in depth first order.
+      private: std::vector<Node> nodes;
+
+      /// \brief Coordinates of the points along each axis, in tree order.
+      private: std::vector<T> coord[3];
+
+      /// \brief Index in the array given to Build of each point, in tree
+      /// order.
+      private: std::vector<size_t> index;
+    };
+
+    typedef KdTree<double> KdTreed;
+    typedef KdTree<float> KdTreef;
+  }
+}
+#endif
@@ -26,6 +26,7 @@
 #include "ignition/math/Vector2.hh"
 #include "ignition/math/Vector3.hh"
 #include "ignition/math/Matrix3.hh"
+#include "ignition/math/Triangle3.hh"
 
 namespace ignition
 {
@@ -328,57 +329,9 @@ namespace ignition
       /// Otherwise, the moments are sorted from smallest to largest.
       public: Vector3<T> PrincipalMoments(const T _tol = 1e-6) const
       {
-        // Compute tolerance relative to maximum value of inertia diagonal
-        T tol = _tol * this->Ixxyyzz.Max();
-        if (this->Ixyxzyz.Equal(Vector3<T>::Zero, tol))
-        {
-          // Matrix is already diagonalized, return diagonal moments
-          return this->Ixxyyzz;
-        }
-
-        // Algorithm based on http://arxiv.org/abs/1306.6291v4
-        // A Method for Fast Diagonalization of a 2x2 or 3x3 Real Symmetric
-        // Matrix, by Maarten Kronenburg
-        Vector3<T> Id(this->Ixxyyzz);
-        Vector3<T> Ip(this->Ixyxzyz);
-        // b = Ixx + Iyy + Izz
-        T b = Id.Sum();
-        // c = Ixx*Iyy - Ixy^2  +  Ixx*Izz - Ixz^2  +  Iyy*Izz - Iyz^2
-        T c = Id[0]*Id[1] - std::pow(Ip[0], 2)
-            + Id[0]*Id[2] - std::pow(Ip[1], 2)
-            + Id[1]*Id[2] - std::pow(Ip[2], 2);
-        // d = Ixx*Iyz^2 + Iyy*Ixz^2 + Izz*Ixy^2 - Ixx*Iyy*Izz - 2*Ixy*Ixz*Iyz
-        T d = Id[0]*std::pow(Ip[2], 2)
-            + Id[1]*std::pow(Ip[1], 2)
-            + Id[2]*std::pow(Ip[0], 2)
-            - Id[0]*Id[1]*Id[2]
-            - 2*Ip[0]*Ip[1]*Ip[2];
-        // p = b^2 - 3c
-        T p = std::pow(b, 2) - 3*c;
-
-        // At this point, it is important to check that p is not close
-        //  to zero, since its inverse is used to compute delta.
-        // In equation 4.7, p is expressed as a sum of squares
-        //  that is only zero if the matrix is diagonal
-        //  with identical principal moments.
-        // This check has no test coverage, since this function returns
-        //  immediately if a diagonal matrix is detected.
-        if (p < std::pow(tol, 2))
-          return b / 3.0 * Vector3<T>::One;
-
-        // q = 2b^3 - 9bc - 27d
-        T q = 2*std::pow(b, 3) - 9*b*c - 27*d;
-
-        // delta = acos(q / (2 * p^(1.5)))
-        // additionally clamp the argument to [-1,1]
-        T delta = acos(clamp<T>(0.5 * q / std::pow(p, 1.5), -1, 1));
-
-        // sort the moments from smallest to largest
-        T moment0 = (b + 2*sqrt(p) * cos(delta / 3.0)) / 3.0;
-        T moment1 = (b + 2*sqrt(p) * cos((delta + 2*IGN_PI)/3.0)) / 3.0;
-        T moment2 = (b + 2*sqrt(p) * cos((delta - 2*IGN_PI)/3.0)) / 3.0;
-        sort3(moment0, moment1, moment2);
-        return Vector3<T>(moment0, moment1, moment2);
+        Vector3<T> moments;
+        this->Diagonalize(_tol, moments, nullptr);
+        return moments;
       }
 
       /// \brief Compute rotational offset of principal axes.
@@ -396,289 +349,56 @@ namespace ignition
       {
         // Compute tolerance relative to maximum value of inertia diagonal
         T tol = _tol * this->Ixxyyzz.Max();
-        Vector3<T> moments = this->PrincipalMoments(tol);
-        if (moments.Equal(this->Ixxyyzz, tol) ||
-            (math::equal<T>(moments[0], moments[1], std::abs(tol)) &&
-             math::equal<T>(moments[0], moments[2], std::abs(tol))))
+        Vector3<T> moments;
+        Matrix3<T> axes;
+        if (!this->Diagonalize(tol, moments, &axes))
         {
           // matrix is already aligned with principal axes
-          // or all three moments are approximately equal
-          // return identity rotation
           return Quaternion<T>::Identity;
         }
-
-        // Algorithm based on http://arxiv.org/abs/1306.6291v4
-        // A Method for Fast Diagonalization of a 2x2 or 3x3 Real Symmetric
-        // Matrix, by Maarten Kronenburg
-        // A real, symmetric matrix can be diagonalized by an orthogonal matrix
-        // (due to the finite-dimensional spectral theorem
-        // https://en.wikipedia.org/wiki/Spectral_theorem
-        // #Hermitian_maps_and_Hermitian_matrices ),
-        // and another name for orthogonal matrix is rotation matrix.
-        // Section 5 of the paper shows how to compute Euler angles
-        // phi1, phi2, and phi3 that map to a rotation matrix.
-        // In some cases, there are multiple possible values for a given angle,
-        // such as phi1, that are denoted as phi11, phi12, phi11a, phi12a, etc.
-        // Similar variable names are used to the paper so that the paper
-        // can be used as an additional reference.
-
-        // f1, f2 defined in equations 5.5, 5.6
-        Vector2<T> f1(this->Ixyxzyz[0], -this->Ixyxzyz[1]);
-        Vector2<T> f2(this->Ixxyyzz[1] - this->Ixxyyzz[2],
-                   -2*this->Ixyxzyz[2]);
-
-        // Check if two moments are equal, since different equations are used
-        // The moments vector is already sorted, so just check adjacent values.
-        Vector2<T> momentsDiff(moments[0] - moments[1],
-                               moments[1] - moments[2]);
-
-        // index of unequal moment
-        int unequalMoment = -1;
-        if (equal<T>(momentsDiff[0], 0, std::abs(tol)))
-          unequalMoment = 2;
-        else if (equal<T>(momentsDiff[1], 0, std::abs(tol)))
-          unequalMoment = 0;
-
-        if (unequalMoment >= 0)
+        return this->AxesOffset(tol, moments, axes);
+      }
+
+      /// \brief Compute principal moments and principal axes offsets of
+      /// many mass matrices at once. Each matrix is diagonalized only
+      /// once, and element i of the outputs equals
+      /// _matrices[i].PrincipalMoments(_tol) and
+      /// _matrices[i].PrincipalAxesOffset(_tol).
+      /// \param[in] _matrices Mass matrices to diagonalize.
+      /// \param[out] _moments Principal moments of each matrix.
+      /// \param[out] _offsets Principal axes offset of each matrix.
+      /// \param[in] _tol Relative tolerance, see PrincipalMoments.
+      public: static void PrincipalMomentsAndAxes(
+                  const std::vector<MassMatrix3<T>> &_matrices,
+                  std::vector<Vector3<T>> &_moments,
+                  std::vector<Quaternion<T>> &_offsets,
+                  const T _tol = 1e-6)
+      {
+        _moments.resize(_matrices.size());
+        _offsets.resize(_matrices.size());
+        for (size_t i = 0; i < _matrices.size(); ++i)
         {
-          // moments[1] is the repeated value
-          // it is not equal to moments[unequalMoment]
-          // momentsDiff3 = lambda - lambda3
-          T momentsDiff3 = moments[1] - moments[unequalMoment];
-          // eq 5.21:
-          // s = cos(phi2)^2 = (A_11 - lambda3) / (lambda - lambda3)
-          // s >= 0 since A_11 is in range [lambda, lambda3]
-          T s = (this->Ixxyyzz[0] - moments[unequalMoment]) / momentsDiff3;
-          // set phi3 to zero for repeated moments (eq 5.23)
-          T phi3 = 0;
-          // phi2 = +- acos(sqrt(s))
-          // start with just the positive value
-          // also clamp the acos argument to prevent NaN's
-          T phi2 = acos(clamp<T>(ClampedSqrt(s), -1, 1));
-
-          // The paper defines variables phi11 and phi12
-          // which are candidate values of angle phi1.
-          // phi12 is straightforward to compute as a function of f2 and g2.
-          // eq 5.25:
-          Vector2<T> g2(momentsDiff3 * s, 0);
-          // combining eq 5.12 and 5.14, and subtracting psi2
-          // instead of multiplying by its rotation matrix:
-          math::Angle phi12(0.5*(Angle2(g2, tol) - Angle2(f2, tol)));
-          phi12.Normalize();
-
-          // The paragraph prior to equation 5.16 describes how to choose
-          // the candidate value of phi1 based on the length
-          // of the f1 and f2 vectors.
-          // * When |f1| != 0 and |f2| != 0, then one should choose the
-          //   value of phi2 so that phi11 = phi12
-          // * When |f1| == 0 and f2 != 0, then phi1 = phi12
-          //   phi11 can be ignored, and either sign of phi2 can be used
-          // * The case of |f2| == 0 can be ignored at this point in the code
-          //   since having a repeated moment when |f2| == 0 implies that
-          //   the matrix is diagonal. But this function returns a unit
-          //   quaternion for diagonal matrices, so we can assume |f2| != 0
-          //   See MassMatrix3.ipynb for a more complete discussion.
-          //
-          // Since |f2| != 0, we only need to consider |f1|
-          // * |f1| == 0: phi1 = phi12
-          // * |f1| != 0: choose phi2 so that phi11 == phi12
-          // In either case, phi1 = phi12,
-          // and the sign of phi2 must be chosen to make phi11 == phi12
-          T phi1 = phi12.Radian();
-
-          bool f1small = f1.SquaredLength() < std::pow(tol, 2);
-          if (!f1small)
-          {
-            // a: phi2 > 0
-            // eq. 5.24
-            Vector2<T> g1a(0, 0.5*momentsDiff3 * sin(2*phi2));
-            // combining eq 5.11 and 5.13, and subtracting psi1
-            // instead of multiplying by its rotation matrix:
-            math::Angle phi11a(Angle2(g1a, tol) - Angle2(f1, tol));
-            phi11a.Normalize();
-
-            // b: phi2 < 0
-            // eq. 5.24
-            Vector2<T> g1b(0, 0.5*momentsDiff3 * sin(-2*phi2));
-            // combining eq 5.11 and 5.13, and subtracting psi1
-            // instead of multiplying by its rotation matrix:
-            math::Angle phi11b(Angle2(g1b, tol) - Angle2(f1, tol));
-            phi11b.Normalize();
-
-            // choose sign of phi2
-            // based on whether phi11a or phi11b is closer to phi12
-            // use sin and cos to account for angle wrapping
-            T erra = std::pow(sin(phi1) - sin(phi11a.Radian()), 2)
-                   + std::pow(cos(phi1) - cos(phi11a.Radian()), 2);
-            T errb = std::pow(sin(phi1) - sin(phi11b.Radian()), 2)
-                   + std::pow(cos(phi1) - cos(phi11b.Radian()), 2);
-            if (errb < erra)
-            {
-              phi2 *= -1;
-            }
-          }
+          const MassMatrix3<T> &m = _matrices[i];
+          Matrix3<T> axes;
+          const bool rotated = m.Diagonalize(_tol, _moments[i], &axes);
 
-          // I determined these arguments using trial and error
-          Quaternion<T> result = Quaternion<T>(-phi1, -phi2, -phi3).Inverse();
-
-          // Previous equations assume repeated moments are at the beginning
-          // of the moments vector (moments[0] == moments[1]).
-          // We have the vectors sorted by size, so it's possible that the
-          // repeated moments are at the end (moments[1] == moments[2]).
-          // In this case (unequalMoment == 0), we apply an extra
-          // rotation that exchanges moment[0] and moment[2]
-          // Rotation matrix = [ 0  0  1]
-          //                   [ 0  1  0]
-          //                   [-1  0  0]
-          // That is equivalent to a 90 degree pitch
-          if (unequalMoment == 0)
-            result *= Quaternion<T>(0, IGN_PI_2, 0);
-
-          return result;
-        }
-
-        // No repeated principal moments
-        // eq 5.1:
-        T v = (std::pow(this->Ixyxzyz[0], 2) + std::pow(this->Ixyxzyz[1], 2)
-              +(this->Ixxyyzz[0] - moments[2])
-              *(this->Ixxyyzz[0] + moments[2] - moments[0] - moments[1]))
-            / ((moments[1] - moments[2]) * (moments[2] - moments[0]));
-        // value of w depends on v
-        T w;
-        if (v < std::abs(tol))
-        {
-          // first sentence after eq 5.4:
-          // "In the case that v = 0, then w = 1."
-          w = 1;
-        }
-        else
-        {
-          // eq 5.2:
-          w = (this->Ixxyyzz[0] - moments[2] + (moments[2] - moments[1])*v)
-              / ((moments[0] - moments[1]) * v);
-        }
-        // initialize values of angle phi1, phi2, phi3
-        T phi1 = 0;
-        // eq 5.3: start with positive value
-        T phi2 = acos(clamp<T>(ClampedSqrt(v), -1, 1));
-        // eq 5.4: start with positive value
-        T phi3 = acos(clamp<T>(ClampedSqrt(w), -1, 1));
-
-        // compute g1, g2 for phi2,phi3 >= 0
-        // equations 5.7, 5.8
-        Vector2<T> g1(
-          0.5* (moments[0]-moments[1])*ClampedSqrt(v)*sin(2*phi3),
-          0.5*((moments[0]-moments[1])*w + moments[1]-moments[2])*sin(2*phi2));
-        Vector2<T> g2(
-          (moments[0]-moments[1])*(1 + (v-2)*w) + (moments[1]-moments[2])*v,
-          (moments[0]-moments[1])*sin(phi2)*sin(2*phi3));
-
-        // The paragraph prior to equation 5.16 describes how to choose
-        // the candidate value of phi1 based on the length
-        // of the f1 and f2 vectors.
-        // * The case of |f1| == |f2| == 0 implies a repeated moment,
-        //   which should not be possible at this point in the code
-        // * When |f1| != 0 and |f2| != 0, then one should choose the
-        //   value of phi2 so that phi11 = phi12
-        // * When |f1| == 0 and f2 != 0, then phi1 = phi12
-        //   phi11 can be ignored, and either sign of phi2, phi3 can be used
-        // * When |f2| == 0 and f1 != 0, then phi1 = phi11
-        //   phi12 can be ignored, and either sign of phi2, phi3 can be used
-        bool f1small = f1.SquaredLength() < std::pow(tol, 2);
-        bool f2small = f2.SquaredLength() < std::pow(tol, 2);
-        if (f1small && f2small)
-        {
-          // this should never happen
-          // f1small && f2small implies a repeated moment
-          // return invalid quaternion
-          return Quaternion<T>::Zero;
-        }
-        else if (f1small)
-        {
-          // use phi12 (equations 5.12, 5.14)
-          math::Angle phi12(0.5*(Angle2(g2, tol) - Angle2(f2, tol)));
-          phi12.Normalize();
-          phi1 = phi12.Radian();
-        }
-        else if (f2small)
-        {
-          // use phi11 (equations 5.11, 5.13)
-          math::Angle phi11(Angle2(g1, tol) - Angle2(f1, tol));
-          phi11.Normalize();
-          phi1 = phi11.Radian();
-        }
-        else
-        {
-          // check for when phi11 == phi12
-          // eqs 5.11, 5.13:
-          math::Angle phi11(Angle2(g1, tol) - Angle2(f1, tol));
-          phi11.Normalize();
-          // eqs 5.12, 5.14:
-          math::Angle phi12(0.5*(Angle2(g2, tol) - Angle2(f2, tol)));
-          phi12.Normalize();
-          T err  = std::pow(sin(phi11.Radian()) - sin(phi12.Radian()), 2)
-                 + std::pow(cos(phi11.Radian()) - cos(phi12.Radian()), 2);
-          phi1 = phi11.Radian();
-          math::Vector2<T> signsPhi23(1, 1);
-          // case a: phi2 <= 0
+          // PrincipalAxesOffset uses a tolerance scaled by the diagonal
+          const T tol = _tol * m.Ixxyyzz.Max();
+          if (!m.OffDiagonalNonZero(tol))
           {
-            Vector2<T> g1a = Vector2<T>(1, -1) * g1;
-            Vector2<T> g2a = Vector2<T>(1, -1) * g2;
-            math::Angle phi11a(Angle2(g1a, tol) - Angle2(f1, tol));
-            math::Angle phi12a(0.5*(Angle2(g2a, tol) - Angle2(f2, tol)));
-            phi11a.Normalize();
-            phi12a.Normalize();
-            T erra = std::pow(sin(phi11a.Radian()) - sin(phi12a.Radian()), 2)
-                   + std::pow(cos(phi11a.Radian()) - cos(phi12a.Radian()), 2);
-            if (erra < err)
-            {
-              err = erra;
-              phi1 = phi11a.Radian();
-              signsPhi23.Set(-1, 1);
-            }
+            _offsets[i] = Quaternion<T>::Identity;
           }
-          // case b: phi3 <= 0
+          else if (rotated)
           {
-            Vector2<T> g1b = Vector2<T>(-1, 1) * g1;
-            Vector2<T> g2b = Vector2<T>(1, -1) * g2;
-            math::Angle phi11b(Angle2(g1b, tol) - Angle2(f1, tol));
-            math::Angle phi12b(0.5*(Angle2(g2b, tol) - Angle2(f2, tol)));
-            phi11b.Normalize();
-            phi12b.Normalize();
-            T errb = std::pow(sin(phi11b.Radian()) - sin(phi12b.Radian()), 2)
-                   + std::pow(cos(phi11b.Radian()) - cos(phi12b.Radian()), 2);
-            if (errb < err)
-            {
-              err = errb;
-              phi1 = phi11b.Radian();
-              signsPhi23.Set(1, -1);
-            }
+            _offsets[i] = m.AxesOffset(tol, _moments[i], axes);
           }
-          // case c: phi2,phi3 <= 0
+          else
           {
-            Vector2<T> g1c = Vector2<T>(-1, -1) * g1;
-            Vector2<T> g2c = g2;
-            math::Angle phi11c(Angle2(g1c, tol) - Angle2(f1, tol));
-            math::Angle phi12c(0.5*(Angle2(g2c, tol) - Angle2(f2, tol)));
-            phi11c.Normalize();
-            phi12c.Normalize();
-            T errc = std::pow(sin(phi11c.Radian()) - sin(phi12c.Radian()), 2)
-                   + std::pow(cos(phi11c.Radian()) - cos(phi12c.Radian()), 2);
-            if (errc < err)
-            {
-              err = errc;
-              phi1 = phi11c.Radian();
-              signsPhi23.Set(-1, -1);
-            }
+            Vector3<T> moments;
+            m.Diagonalize(tol, moments, &axes);
+            _offsets[i] = m.AxesOffset(tol, moments, axes);
           }
-
-          // apply sign changes
-          phi2 *= signsPhi23[0];
-          phi3 *= signsPhi23[1];
         }
-
-        // I determined these arguments using trial and error
-        return Quaternion<T>(-phi1, -phi2, -phi3).Inverse();
       }
 
       /// \brief Get dimensions and rotation offset of uniform box
@@ -861,28 +581,265 @@ namespace ignition
         return this->MOI(L);
       }
 
-      /// \brief Square root of positive numbers, otherwise zero.
-      /// \param[in] _x Number to be square rooted.
-      /// \return sqrt(_x) if _x > 0, otherwise 0
-      private: static inline T ClampedSqrt(const T &_x)
+      /// \brief Set inertial properties from a closed triangle mesh of
+      /// uniform density. The volume integrals are computed with the
+      /// divergence theorem, one signed tetrahedron per triangle, as
+      /// described in "Polyhedral Mass Properties (Revisited)" by
+      /// David Eberly. Triangles must be wound counter-clockwise when seen
+      /// from outside the mesh, so that their normals point outward.
+      /// \param[in] _density Density of the solid.
+      /// \param[in] _vertices Mesh vertices.
+      /// \param[in] _indices Vertex indices, three per triangle.
+      /// \param[out] _centerOfMass Center of mass in the mesh frame. The
+      /// moment of inertia is expressed about this point, with axes
+      /// aligned with the mesh frame.
+      /// \return True if inertial properties were set successfully. False
+      /// if _density is not strictly positive, an index is out of range,
+      /// the number of indices is not a multiple of three, or the enclosed
+      /// volume is not positive.
+      public: bool SetFromMesh(const T _density,
+                               const std::vector<Vector3<T>> &_vertices,
+                               const std::vector<unsigned int> &_indices,
+                               Vector3<T> &_centerOfMass)
+      {
+        if (_density <= 0 || _indices.empty() || _indices.size() % 3 != 0)
+          return false;
+
+        for (const unsigned int index : _indices)
+        {
+          if (index >= _vertices.size())
+            return false;
+        }
+
+        // Integrate relative to a vertex of the mesh to limit the loss of
+        // precision for meshes located far from the origin.
+        const Vector3<T> ref = _vertices[_indices[0]];
+        T integrals[10] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+        const size_t count = _indices.size() / 3;
+        for (size_t block = 0; block < count; block += MeshBlockSize)
+        {
+          // Sum each block separately before adding it to the total, which
+          // keeps the partial sums of similar magnitude.
+          T partial[10] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+          const size_t end = std::min(count, block + MeshBlockSize);
+          for (size_t i = block; i < end; ++i)
+          {
+            AccumulateTriangle(_vertices[_indices[3*i]] - ref,
+                               _vertices[_indices[3*i+1]] - ref,
+                               _vertices[_indices[3*i+2]] - ref, partial);
+          }
+          for (int k = 0; k < 10; ++k)
+            integrals[k] += partial[k];
+        }
+
+        return this->SetFromMeshIntegrals(_density, integrals, ref,
+            _centerOfMass);
+      }
+
+      /// \brief Set inertial properties from a closed triangle mesh of
+      /// uniform density.
+      /// \param[in] _density Density of the solid.
+      /// \param[in] _triangles Mesh triangles, wound counter-clockwise when
+      /// seen from outside the mesh.
+      /// \param[out] _centerOfMass Center of mass in the mesh frame.
+      /// \return True if inertial properties were set successfully.
+      /// \sa SetFromMesh(const T, const std::vector<Vector3<T>> &,
+      /// const std::vector<unsigned int> &, Vector3<T> &)
+      public: bool SetFromMesh(const T _density,
+                               const std::vector<Triangle3<T>> &_triangles,
+                               Vector3<T> &_centerOfMass)
       {
-        if (_x <= 0)
-          return 0;
-        return sqrt(_x);
+        if (_density <= 0 || _triangles.empty())
+          return false;
+
+        const Vector3<T> ref = _triangles[0][0];
+        T integrals[10] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+        const size_t count = _triangles.size();
+        for (size_t block = 0; block < count; block += MeshBlockSize)
+        {
+          T partial[10] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+          const size_t end = std::min(count, block + MeshBlockSize);
+          for (size_t i = block; i < end; ++i)
+          {
+            const Triangle3<T> &tri = _triangles[i];
+            AccumulateTriangle(tri[0] - ref, tri[1] - ref, tri[2] - ref,
+                partial);
+          }
+          for (int k = 0; k < 10; ++k)
+            integrals[k] += partial[k];
+        }
+
+        return this->SetFromMeshIntegrals(_density, integrals, ref,
+            _centerOfMass);
       }
 
-      /// \brief Angle formed by direction of a Vector2.
-      /// \param[in] _v Vector whose direction is to be computed.
-      /// \param[in] _eps Minimum length of vector required for computing angle.
-      /// \return Angle formed between vector and X axis,
-      /// or zero if vector has length less than 1e-6.
-      private: static T Angle2(const Vector2<T> &_v, const T _eps = 1e-6)
+      /// \brief Check whether the product moments are significant
+      /// relative to the diagonal moments.
+      /// \param[in] _tol Relative tolerance, see PrincipalMoments.
+      /// \return False if the matrix is diagonal within tolerance.
+      private: bool OffDiagonalNonZero(const T _tol) const
       {
-        if (_v.SquaredLength() < std::pow(_eps, 2))
-          return 0;
-        return atan2(_v[1], _v[0]);
+        // Compute tolerance relative to maximum value of inertia diagonal
+        T tol = _tol * this->Ixxyyzz.Max();
+        return !this->Ixyxzyz.Equal(Vector3<T>::Zero, tol);
       }
 
+      /// \brief Diagonalize the moment of inertia matrix.
+      /// \param[in] _tol Relative tolerance, see PrincipalMoments.
+      /// \param[out] _moments Principal moments.
+      /// \param[out] _axes Principal axes stored as columns, or nullptr
+      /// if they are not needed. Not set if the matrix is already
+      /// diagonal.
+      /// \return False if the matrix is already diagonal, in which case
+      /// _moments are the diagonal moments in their existing order.
+      private: bool Diagonalize(const T _tol, Vector3<T> &_moments,
+                                Matrix3<T> *_axes) const
+      {
+        if (!this->OffDiagonalNonZero(_tol))
+        {
+          // Matrix is already diagonalized, return diagonal moments
+          _moments = this->Ixxyyzz;
+          return false;
+        }
+
+        if (_axes)
+          this->MOI().SymmetricEigen(_moments, *_axes);
+        else
+          _moments = this->MOI().SymmetricEigenvalues();
+        return true;
+      }
+
+      /// \brief Convert principal axes to a rotational offset.
+      /// \param[in] _tol Absolute tolerance.
+      /// \param[in] _moments Sorted principal moments.
+      /// \param[in] _axes Principal axes stored as columns.
+      /// \return Rotational offset of the principal axes.
+      private: Quaternion<T> AxesOffset(const T _tol,
+                                        const Vector3<T> &_moments,
+                                        const Matrix3<T> &_axes) const
+      {
+        if (_moments.Equal(this->Ixxyyzz, _tol) ||
+            (math::equal<T>(_moments[0], _moments[1], std::abs(_tol)) &&
+             math::equal<T>(_moments[0], _moments[2], std::abs(_tol))))
+        {
+          // matrix is already aligned with principal axes
+          // or all three moments are approximately equal
+          // return identity rotation
+          return Quaternion<T>::Identity;
+        }
+
+        // The eigenvectors form a rotation matrix R with MOI = R * L * R^T
+        return Quaternion<T>(_axes);
+      }
+
+      /// \brief Add the volume integrals of the tetrahedron formed by a
+      /// triangle and the origin.
+      /// \param[in] _p0 First vertex.
+      /// \param[in] _p1 Second vertex.
+      /// \param[in] _p2 Third vertex.
+      /// \param[in,out] _integrals Unscaled integrals of 1, x, y, z, x^2,
+      /// y^2, z^2, xy, yz and zx.
+      private: static void AccumulateTriangle(const Vector3<T> &_p0,
+                                             const Vector3<T> &_p1,
+                                             const Vector3<T> &_p2,
+                                             T _integrals[10])
+      {
+        const Vector3<T> e1 = _p1 - _p0;
+        const Vector3<T> e2 = _p2 - _p0;
+        const Vector3<T> d = e1.Cross(e2);
+
+        T f1[3], f2[3], f3[3], g0[3], g1[3], g2[3];
+        for (int k = 0; k < 3; ++k)
+        {
+          const T w0 = _p0[k];
+          const T w1 = _p1[k];
+          const T w2 = _p2[k];
+          const T temp0 = w0 + w1;
+          const T temp1 = w0 * w0;
+          const T temp2 = temp1 + w1 * temp0;
+          f1[k] = temp0 + w2;
+          f2[k] = temp2 + w2 * f1[k];
+          f3[k] = w0 * temp1 + w1 * temp2 + w2 * f2[k];
+          g0[k] = f2[k] + w0 * (f1[k] + w0);
+          g1[k] = f2[k] + w1 * (f1[k] + w1);
+          g2[k] = f2[k] + w2 * (f1[k] + w2);
+        }
+
+        _integrals[0] += d[0] * f1[0];
+        _integrals[1] += d[0] * f2[0];
+        _integrals[2] += d[1] * f2[1];
+        _integrals[3] += d[2] * f2[2];
+        _integrals[4] += d[0] * f3[0];
+        _integrals[5] += d[1] * f3[1];
+        _integrals[6] += d[2] * f3[2];
+        _integrals[7] += d[0] * (_p0[1]*g0[0] + _p1[1]*g1[0] + _p2[1]*g2[0]);
+        _integrals[8] += d[1] * (_p0[2]*g0[1] + _p1[2]*g1[1] + _p2[2]*g2[1]);
+        _integrals[9] += d[2] * (_p0[0]*g0[2] + _p1[0]*g1[2] + _p2[0]*g2[2]);
+      }
+
+      /// \brief Set mass, center of mass and inertia from accumulated mesh
+      /// volume integrals.
+      /// \param[in] _density Density of the solid.
+      /// \param[in] _integrals Unscaled volume integrals, see
+      /// AccumulateTriangle.
+      /// \param[in] _ref Point the integrals are relative to.
+      /// \param[out] _centerOfMass Center of mass.
+      /// \return True if the volume is positive and the resulting mass
+      /// matrix is valid. On failure neither this object nor _centerOfMass
+      /// is changed.
+      private: bool SetFromMeshIntegrals(const T _density,
+                                         const T _integrals[10],
+                                         const Vector3<T> &_ref,
+                                         Vector3<T> &_centerOfMass)
+      {
+        const T volume = _integrals[0] / 6;
+        if (volume <= 0)
+          return false;
+
+        const T m = _density * volume;
+        // Center of mass relative to _ref
+        const Vector3<T> com(_integrals[1] / 24 / volume,
+                             _integrals[2] / 24 / volume,
+                             _integrals[3] / 24 / volume);
+
+        // Second moments about _ref
+        const T xx = _density * _integrals[4] / 60;
+        const T yy = _density * _integrals[5] / 60;
+        const T zz = _density * _integrals[6] / 60;
+        const T xy = _density * _integrals[7] / 120;
+        const T yz = _density * _integrals[8] / 120;
+        const T zx = _density * _integrals[9] / 120;
+
+        // Parallel axis theorem to move the inertia to the center of mass
+        const T cx = com[0];
+        const T cy = com[1];
+        const T cz = com[2];
+        Matrix3<T> moi(
+          yy + zz - m * (cy*cy + cz*cz),
+          -(xy - m * cx * cy),
+          -(zx - m * cz * cx),
+          -(xy - m * cx * cy),
+          xx + zz - m * (cz*cz + cx*cx),
+          -(yz - m * cy * cz),
+          -(zx - m * cz * cx),
+          -(yz - m * cy * cz),
+          xx + yy - m * (cx*cx + cy*cy));
+
+        // Fill a copy so that this object is unchanged on failure
+        MassMatrix3<T> result(*this);
+        result.mass = m;
+        if (!result.MOI(moi))
+          return false;
+
+        *this = result;
+        _centerOfMass = _ref + com;
+        return true;
+      }
+
+      /// \brief Number of triangles summed together before being added to
+      /// the mesh totals.
+      private: static const size_t MeshBlockSize = 1024;
+
       /// \brief Mass of the object. Default is 0.0.
       private: T mass;
 
@@ -480,6 +480,34 @@ namespace ignition
           this->data[0][2], this->data[1][2], this->data[2][2]);
       }
 
+      /// \brief Compute the eigenvalues of a symmetric matrix.
+      /// Only the diagonal and the upper triangle of the matrix are read.
+      /// \return Eigenvalues sorted from smallest to largest.
+      /// \sa SymmetricEigen
+      public: Vector3<T> SymmetricEigenvalues() const
+      {
+        Vector3<T> values;
+        this->SymmetricEigen(values, nullptr);
+        return values;
+      }
+
+      /// \brief Compute the eigenvalues and eigenvectors of a symmetric
+      /// matrix using cyclic Jacobi rotations, which converge in a few
+      /// sweeps for a 3x3 matrix and handle repeated eigenvalues without
+      /// special cases. Only the diagonal and the upper triangle of the
+      /// matrix are read.
+      /// \param[out] _values Eigenvalues sorted from smallest to largest.
+      /// \param[out] _vectors Orthonormal eigenvectors stored as columns,
+      /// in the same order as _values. The matrix is a proper rotation
+      /// (determinant +1) so that this = _vectors * L * _vectors^T,
+      /// where L is the diagonal matrix of eigenvalues. The largest
+      /// component of the first and last columns is positive.
+      public: void SymmetricEigen(Vector3<T> &_values,
+                                  Matrix3<T> &_vectors) const
+      {
+        this->SymmetricEigen(_values, &_vectors);
+      }
+
       /// \brief Stream insertion operator
       /// \param[in] _out Output stream
       /// \param[in] _m Matrix to output
@@ -519,6 +547,103 @@ namespace ignition
         return _in;
       }
 
+      /// \brief Jacobi eigen decomposition of the symmetric part of this
+      /// matrix.
+      /// \param[out] _values Sorted eigenvalues.
+      /// \param[out] _vectors Eigenvectors as columns, or nullptr if they
+      /// are not needed.
+      private: void SymmetricEigen(Vector3<T> &_values,
+                                   Matrix3<T> *_vectors) const
+      {
+        T a[3][3] = {
+          {this->data[0][0], this->data[0][1], this->data[0][2]},
+          {this->data[0][1], this->data[1][1], this->data[1][2]},
+          {this->data[0][2], this->data[1][2], this->data[2][2]}};
+        T v[3][3] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+
+        const T eps = std::numeric_limits<T>::epsilon();
+        const T diag = a[0][0]*a[0][0] + a[1][1]*a[1][1] + a[2][2]*a[2][2];
+        for (int sweep = 0; sweep < 50; ++sweep)
+        {
+          const T off = a[0][1]*a[0][1] + a[0][2]*a[0][2] + a[1][2]*a[1][2];
+          if (off <= eps * eps * diag || off < std::numeric_limits<T>::min())
+            break;
+
+          for (int p = 0; p < 2; ++p)
+          {
+            for (int q = p + 1; q < 3; ++q)
+            {
+              const T apq = a[p][q];
+              if (std::abs(apq) < std::numeric_limits<T>::min())
+                continue;
+
+              // Rotation angle that zeroes a[p][q]
+              const T theta = (a[q][q] - a[p][p]) / (2 * apq);
+              const T t = (theta >= 0 ? T(1) : T(-1)) /
+                (std::abs(theta) + std::sqrt(theta*theta + 1));
+              const T c = 1 / std::sqrt(t*t + 1);
+              const T s = t * c;
+
+              a[p][p] -= t * apq;
+              a[q][q] += t * apq;
+              a[p][q] = a[q][p] = 0;
+
+              const int r = 3 - p - q;
+              const T arp = a[r][p];
+              const T arq = a[r][q];
+              a[r][p] = a[p][r] = c * arp - s * arq;
+              a[r][q] = a[q][r] = s * arp + c * arq;
+
+              for (int k = 0; k < 3; ++k)
+              {
+                const T vkp = v[k][p];
+                const T vkq = v[k][q];
+                v[k][p] = c * vkp - s * vkq;
+                v[k][q] = s * vkp + c * vkq;
+              }
+            }
+          }
+        }
+
+        // Sort eigenvalues, and the matching columns, in ascending order
+        int order[3] = {0, 1, 2};
+        if (a[order[1]][order[1]] < a[order[0]][order[0]])
+          std::swap(order[0], order[1]);
+        if (a[order[2]][order[2]] < a[order[1]][order[1]])
+          std::swap(order[1], order[2]);
+        if (a[order[1]][order[1]] < a[order[0]][order[0]])
+          std::swap(order[0], order[1]);
+
+        _values.Set(a[order[0]][order[0]], a[order[1]][order[1]],
+                    a[order[2]][order[2]]);
+
+        if (!_vectors)
+          return;
+
+        Vector3<T> cols[3];
+        for (int i = 0; i < 3; ++i)
+        {
+          const int c = order[i];
+          cols[i].Set(v[0][c], v[1][c], v[2][c]);
+        }
+
+        // Choose deterministic signs: the largest component of the first
+        // and last eigenvectors is positive, and the middle one completes
+        // a right-handed frame.
+        for (int i = 0; i < 3; i += 2)
+        {
+          const Vector3<T> absCol = cols[i].Abs();
+          int k = absCol[0] >= absCol[1] ? 0 : 1;
+          if (absCol[2] > absCol[k])
+            k = 2;
+          if (cols[i][k] < 0)
+            cols[i] = -cols[i];
+        }
+        cols[1] = cols[2].Cross(cols[0]);
+
+        _vectors->Axes(cols[0], cols[1], cols[2]);
+      }
+
       /// \brief the 3x3 matrix
       private: T data[3][3];
     };
@@ -58,6 +58,10 @@ namespace ignition
                   const double _cmdMin = 0.0,
                   const double _cmdOffset = 0.0);
 
+      /// \brief Copy constructor
+      /// \param[in] _p PID to copy.
+      public: PID(const PID &_p) = default;
+
       /// \brief Destructor
       public: ~PID() = default;
 
@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_PIDBANK_HH_
+#define IGNITION_MATH_PIDBANK_HH_
+
+#include <chrono>
+#include <memory>
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/PID.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Forward declare private data
+    class PIDBankPrivate;
+
+    /// \class PIDBank PIDBank.hh ignition/math/PIDBank.hh
+    /// \brief A set of independent PID controllers updated together.
+    /// Each channel behaves like a PID object, but gains, limits and
+    /// error states of all channels are stored in contiguous arrays and
+    /// updated in a single call sharing the same time step. Channels can
+    /// be disabled individually, in which case their state is frozen.
+    /// \sa PID
+    class IGNITION_VISIBLE PIDBank
+    {
+      /// \brief Constructor, creates an empty bank.
+      public: PIDBank();
+
+      /// \brief Constructor. Every channel has zero gains, clamping
+      /// disabled and is enabled.
+      /// \param[in] _size Number of channels.
+      public: explicit PIDBank(const size_t _size);
+
+      /// \brief Copy constructor.
+      /// \param[in] _bank Bank to copy.
+      public: PIDBank(const PIDBank &_bank);
+
+      /// \brief Destructor.
+      public: ~PIDBank();
+
+      /// \brief Assignment operator.
+      /// \param[in] _bank Bank to copy.
+      /// \return Reference to this object.
+      public: PIDBank &operator=(const PIDBank &_bank);
+
+      /// \brief Get the number of channels.
+      /// \return Number of channels.
+      public: size_t Size() const;
+
+      /// \brief Change the number of channels. Existing channels are kept,
+      /// new channels are configured as in PIDBank(size_t).
+      /// \param[in] _size Number of channels.
+      public: void Resize(const size_t _size);
+
+      /// \brief Copy the gains, limits and command offset of a PID
+      /// controller into a channel, and reset the channel's state.
+      /// \param[in] _i Channel index, must be less than Size().
+      /// \param[in] _pid Controller to copy the configuration from.
+      public: void Set(const size_t _i, const PID &_pid);
+
+      /// \brief Get a PID controller with the configuration of a channel.
+      /// The errors of the channel are not copied.
+      /// \param[in] _i Channel index, must be less than Size().
+      /// \return A PID controller with the channel's gains, limits and
+      /// command.
+      public: PID Controller(const size_t _i) const;
+
+      /// \brief Set the proportional gain of a channel.
+      /// \param[in] _i Channel index, must be less than Size().
+      /// \param[in] _p Proportional gain value.
+      public: void SetPGain(const size_t _i, const double _p);
+
+      /// \brief Set the integral gain of a channel.
+      /// \param[in] _i Channel index, must be less than Size().
+      /// \param[in] _g Integral gain value.
+      public: void SetIGain(const size_t _i, const double _g);
+
+      /// \brief Set the derivative gain of a channel.
+      /// \param[in] _i Channel index, must be less than Size().
+      /// \param[in] _d Derivative gain value.
+      public: void SetDGain(const size_t _i, const double _d);
+
+      /// \brief Set the integral upper limit of a channel.
+      /// \param[in] _i Channel index, must be less than Size().
+      /// \param[in] _max Integral upper limit value.
+      public: void SetIMax(const size_t _i, const double _max);
+
+      /// \brief Set the integral lower limit of a channel.
+      /// \param[in] _i Channel index, must be less than Size().
+      /// \param[in] _min Integral lower limit value.
+      public: void SetIMin(const size_t _i, const double _min);
+
+      /// \brief Set the maximum command of a channel.
+      /// \param[in] _i Channel index, must be less than Size().
+      /// \param[in] _c The maximum value.
+      public: void SetCmdMax(const size_t _i, const double _c);
+
+      /// \brief Set the minimum command of a channel.
+      /// \param[in] _i Channel index, must be less than Size().
+      /// \param[in] _c The minimum value.
+      public: void SetCmdMin(const size_t _i, const double _c);
+
+      /// \brief Set the command offset (feed-forward) of a channel.
+      /// \param[in] _i Channel index, must be less than Size().
+      /// \param[in] _c The offset value.
+      public: void SetCmdOffset(const size_t _i, const double _c);
+
+      /// \brief Get the proportional gain of a channel.
+      /// \param[in] _i Channel index, must be less than Size().
+      /// \return The proportional gain value.
+      public: double PGain(const size_t _i) const;
+
+      /// \brief Get the integral gain of a channel.
+      /// \param[in] _i Channel index, must be less than Size().
+      /// \return The integral gain value.
+      public: double IGain(const size_t _i) const;
+
+      /// \brief Get the derivative gain of a channel.
+      /// \param[in] _i Channel index, must be less than Size().
+      /// \return The derivative gain value.
+      public: double DGain(const size_t _i) const;
+
+      /// \brief Get the integral upper limit of a channel.
+      /// \param[in] _i Channel index, must be less than Size().
+      /// \return The integral upper limit value.
+      public: double IMax(const size_t _i) const;
+
+      /// \brief Get the integral lower limit of a channel.
+      /// \param[in] _i Channel index, must be less than Size().
+      /// \return The integral lower limit value.
+      public: double IMin(const size_t _i) const;
+
+      /// \brief Get the maximum command of a channel.
+      /// \param[in] _i Channel index, must be less than Size().
+      /// \return The maximum value.
+      public: double CmdMax(const size_t _i) const;
+
+      /// \brief Get the minimum command of a channel.
+      /// \param[in] _i Channel index, must be less than Size().
+      /// \return The minimum value.
+      public: double CmdMin(const size_t _i) const;
+
+      /// \brief Get the command offset of a channel.
+      /// \param[in] _i Channel index, must be less than Size().
+      /// \return The offset value.
+      public: double CmdOffset(const size_t _i) const;
+
+      /// \brief Enable or disable a channel. A disabled channel ignores
+      /// its error in Update, keeps its state and outputs its last
+      /// command.
+      /// \param[in] _i Channel index, must be less than Size().
+      /// \param[in] _enabled True to enable the channel.
+      public: void SetEnabled(const size_t _i, const bool _enabled);
+
+      /// \brief Get whether a channel is enabled.
+      /// \param[in] _i Channel index, must be less than Size().
+      /// \return True if the channel is enabled.
+      public: bool Enabled(const size_t _i) const;
+
+      /// \brief Update all channels with the same time step. Each enabled
+      /// channel computes the same command as PID::Update would. As in
+      /// PID::Update, a channel whose error is not finite outputs 0 and
+      /// keeps its state, and a zero time step outputs 0 on every enabled
+      /// channel without updating any state.
+      /// \param[in] _errors Size() errors (p_state - p_target).
+      /// \param[in] _dt Change in time since last update call.
+      /// \param[out] _cmds Size() commands. May be the same buffer as
+      /// _errors.
+      public: void Update(const double *_errors,
+                          const std::chrono::duration<double> &_dt,
+                          double *_cmds);
+
+      /// \brief Set the current command of a channel.
+      /// \param[in] _i Channel index, must be less than Size().
+      /// \param[in] _cmd New command.
+      public: void SetCmd(const size_t _i, const double _cmd);
+
+      /// \brief Get the current command of a channel.
+      /// \param[in] _i Channel index, must be less than Size().
+      /// \return The command value.
+      public: double Cmd(const size_t _i) const;
+
+      /// \brief Get the current commands of all channels.
+      /// \return Pointer to Size() contiguous commands.
+      public: const double *Cmds() const;
+
+      /// \brief Get the error states of a channel.
+      /// \param[in] _i Channel index, must be less than Size().
+      /// \param[out] _pe The proportional error.
+      /// \param[out] _ie The integral of gain times error.
+      /// \param[out] _de The derivative error.
+      public: void Errors(const size_t _i,
+                          double &_pe, double &_ie, double &_de) const;
+
+      /// \brief Reset the errors and command of every channel.
+      public: void Reset();
+
+      /// \brief Reset the errors and command of a channel.
+      /// \param[in] _i Channel index, must be less than Size().
+      public: void Reset(const size_t _i);
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<PIDBankPrivate> dataPtr;
+    };
+  }
+}
+#endif
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_PIDBANKPRIVATE_HH_
+#define IGNITION_MATH_PIDBANKPRIVATE_HH_
+
+#include <vector>
+
+namespace ignition
+{
+  namespace math
+  {
+    /// \internal
+    /// \brief Private data for PIDBank class. Each member holds one value
+    /// per channel.
+    class PIDBankPrivate
+    {
+      /// \brief Proportional gains.
+      public: std::vector<double> pGain;
+
+      /// \brief Integral gains.
+      public: std::vector<double> iGain;
+
+      /// \brief Derivative gains.
+      public: std::vector<double> dGain;
+
+      /// \brief Integral upper limits.
+      public: std::vector<double> iMax;
+
+      /// \brief Integral lower limits.
+      public: std::vector<double> iMin;
+
+      /// \brief Command upper limits.
+      public: std::vector<double> cmdMax;
+
+      /// \brief Command lower limits.
+      public: std::vector<double> cmdMin;
+
+      /// \brief Command offsets.
+      public: std::vector<double> cmdOffset;
+
+      /// \brief Proportional errors of the previous update.
+      public: std::vector<double> pErrLast;
+
+      /// \brief Proportional errors.
+      public: std::vector<double> pErr;
+
+      /// \brief Integral errors.
+      public: std::vector<double> iErr;
+
+      /// \brief Derivative errors.
+      public: std::vector<double> dErr;
+
+      /// \brief Commands.
+      public: std::vector<double> cmd;
+
+      /// \brief Enable mask, 1 for enabled channels and 0 otherwise.
+      public: std::vector<unsigned char> enabled;
+    };
+  }
+}
+#endif
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_PHILOXRAND_HH_
+#define IGNITION_MATH_PHILOXRAND_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <ignition/math/Helpers.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    /// \class PhiloxRand PhiloxRand.hh ignition/math/PhiloxRand.hh
+    /// \brief Counter-based random number generator, using the
+    /// Philox4x32-10 function from Salmon et al., "Parallel random numbers:
+    /// as easy as 1, 2, 3" (SC 2011).
+    ///
+    /// Every output is a pure function of the seed, the stream and its
+    /// position in the stream. Streams with different numbers are
+    /// independent, and jumping to any position costs the same as drawing
+    /// one number. This makes results reproducible whatever the number of
+    /// threads or the order of execution: give each task its own stream,
+    /// or its own range of positions in a shared stream.
+    ///
+    /// The stream is a sequence of 32 bit words. DblUniform consumes two
+    /// words per number. DblNormal consumes four words per pair of numbers
+    /// and returns the second number of a pair on the next call. The
+    /// batch functions return the same values as the same number of
+    /// calls to the single value functions.
+    class IGNITION_VISIBLE PhiloxRand
+    {
+      /// \brief Constructor.
+      /// \param[in] _seed Seed (the Philox key).
+      /// \param[in] _stream Stream number.
+      public: explicit PhiloxRand(const uint64_t _seed = 0,
+                                  const uint64_t _stream = 0);
+
+      /// \brief Get the seed.
+      /// \return The seed.
+      public: uint64_t Seed() const;
+
+      /// \brief Set the seed and go back to the start of the stream.
+      /// \param[in] _seed New seed.
+      public: void SetSeed(const uint64_t _seed);
+
+      /// \brief Get the stream number.
+      /// \return The stream number.
+      public: uint64_t Stream() const;
+
+      /// \brief Switch to another stream and go to its start.
+      /// \param[in] _stream New stream number.
+      public: void SetStream(const uint64_t _stream);
+
+      /// \brief Get the position of the next word in the stream.
+      /// \return Number of 32 bit words consumed since the start of the
+      /// stream.
+      public: uint64_t Position() const;
+
+      /// \brief Jump to a position in the stream.
+      /// \param[in] _position Number of 32 bit words from the start of the
+      /// stream.
+      public: void Seek(const uint64_t _position);
+
+      /// \brief Skip words in the stream.
+      /// \param[in] _count Number of 32 bit words to skip.
+      public: void Discard(const uint64_t _count);
+
+      /// \brief Get the next 32 bit word of the stream.
+      /// \return A uniformly distributed 32 bit integer.
+      public: uint32_t UInt32();
+
+      /// \brief Get a double from a uniform distribution.
+      /// \param[in] _min Minimum bound for the random number.
+      /// \param[in] _max Maximum bound for the random number.
+      /// \return A number in [_min, _max).
+      public: double DblUniform(const double _min = 0, const double _max = 1);
+
+      /// \brief Get a double from a normal distribution.
+      /// \param[in] _mean Mean value for the distribution.
+      /// \param[in] _sigma Sigma value for the distribution.
+      /// \return The random number.
+      public: double DblNormal(const double _mean = 0, const double _sigma = 1);
+
+      /// \brief Fill an array with doubles from a uniform distribution.
+      /// \param[out] _out Output array.
+      /// \param[in] _n Number of values to write.
+      /// \param[in] _min Minimum bound for the random numbers.
+      /// \param[in] _max Maximum bound for the random numbers.
+      public: void FillDblUniform(double *_out, const size_t _n,
+                                  const double _min = 0,
+                                  const double _max = 1);
+
+      /// \brief Fill an array with doubles from a normal distribution.
+      /// \param[out] _out Output array.
+      /// \param[in] _n Number of values to write.
+      /// \param[in] _mean Mean value for the distribution.
+      /// \param[in] _sigma Sigma value for the distribution.
+      public: void FillDblNormal(double *_out, const size_t _n,
+                                 const double _mean = 0,
+                                 const double _sigma = 1);
+
+      /// \brief Compute one block of the Philox4x32-10 function.
+      /// \param[in] _seed Seed (key).
+      /// \param[in] _stream Stream number, the high half of the counter.
+      /// \param[in] _block Block number, the low half of the counter.
+      /// Block b holds the words at positions 4b to 4b+3 of the stream.
+      /// \param[out] _out The four words of the block.
+      public: static void Block(const uint64_t _seed, const uint64_t _stream,
+                                const uint64_t _block, uint32_t _out[4]);
+
+      /// \brief Draw a pair of normally distributed numbers, with mean 0
+      /// and sigma 1, from the next four words.
+      /// \param[out] _a First number.
+      /// \param[out] _b Second number.
+      private: void NormalPair(double &_a, double &_b);
+
+      /// \brief Seed.
+      private: uint64_t seed;
+
+      /// \brief Stream number.
+      private: uint64_t stream;
+
+      /// \brief Position of the next word.
+      private: uint64_t position = 0;
+
+      /// \brief Words of the current block.
+      private: uint32_t buffer[4];
+
+      /// \brief Block number held in buffer.
+      private: uint64_t bufferBlock = 0;
+
+      /// \brief True if buffer holds bufferBlock.
+      private: bool bufferValid = false;
+
+      /// \brief Second number of the last normal pair.
+      private: double normal = 0;
+
+      /// \brief True if normal has not been returned yet.
+      private: bool hasNormal = false;
+    };
+  }
+}
+#endif
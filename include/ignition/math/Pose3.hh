@@ -395,6 +395,34 @@ namespace ignition
         return _in;
       }
 
+      /// \brief Parse a pose from text in the format written by
+      /// operator<<, x, y, z, roll, pitch and yaw separated by white spaces
+      /// or commas. This does not allocate and does not depend on the
+      /// locale.
+      /// \param[in,out] _pos Start of the text. On success it is moved
+      /// past the pose, on failure it points to the invalid token, or to
+      /// _end if the text ran out.
+      /// \param[in] _end End of the text.
+      /// \param[out] _pose Parsed pose, not modified on failure.
+      /// \return True on success.
+      /// \sa parseFloats
+      public: static bool Parse(const char *&_pos, const char *_end,
+                                Pose3<T> &_pose)
+      {
+        double v[6];
+        const char *p = _pos;
+        if (parseFloats(p, _end, v, 6) != 6)
+        {
+          _pos = p;
+          return false;
+        }
+        _pose.Set(static_cast<T>(v[0]), static_cast<T>(v[1]),
+                  static_cast<T>(v[2]), static_cast<T>(v[3]),
+                  static_cast<T>(v[4]), static_cast<T>(v[5]));
+        _pos = p;
+        return true;
+      }
+
       /// \brief The position
       private: Vector3<T> p;
 
@@ -0,0 +1,542 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_POSE3ARRAY_HH_
+#define IGNITION_MATH_POSE3ARRAY_HH_
+
+#include <cstddef>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    /// \class Pose3Array Pose3Array.hh ignition/math/Pose3Array.hh
+    /// \brief A collection of poses stored in structure-of-arrays layout.
+    /// Each component of the position (x, y, z) and of the rotation
+    /// (w, x, y, z) is kept in its own contiguous lane, so that the batch
+    /// operations below run as straight loops over plain arrays which the
+    /// compiler can vectorize.
+    ///
+    /// The batch operations produce the same results as the corresponding
+    /// Pose3 operations applied to each element.
+    template<typename T>
+    class Pose3Array
+    {
+      /// \brief Default constructor, creates an empty array.
+      public: Pose3Array() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _size Number of poses. All poses are set to identity.
+      public: explicit Pose3Array(const size_t _size)
+      {
+        this->Resize(_size);
+      }
+
+      /// \brief Constructor.
+      /// \param[in] _poses Poses to copy into the array.
+      public: explicit Pose3Array(const std::vector<Pose3<T>> &_poses)
+      {
+        this->Resize(_poses.size());
+        for (size_t i = 0; i < _poses.size(); ++i)
+          this->Set(i, _poses[i]);
+      }
+
+      /// \brief Get the number of poses.
+      /// \return Number of poses in the array.
+      public: size_t Size() const
+      {
+        return this->px.size();
+      }
+
+      /// \brief Change the number of poses. New poses are set to identity.
+      /// \param[in] _size New number of poses.
+      public: void Resize(const size_t _size)
+      {
+        this->px.resize(_size, 0);
+        this->py.resize(_size, 0);
+        this->pz.resize(_size, 0);
+        this->qw.resize(_size, 1);
+        this->qx.resize(_size, 0);
+        this->qy.resize(_size, 0);
+        this->qz.resize(_size, 0);
+      }
+
+      /// \brief Set a pose in the array.
+      /// \param[in] _index Index of the pose, must be less than Size().
+      /// \param[in] _pose New value of the pose.
+      public: void Set(const size_t _index, const Pose3<T> &_pose)
+      {
+        this->px[_index] = _pose.Pos().X();
+        this->py[_index] = _pose.Pos().Y();
+        this->pz[_index] = _pose.Pos().Z();
+        this->qw[_index] = _pose.Rot().W();
+        this->qx[_index] = _pose.Rot().X();
+        this->qy[_index] = _pose.Rot().Y();
+        this->qz[_index] = _pose.Rot().Z();
+      }
+
+      /// \brief Get a pose in the array.
+      /// \param[in] _index Index of the pose, must be less than Size().
+      /// \return A copy of the pose.
+      public: Pose3<T> Pose(const size_t _index) const
+      {
+        return Pose3<T>(this->px[_index], this->py[_index], this->pz[_index],
+            this->qw[_index], this->qx[_index], this->qy[_index],
+            this->qz[_index]);
+      }
+
+      /// \brief Copy all poses into a vector of Pose3.
+      /// \return The poses.
+      public: std::vector<Pose3<T>> Poses() const
+      {
+        std::vector<Pose3<T>> result;
+        result.reserve(this->Size());
+        for (size_t i = 0; i < this->Size(); ++i)
+          result.push_back(this->Pose(i));
+        return result;
+      }
+
+      /// \brief Addition operator, applied element-wise. Element i of the
+      /// result equals this->Pose(i) + _poses.Pose(i).
+      /// \param[in] _poses Poses to add, must have the same size as this.
+      /// \return The resulting poses.
+      /// \sa Pose3::operator+
+      public: Pose3Array<T> operator+(const Pose3Array<T> &_poses) const
+      {
+        Pose3Array<T> result;
+        this->Add(_poses, result);
+        return result;
+      }
+
+      /// \brief Add poses element-wise without allocating when _result
+      /// already has the right size. Element i of the result equals
+      /// this->Pose(i) + _poses.Pose(i). _result may be this array or
+      /// _poses.
+      /// \param[in] _poses Poses to add, must have the same size as this.
+      /// \param[out] _result The resulting poses.
+      public: void Add(const Pose3Array<T> &_poses,
+                       Pose3Array<T> &_result) const
+      {
+        const size_t n = this->Size();
+        _result.Resize(n);
+
+        const T *ax = this->px.data();
+        const T *ay = this->py.data();
+        const T *az = this->pz.data();
+        const T *aqw = this->qw.data();
+        const T *aqx = this->qx.data();
+        const T *aqy = this->qy.data();
+        const T *aqz = this->qz.data();
+        const T *bx = _poses.px.data();
+        const T *by = _poses.py.data();
+        const T *bz = _poses.pz.data();
+        const T *bqw = _poses.qw.data();
+        const T *bqx = _poses.qx.data();
+        const T *bqy = _poses.qy.data();
+        const T *bqz = _poses.qz.data();
+        T *rx = _result.px.data();
+        T *ry = _result.py.data();
+        T *rz = _result.pz.data();
+        T *rqw = _result.qw.data();
+        T *rqx = _result.qx.data();
+        T *rqy = _result.qy.data();
+        T *rqz = _result.qz.data();
+
+        for (size_t i = 0; i < n; ++i)
+        {
+          T vx, vy, vz;
+          Rotate(bqw[i], bqx[i], bqy[i], bqz[i], ax[i], ay[i], az[i],
+              vx, vy, vz);
+
+          T w, x, y, z;
+          Multiply(bqw[i], bqx[i], bqy[i], bqz[i],
+              aqw[i], aqx[i], aqy[i], aqz[i], w, x, y, z);
+
+          rx[i] = bx[i] + vx;
+          ry[i] = by[i] + vy;
+          rz[i] = bz[i] + vz;
+          rqw[i] = w;
+          rqx[i] = x;
+          rqy[i] = y;
+          rqz[i] = z;
+        }
+      }
+
+      /// \brief Add a single pose to every pose in this array. Element i
+      /// of the result equals this->Pose(i) + _pose. This is the usual way
+      /// to move a set of poses expressed in a frame P into the parent
+      /// frame O, when _pose is the transform from O to P.
+      /// \param[in] _pose Pose to add.
+      /// \param[out] _result The resulting poses. May be this array.
+      public: void Add(const Pose3<T> &_pose, Pose3Array<T> &_result) const
+      {
+        const size_t n = this->Size();
+        _result.Resize(n);
+
+        const T bx = _pose.Pos().X();
+        const T by = _pose.Pos().Y();
+        const T bz = _pose.Pos().Z();
+        const T bqw = _pose.Rot().W();
+        const T bqx = _pose.Rot().X();
+        const T bqy = _pose.Rot().Y();
+        const T bqz = _pose.Rot().Z();
+
+        const T *ax = this->px.data();
+        const T *ay = this->py.data();
+        const T *az = this->pz.data();
+        const T *aqw = this->qw.data();
+        const T *aqx = this->qx.data();
+        const T *aqy = this->qy.data();
+        const T *aqz = this->qz.data();
+        T *rx = _result.px.data();
+        T *ry = _result.py.data();
+        T *rz = _result.pz.data();
+        T *rqw = _result.qw.data();
+        T *rqx = _result.qx.data();
+        T *rqy = _result.qy.data();
+        T *rqz = _result.qz.data();
+
+        for (size_t i = 0; i < n; ++i)
+        {
+          T vx, vy, vz;
+          Rotate(bqw, bqx, bqy, bqz, ax[i], ay[i], az[i], vx, vy, vz);
+
+          T w, x, y, z;
+          Multiply(bqw, bqx, bqy, bqz, aqw[i], aqx[i], aqy[i], aqz[i],
+              w, x, y, z);
+
+          rx[i] = bx + vx;
+          ry[i] = by + vy;
+          rz[i] = bz + vz;
+          rqw[i] = w;
+          rqx[i] = x;
+          rqy[i] = y;
+          rqz[i] = z;
+        }
+      }
+
+      /// \brief Get the inverse of every pose.
+      /// \return The inverse poses.
+      /// \sa Pose3::Inverse
+      public: Pose3Array<T> Inverse() const
+      {
+        Pose3Array<T> result;
+        this->Inverse(result);
+        return result;
+      }
+
+      /// \brief Compute the inverse of every pose without allocating when
+      /// _result already has the right size.
+      /// \param[out] _result The inverse poses. May be this array.
+      public: void Inverse(Pose3Array<T> &_result) const
+      {
+        const size_t n = this->Size();
+        _result.Resize(n);
+
+        const T *ax = this->px.data();
+        const T *ay = this->py.data();
+        const T *az = this->pz.data();
+        const T *aqw = this->qw.data();
+        const T *aqx = this->qx.data();
+        const T *aqy = this->qy.data();
+        const T *aqz = this->qz.data();
+        T *rx = _result.px.data();
+        T *ry = _result.py.data();
+        T *rz = _result.pz.data();
+        T *rqw = _result.qw.data();
+        T *rqx = _result.qx.data();
+        T *rqy = _result.qy.data();
+        T *rqz = _result.qz.data();
+
+        for (size_t i = 0; i < n; ++i)
+        {
+          T w, x, y, z;
+          Invert(aqw[i], aqx[i], aqy[i], aqz[i], w, x, y, z);
+
+          // Pose3::Inverse rotates with Quaternion::operator*(Vector3)
+          T vx, vy, vz;
+          Rotate(w, x, y, z, static_cast<T>(2), -ax[i], -ay[i], -az[i],
+              vx, vy, vz);
+
+          rx[i] = vx;
+          ry[i] = vy;
+          rz[i] = vz;
+          rqw[i] = w;
+          rqx[i] = x;
+          rqy[i] = y;
+          rqz[i] = z;
+        }
+      }
+
+      /// \brief Find the inverse of every pose; i.e., if b = this + a,
+      /// given b and this, find a.
+      /// \param[in] _b The other poses, must have the same size as this.
+      /// \return The poses a.
+      /// \sa Pose3::CoordPoseSolve
+      public: Pose3Array<T> CoordPoseSolve(const Pose3Array<T> &_b) const
+      {
+        Pose3Array<T> result;
+        this->CoordPoseSolve(_b, result);
+        return result;
+      }
+
+      /// \brief Find the inverse of every pose; i.e., if b = this + a,
+      /// given b and this, find a. Does not allocate when _result already
+      /// has the right size.
+      /// \param[in] _b The other poses, must have the same size as this.
+      /// \param[out] _result The poses a. May be this array or _b.
+      public: void CoordPoseSolve(const Pose3Array<T> &_b,
+                                  Pose3Array<T> &_result) const
+      {
+        const size_t n = this->Size();
+        _result.Resize(n);
+
+        const T *ax = this->px.data();
+        const T *ay = this->py.data();
+        const T *az = this->pz.data();
+        const T *aqw = this->qw.data();
+        const T *aqx = this->qx.data();
+        const T *aqy = this->qy.data();
+        const T *aqz = this->qz.data();
+        const T *bx = _b.px.data();
+        const T *by = _b.py.data();
+        const T *bz = _b.pz.data();
+        const T *bqw = _b.qw.data();
+        const T *bqx = _b.qx.data();
+        const T *bqy = _b.qy.data();
+        const T *bqz = _b.qz.data();
+        T *rx = _result.px.data();
+        T *ry = _result.py.data();
+        T *rz = _result.pz.data();
+        T *rqw = _result.qw.data();
+        T *rqx = _result.qx.data();
+        T *rqy = _result.qy.data();
+        T *rqz = _result.qz.data();
+
+        for (size_t i = 0; i < n; ++i)
+        {
+          T iw, ix, iy, iz;
+          Invert(aqw[i], aqx[i], aqy[i], aqz[i], iw, ix, iy, iz);
+
+          // a.q = this->q.Inverse() * b.q
+          T w, x, y, z;
+          Multiply(iw, ix, iy, iz, bqw[i], bqx[i], bqy[i], bqz[i],
+              w, x, y, z);
+
+          // a.p = b.p - a.q * this->p
+          T vx, vy, vz;
+          Rotate(w, x, y, z, ax[i], ay[i], az[i], vx, vy, vz);
+
+          rx[i] = bx[i] - vx;
+          ry[i] = by[i] - vy;
+          rz[i] = bz[i] - vz;
+          rqw[i] = w;
+          rqx[i] = x;
+          rqy[i] = y;
+          rqz[i] = z;
+        }
+      }
+
+      /// \brief Get the x position lane.
+      /// \return Pointer to Size() contiguous x values.
+      public: const T *PosX() const
+      {
+        return this->px.data();
+      }
+
+      /// \brief Get the y position lane.
+      /// \return Pointer to Size() contiguous y values.
+      public: const T *PosY() const
+      {
+        return this->py.data();
+      }
+
+      /// \brief Get the z position lane.
+      /// \return Pointer to Size() contiguous z values.
+      public: const T *PosZ() const
+      {
+        return this->pz.data();
+      }
+
+      /// \brief Get the rotation w lane.
+      /// \return Pointer to Size() contiguous quaternion w values.
+      public: const T *RotW() const
+      {
+        return this->qw.data();
+      }
+
+      /// \brief Get the rotation x lane.
+      /// \return Pointer to Size() contiguous quaternion x values.
+      public: const T *RotX() const
+      {
+        return this->qx.data();
+      }
+
+      /// \brief Get the rotation y lane.
+      /// \return Pointer to Size() contiguous quaternion y values.
+      public: const T *RotY() const
+      {
+        return this->qy.data();
+      }
+
+      /// \brief Get the rotation z lane.
+      /// \return Pointer to Size() contiguous quaternion z values.
+      public: const T *RotZ() const
+      {
+        return this->qz.data();
+      }
+
+      /// \brief Get a mutable x position lane.
+      /// \return Pointer to Size() contiguous x values.
+      public: T *PosX()
+      {
+        return this->px.data();
+      }
+
+      /// \brief Get a mutable y position lane.
+      /// \return Pointer to Size() contiguous y values.
+      public: T *PosY()
+      {
+        return this->py.data();
+      }
+
+      /// \brief Get a mutable z position lane.
+      /// \return Pointer to Size() contiguous z values.
+      public: T *PosZ()
+      {
+        return this->pz.data();
+      }
+
+      /// \brief Get a mutable rotation w lane.
+      /// \return Pointer to Size() contiguous quaternion w values.
+      public: T *RotW()
+      {
+        return this->qw.data();
+      }
+
+      /// \brief Get a mutable rotation x lane.
+      /// \return Pointer to Size() contiguous quaternion x values.
+      public: T *RotX()
+      {
+        return this->qx.data();
+      }
+
+      /// \brief Get a mutable rotation y lane.
+      /// \return Pointer to Size() contiguous quaternion y values.
+      public: T *RotY()
+      {
+        return this->qy.data();
+      }
+
+      /// \brief Get a mutable rotation z lane.
+      /// \return Pointer to Size() contiguous quaternion z values.
+      public: T *RotZ()
+      {
+        return this->qz.data();
+      }
+
+      /// \brief Quaternion product r = a * b.
+      private: static inline void Multiply(
+                   const T _aw, const T _ax, const T _ay, const T _az,
+                   const T _bw, const T _bx, const T _by, const T _bz,
+                   T &_rw, T &_rx, T &_ry, T &_rz)
+      {
+        _rw = _aw*_bw - _ax*_bx - _ay*_by - _az*_bz;
+        _rx = _aw*_bx + _ax*_bw + _ay*_bz - _az*_by;
+        _ry = _aw*_by - _ax*_bz + _ay*_bw + _az*_bx;
+        _rz = _aw*_bz + _ax*_by - _ay*_bx + _az*_bw;
+      }
+
+      /// \brief Quaternion inverse, matching Quaternion::Inverse. A zero
+      /// quaternion is mapped to identity without branching.
+      private: static inline void Invert(
+                   const T _w, const T _x, const T _y, const T _z,
+                   T &_rw, T &_rx, T &_ry, T &_rz)
+      {
+        const T s = _w*_w + _x*_x + _y*_y + _z*_z;
+        const bool zero = equal<T>(s, static_cast<T>(0));
+        const T invS = zero ? static_cast<T>(0) : static_cast<T>(1) / s;
+        _rw = zero ? static_cast<T>(1) : _w * invS;
+        _rx = -_x * invS;
+        _ry = -_y * invS;
+        _rz = -_z * invS;
+      }
+
+      /// \brief Rotate a vector by a quaternion, r = q * v * q.Inverse().
+      /// The quaternion does not need to be normalized.
+      private: static inline void Rotate(
+                   const T _w, const T _x, const T _y, const T _z,
+                   const T _vx, const T _vy, const T _vz,
+                   T &_rx, T &_ry, T &_rz)
+      {
+        // q * v * q^-1 = v + 2/|q|^2 * (w * (u x v) + u x (u x v))
+        const T s = _w*_w + _x*_x + _y*_y + _z*_z;
+        const T k = equal<T>(s, static_cast<T>(0)) ?
+          static_cast<T>(0) : static_cast<T>(2) / s;
+        Rotate(_w, _x, _y, _z, k, _vx, _vy, _vz, _rx, _ry, _rz);
+      }
+
+      /// \brief Compute r = v + _k * (w * (u x v) + u x (u x v)), where
+      /// u is the vector part of the quaternion. With _k = 2 this matches
+      /// Quaternion::operator*(const Vector3<T> &).
+      private: static inline void Rotate(
+                   const T _w, const T _x, const T _y, const T _z,
+                   const T _k, const T _vx, const T _vy, const T _vz,
+                   T &_rx, T &_ry, T &_rz)
+      {
+        const T cx = _y*_vz - _z*_vy;
+        const T cy = _z*_vx - _x*_vz;
+        const T cz = _x*_vy - _y*_vx;
+
+        const T ccx = _y*cz - _z*cy;
+        const T ccy = _z*cx - _x*cz;
+        const T ccz = _x*cy - _y*cx;
+
+        _rx = _vx + _k * (_w*cx + ccx);
+        _ry = _vy + _k * (_w*cy + ccy);
+        _rz = _vz + _k * (_w*cz + ccz);
+      }
+
+      /// \brief X positions.
+      private: std::vector<T> px;
+
+      /// \brief Y positions.
+      private: std::vector<T> py;
+
+      /// \brief Z positions.
+      private: std::vector<T> pz;
+
+      /// \brief Rotation w components.
+      private: std::vector<T> qw;
+
+      /// \brief Rotation x components.
+      private: std::vector<T> qx;
+
+      /// \brief Rotation y components.
+      private: std::vector<T> qy;
+
+      /// \brief Rotation z components.
+      private: std::vector<T> qz;
+    };
+
+    typedef Pose3Array<double> Pose3Arrayd;
+    typedef Pose3Array<float> Pose3Arrayf;
+  }
+}
+#endif
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_POSETRAJECTORY_HH_
+#define IGNITION_MATH_POSETRAJECTORY_HH_
+
+#include <cstddef>
+#include <memory>
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Pose3.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Forward declare private data
+    class PoseTrajectoryPrivate;
+
+    /// \class PoseTrajectory PoseTrajectory.hh ignition/math/PoseTrajectory.hh
+    /// \brief A history of timestamped poses which can be queried at any
+    /// time between the first and the last sample.
+    ///
+    /// Timestamps and each pose component are stored in contiguous arrays.
+    /// A capacity can be set, in which case the trajectory behaves as a
+    /// ring buffer and adding a sample to a full trajectory drops the
+    /// oldest one. A single query costs O(log n), and a batch of queries
+    /// with increasing times costs amortized O(1) per query.
+    class IGNITION_VISIBLE PoseTrajectory
+    {
+      /// \enum InterpolationType
+      /// \brief How poses are computed between two samples.
+      public: enum InterpolationType
+      {
+        /// \brief Linear interpolation of the position and spherical
+        /// linear interpolation of the rotation, see Quaternion::Slerp.
+        LINEAR = 0,
+
+        /// \brief Catmull-Rom interpolation of the position, scaled by
+        /// the time between samples, and spherical quadrangle
+        /// interpolation of the rotation with the same tangents as
+        /// RotationSpline.
+        SPLINE = 1
+      };
+
+      /// \brief Constructor, creates an empty trajectory without capacity
+      /// limit.
+      public: PoseTrajectory();
+
+      /// \brief Constructor.
+      /// \param[in] _capacity Maximum number of samples, 0 for no limit.
+      public: explicit PoseTrajectory(const size_t _capacity);
+
+      /// \brief Copy constructor.
+      /// \param[in] _trajectory Trajectory to copy.
+      public: PoseTrajectory(const PoseTrajectory &_trajectory);
+
+      /// \brief Destructor.
+      public: ~PoseTrajectory();
+
+      /// \brief Assignment operator.
+      /// \param[in] _trajectory Trajectory to copy.
+      /// \return Reference to this object.
+      public: PoseTrajectory &operator=(const PoseTrajectory &_trajectory);
+
+      /// \brief Set the maximum number of samples. When the trajectory
+      /// holds more samples, only the newest ones are kept.
+      /// \param[in] _capacity Maximum number of samples, 0 for no limit.
+      public: void SetCapacity(const size_t _capacity);
+
+      /// \brief Get the maximum number of samples.
+      /// \return Maximum number of samples, 0 when there is no limit.
+      public: size_t Capacity() const;
+
+      /// \brief Add a sample at the end of the trajectory. When the
+      /// trajectory is full, the oldest sample is dropped.
+      /// \param[in] _time Time of the sample. Must be finite and greater
+      /// than EndTime().
+      /// \param[in] _pose Pose at _time.
+      /// \return True if the sample was added.
+      public: bool Add(const double _time, const Pose3d &_pose);
+
+      /// \brief Remove all samples. The capacity is not changed.
+      public: void Clear();
+
+      /// \brief Get the number of samples.
+      /// \return Number of samples.
+      public: size_t Size() const;
+
+      /// \brief Check whether the trajectory has no sample.
+      /// \return True if the trajectory is empty.
+      public: bool Empty() const;
+
+      /// \brief Get the time of the oldest sample.
+      /// \return Time of the first sample, NAN_D when empty.
+      public: double StartTime() const;
+
+      /// \brief Get the time of the newest sample.
+      /// \return Time of the last sample, NAN_D when empty.
+      public: double EndTime() const;
+
+      /// \brief Get the time of a sample.
+      /// \param[in] _index Index of the sample, 0 is the oldest.
+      /// \return Time of the sample, NAN_D if _index is out of range.
+      public: double Time(const size_t _index) const;
+
+      /// \brief Get the pose of a sample.
+      /// \param[in] _index Index of the sample, 0 is the oldest.
+      /// \return Pose of the sample, Pose3d::Zero if _index is out of
+      /// range.
+      public: Pose3d Pose(const size_t _index) const;
+
+      /// \brief Get the pose at a given time.
+      /// \param[in] _time Time of the query, between StartTime() and
+      /// EndTime().
+      /// \param[out] _pose Pose at _time. Samples are returned exactly.
+      /// \param[in] _type Interpolation between samples.
+      /// \return False if _time is outside of the trajectory, in which
+      /// case _pose is not changed.
+      public: bool Interpolate(const double _time, Pose3d &_pose,
+                  const InterpolationType _type = LINEAR) const;
+
+      /// \brief Get the poses at many times. Consecutive times are
+      /// expected to be close to each other, such as increasing times,
+      /// and the search for each one starts from the previous result.
+      /// Times outside of the trajectory are clamped to the first or the
+      /// last sample.
+      /// \param[in] _times Times of the queries.
+      /// \param[in] _count Number of queries.
+      /// \param[out] _poses Array of _count poses at _times.
+      /// \param[in] _type Interpolation between samples.
+      /// \return Number of times inside of the trajectory, 0 when the
+      /// trajectory is empty in which case _poses is not changed.
+      public: size_t Interpolate(const double *_times, const size_t _count,
+                  Pose3d *_poses,
+                  const InterpolationType _type = LINEAR) const;
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<PoseTrajectoryPrivate> dataPtr;
+    };
+  }
+}
+#endif
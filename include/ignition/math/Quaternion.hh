@@ -1046,6 +1046,27 @@ namespace ignition
         return _in;
       }
 
+      /// \brief Parse a quaternion from text in the format written by
+      /// operator<<, roll, pitch and yaw angles in radians separated by
+      /// white spaces or commas. This does not allocate and does not
+      /// depend on the locale.
+      /// \param[in,out] _pos Start of the text. On success it is moved
+      /// past the angles, on failure it points to the invalid token, or to
+      /// _end if the text ran out.
+      /// \param[in] _end End of the text.
+      /// \param[out] _q Parsed quaternion, not modified on failure.
+      /// \return True on success.
+      /// \sa parseFloats
+      public: static bool Parse(const char *&_pos, const char *_end,
+                                Quaternion<T> &_q)
+      {
+        Vector3<T> euler;
+        if (!Vector3<T>::Parse(_pos, _end, euler))
+          return false;
+        _q.Euler(euler);
+        return true;
+      }
+
       /// \brief w value of the quaternion
       private: T qw;
 
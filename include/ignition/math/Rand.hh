@@ -22,6 +22,7 @@
 #include <cstdint>
 #include <memory>
 #include <ignition/math/Helpers.hh>
+#include <ignition/math/Vector3.hh>
 
 namespace ignition
 {
@@ -41,7 +42,14 @@ namespace ignition
     typedef std::uniform_int_distribution<int32_t> UniformIntDist;
 
     /// \class Rand Rand.hh ignition/math/Rand.hh
-    /// \brief Random number generator class
+    /// \brief Random number generator class. All functions are thread
+    /// safe: every thread draws from its own generator, seeded from the
+    /// global seed and the stream of the thread. A thread which does not
+    /// select a stream with SetStream gets one when it first draws: stream
+    /// 0 for the first thread, and the next unused stream for each other
+    /// thread. These streams follow the order in which threads start
+    /// drawing, so threads which must draw the same numbers on every run
+    /// should select their stream with SetStream.
     class IGNITION_VISIBLE Rand
     {
       /// \brief Set the seed value.
@@ -54,6 +62,21 @@ namespace ignition
       /// generator.
       public: static unsigned int Seed();
 
+      /// \brief Select the stream of the calling thread. The generator of
+      /// a thread is seeded from the global seed and its stream, so a
+      /// thread draws the same numbers for the same seed and stream
+      /// whatever the other threads do. Stream 0 uses the seed alone and
+      /// gives the same sequence as earlier versions of Rand. The generator
+      /// of the calling thread restarts its sequence.
+      /// \param[in] _stream Index of the stream, for example the index of
+      /// a worker thread.
+      public: static void SetStream(size_t _stream);
+
+      /// \brief Get the stream of the calling thread.
+      /// \return The stream selected with SetStream, or else the stream
+      /// given to the thread by default.
+      public: static size_t Stream();
+
       /// \brief Get a double from a uniform distribution
       /// \param[in] _min Minimum bound for the random number
       /// \param[in] _max Maximum bound for the random number
@@ -74,20 +97,51 @@ namespace ignition
       /// \param[in] _sigma Sigma value for the distribution
       public: static int32_t IntNormal(int _mean, int _sigma);
 
-#ifdef _WIN32
-// Disable warning C4251 which is triggered by
-// std::unique_ptr
-#pragma warning(push)
-#pragma warning(disable: 4251)
-#endif
-      /// \brief The random number generator.
-      private: static std::unique_ptr<GeneratorType> randGenerator;
-#ifdef _WIN32
-#pragma warning(pop)
-#endif
+      /// \brief Fill an array with doubles from a uniform distribution.
+      /// \param[out] _out Output array.
+      /// \param[in] _n Number of values to write.
+      /// \param[in] _min Minimum bound for the random numbers
+      /// \param[in] _max Maximum bound for the random numbers
+      public: static void FillDblUniform(double *_out, size_t _n,
+                                         double _min = 0, double _max = 1);
+
+      /// \brief Fill an array with doubles from a normal distribution.
+      /// This uses the ziggurat method, which is much faster than drawing
+      /// the numbers one at a time with DblNormal(double, double), but
+      /// gives a different sequence for the same seed.
+      /// \param[out] _out Output array.
+      /// \param[in] _n Number of values to write.
+      /// \param[in] _mean Mean value for the distribution
+      /// \param[in] _sigma Sigma value for the distribution
+      public: static void FillDblNormal(double *_out, size_t _n,
+                                        double _mean = 0, double _sigma = 1);
+
+      /// \brief Fill an array with points uniformly distributed in an
+      /// axis aligned box.
+      /// \param[out] _out Output array.
+      /// \param[in] _n Number of points to write.
+      /// \param[in] _min Minimum corner of the box.
+      /// \param[in] _max Maximum corner of the box.
+      public: static void FillVector3InBox(Vector3d *_out, size_t _n,
+                                           const Vector3d &_min,
+                                           const Vector3d &_max);
+
+      /// \brief Fill an array with points uniformly distributed in a
+      /// sphere.
+      /// \param[out] _out Output array.
+      /// \param[in] _n Number of points to write.
+      /// \param[in] _center Center of the sphere.
+      /// \param[in] _radius Radius of the sphere.
+      public: static void FillVector3InSphere(Vector3d *_out, size_t _n,
+                                              const Vector3d &_center,
+                                              double _radius);
 
-      /// \brief Random number seed.
-      private: static uint32_t seed;
+      /// \brief Get the random number generator of the calling thread.
+      /// Each thread owns a generator, so that threads can draw numbers
+      /// concurrently without locking. The generator is reseeded when the
+      /// seed or the stream of the thread changes.
+      /// \return The calling thread's generator.
+      private: static GeneratorType &Generator();
     };
   }
 }
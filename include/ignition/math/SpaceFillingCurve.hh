@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_SPACEFILLINGCURVE_HH_
+#define IGNITION_MATH_SPACEFILLINGCURVE_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <ignition/math/Box.hh>
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Vector2.hh>
+#include <ignition/math/Vector3.hh>
+
+// Morton (Z-order) and Hilbert codes of grid cells and points. Sorting
+// points by code places points that are close in space close in memory,
+// which makes spatial structures and traversals more cache friendly. The
+// Hilbert curve keeps better locality, since consecutive codes are always
+// neighbor cells, while Morton codes are cheaper to compute.
+//
+// 2D codes interleave two 32 bit coordinates. 3D codes interleave the low
+// 21 bits of three coordinates into 63 bits. Points are quantized to the
+// grid of cells that divides a Box domain into 2^32 or 2^21 cells along
+// each axis; points outside the domain get the code of the closest cell.
+//
+// Bits are interleaved with the BMI2 pdep and pext instructions when the
+// library is compiled with BMI2 enabled, and with shifts and masks
+// otherwise. pdep and pext take a cycle or so on Intel processors since
+// Haswell and on AMD processors since Zen 3, but are microcoded on Zen and
+// Zen 2, where they take tens to hundreds of cycles and are much slower
+// than the shifts. The host CFlags (USE_HOST_CFLAGS, on by default) enable
+// BMI2 when the build machine supports it, except on those AMD
+// processors. Build with USE_BMI2 off for binaries that may run on them,
+// and with USE_HOST_CFLAGS off for binaries that must run on processors
+// without BMI2.
+
+namespace ignition
+{
+  namespace math
+  {
+    /// \brief Get the Morton code of a 2D cell.
+    /// \param[in] _x X coordinate of the cell, stored in the even bits.
+    /// \param[in] _y Y coordinate of the cell, stored in the odd bits.
+    /// \return Morton code.
+    /// \sa mortonDecode
+    uint64_t IGNITION_VISIBLE mortonEncode(const uint32_t _x,
+                                           const uint32_t _y);
+
+    /// \brief Get the Morton code of a 3D cell.
+    /// \param[in] _x X coordinate of the cell, only the low 21 bits are
+    /// used.
+    /// \param[in] _y Y coordinate of the cell, only the low 21 bits are
+    /// used.
+    /// \param[in] _z Z coordinate of the cell, only the low 21 bits are
+    /// used.
+    /// \return Morton code, below 2^63.
+    /// \sa mortonDecode
+    uint64_t IGNITION_VISIBLE mortonEncode(const uint32_t _x,
+                                           const uint32_t _y,
+                                           const uint32_t _z);
+
+    /// \brief Get the 2D cell of a Morton code.
+    /// \param[in] _code Morton code.
+    /// \param[out] _x X coordinate of the cell.
+    /// \param[out] _y Y coordinate of the cell.
+    void IGNITION_VISIBLE mortonDecode(const uint64_t _code,
+                                       uint32_t &_x, uint32_t &_y);
+
+    /// \brief Get the 3D cell of a Morton code.
+    /// \param[in] _code Morton code, bit 63 is ignored.
+    /// \param[out] _x X coordinate of the cell.
+    /// \param[out] _y Y coordinate of the cell.
+    /// \param[out] _z Z coordinate of the cell.
+    void IGNITION_VISIBLE mortonDecode(const uint64_t _code,
+                                       uint32_t &_x, uint32_t &_y,
+                                       uint32_t &_z);
+
+    /// \brief Get the Hilbert code of a 2D cell.
+    /// \param[in] _x X coordinate of the cell.
+    /// \param[in] _y Y coordinate of the cell.
+    /// \return Hilbert code.
+    /// \sa hilbertDecode
+    uint64_t IGNITION_VISIBLE hilbertEncode(const uint32_t _x,
+                                            const uint32_t _y);
+
+    /// \brief Get the Hilbert code of a 3D cell.
+    /// \param[in] _x X coordinate of the cell, only the low 21 bits are
+    /// used.
+    /// \param[in] _y Y coordinate of the cell, only the low 21 bits are
+    /// used.
+    /// \param[in] _z Z coordinate of the cell, only the low 21 bits are
+    /// used.
+    /// \return Hilbert code, below 2^63.
+    /// \sa hilbertDecode
+    uint64_t IGNITION_VISIBLE hilbertEncode(const uint32_t _x,
+                                            const uint32_t _y,
+                                            const uint32_t _z);
+
+    /// \brief Get the 2D cell of a Hilbert code.
+    /// \param[in] _code Hilbert code.
+    /// \param[out] _x X coordinate of the cell.
+    /// \param[out] _y Y coordinate of the cell.
+    void IGNITION_VISIBLE hilbertDecode(const uint64_t _code,
+                                        uint32_t &_x, uint32_t &_y);
+
+    /// \brief Get the 3D cell of a Hilbert code.
+    /// \param[in] _code Hilbert code, bit 63 is ignored.
+    /// \param[out] _x X coordinate of the cell.
+    /// \param[out] _y Y coordinate of the cell.
+    /// \param[out] _z Z coordinate of the cell.
+    void IGNITION_VISIBLE hilbertDecode(const uint64_t _code,
+                                        uint32_t &_x, uint32_t &_y,
+                                        uint32_t &_z);
+
+    /// \brief Get the Morton code of a 2D point.
+    /// \param[in] _point Point.
+    /// \param[in] _domain Domain of the points, only its X and Y extents
+    /// are used.
+    /// \return Morton code of the cell of _point. NaN coordinates are
+    /// in cell 0.
+    uint64_t IGNITION_VISIBLE mortonCode(const Vector2d &_point,
+                                         const Box &_domain);
+
+    /// \brief Get the Morton code of a 3D point.
+    /// \param[in] _point Point.
+    /// \param[in] _domain Domain of the points.
+    /// \return Morton code of the cell of _point. NaN coordinates are
+    /// in cell 0.
+    uint64_t IGNITION_VISIBLE mortonCode(const Vector3d &_point,
+                                         const Box &_domain);
+
+    /// \brief Get the Hilbert code of a 2D point.
+    /// \param[in] _point Point.
+    /// \param[in] _domain Domain of the points, only its X and Y extents
+    /// are used.
+    /// \return Hilbert code of the cell of _point. NaN coordinates are
+    /// in cell 0.
+    uint64_t IGNITION_VISIBLE hilbertCode(const Vector2d &_point,
+                                          const Box &_domain);
+
+    /// \brief Get the Hilbert code of a 3D point.
+    /// \param[in] _point Point.
+    /// \param[in] _domain Domain of the points.
+    /// \return Hilbert code of the cell of _point. NaN coordinates are
+    /// in cell 0.
+    uint64_t IGNITION_VISIBLE hilbertCode(const Vector3d &_point,
+                                          const Box &_domain);
+
+    /// \brief Get the Morton codes of an array of 3D points.
+    /// \param[in] _points Array of points.
+    /// \param[in] _count Number of points.
+    /// \param[in] _domain Domain of the points.
+    /// \param[out] _codes Array of _count codes.
+    void IGNITION_VISIBLE mortonCodes(const Vector3d *_points,
+                                      const size_t _count,
+                                      const Box &_domain,
+                                      uint64_t *_codes);
+
+    /// \brief Get the Hilbert codes of an array of 3D points.
+    /// \param[in] _points Array of points.
+    /// \param[in] _count Number of points.
+    /// \param[in] _domain Domain of the points.
+    /// \param[out] _codes Array of _count codes.
+    void IGNITION_VISIBLE hilbertCodes(const Vector3d *_points,
+                                       const size_t _count,
+                                       const Box &_domain,
+                                       uint64_t *_codes);
+
+    /// \brief Get the order that sorts an array of codes, using a least
+    /// significant digit radix sort. The sort is stable, and digits which
+    /// are the same in all codes are skipped, so that codes of a small
+    /// domain sort faster.
+    /// \param[in] _codes Array of codes.
+    /// \param[in] _count Number of codes.
+    /// \param[out] _order Indices of the codes in increasing order.
+    void IGNITION_VISIBLE sortCodes(const uint64_t *_codes,
+                                    const size_t _count,
+                                    std::vector<size_t> &_order);
+  }
+}
+#endif
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_SPATIALHASHGRID_HH_
+#define IGNITION_MATH_SPATIALHASHGRID_HH_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Vector3.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Forward declare private data
+    class SpatialHashGridPrivate;
+
+    /// \class SpatialHashGrid SpatialHashGrid.hh
+    /// ignition/math/SpatialHashGrid.hh
+    /// \brief A uniform grid of cubic cells over a set of points, used to
+    /// find the points close to a location without testing all of them.
+    ///
+    /// Only cells which hold points are stored, in an open addressing
+    /// hash table. The points are copied and sorted by cell, so that the
+    /// points of a cell are contiguous in memory. Build runs in O(n) and
+    /// reuses the memory of the previous build, which suits point sets
+    /// that move every step such as particles.
+    ///
+    /// Points with a non finite coordinate are never returned by queries.
+    /// Queries return indices in the array given to Build.
+    class IGNITION_VISIBLE SpatialHashGrid
+    {
+      /// \brief Constructor, creates an empty grid with a cell size of 1.
+      public: SpatialHashGrid();
+
+      /// \brief Constructor.
+      /// \param[in] _cellSize Length of the side of a cell. The grid is
+      /// fastest when the cells are about the size of the query radius.
+      public: explicit SpatialHashGrid(const double _cellSize);
+
+      /// \brief Copy constructor.
+      /// \param[in] _grid Grid to copy.
+      public: SpatialHashGrid(const SpatialHashGrid &_grid);
+
+      /// \brief Destructor.
+      public: ~SpatialHashGrid();
+
+      /// \brief Assignment operator.
+      /// \param[in] _grid Grid to copy.
+      /// \return Reference to this object.
+      public: SpatialHashGrid &operator=(const SpatialHashGrid &_grid);
+
+      /// \brief Set the cell size. The grid is emptied, call Build again.
+      /// \param[in] _cellSize Length of the side of a cell, positive and
+      /// finite.
+      /// \return False if _cellSize is invalid, in which case nothing is
+      /// changed.
+      public: bool SetCellSize(const double _cellSize);
+
+      /// \brief Get the cell size.
+      /// \return Length of the side of a cell.
+      public: double CellSize() const;
+
+      /// \brief Replace the points of the grid.
+      /// \param[in] _points Array of points.
+      /// \param[in] _count Number of points.
+      public: void Build(const Vector3d *_points, const size_t _count);
+
+      /// \brief Replace the points of the grid.
+      /// \param[in] _points Points.
+      public: void Build(const std::vector<Vector3d> &_points);
+
+      /// \brief Remove all points.
+      public: void Clear();
+
+      /// \brief Get the number of points given to Build.
+      /// \return Number of points.
+      public: size_t Size() const;
+
+      /// \brief Get the number of cells which hold at least one point.
+      /// \return Number of cells.
+      public: size_t CellCount() const;
+
+      /// \brief Find the points within a distance of a location. No point
+      /// is found around a non finite center.
+      /// \param[in] _center Center of the query.
+      /// \param[in] _radius Maximum distance to _center, inclusive.
+      /// \param[out] _indices Indices of the points, in no particular
+      /// order.
+      /// \return Number of points found.
+      public: size_t Radius(const Vector3d &_center, const double _radius,
+                            std::vector<size_t> &_indices) const;
+
+      /// \brief Find the points closest to a location.
+      /// \param[in] _point Location of the query.
+      /// \param[in] _k Number of points to find.
+      /// \param[out] _indices Indices of the min(_k, Size()) closest points,
+      /// sorted by increasing distance.
+      /// \return Number of points found.
+      public: size_t Nearest(const Vector3d &_point, const size_t _k,
+                             std::vector<size_t> &_indices) const;
+
+      /// \brief Find the points closest to a location.
+      /// \param[in] _point Location of the query.
+      /// \param[in] _k Number of points to find.
+      /// \param[out] _indices Indices of the min(_k, Size()) closest points,
+      /// sorted by increasing distance.
+      /// \param[out] _distances Distance of each point to _point.
+      /// \return Number of points found.
+      public: size_t Nearest(const Vector3d &_point, const size_t _k,
+                             std::vector<size_t> &_indices,
+                             std::vector<double> &_distances) const;
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<SpatialHashGridPrivate> dataPtr;
+    };
+  }
+}
+#endif
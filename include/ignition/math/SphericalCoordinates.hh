@@ -21,6 +21,7 @@
 #include <string>
 
 #include <ignition/math/Angle.hh>
+#include <ignition/math/Matrix3.hh>
 #include <ignition/math/Vector3.hh>
 #include <ignition/math/Helpers.hh>
 
@@ -60,6 +61,96 @@ namespace ignition
                 LOCAL = 4
               };
 
+      /// \class PositionConverter SphericalCoordinates.hh
+      /// ignition/math/SphericalCoordinates.hh
+      /// \brief Converts positions between a fixed pair of frames.
+      /// The transforms for the pair are precomputed when the converter is
+      /// created: conversions between ECEF, GLOBAL and LOCAL frames are a
+      /// single fused rotation and offset, and conversions from or to
+      /// SPHERICAL need one geodetic step. Results match
+      /// SphericalCoordinates::PositionTransform up to rounding.
+      /// The converter keeps a copy of the reference parameters, so it
+      /// must be recreated after the SphericalCoordinates it was built
+      /// from is modified.
+      public: class IGNITION_VISIBLE PositionConverter
+      {
+        /// \brief Constructor, for an ECEF to ECEF converter.
+        public: PositionConverter();
+
+        /// \brief Constructor.
+        /// \param[in] _sc Spherical coordinates giving the reference.
+        /// \param[in] _in CoordinateType for input.
+        /// \param[in] _out CoordinateType for output.
+        public: PositionConverter(const SphericalCoordinates &_sc,
+                    const CoordinateType _in, const CoordinateType _out);
+
+        /// \brief Get whether both coordinate types are valid. An invalid
+        /// converter returns its input unchanged.
+        /// \return True if the converter is valid.
+        public: bool Valid() const;
+
+        /// \brief Get the input coordinate type.
+        /// \return CoordinateType for input.
+        public: CoordinateType In() const;
+
+        /// \brief Get the output coordinate type.
+        /// \return CoordinateType for output.
+        public: CoordinateType Out() const;
+
+        /// \brief Convert a position.
+        /// \param[in] _pos Position in the input frame.
+        /// \return Position in the output frame.
+        public: Vector3d Convert(const Vector3d &_pos) const;
+
+        /// \brief Convert an array of positions.
+        /// \param[in] _pos Positions in the input frame.
+        /// \param[out] _result Positions in the output frame. May be the
+        /// same array as _pos.
+        /// \param[in] _n Number of positions.
+        public: void Convert(const Vector3d *_pos, Vector3d *_result,
+                             const size_t _n) const;
+
+        /// \brief CoordinateType for input.
+        private: CoordinateType in;
+
+        /// \brief CoordinateType for output.
+        private: CoordinateType out;
+
+        /// \brief True if both coordinate types are valid.
+        private: bool valid;
+
+        /// \brief Rotation from the input frame to ECEF.
+        private: Matrix3d inRot;
+
+        /// \brief Offset from the input frame to ECEF.
+        private: Vector3d inOffset;
+
+        /// \brief Rotation from ECEF to the output frame.
+        private: Matrix3d outRot;
+
+        /// \brief Offset from ECEF to the output frame.
+        private: Vector3d outOffset;
+
+        /// \brief Fused rotation from the input to the output frame, used
+        /// when neither frame is SPHERICAL.
+        private: Matrix3d rot;
+
+        /// \brief Fused offset from the input to the output frame.
+        private: Vector3d offset;
+
+        /// \brief Semi-major axis ellipse parameter.
+        private: double ellA;
+
+        /// \brief Semi-minor axis ellipse parameter.
+        private: double ellB;
+
+        /// \brief First eccentricity ellipse parameter.
+        private: double ellE;
+
+        /// \brief Second eccentricity ellipse parameter.
+        private: double ellP;
+      };
+
       /// \brief Constructor.
       public: SphericalCoordinates();
 
@@ -120,6 +211,60 @@ namespace ignition
                                      const ignition::math::Angle &_latB,
                                      const ignition::math::Angle &_lonB);
 
+      /// \brief Get the distances from one point to many points, using the
+      /// same spherical model as Distance(). All angles are in radians.
+      /// \param[in] _latA Latitude of point A.
+      /// \param[in] _lonA Longitude of point A.
+      /// \param[in] _latB Latitudes of the other points.
+      /// \param[in] _lonB Longitudes of the other points.
+      /// \param[out] _dist Distances in meters.
+      /// \param[in] _n Number of points in _latB, _lonB and _dist.
+      public: static void Distance(const ignition::math::Angle &_latA,
+                                   const ignition::math::Angle &_lonA,
+                                   const double *_latB, const double *_lonB,
+                                   double *_dist, const size_t _n);
+
+      /// \brief Get the distances between pairs of points, using the same
+      /// spherical model as Distance(). All angles are in radians.
+      /// \param[in] _latA Latitudes of the first points.
+      /// \param[in] _lonA Longitudes of the first points.
+      /// \param[in] _latB Latitudes of the second points.
+      /// \param[in] _lonB Longitudes of the second points.
+      /// \param[out] _dist Distance in meters between points A[i] and B[i].
+      /// \param[in] _n Number of pairs.
+      public: static void Distance(const double *_latA, const double *_lonA,
+                                   const double *_latB, const double *_lonB,
+                                   double *_dist, const size_t _n);
+
+      /// \brief Get the distance between two points at zero altitude on
+      /// the reference ellipsoid of the current surface, using Vincenty's
+      /// inverse formula. This is accurate to within a millimeter, while
+      /// Distance() uses a sphere and can be off by about 0.5%.
+      /// \param[in] _latA Latitude of point A.
+      /// \param[in] _lonA Longitude of point A.
+      /// \param[in] _latB Latitude of point B.
+      /// \param[in] _lonB Longitude of point B.
+      /// \return Distance in meters, or NaN if the iteration does not
+      /// converge, which can happen for nearly antipodal points.
+      public: double DistanceVincenty(const ignition::math::Angle &_latA,
+                                      const ignition::math::Angle &_lonA,
+                                      const ignition::math::Angle &_latB,
+                                      const ignition::math::Angle &_lonB)
+                                      const;
+
+      /// \brief Get the ellipsoidal distances between pairs of points,
+      /// as computed by DistanceVincenty(). All angles are in radians.
+      /// \param[in] _latA Latitudes of the first points.
+      /// \param[in] _lonA Longitudes of the first points.
+      /// \param[in] _latB Latitudes of the second points.
+      /// \param[in] _lonB Longitudes of the second points.
+      /// \param[out] _dist Distance in meters between points A[i] and B[i],
+      /// or NaN where the iteration does not converge.
+      /// \param[in] _n Number of pairs.
+      public: void DistanceVincenty(const double *_latA, const double *_lonA,
+                                    const double *_latB, const double *_lonB,
+                                    double *_dist, const size_t _n) const;
+
       /// \brief Get SurfaceType currently in use.
       /// \return Current SurfaceType value.
       public: SurfaceType Surface() const;
@@ -187,6 +332,19 @@ namespace ignition
               PositionTransform(const ignition::math::Vector3d &_pos,
                   const CoordinateType &_in, const CoordinateType &_out) const;
 
+      /// \brief Convert an array of positions between SPHERICAL/ECEF/LOCAL/
+      /// GLOBAL frames. The frame dispatch and cached transforms are
+      /// resolved once for the whole array, using a PositionConverter.
+      /// \param[in] _pos Positions in frame defined by parameter _in
+      /// \param[out] _result Transformed positions. May be the same array
+      /// as _pos.
+      /// \param[in] _n Number of positions
+      /// \param[in] _in  CoordinateType for input
+      /// \param[in] _out CoordinateType for output
+      public: void PositionTransform(const ignition::math::Vector3d *_pos,
+                  ignition::math::Vector3d *_result, const size_t _n,
+                  const CoordinateType &_in, const CoordinateType &_out) const;
+
       /// \brief Convert between velocity in SPHERICAL/ECEF/LOCAL/GLOBAL frame
       /// \param[in] _vel Velocity vector in frame defined by parameter _in
       /// \param[in] _in  CoordinateType for input
@@ -196,6 +354,20 @@ namespace ignition
                   const ignition::math::Vector3d &_vel,
                   const CoordinateType &_in, const CoordinateType &_out) const;
 
+      /// \brief Convert an array of velocities between ECEF/LOCAL/GLOBAL
+      /// frames. Each result is the same as with
+      /// VelocityTransform(const Vector3d &, ...), computed with a single
+      /// rotation matrix for the whole array.
+      /// \param[in] _vel Velocities in frame defined by parameter _in
+      /// \param[out] _result Transformed velocities. May be the same array
+      /// as _vel.
+      /// \param[in] _n Number of velocities
+      /// \param[in] _in  CoordinateType for input
+      /// \param[in] _out CoordinateType for output
+      public: void VelocityTransform(const ignition::math::Vector3d *_vel,
+                  ignition::math::Vector3d *_result, const size_t _n,
+                  const CoordinateType &_in, const CoordinateType &_out) const;
+
       /// \brief Equality operator, result = this == _sc
       /// \param[in] _sc Spherical coordinates to check for equality
       /// \return true if this == _sc
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_SWEEPANDPRUNE_HH_
+#define IGNITION_MATH_SWEEPANDPRUNE_HH_
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <ignition/math/Box.hh>
+#include <ignition/math/Helpers.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Forward declare private data
+    class SweepAndPrunePrivate;
+
+    /// \class SweepAndPrune SweepAndPrune.hh ignition/math/SweepAndPrune.hh
+    /// \brief A sort and sweep collision broad phase, which finds the
+    /// overlapping pairs of an array of boxes that moves from one step to
+    /// the next.
+    ///
+    /// The boxes are kept sorted by their minimum along a sweep axis
+    /// between calls to Update. When the boxes move little, the order
+    /// changes little and an insertion sort restores it in close to O(n);
+    /// after large motions it falls back to a full sort. The sweep then
+    /// only tests the boxes whose extents overlap along the sweep axis.
+    /// The sweep axis can be fixed, or chosen at each update as the axis
+    /// along which the centers of the boxes spread the most.
+    ///
+    /// Boxes which touch overlap, as in Box::Intersects. Boxes with a NaN
+    /// coordinate never overlap. Update reuses its memory, and that of
+    /// the output vector, from one call to the next.
+    class IGNITION_VISIBLE SweepAndPrune
+    {
+      /// \enum SweepAxis
+      /// \brief Axis along which the boxes are sorted.
+      public: enum SweepAxis
+      {
+        /// \brief X axis.
+        SWEEP_X = 0,
+
+        /// \brief Y axis.
+        SWEEP_Y = 1,
+
+        /// \brief Z axis.
+        SWEEP_Z = 2,
+
+        /// \brief Axis of largest variance of the centers of the boxes.
+        SWEEP_AUTO = 3
+      };
+
+      /// \brief Constructor, with the SWEEP_AUTO axis.
+      public: SweepAndPrune();
+
+      /// \brief Constructor.
+      /// \param[in] _axis Sweep axis.
+      public: explicit SweepAndPrune(const SweepAxis _axis);
+
+      /// \brief Copy constructor.
+      /// \param[in] _sap Object to copy.
+      public: SweepAndPrune(const SweepAndPrune &_sap);
+
+      /// \brief Destructor.
+      public: ~SweepAndPrune();
+
+      /// \brief Assignment operator.
+      /// \param[in] _sap Object to copy.
+      /// \return Reference to this object.
+      public: SweepAndPrune &operator=(const SweepAndPrune &_sap);
+
+      /// \brief Set the sweep axis.
+      /// \param[in] _axis Sweep axis.
+      public: void SetAxis(const SweepAxis _axis);
+
+      /// \brief Get the sweep axis.
+      /// \return Sweep axis, possibly SWEEP_AUTO.
+      public: SweepAxis Axis() const;
+
+      /// \brief Get the axis used by the last update.
+      /// \return SWEEP_X, SWEEP_Y or SWEEP_Z.
+      public: SweepAxis CurrentAxis() const;
+
+      /// \brief Find the overlapping pairs of boxes. Call it with the boxes
+      /// of each step, in the same order.
+      /// \param[in] _boxes Array of boxes.
+      /// \param[in] _count Number of boxes. A count different from that of
+      /// the previous update sorts the boxes from scratch.
+      /// \param[out] _pairs Pairs of indices in _boxes, with the lower
+      /// index first, in no particular order. The vector is cleared
+      /// first.
+      /// \return Number of pairs found.
+      public: size_t Update(const Box *_boxes, const size_t _count,
+                  std::vector<std::pair<size_t, size_t>> &_pairs);
+
+      /// \brief Find the overlapping pairs of boxes. Call it with the boxes
+      /// of each step, in the same order.
+      /// \param[in] _boxes Boxes.
+      /// \param[out] _pairs Pairs of indices in _boxes, with the lower
+      /// index first, in no particular order. The vector is cleared
+      /// first.
+      /// \return Number of pairs found.
+      public: size_t Update(const std::vector<Box> &_boxes,
+                  std::vector<std::pair<size_t, size_t>> &_pairs);
+
+      /// \brief Forget the boxes of the previous update, so that the next
+      /// one sorts from scratch.
+      public: void Clear();
+
+      /// \brief Get the number of boxes of the last update.
+      /// \return Number of boxes.
+      public: size_t Size() const;
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<SweepAndPrunePrivate> dataPtr;
+    };
+  }
+}
+#endif
@@ -730,6 +730,32 @@ namespace ignition
         return _in;
       }
 
+      /// \brief Parse a vector from text in the format written by
+      /// operator<<, three numbers separated by white spaces or commas.
+      /// This does not allocate and does not depend on the locale.
+      /// \param[in,out] _pos Start of the text. On success it is moved
+      /// past the vector, on failure it points to the invalid token, or to
+      /// _end if the text ran out.
+      /// \param[in] _end End of the text.
+      /// \param[out] _pt Parsed vector, not modified on failure.
+      /// \return True on success.
+      /// \sa parseFloats
+      public: static bool Parse(const char *&_pos, const char *_end,
+                                Vector3<T> &_pt)
+      {
+        double v[3];
+        const char *p = _pos;
+        if (parseFloats(p, _end, v, 3) != 3)
+        {
+          _pos = p;
+          return false;
+        }
+        _pt.Set(static_cast<T>(v[0]), static_cast<T>(v[1]),
+                static_cast<T>(v[2]));
+        _pos = p;
+        return true;
+      }
+
       /// \brief The x, y, and z values
       private: T data[3];
     };
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_VOXELGRID_HH_
+#define IGNITION_MATH_VOXELGRID_HH_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/Vector3.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Forward declare private data
+    class VoxelGridPrivate;
+
+    /// \class VoxelGrid VoxelGrid.hh ignition/math/VoxelGrid.hh
+    /// \brief Downsample a point cloud by keeping a single point in each
+    /// voxel of a uniform grid.
+    ///
+    /// The occupied voxels are found with an open addressing hash table,
+    /// so filtering runs in O(n). Output points are ordered by the first
+    /// input point of their voxel, which makes the result independent of
+    /// the layout of the table. Points with a non finite coordinate are
+    /// dropped. The output vector must not hold the input points.
+    class IGNITION_VISIBLE VoxelGrid
+    {
+      /// \enum ReductionType
+      /// \brief How the points of a voxel are reduced to one point.
+      public: enum ReductionType
+      {
+        /// \brief Average of the points of the voxel.
+        CENTROID = 0,
+
+        /// \brief First point of the voxel in the input order.
+        FIRST_POINT = 1
+      };
+
+      /// \brief Constructor, with a voxel size of 1 and CENTROID reduction.
+      public: VoxelGrid();
+
+      /// \brief Constructor.
+      /// \param[in] _voxelSize Length of the side of a voxel, positive and
+      /// finite. Invalid values leave the default of 1.
+      /// \param[in] _reduction How the points of a voxel are reduced.
+      public: explicit VoxelGrid(const double _voxelSize,
+                  const ReductionType _reduction = CENTROID);
+
+      /// \brief Copy constructor.
+      /// \param[in] _grid Voxel grid to copy.
+      public: VoxelGrid(const VoxelGrid &_grid);
+
+      /// \brief Destructor.
+      public: ~VoxelGrid();
+
+      /// \brief Assignment operator.
+      /// \param[in] _grid Voxel grid to copy.
+      /// \return Reference to this object.
+      public: VoxelGrid &operator=(const VoxelGrid &_grid);
+
+      /// \brief Set the voxel size.
+      /// \param[in] _voxelSize Length of the side of a voxel, positive and
+      /// finite.
+      /// \return False if _voxelSize is invalid, in which case nothing is
+      /// changed.
+      public: bool SetVoxelSize(const double _voxelSize);
+
+      /// \brief Get the voxel size.
+      /// \return Length of the side of a voxel.
+      public: double VoxelSize() const;
+
+      /// \brief Set how the points of a voxel are reduced.
+      /// \param[in] _reduction Reduction type.
+      public: void SetReduction(const ReductionType _reduction);
+
+      /// \brief Get how the points of a voxel are reduced.
+      /// \return Reduction type.
+      public: ReductionType Reduction() const;
+
+      /// \brief Downsample points.
+      /// \param[in] _points Array of points.
+      /// \param[in] _count Number of points.
+      /// \param[out] _output One point per occupied voxel.
+      /// \return Number of output points.
+      public: size_t Filter(const Vector3d *_points, const size_t _count,
+                            std::vector<Vector3d> &_output) const;
+
+      /// \brief Downsample points, and tell which output point stands for
+      /// each input point.
+      /// \param[in] _points Array of points.
+      /// \param[in] _count Number of points.
+      /// \param[out] _output One point per occupied voxel.
+      /// \param[out] _voxels Index in _output of the voxel of each input
+      /// point, or _output.size() for points with a non finite coordinate.
+      /// \return Number of output points.
+      public: size_t Filter(const Vector3d *_points, const size_t _count,
+                            std::vector<Vector3d> &_output,
+                            std::vector<size_t> &_voxels) const;
+
+      /// \brief Downsample points.
+      /// \param[in] _points Array of points.
+      /// \param[in] _count Number of points.
+      /// \param[out] _output One point per occupied voxel.
+      /// \return Number of output points.
+      public: size_t Filter(const Vector3f *_points, const size_t _count,
+                            std::vector<Vector3f> &_output) const;
+
+      /// \brief Downsample points, and tell which output point stands for
+      /// each input point.
+      /// \param[in] _points Array of points.
+      /// \param[in] _count Number of points.
+      /// \param[out] _output One point per occupied voxel.
+      /// \param[out] _voxels Index in _output of the voxel of each input
+      /// point, or _output.size() for points with a non finite coordinate.
+      /// \return Number of output points.
+      public: size_t Filter(const Vector3f *_points, const size_t _count,
+                            std::vector<Vector3f> &_output,
+                            std::vector<size_t> &_voxels) const;
+
+      /// \brief Private data pointer.
+      private: std::unique_ptr<VoxelGridPrivate> dataPtr;
+    };
+  }
+}
+#endif
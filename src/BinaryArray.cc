@@ -0,0 +1,563 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "ignition/math/BinaryArray.hh"
+
+namespace
+{
+  /// \brief Magic string at the start of every file.
+  const char kMagic[8] = {'I', 'G', 'N', 'A', 'R', 'R', 'A', 'Y'};
+
+  /// \brief Byte order mark, as written on the machine of the writer.
+  const uint32_t kByteOrderMark = 0x01020304u;
+
+  /// \brief Current format version.
+  const uint32_t kVersion = 1;
+
+  /// \brief Size of the header in bytes. A multiple of 8 so that the
+  /// doubles of a memory mapped file are aligned.
+  const size_t kHeaderSize = 32;
+
+  /// \brief File header.
+  struct Header
+  {
+    /// \brief Magic string, kMagic.
+    char magic[8];
+
+    /// \brief Byte order mark, kByteOrderMark in the writer's byte order.
+    uint32_t byteOrder;
+
+    /// \brief Format version.
+    uint32_t version;
+
+    /// \brief BinaryArrayType of the elements.
+    uint32_t type;
+
+    /// \brief Size of an element in bytes.
+    uint32_t elementSize;
+
+    /// \brief Reserved for future versions, zero.
+    uint64_t reserved;
+  };
+  static_assert(sizeof(Header) == kHeaderSize, "Unexpected header size");
+
+  /// \brief Number of doubles of an element.
+  /// \param[in] _type Element type.
+  /// \return Number of doubles, 0 for an invalid type.
+  size_t doublesPerElement(const uint32_t _type)
+  {
+    switch (_type)
+    {
+      case ignition::math::BINARY_ARRAY_VECTOR3D:
+        return 3;
+      case ignition::math::BINARY_ARRAY_QUATERNIOND:
+        return 4;
+      case ignition::math::BINARY_ARRAY_POSE3D:
+        return 7;
+      default:
+        return 0;
+    }
+  }
+
+  /// \brief Reverse the bytes of a 32 bit value.
+  /// \param[in] _v Value.
+  /// \return Value with the other byte order.
+  uint32_t swap32(const uint32_t _v)
+  {
+    return ((_v & 0xFF) << 24) | ((_v & 0xFF00) << 8) |
+           ((_v >> 8) & 0xFF00) | (_v >> 24);
+  }
+
+  /// \brief Reverse the bytes of 64 bit values in place.
+  /// \param[in,out] _data Values.
+  /// \param[in] _n Number of values.
+  void swap64(double *_data, const size_t _n)
+  {
+    for (size_t i = 0; i < _n; ++i)
+    {
+      unsigned char *b = reinterpret_cast<unsigned char *>(_data + i);
+      for (int j = 0; j < 4; ++j)
+        std::swap(b[j], b[7 - j]);
+    }
+  }
+
+  /// \brief Check a header and convert it to the host byte order.
+  /// \param[in,out] _header Header read from a file.
+  /// \param[out] _swapped True if the file has the other byte order.
+  /// \return True if the header is valid and supported.
+  bool checkHeader(Header &_header, bool &_swapped)
+  {
+    if (std::memcmp(_header.magic, kMagic, sizeof(kMagic)) != 0)
+      return false;
+
+    if (_header.byteOrder == kByteOrderMark)
+    {
+      _swapped = false;
+    }
+    else if (swap32(_header.byteOrder) == kByteOrderMark)
+    {
+      _swapped = true;
+      _header.version = swap32(_header.version);
+      _header.type = swap32(_header.type);
+      _header.elementSize = swap32(_header.elementSize);
+    }
+    else
+    {
+      return false;
+    }
+
+    const size_t doubles = doublesPerElement(_header.type);
+    return _header.version >= 1 && _header.version <= kVersion &&
+           doubles > 0 && _header.elementSize == doubles * sizeof(double);
+  }
+}
+
+/// \brief Private data for the BinaryArrayWriter class.
+class ignition::math::BinaryArrayWriterPrivate
+{
+  /// \brief Open file, nullptr if closed.
+  public: std::FILE *file = nullptr;
+
+  /// \brief Element type.
+  public: BinaryArrayType type = BINARY_ARRAY_INVALID;
+
+  /// \brief Number of elements in the file.
+  public: uint64_t count = 0;
+
+  /// \brief Staging buffer used to convert math types to doubles.
+  public: std::vector<double> buffer;
+};
+
+/// \brief Private data for the BinaryArrayReader class.
+class ignition::math::BinaryArrayReaderPrivate
+{
+  /// \brief Start of the memory mapping, nullptr if not mapped.
+  public: void *mapping = nullptr;
+
+  /// \brief Size of the memory mapping in bytes.
+  public: size_t mappingSize = 0;
+
+  /// \brief Elements copied in memory, when the file is not mapped.
+  public: std::vector<double> copy;
+
+  /// \brief First double of the elements.
+  public: const double *data = nullptr;
+
+  /// \brief Number of elements.
+  public: size_t count = 0;
+
+  /// \brief Element type.
+  public: BinaryArrayType type = BINARY_ARRAY_INVALID;
+
+  /// \brief Format version.
+  public: uint32_t version = 0;
+
+  /// \brief True if a file is open.
+  public: bool open = false;
+};
+
+using namespace ignition;
+using namespace math;
+
+/////////////////////////////////////////////////
+BinaryArrayWriter::BinaryArrayWriter()
+: dataPtr(new BinaryArrayWriterPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+BinaryArrayWriter::~BinaryArrayWriter()
+{
+  this->Close();
+}
+
+/////////////////////////////////////////////////
+bool BinaryArrayWriter::Open(const std::string &_path,
+    const BinaryArrayType _type, const bool _append)
+{
+  this->Close();
+
+  const size_t doubles = doublesPerElement(_type);
+  if (doubles == 0)
+    return false;
+  const uint32_t elementSize =
+    static_cast<uint32_t>(doubles * sizeof(double));
+
+  std::FILE *file = _append ? std::fopen(_path.c_str(), "r+b") : nullptr;
+  uint64_t count = 0;
+  if (file)
+  {
+    // Check that the existing file can be extended
+    Header header;
+    bool swapped = false;
+    if (std::fread(&header, sizeof(header), 1, file) != 1 ||
+        !checkHeader(header, swapped) || swapped ||
+        header.version != kVersion ||
+        header.type != static_cast<uint32_t>(_type) ||
+        std::fseek(file, 0, SEEK_END) != 0)
+    {
+      std::fclose(file);
+      return false;
+    }
+
+    // Drop a partially written last element
+    const long size = std::ftell(file);
+    if (size < static_cast<long>(kHeaderSize))
+    {
+      std::fclose(file);
+      return false;
+    }
+    count = (static_cast<uint64_t>(size) - kHeaderSize) / elementSize;
+    if (std::fseek(file, static_cast<long>(kHeaderSize + count * elementSize),
+          SEEK_SET) != 0)
+    {
+      std::fclose(file);
+      return false;
+    }
+  }
+  else
+  {
+    file = std::fopen(_path.c_str(), "wb");
+    if (!file)
+      return false;
+
+    Header header;
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.byteOrder = kByteOrderMark;
+    header.version = kVersion;
+    header.type = static_cast<uint32_t>(_type);
+    header.elementSize = elementSize;
+    header.reserved = 0;
+    if (std::fwrite(&header, sizeof(header), 1, file) != 1)
+    {
+      std::fclose(file);
+      return false;
+    }
+  }
+
+  this->dataPtr->file = file;
+  this->dataPtr->type = _type;
+  this->dataPtr->count = count;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool BinaryArrayWriter::IsOpen() const
+{
+  return this->dataPtr->file != nullptr;
+}
+
+/////////////////////////////////////////////////
+void BinaryArrayWriter::Close()
+{
+  if (this->dataPtr->file)
+    std::fclose(this->dataPtr->file);
+
+  this->dataPtr->file = nullptr;
+  this->dataPtr->type = BINARY_ARRAY_INVALID;
+  this->dataPtr->count = 0;
+}
+
+/////////////////////////////////////////////////
+bool BinaryArrayWriter::Flush()
+{
+  return this->dataPtr->file && std::fflush(this->dataPtr->file) == 0;
+}
+
+/////////////////////////////////////////////////
+BinaryArrayType BinaryArrayWriter::Type() const
+{
+  return this->dataPtr->type;
+}
+
+/////////////////////////////////////////////////
+uint64_t BinaryArrayWriter::Count() const
+{
+  return this->dataPtr->count;
+}
+
+/////////////////////////////////////////////////
+bool BinaryArrayWriter::Write(const Vector3d *_v, const size_t _n)
+{
+  if (this->dataPtr->type != BINARY_ARRAY_VECTOR3D)
+    return false;
+
+  std::vector<double> &buffer = this->dataPtr->buffer;
+  buffer.resize(3 * _n);
+  for (size_t i = 0; i < _n; ++i)
+  {
+    buffer[3*i] = _v[i].X();
+    buffer[3*i+1] = _v[i].Y();
+    buffer[3*i+2] = _v[i].Z();
+  }
+  return this->WriteRaw(buffer.data(), _n);
+}
+
+/////////////////////////////////////////////////
+bool BinaryArrayWriter::Write(const Quaterniond *_q, const size_t _n)
+{
+  if (this->dataPtr->type != BINARY_ARRAY_QUATERNIOND)
+    return false;
+
+  std::vector<double> &buffer = this->dataPtr->buffer;
+  buffer.resize(4 * _n);
+  for (size_t i = 0; i < _n; ++i)
+  {
+    buffer[4*i] = _q[i].W();
+    buffer[4*i+1] = _q[i].X();
+    buffer[4*i+2] = _q[i].Y();
+    buffer[4*i+3] = _q[i].Z();
+  }
+  return this->WriteRaw(buffer.data(), _n);
+}
+
+/////////////////////////////////////////////////
+bool BinaryArrayWriter::Write(const Pose3d *_p, const size_t _n)
+{
+  if (this->dataPtr->type != BINARY_ARRAY_POSE3D)
+    return false;
+
+  std::vector<double> &buffer = this->dataPtr->buffer;
+  buffer.resize(7 * _n);
+  for (size_t i = 0; i < _n; ++i)
+  {
+    const Vector3d &pos = _p[i].Pos();
+    const Quaterniond &rot = _p[i].Rot();
+    buffer[7*i] = pos.X();
+    buffer[7*i+1] = pos.Y();
+    buffer[7*i+2] = pos.Z();
+    buffer[7*i+3] = rot.W();
+    buffer[7*i+4] = rot.X();
+    buffer[7*i+5] = rot.Y();
+    buffer[7*i+6] = rot.Z();
+  }
+  return this->WriteRaw(buffer.data(), _n);
+}
+
+/////////////////////////////////////////////////
+bool BinaryArrayWriter::WriteRaw(const double *_data, const size_t _n)
+{
+  if (!this->dataPtr->file)
+    return false;
+  if (_n == 0)
+    return true;
+
+  const size_t doubles = doublesPerElement(this->dataPtr->type) * _n;
+  const size_t written =
+    std::fwrite(_data, sizeof(double), doubles, this->dataPtr->file);
+
+  // Only complete elements count, a partial one is dropped on append
+  this->dataPtr->count += written / doublesPerElement(this->dataPtr->type);
+  return written == doubles;
+}
+
+/////////////////////////////////////////////////
+BinaryArrayReader::BinaryArrayReader()
+: dataPtr(new BinaryArrayReaderPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+BinaryArrayReader::~BinaryArrayReader()
+{
+  this->Close();
+}
+
+/////////////////////////////////////////////////
+bool BinaryArrayReader::Open(const std::string &_path)
+{
+  this->Close();
+
+  Header header;
+  bool swapped = false;
+  size_t fileSize = 0;
+
+#ifndef _WIN32
+  const int fd = ::open(_path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(kHeaderSize) ||
+      ::pread(fd, &header, sizeof(header), 0) !=
+        static_cast<ssize_t>(sizeof(header)) ||
+      !checkHeader(header, swapped))
+  {
+    ::close(fd);
+    return false;
+  }
+  fileSize = static_cast<size_t>(st.st_size);
+
+  const size_t elementSize = header.elementSize;
+  const size_t count = (fileSize - kHeaderSize) / elementSize;
+  const size_t doubles = count * doublesPerElement(header.type);
+
+  if (!swapped)
+  {
+    void *mapping = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+      return false;
+
+    this->dataPtr->mapping = mapping;
+    this->dataPtr->mappingSize = fileSize;
+    this->dataPtr->data = count > 0 ? reinterpret_cast<const double *>(
+        static_cast<const char *>(mapping) + kHeaderSize) : nullptr;
+  }
+  else
+  {
+    this->dataPtr->copy.resize(doubles);
+    const ssize_t bytes = static_cast<ssize_t>(doubles * sizeof(double));
+    const ssize_t got = doubles > 0 ? ::pread(fd, this->dataPtr->copy.data(),
+        static_cast<size_t>(bytes), kHeaderSize) : 0;
+    ::close(fd);
+    if (got != bytes)
+    {
+      this->Close();
+      return false;
+    }
+    swap64(this->dataPtr->copy.data(), doubles);
+    this->dataPtr->data = count > 0 ? this->dataPtr->copy.data() : nullptr;
+  }
+#else
+  std::FILE *file = std::fopen(_path.c_str(), "rb");
+  if (!file)
+    return false;
+
+  if (std::fread(&header, sizeof(header), 1, file) != 1 ||
+      !checkHeader(header, swapped) || std::fseek(file, 0, SEEK_END) != 0)
+  {
+    std::fclose(file);
+    return false;
+  }
+  fileSize = static_cast<size_t>(std::ftell(file));
+
+  const size_t elementSize = header.elementSize;
+  const size_t count = (fileSize - kHeaderSize) / elementSize;
+  const size_t doubles = count * doublesPerElement(header.type);
+
+  this->dataPtr->copy.resize(doubles);
+  if (std::fseek(file, static_cast<long>(kHeaderSize), SEEK_SET) != 0 ||
+      std::fread(this->dataPtr->copy.data(), sizeof(double), doubles, file) !=
+        doubles)
+  {
+    std::fclose(file);
+    this->Close();
+    return false;
+  }
+  std::fclose(file);
+
+  if (swapped)
+    swap64(this->dataPtr->copy.data(), doubles);
+  this->dataPtr->data = count > 0 ? this->dataPtr->copy.data() : nullptr;
+#endif
+
+  this->dataPtr->count = count;
+  this->dataPtr->type = static_cast<BinaryArrayType>(header.type);
+  this->dataPtr->version = header.version;
+  this->dataPtr->open = true;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool BinaryArrayReader::IsOpen() const
+{
+  return this->dataPtr->open;
+}
+
+/////////////////////////////////////////////////
+void BinaryArrayReader::Close()
+{
+#ifndef _WIN32
+  if (this->dataPtr->mapping)
+    ::munmap(this->dataPtr->mapping, this->dataPtr->mappingSize);
+#endif
+  this->dataPtr->mapping = nullptr;
+  this->dataPtr->mappingSize = 0;
+  this->dataPtr->copy.clear();
+  this->dataPtr->copy.shrink_to_fit();
+  this->dataPtr->data = nullptr;
+  this->dataPtr->count = 0;
+  this->dataPtr->type = BINARY_ARRAY_INVALID;
+  this->dataPtr->version = 0;
+  this->dataPtr->open = false;
+}
+
+/////////////////////////////////////////////////
+bool BinaryArrayReader::IsMapped() const
+{
+  return this->dataPtr->mapping != nullptr;
+}
+
+/////////////////////////////////////////////////
+uint32_t BinaryArrayReader::Version() const
+{
+  return this->dataPtr->version;
+}
+
+/////////////////////////////////////////////////
+BinaryArrayType BinaryArrayReader::Type() const
+{
+  return this->dataPtr->type;
+}
+
+/////////////////////////////////////////////////
+size_t BinaryArrayReader::Count() const
+{
+  return this->dataPtr->count;
+}
+
+/////////////////////////////////////////////////
+const double *BinaryArrayReader::Data() const
+{
+  return this->dataPtr->data;
+}
+
+/////////////////////////////////////////////////
+Vector3dSpan BinaryArrayReader::Vector3ds() const
+{
+  if (this->dataPtr->type != BINARY_ARRAY_VECTOR3D)
+    return Vector3dSpan();
+  return Vector3dSpan(this->dataPtr->data, this->dataPtr->count);
+}
+
+/////////////////////////////////////////////////
+QuaterniondSpan BinaryArrayReader::Quaternionds() const
+{
+  if (this->dataPtr->type != BINARY_ARRAY_QUATERNIOND)
+    return QuaterniondSpan();
+  return QuaterniondSpan(this->dataPtr->data, this->dataPtr->count);
+}
+
+/////////////////////////////////////////////////
+Pose3dSpan BinaryArrayReader::Pose3ds() const
+{
+  if (this->dataPtr->type != BINARY_ARRAY_POSE3D)
+    return Pose3dSpan();
+  return Pose3dSpan(this->dataPtr->data, this->dataPtr->count);
+}
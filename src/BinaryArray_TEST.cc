@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "ignition/math/BinaryArray.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+/// \brief Read a whole file.
+/// \param[in] _path Path of the file.
+/// \return Contents of the file.
+std::vector<char> ReadFile(const std::string &_path)
+{
+  std::vector<char> contents;
+  std::FILE *file = std::fopen(_path.c_str(), "rb");
+  if (!file)
+    return contents;
+  char buffer[4096];
+  size_t n;
+  while ((n = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+    contents.insert(contents.end(), buffer, buffer + n);
+  std::fclose(file);
+  return contents;
+}
+
+/////////////////////////////////////////////////
+/// \brief Write a whole file.
+/// \param[in] _path Path of the file.
+/// \param[in] _contents Contents of the file.
+void WriteFile(const std::string &_path, const std::vector<char> &_contents)
+{
+  std::FILE *file = std::fopen(_path.c_str(), "wb");
+  ASSERT_NE(nullptr, file);
+  std::fwrite(_contents.data(), 1, _contents.size(), file);
+  std::fclose(file);
+}
+
+/////////////////////////////////////////////////
+TEST(BinaryArrayTest, Poses)
+{
+  const std::string path = "BinaryArray_TEST_poses.bin";
+
+  std::vector<math::Pose3d> poses;
+  for (int i = 0; i < 100; ++i)
+    poses.push_back(math::Pose3d(i, -i * 0.5, 1e-3 * i, 0.01 * i, 0.2, -0.3));
+
+  math::BinaryArrayWriter writer;
+  EXPECT_FALSE(writer.IsOpen());
+  EXPECT_FALSE(writer.Write(poses.data(), 1));
+  ASSERT_TRUE(writer.Open(path, math::BINARY_ARRAY_POSE3D));
+  EXPECT_TRUE(writer.IsOpen());
+  EXPECT_EQ(math::BINARY_ARRAY_POSE3D, writer.Type());
+
+  // Wrong type
+  math::Vector3d v;
+  EXPECT_FALSE(writer.Write(&v));
+
+  // One sample at a time, then a block
+  for (int i = 0; i < 10; ++i)
+    EXPECT_TRUE(writer.Write(&poses[i]));
+  EXPECT_TRUE(writer.Write(poses.data() + 10, 90));
+  EXPECT_EQ(100u, writer.Count());
+  EXPECT_TRUE(writer.Flush());
+
+  // The file can be read while recording
+  math::BinaryArrayReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  EXPECT_EQ(100u, reader.Count());
+  writer.Close();
+  EXPECT_FALSE(writer.IsOpen());
+
+  ASSERT_TRUE(reader.Open(path));
+  EXPECT_TRUE(reader.IsOpen());
+#ifndef _WIN32
+  EXPECT_TRUE(reader.IsMapped());
+#endif
+  EXPECT_EQ(1u, reader.Version());
+  EXPECT_EQ(math::BINARY_ARRAY_POSE3D, reader.Type());
+  EXPECT_EQ(100u, reader.Count());
+  EXPECT_TRUE(reader.Vector3ds().Empty());
+  EXPECT_TRUE(reader.Quaternionds().Empty());
+
+  math::Pose3dSpan span = reader.Pose3ds();
+  ASSERT_EQ(100u, span.Size());
+  EXPECT_EQ(7u, math::Pose3dSpan::Stride());
+  EXPECT_EQ(reader.Data(), span.Data());
+  for (size_t i = 0; i < span.Size(); ++i)
+  {
+    EXPECT_EQ(poses[i].Pos(), span[i].Pos());
+    EXPECT_DOUBLE_EQ(poses[i].Rot().W(), span[i].Rot().W());
+    EXPECT_DOUBLE_EQ(poses[i].Rot().X(), span[i].Rot().X());
+    EXPECT_DOUBLE_EQ(poses[i].Rot().Y(), span[i].Rot().Y());
+    EXPECT_DOUBLE_EQ(poses[i].Rot().Z(), span[i].Rot().Z());
+  }
+
+  // Raw layout is x, y, z, qw, qx, qy, qz
+  EXPECT_DOUBLE_EQ(poses[3].Pos().Y(), reader.Data()[7*3+1]);
+  EXPECT_DOUBLE_EQ(poses[3].Rot().W(), reader.Data()[7*3+3]);
+
+  reader.Close();
+  EXPECT_FALSE(reader.IsOpen());
+  EXPECT_EQ(0u, reader.Count());
+  EXPECT_EQ(nullptr, reader.Data());
+  std::remove(path.c_str());
+}
+
+/////////////////////////////////////////////////
+TEST(BinaryArrayTest, Append)
+{
+  const std::string path = "BinaryArray_TEST_append.bin";
+
+  math::BinaryArrayWriter writer;
+  ASSERT_TRUE(writer.Open(path, math::BINARY_ARRAY_VECTOR3D, true));
+  const math::Vector3d a(1, 2, 3);
+  EXPECT_TRUE(writer.Write(&a));
+  writer.Close();
+
+  // Append to the existing file
+  ASSERT_TRUE(writer.Open(path, math::BINARY_ARRAY_VECTOR3D, true));
+  EXPECT_EQ(1u, writer.Count());
+  const math::Vector3d b[2] = {math::Vector3d(4, 5, 6),
+                               math::Vector3d(7, 8, 9)};
+  EXPECT_TRUE(writer.Write(b, 2));
+  EXPECT_EQ(3u, writer.Count());
+  writer.Close();
+
+  // Appending with another type fails
+  EXPECT_FALSE(writer.Open(path, math::BINARY_ARRAY_POSE3D, true));
+  EXPECT_FALSE(writer.Open(path, math::BINARY_ARRAY_INVALID));
+
+  // A partially written element is ignored, and dropped on append
+  std::vector<char> contents = ReadFile(path);
+  contents.resize(contents.size() + 5, 0);
+  WriteFile(path, contents);
+
+  math::BinaryArrayReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  EXPECT_EQ(3u, reader.Count());
+  math::Vector3dSpan span = reader.Vector3ds();
+  ASSERT_EQ(3u, span.Size());
+  EXPECT_EQ(a, span[0]);
+  EXPECT_EQ(b[0], span[1]);
+  EXPECT_EQ(b[1], span[2]);
+
+  ASSERT_TRUE(writer.Open(path, math::BINARY_ARRAY_VECTOR3D, true));
+  EXPECT_EQ(3u, writer.Count());
+  EXPECT_TRUE(writer.Write(&a));
+  writer.Close();
+  ASSERT_TRUE(reader.Open(path));
+  EXPECT_EQ(4u, reader.Count());
+  EXPECT_EQ(a, reader.Vector3ds()[3]);
+
+  reader.Close();
+  std::remove(path.c_str());
+}
+
+/////////////////////////////////////////////////
+TEST(BinaryArrayTest, Quaternions)
+{
+  const std::string path = "BinaryArray_TEST_quaternions.bin";
+
+  std::vector<math::Quaterniond> quats;
+  for (int i = 0; i < 16; ++i)
+    quats.push_back(math::Quaterniond(0.1 * i, -0.2, 0.05 * i));
+
+  {
+    math::BinaryArrayWriter writer;
+    ASSERT_TRUE(writer.Open(path, math::BINARY_ARRAY_QUATERNIOND));
+    EXPECT_TRUE(writer.Write(quats.data(), quats.size()));
+  }
+
+  math::BinaryArrayReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  math::QuaterniondSpan span = reader.Quaternionds();
+  ASSERT_EQ(quats.size(), span.Size());
+  for (size_t i = 0; i < quats.size(); ++i)
+    EXPECT_EQ(quats[i], span[i]);
+
+  // Byte swap the whole file to simulate a file from a machine with the
+  // other byte order. It is read into memory and converted.
+  std::vector<char> contents = ReadFile(path);
+  for (size_t i = 8; i < 24; i += 4)
+    std::reverse(contents.begin() + i, contents.begin() + i + 4);
+  for (size_t i = 32; i < contents.size(); i += 8)
+    std::reverse(contents.begin() + i, contents.begin() + i + 8);
+  WriteFile(path, contents);
+
+  ASSERT_TRUE(reader.Open(path));
+  EXPECT_FALSE(reader.IsMapped());
+  EXPECT_EQ(math::BINARY_ARRAY_QUATERNIOND, reader.Type());
+  span = reader.Quaternionds();
+  ASSERT_EQ(quats.size(), span.Size());
+  for (size_t i = 0; i < quats.size(); ++i)
+    EXPECT_EQ(quats[i], span[i]);
+
+  // Appending to a file with the other byte order is not supported
+  math::BinaryArrayWriter writer;
+  EXPECT_FALSE(writer.Open(path, math::BINARY_ARRAY_QUATERNIOND, true));
+
+  reader.Close();
+  std::remove(path.c_str());
+}
+
+/////////////////////////////////////////////////
+TEST(BinaryArrayTest, Invalid)
+{
+  const std::string path = "BinaryArray_TEST_invalid.bin";
+  math::BinaryArrayReader reader;
+
+  EXPECT_FALSE(reader.Open("/this/file/does/not/exist.bin"));
+  EXPECT_FALSE(reader.IsOpen());
+
+  {
+    math::BinaryArrayWriter writer;
+    ASSERT_TRUE(writer.Open(path, math::BINARY_ARRAY_VECTOR3D));
+  }
+  std::vector<char> valid = ReadFile(path);
+  ASSERT_EQ(32u, valid.size());
+
+  // Empty file
+  ASSERT_TRUE(reader.Open(path));
+  EXPECT_EQ(0u, reader.Count());
+  EXPECT_TRUE(reader.Vector3ds().Empty());
+  EXPECT_EQ(nullptr, reader.Data());
+
+  // Bad magic
+  std::vector<char> contents = valid;
+  contents[0] = 'X';
+  WriteFile(path, contents);
+  EXPECT_FALSE(reader.Open(path));
+
+  // Newer version
+  contents = valid;
+  uint32_t version = 2;
+  std::memcpy(&contents[12], &version, sizeof(version));
+  WriteFile(path, contents);
+  EXPECT_FALSE(reader.Open(path));
+
+  // Unknown type
+  contents = valid;
+  uint32_t type = 42;
+  std::memcpy(&contents[16], &type, sizeof(type));
+  WriteFile(path, contents);
+  EXPECT_FALSE(reader.Open(path));
+
+  // Truncated header
+  contents = valid;
+  contents.resize(20);
+  WriteFile(path, contents);
+  EXPECT_FALSE(reader.Open(path));
+
+  std::remove(path.c_str());
+}
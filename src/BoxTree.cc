@@ -0,0 +1,739 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "ignition/math/BoxTree.hh"
+
+using namespace ignition;
+using namespace math;
+
+namespace
+{
+  /// \brief Index of no node.
+  const size_t kNullNode = std::numeric_limits<size_t>::max();
+
+  /// \brief Bounds of a box, as plain values so that nodes stay small.
+  struct Bounds
+  {
+    /// \brief Minimum corner.
+    double min[3];
+
+    /// \brief Maximum corner.
+    double max[3];
+  };
+
+  /// \brief A node of the tree.
+  struct Node
+  {
+    /// \brief Fat box of a leaf, or union of the children's bounds.
+    Bounds bounds;
+
+    /// \brief Parent node, or next free node when the node is free.
+    size_t parent;
+
+    /// \brief First child, kNullNode for a leaf.
+    size_t child1;
+
+    /// \brief Second child, kNullNode for a leaf.
+    size_t child2;
+
+    /// \brief Height of the node, 0 for a leaf and -1 for a free node.
+    int height;
+  };
+
+  /// \brief Get the bounds of a box.
+  /// \param[in] _box Box.
+  /// \param[out] _bounds Bounds of _box.
+  /// \return False if _box has a non finite coordinate.
+  bool boundsOf(const Box &_box, Bounds &_bounds)
+  {
+    const Vector3d &min = _box.Min();
+    const Vector3d &max = _box.Max();
+    _bounds.min[0] = min.X();
+    _bounds.min[1] = min.Y();
+    _bounds.min[2] = min.Z();
+    _bounds.max[0] = max.X();
+    _bounds.max[1] = max.Y();
+    _bounds.max[2] = max.Z();
+    for (int i = 0; i < 3; ++i)
+    {
+      if (!std::isfinite(_bounds.min[i]) || !std::isfinite(_bounds.max[i]))
+        return false;
+    }
+    return true;
+  }
+
+  /// \brief Get the union of two bounds.
+  /// \param[in] _a First bounds.
+  /// \param[in] _b Second bounds.
+  /// \return Union of _a and _b.
+  Bounds merge(const Bounds &_a, const Bounds &_b)
+  {
+    Bounds result;
+    for (int i = 0; i < 3; ++i)
+    {
+      result.min[i] = std::min(_a.min[i], _b.min[i]);
+      result.max[i] = std::max(_a.max[i], _b.max[i]);
+    }
+    return result;
+  }
+
+  /// \brief Get half the surface area of bounds, the cost of a node.
+  /// \param[in] _a Bounds.
+  /// \return Half the surface area of _a.
+  double area(const Bounds &_a)
+  {
+    const double x = _a.max[0] - _a.min[0];
+    const double y = _a.max[1] - _a.min[1];
+    const double z = _a.max[2] - _a.min[2];
+    return x * y + y * z + z * x;
+  }
+
+  /// \brief Check if bounds contain other bounds.
+  /// \param[in] _a Outer bounds.
+  /// \param[in] _b Inner bounds.
+  /// \return True if _b is within _a.
+  bool contains(const Bounds &_a, const Bounds &_b)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      if (_b.min[i] < _a.min[i] || _b.max[i] > _a.max[i])
+        return false;
+    }
+    return true;
+  }
+
+  /// \brief Check if two bounds overlap, touching bounds overlap.
+  /// \param[in] _a First bounds.
+  /// \param[in] _b Second bounds.
+  /// \return True if _a and _b overlap.
+  bool overlaps(const Bounds &_a, const Bounds &_b)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      if (_a.max[i] < _b.min[i] || _a.min[i] > _b.max[i])
+        return false;
+    }
+    return true;
+  }
+
+  /// \brief Check if a ray segment hits bounds, using the slab test.
+  /// \param[in] _a Bounds.
+  /// \param[in] _origin Origin of the ray.
+  /// \param[in] _inverseDir Inverse of each component of the direction.
+  /// \param[in] _max End of the segment along the ray.
+  /// \return True if the segment hits _a.
+  bool hits(const Bounds &_a, const double (&_origin)[3],
+            const double (&_inverseDir)[3], const double _max)
+  {
+    double t0 = 0;
+    double t1 = _max;
+    for (int i = 0; i < 3; ++i)
+    {
+      // The ray is parallel to the slab
+      if (std::isinf(_inverseDir[i]))
+      {
+        if (_origin[i] < _a.min[i] || _origin[i] > _a.max[i])
+          return false;
+        continue;
+      }
+
+      double tNear = (_a.min[i] - _origin[i]) * _inverseDir[i];
+      double tFar = (_a.max[i] - _origin[i]) * _inverseDir[i];
+      if (tNear > tFar)
+        std::swap(tNear, tFar);
+      if (tNear > t0)
+        t0 = tNear;
+      if (tFar < t1)
+        t1 = tFar;
+      if (t0 > t1)
+        return false;
+    }
+    return true;
+  }
+
+  /// \brief Get the fat box of a box.
+  /// \param[in] _box Bounds of the box.
+  /// \param[in] _margin Margin added on every side.
+  /// \param[in] _displacement Expected displacement of the box.
+  /// \return Fat box.
+  Bounds fatten(const Bounds &_box, const double _margin,
+                const double (&_displacement)[3])
+  {
+    Bounds fat;
+    for (int i = 0; i < 3; ++i)
+    {
+      fat.min[i] = _box.min[i] - _margin;
+      fat.max[i] = _box.max[i] + _margin;
+      if (_displacement[i] < 0)
+        fat.min[i] += _displacement[i];
+      else
+        fat.max[i] += _displacement[i];
+    }
+    return fat;
+  }
+}
+
+/// \internal
+/// \brief Private data for the BoxTree class
+class ignition::math::BoxTreePrivate
+{
+  /// \brief Get a node from the free list, or a new node.
+  /// \return Index of the node.
+  public: size_t AllocateNode();
+
+  /// \brief Put a node in the free list.
+  /// \param[in] _node Index of the node.
+  public: void FreeNode(const size_t _node);
+
+  /// \brief Insert a leaf in the tree.
+  /// \param[in] _leaf Index of the leaf.
+  public: void InsertLeaf(const size_t _leaf);
+
+  /// \brief Remove a leaf from the tree, the node is not freed.
+  /// \param[in] _leaf Index of the leaf.
+  public: void RemoveLeaf(const size_t _leaf);
+
+  /// \brief Update the bounds and heights of the ancestors of a node,
+  /// rebalancing them.
+  /// \param[in] _node Index of the first node to update.
+  public: void Refit(size_t _node);
+
+  /// \brief Rotate a node if its children heights differ by more than 1.
+  /// \param[in] _a Index of the node.
+  /// \return Index of the node which replaces _a in the tree.
+  public: size_t Balance(const size_t _a);
+
+  /// \brief Margin of the fat boxes.
+  public: double margin = 0.1;
+
+  /// \brief Nodes of the tree.
+  public: std::vector<Node> nodes;
+
+  /// \brief Box of each leaf, indexed like nodes.
+  public: std::vector<Bounds> boxes;
+
+  /// \brief Root node.
+  public: size_t root = kNullNode;
+
+  /// \brief First free node.
+  public: size_t freeList = kNullNode;
+
+  /// \brief Number of boxes.
+  public: size_t count = 0;
+};
+
+/////////////////////////////////////////////////
+size_t BoxTreePrivate::AllocateNode()
+{
+  size_t node = this->freeList;
+  if (node == kNullNode)
+  {
+    node = this->nodes.size();
+    this->nodes.push_back(Node());
+    this->boxes.push_back(Bounds());
+  }
+  else
+  {
+    this->freeList = this->nodes[node].parent;
+  }
+
+  Node &n = this->nodes[node];
+  n.parent = kNullNode;
+  n.child1 = kNullNode;
+  n.child2 = kNullNode;
+  n.height = 0;
+  return node;
+}
+
+/////////////////////////////////////////////////
+void BoxTreePrivate::FreeNode(const size_t _node)
+{
+  this->nodes[_node].parent = this->freeList;
+  this->nodes[_node].height = -1;
+  this->freeList = _node;
+}
+
+/////////////////////////////////////////////////
+void BoxTreePrivate::InsertLeaf(const size_t _leaf)
+{
+  if (this->root == kNullNode)
+  {
+    this->root = _leaf;
+    this->nodes[_leaf].parent = kNullNode;
+    return;
+  }
+
+  // Find the best sibling, descending to the child which least increases
+  // the total area, until creating a new parent here costs less.
+  const Bounds leafBounds = this->nodes[_leaf].bounds;
+  size_t index = this->root;
+  while (this->nodes[index].child1 != kNullNode)
+  {
+    const Node &node = this->nodes[index];
+    const double nodeArea = area(node.bounds);
+    const double combinedArea = area(merge(node.bounds, leafBounds));
+
+    // Cost of a new parent for this node and the leaf
+    const double cost = 2 * combinedArea;
+
+    // Minimum cost of pushing the leaf further down
+    const double inheritanceCost = 2 * (combinedArea - nodeArea);
+
+    double childCost[2];
+    const size_t children[2] = {node.child1, node.child2};
+    for (int c = 0; c < 2; ++c)
+    {
+      const Node &child = this->nodes[children[c]];
+      const double merged = area(merge(leafBounds, child.bounds));
+      childCost[c] = inheritanceCost +
+        (child.child1 == kNullNode ? merged : merged - area(child.bounds));
+    }
+
+    if (cost < childCost[0] && cost < childCost[1])
+      break;
+    index = childCost[0] < childCost[1] ? children[0] : children[1];
+  }
+  const size_t sibling = index;
+
+  // Create a new parent for the sibling and the leaf
+  const size_t oldParent = this->nodes[sibling].parent;
+  const size_t newParent = this->AllocateNode();
+  Node &parent = this->nodes[newParent];
+  parent.parent = oldParent;
+  parent.bounds = merge(leafBounds, this->nodes[sibling].bounds);
+  parent.height = this->nodes[sibling].height + 1;
+  parent.child1 = sibling;
+  parent.child2 = _leaf;
+
+  if (oldParent != kNullNode)
+  {
+    Node &old = this->nodes[oldParent];
+    if (old.child1 == sibling)
+      old.child1 = newParent;
+    else
+      old.child2 = newParent;
+  }
+  else
+  {
+    this->root = newParent;
+  }
+  this->nodes[sibling].parent = newParent;
+  this->nodes[_leaf].parent = newParent;
+
+  this->Refit(newParent);
+}
+
+/////////////////////////////////////////////////
+void BoxTreePrivate::RemoveLeaf(const size_t _leaf)
+{
+  if (_leaf == this->root)
+  {
+    this->root = kNullNode;
+    return;
+  }
+
+  const size_t parent = this->nodes[_leaf].parent;
+  const size_t grandParent = this->nodes[parent].parent;
+  const size_t sibling = this->nodes[parent].child1 == _leaf ?
+    this->nodes[parent].child2 : this->nodes[parent].child1;
+
+  // Replace the parent with the sibling
+  this->nodes[sibling].parent = grandParent;
+  this->FreeNode(parent);
+  if (grandParent == kNullNode)
+  {
+    this->root = sibling;
+    return;
+  }
+
+  Node &grand = this->nodes[grandParent];
+  if (grand.child1 == parent)
+    grand.child1 = sibling;
+  else
+    grand.child2 = sibling;
+  this->Refit(grandParent);
+}
+
+/////////////////////////////////////////////////
+void BoxTreePrivate::Refit(size_t _node)
+{
+  while (_node != kNullNode)
+  {
+    _node = this->Balance(_node);
+
+    Node &node = this->nodes[_node];
+    const Node &child1 = this->nodes[node.child1];
+    const Node &child2 = this->nodes[node.child2];
+    node.height = 1 + std::max(child1.height, child2.height);
+    node.bounds = merge(child1.bounds, child2.bounds);
+
+    _node = node.parent;
+  }
+}
+
+/////////////////////////////////////////////////
+size_t BoxTreePrivate::Balance(const size_t _a)
+{
+  Node &a = this->nodes[_a];
+  if (a.child1 == kNullNode || a.height < 2)
+    return _a;
+
+  const size_t iB = a.child1;
+  const size_t iC = a.child2;
+  Node &b = this->nodes[iB];
+  Node &c = this->nodes[iC];
+  const int balance = c.height - b.height;
+
+  // Rotate the higher child up, and the lower one down to its place. The
+  // higher child keeps its higher grandchild, and gives the other to a.
+  if (balance > 1 || balance < -1)
+  {
+    const size_t iUp = balance > 1 ? iC : iB;
+    const size_t iDown = balance > 1 ? iB : iC;
+    Node &up = this->nodes[iUp];
+    Node &down = this->nodes[iDown];
+    const size_t iF = up.child1;
+    const size_t iG = up.child2;
+    Node &f = this->nodes[iF];
+    Node &g = this->nodes[iG];
+
+    // Put up in place of a
+    up.child1 = _a;
+    up.parent = a.parent;
+    a.parent = iUp;
+    if (up.parent != kNullNode)
+    {
+      Node &parent = this->nodes[up.parent];
+      if (parent.child1 == _a)
+        parent.child1 = iUp;
+      else
+        parent.child2 = iUp;
+    }
+    else
+    {
+      this->root = iUp;
+    }
+
+    // Keep the higher grandchild under up, give the other to a
+    const size_t iKeep = f.height > g.height ? iF : iG;
+    const size_t iGive = f.height > g.height ? iG : iF;
+    Node &keep = this->nodes[iKeep];
+    Node &give = this->nodes[iGive];
+    up.child2 = iKeep;
+    a.child1 = iDown;
+    a.child2 = iGive;
+    give.parent = _a;
+    a.bounds = merge(down.bounds, give.bounds);
+    up.bounds = merge(a.bounds, keep.bounds);
+    a.height = 1 + std::max(down.height, give.height);
+    up.height = 1 + std::max(a.height, keep.height);
+    return iUp;
+  }
+  return _a;
+}
+
+/////////////////////////////////////////////////
+const size_t BoxTree::NullId = kNullNode;
+
+/////////////////////////////////////////////////
+BoxTree::BoxTree()
+: dataPtr(new BoxTreePrivate)
+{
+}
+
+/////////////////////////////////////////////////
+BoxTree::BoxTree(const double _margin)
+: dataPtr(new BoxTreePrivate)
+{
+  this->SetMargin(_margin);
+}
+
+/////////////////////////////////////////////////
+BoxTree::BoxTree(const BoxTree &_tree)
+: dataPtr(new BoxTreePrivate(*_tree.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+BoxTree::~BoxTree()
+{
+}
+
+/////////////////////////////////////////////////
+BoxTree &BoxTree::operator=(const BoxTree &_tree)
+{
+  if (this == &_tree)
+    return *this;
+
+  *this->dataPtr = *_tree.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+bool BoxTree::SetMargin(const double _margin)
+{
+  if (!(_margin >= 0) || !std::isfinite(_margin))
+    return false;
+
+  this->dataPtr->margin = _margin;
+  return true;
+}
+
+/////////////////////////////////////////////////
+double BoxTree::Margin() const
+{
+  return this->dataPtr->margin;
+}
+
+/////////////////////////////////////////////////
+size_t BoxTree::Add(const Box &_box)
+{
+  Bounds bounds;
+  if (!boundsOf(_box, bounds))
+    return NullId;
+
+  const size_t leaf = this->dataPtr->AllocateNode();
+  const double zero[3] = {0, 0, 0};
+  this->dataPtr->boxes[leaf] = bounds;
+  this->dataPtr->nodes[leaf].bounds =
+    fatten(bounds, this->dataPtr->margin, zero);
+  this->dataPtr->InsertLeaf(leaf);
+  ++this->dataPtr->count;
+  return leaf;
+}
+
+/////////////////////////////////////////////////
+bool BoxTree::Remove(const size_t _id)
+{
+  if (!this->Valid(_id))
+    return false;
+
+  this->dataPtr->RemoveLeaf(_id);
+  this->dataPtr->FreeNode(_id);
+  --this->dataPtr->count;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool BoxTree::Move(const size_t _id, const Box &_box)
+{
+  return this->Move(_id, _box, Vector3d::Zero);
+}
+
+/////////////////////////////////////////////////
+bool BoxTree::Move(const size_t _id, const Box &_box,
+    const Vector3d &_displacement)
+{
+  Bounds bounds;
+  if (!this->Valid(_id) || !boundsOf(_box, bounds))
+    return false;
+
+  const double displacement[3] = {_displacement.X(), _displacement.Y(),
+                                  _displacement.Z()};
+  for (const double d : displacement)
+  {
+    if (!std::isfinite(d))
+      return false;
+  }
+
+  this->dataPtr->boxes[_id] = bounds;
+  Bounds &fat = this->dataPtr->nodes[_id].bounds;
+  const double margin = this->dataPtr->margin;
+  const Bounds newFat = fatten(bounds, margin, displacement);
+  if (contains(fat, bounds))
+  {
+    // Keep the fat box unless it became much larger than needed, for
+    // example after the box slowed down
+    const double none[3] = {0, 0, 0};
+    if (contains(fatten(newFat, 4 * margin, none), fat))
+      return false;
+  }
+
+  this->dataPtr->RemoveLeaf(_id);
+  fat = newFat;
+  this->dataPtr->InsertLeaf(_id);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool BoxTree::Valid(const size_t _id) const
+{
+  return _id < this->dataPtr->nodes.size() &&
+    this->dataPtr->nodes[_id].height == 0;
+}
+
+/////////////////////////////////////////////////
+Box BoxTree::BoxOf(const size_t _id) const
+{
+  if (!this->Valid(_id))
+    return Box();
+
+  const Bounds &b = this->dataPtr->boxes[_id];
+  return Box(b.min[0], b.min[1], b.min[2], b.max[0], b.max[1], b.max[2]);
+}
+
+/////////////////////////////////////////////////
+Box BoxTree::FatBox(const size_t _id) const
+{
+  if (!this->Valid(_id))
+    return Box();
+
+  const Bounds &b = this->dataPtr->nodes[_id].bounds;
+  return Box(b.min[0], b.min[1], b.min[2], b.max[0], b.max[1], b.max[2]);
+}
+
+/////////////////////////////////////////////////
+void BoxTree::Clear()
+{
+  this->dataPtr->nodes.clear();
+  this->dataPtr->boxes.clear();
+  this->dataPtr->root = kNullNode;
+  this->dataPtr->freeList = kNullNode;
+  this->dataPtr->count = 0;
+}
+
+/////////////////////////////////////////////////
+size_t BoxTree::Size() const
+{
+  return this->dataPtr->count;
+}
+
+/////////////////////////////////////////////////
+size_t BoxTree::Height() const
+{
+  if (this->dataPtr->root == kNullNode)
+    return 0;
+  return this->dataPtr->nodes[this->dataPtr->root].height + 1;
+}
+
+/////////////////////////////////////////////////
+size_t BoxTree::Overlaps(const Box &_box, std::vector<size_t> &_ids) const
+{
+  _ids.clear();
+  Bounds bounds;
+  if (!boundsOf(_box, bounds) || this->dataPtr->root == kNullNode)
+    return 0;
+
+  const std::vector<Node> &nodes = this->dataPtr->nodes;
+  std::vector<size_t> stack(1, this->dataPtr->root);
+  while (!stack.empty())
+  {
+    const size_t index = stack.back();
+    stack.pop_back();
+    const Node &node = nodes[index];
+    if (!overlaps(node.bounds, bounds))
+      continue;
+
+    if (node.child1 == kNullNode)
+    {
+      if (overlaps(this->dataPtr->boxes[index], bounds))
+        _ids.push_back(index);
+    }
+    else
+    {
+      stack.push_back(node.child1);
+      stack.push_back(node.child2);
+    }
+  }
+  return _ids.size();
+}
+
+/////////////////////////////////////////////////
+size_t BoxTree::Pairs(std::vector<std::pair<size_t, size_t>> &_pairs) const
+{
+  _pairs.clear();
+  const std::vector<Node> &nodes = this->dataPtr->nodes;
+  const std::vector<Bounds> &boxes = this->dataPtr->boxes;
+  std::vector<size_t> stack;
+
+  // Query the tree with each box, keeping the pairs where the other box
+  // has a higher id so that each pair is found once
+  for (size_t leaf = 0; leaf < nodes.size(); ++leaf)
+  {
+    if (nodes[leaf].height != 0)
+      continue;
+
+    const Bounds &bounds = boxes[leaf];
+    stack.assign(1, this->dataPtr->root);
+    while (!stack.empty())
+    {
+      const size_t index = stack.back();
+      stack.pop_back();
+      const Node &node = nodes[index];
+      if (!overlaps(node.bounds, bounds))
+        continue;
+
+      if (node.child1 == kNullNode)
+      {
+        if (index > leaf && overlaps(boxes[index], bounds))
+          _pairs.push_back(std::make_pair(leaf, index));
+      }
+      else
+      {
+        stack.push_back(node.child1);
+        stack.push_back(node.child2);
+      }
+    }
+  }
+  return _pairs.size();
+}
+
+/////////////////////////////////////////////////
+size_t BoxTree::Raycast(const Vector3d &_origin, const Vector3d &_dir,
+    const double _max, std::vector<size_t> &_ids) const
+{
+  _ids.clear();
+  if (this->dataPtr->root == kNullNode || !(_max >= 0) ||
+      !std::isfinite(_origin.X()) || !std::isfinite(_origin.Y()) ||
+      !std::isfinite(_origin.Z()) || !std::isfinite(_dir.X()) ||
+      !std::isfinite(_dir.Y()) || !std::isfinite(_dir.Z()))
+  {
+    return 0;
+  }
+
+  const double origin[3] = {_origin.X(), _origin.Y(), _origin.Z()};
+  const double inverseDir[3] = {1.0 / _dir.X(), 1.0 / _dir.Y(),
+                                1.0 / _dir.Z()};
+
+  const std::vector<Node> &nodes = this->dataPtr->nodes;
+  std::vector<size_t> stack(1, this->dataPtr->root);
+  while (!stack.empty())
+  {
+    const size_t index = stack.back();
+    stack.pop_back();
+    const Node &node = nodes[index];
+    if (!hits(node.bounds, origin, inverseDir, _max))
+      continue;
+
+    if (node.child1 == kNullNode)
+    {
+      if (hits(this->dataPtr->boxes[index], origin, inverseDir, _max))
+        _ids.push_back(index);
+    }
+    else
+    {
+      stack.push_back(node.child1);
+      stack.push_back(node.child2);
+    }
+  }
+  return _ids.size();
+}
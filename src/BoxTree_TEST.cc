@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "ignition/math/BoxTree.hh"
+#include "ignition/math/Rand.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+/// \brief Random box in a cube.
+/// \param[in] _size Side of the cube.
+/// \return Box with sides up to 2.
+math::Box RandomBox(const double _size)
+{
+  const math::Vector3d min(math::Rand::DblUniform(0, _size),
+      math::Rand::DblUniform(0, _size), math::Rand::DblUniform(0, _size));
+  const math::Vector3d size(math::Rand::DblUniform(0, 2),
+      math::Rand::DblUniform(0, 2), math::Rand::DblUniform(0, 2));
+  return math::Box(min, min + size);
+}
+
+/////////////////////////////////////////////////
+/// \brief Check the queries of a tree against testing all boxes.
+/// \param[in] _tree Tree.
+/// \param[in] _ids Ids of the boxes in the tree.
+void CheckQueries(const math::BoxTree &_tree,
+                  const std::vector<size_t> &_ids)
+{
+  EXPECT_EQ(_ids.size(), _tree.Size());
+
+  // Pairs
+  std::vector<std::pair<size_t, size_t>> expected;
+  for (size_t i = 0; i < _ids.size(); ++i)
+  {
+    for (size_t j = i + 1; j < _ids.size(); ++j)
+    {
+      if (_tree.BoxOf(_ids[i]).Intersects(_tree.BoxOf(_ids[j])))
+      {
+        expected.push_back(std::make_pair(std::min(_ids[i], _ids[j]),
+                                          std::max(_ids[i], _ids[j])));
+      }
+    }
+  }
+  std::vector<std::pair<size_t, size_t>> pairs;
+  EXPECT_EQ(expected.size(), _tree.Pairs(pairs));
+  std::sort(expected.begin(), expected.end());
+  std::sort(pairs.begin(), pairs.end());
+  EXPECT_EQ(expected, pairs);
+
+  // Boxes and rays
+  std::vector<size_t> found;
+  for (int q = 0; q < 20; ++q)
+  {
+    const math::Box query = RandomBox(20);
+    std::vector<size_t> expectedIds;
+    for (const size_t id : _ids)
+    {
+      if (query.Intersects(_tree.BoxOf(id)))
+        expectedIds.push_back(id);
+    }
+    EXPECT_EQ(expectedIds.size(), _tree.Overlaps(query, found));
+    std::sort(expectedIds.begin(), expectedIds.end());
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(expectedIds, found);
+
+    const math::Vector3d origin(math::Rand::DblUniform(-5, 25),
+        math::Rand::DblUniform(-5, 25), math::Rand::DblUniform(-5, 25));
+    const math::Vector3d dir = math::Vector3d(math::Rand::DblUniform(-1, 1),
+        math::Rand::DblUniform(-1, 1),
+        math::Rand::DblUniform(-1, 1)).Normalize();
+    expectedIds.clear();
+    for (const size_t id : _ids)
+    {
+      if (_tree.BoxOf(id).IntersectCheck(origin, dir, 0, 15))
+        expectedIds.push_back(id);
+    }
+    EXPECT_EQ(expectedIds.size(), _tree.Raycast(origin, dir, 15, found));
+    std::sort(expectedIds.begin(), expectedIds.end());
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(expectedIds, found);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(BoxTreeTest, Construct)
+{
+  math::BoxTree tree;
+  EXPECT_DOUBLE_EQ(0.1, tree.Margin());
+  EXPECT_EQ(0u, tree.Size());
+  EXPECT_EQ(0u, tree.Height());
+  EXPECT_FALSE(tree.Valid(0));
+  EXPECT_FALSE(tree.Valid(math::BoxTree::NullId));
+  EXPECT_EQ(math::Box(), tree.BoxOf(0));
+  EXPECT_EQ(math::Box(), tree.FatBox(0));
+
+  EXPECT_FALSE(tree.SetMargin(-1));
+  EXPECT_FALSE(tree.SetMargin(math::INF_D));
+  EXPECT_FALSE(tree.SetMargin(math::NAN_D));
+  EXPECT_DOUBLE_EQ(0.1, tree.Margin());
+  EXPECT_TRUE(tree.SetMargin(0));
+  EXPECT_DOUBLE_EQ(0.0, tree.Margin());
+
+  math::BoxTree tree2(0.5);
+  EXPECT_DOUBLE_EQ(0.5, tree2.Margin());
+
+  std::vector<size_t> ids;
+  std::vector<std::pair<size_t, size_t>> pairs;
+  EXPECT_EQ(0u, tree.Overlaps(math::Box(0, 0, 0, 1, 1, 1), ids));
+  EXPECT_EQ(0u, tree.Pairs(pairs));
+  EXPECT_EQ(0u, tree.Raycast(math::Vector3d::Zero, math::Vector3d::UnitX,
+        10, ids));
+}
+
+/////////////////////////////////////////////////
+TEST(BoxTreeTest, AddRemove)
+{
+  math::BoxTree tree(0.5);
+  EXPECT_EQ(math::BoxTree::NullId,
+      tree.Add(math::Box(0, 0, 0, 1, math::NAN_D, 1)));
+  EXPECT_EQ(math::BoxTree::NullId,
+      tree.Add(math::Box(0, 0, 0, 1, 1, math::INF_D)));
+  EXPECT_EQ(0u, tree.Size());
+
+  const size_t a = tree.Add(math::Box(0, 0, 0, 1, 1, 1));
+  const size_t b = tree.Add(math::Box(2, 0, 0, 3, 1, 1));
+  const size_t c = tree.Add(math::Box(1, 1, 1, 2, 2, 2));
+  EXPECT_EQ(3u, tree.Size());
+  EXPECT_EQ(3u, tree.Height());
+  EXPECT_TRUE(tree.Valid(a));
+  EXPECT_TRUE(tree.Valid(b));
+  EXPECT_TRUE(tree.Valid(c));
+  EXPECT_NE(a, b);
+  EXPECT_NE(b, c);
+  EXPECT_NE(a, c);
+  EXPECT_EQ(math::Box(2, 0, 0, 3, 1, 1), tree.BoxOf(b));
+  EXPECT_EQ(math::Box(1.5, -0.5, -0.5, 3.5, 1.5, 1.5), tree.FatBox(b));
+
+  // Boxes a and b are not within the margin, c touches both
+  std::vector<std::pair<size_t, size_t>> pairs;
+  EXPECT_EQ(2u, tree.Pairs(pairs));
+  std::sort(pairs.begin(), pairs.end());
+  EXPECT_EQ(std::make_pair(std::min(a, c), std::max(a, c)), pairs[0]);
+
+  EXPECT_TRUE(tree.Remove(c));
+  EXPECT_FALSE(tree.Remove(c));
+  EXPECT_FALSE(tree.Valid(c));
+  EXPECT_EQ(2u, tree.Size());
+  EXPECT_EQ(0u, tree.Pairs(pairs));
+
+  // Copies are independent
+  math::BoxTree copy(tree);
+  EXPECT_TRUE(tree.Remove(a));
+  EXPECT_EQ(1u, tree.Size());
+  EXPECT_EQ(2u, copy.Size());
+  EXPECT_TRUE(copy.Valid(a));
+  copy = tree;
+  EXPECT_FALSE(copy.Valid(a));
+
+  tree.Clear();
+  EXPECT_EQ(0u, tree.Size());
+  EXPECT_EQ(0u, tree.Height());
+  EXPECT_FALSE(tree.Valid(b));
+}
+
+/////////////////////////////////////////////////
+TEST(BoxTreeTest, Move)
+{
+  math::BoxTree tree(0.5);
+  const size_t a = tree.Add(math::Box(0, 0, 0, 1, 1, 1));
+  const size_t b = tree.Add(math::Box(3, 0, 0, 4, 1, 1));
+  EXPECT_FALSE(tree.Move(5, math::Box(0, 0, 0, 1, 1, 1)));
+  EXPECT_FALSE(tree.Move(a, math::Box(0, 0, 0, 1, 1, math::NAN_D)));
+
+  // Within the fat box, the box moves but the tree does not change
+  EXPECT_FALSE(tree.Move(a, math::Box(0.4, 0, 0, 1.4, 1, 1)));
+  EXPECT_EQ(math::Box(0.4, 0, 0, 1.4, 1, 1), tree.BoxOf(a));
+  EXPECT_EQ(math::Box(-0.5, -0.5, -0.5, 1.5, 1.5, 1.5), tree.FatBox(a));
+
+  // Out of the fat box
+  EXPECT_TRUE(tree.Move(a, math::Box(1, 0, 0, 2, 1, 1),
+        math::Vector3d(1, 0, -0.5)));
+  EXPECT_EQ(math::Box(0.5, -0.5, -1, 3.5, 1.5, 1.5), tree.FatBox(a));
+  std::vector<std::pair<size_t, size_t>> pairs;
+  EXPECT_EQ(0u, tree.Pairs(pairs));
+  EXPECT_FALSE(tree.Move(a, math::Box(2, 0, 0, 3, 1, 1)));
+  EXPECT_EQ(1u, tree.Pairs(pairs));
+  EXPECT_EQ(std::make_pair(std::min(a, b), std::max(a, b)), pairs[0]);
+
+  // A fat box much larger than needed is shrunk
+  EXPECT_TRUE(tree.Move(a, math::Box(0, 0, 0, 1, 1, 1),
+        math::Vector3d(10, 0, 0)));
+  EXPECT_TRUE(tree.Move(a, math::Box(0, 0, 0, 1, 1, 1)));
+  EXPECT_EQ(math::Box(-0.5, -0.5, -0.5, 1.5, 1.5, 1.5), tree.FatBox(a));
+}
+
+/////////////////////////////////////////////////
+TEST(BoxTreeTest, Raycast)
+{
+  math::BoxTree tree;
+  const size_t a = tree.Add(math::Box(0, 0, 0, 1, 1, 1));
+  const size_t b = tree.Add(math::Box(3, 0, 0, 4, 1, 1));
+  tree.Add(math::Box(0, 3, 0, 1, 4, 1));
+
+  // Rays along the axes, with zero direction components
+  std::vector<size_t> ids;
+  EXPECT_EQ(2u, tree.Raycast(math::Vector3d(-1, 0.5, 0.5),
+        math::Vector3d::UnitX, 10, ids));
+  EXPECT_EQ(1u, tree.Raycast(math::Vector3d(-1, 0.5, 0.5),
+        math::Vector3d::UnitX, 2, ids));
+  EXPECT_EQ(a, ids[0]);
+  EXPECT_EQ(1u, tree.Raycast(math::Vector3d(5, 1, 1),
+        -math::Vector3d::UnitX, 1, ids));
+  EXPECT_EQ(b, ids[0]);
+  EXPECT_EQ(0u, tree.Raycast(math::Vector3d(-1, 1.5, 0.5),
+        math::Vector3d::UnitX, 10, ids));
+
+  // Unnormalized direction
+  EXPECT_EQ(1u, tree.Raycast(math::Vector3d(-1, 0.5, 0.5),
+        math::Vector3d(2, 0, 0), 1, ids));
+  EXPECT_EQ(0u, tree.Raycast(math::Vector3d(-1, 0.5, 0.5),
+        math::Vector3d(2, 0, 0), -1, ids));
+
+  // Non finite origin or direction
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double inf = std::numeric_limits<double>::infinity();
+  EXPECT_EQ(0u, tree.Raycast(math::Vector3d(nan, 0.5, 0.5),
+        math::Vector3d::UnitX, 10, ids));
+  EXPECT_TRUE(ids.empty());
+  EXPECT_EQ(0u, tree.Raycast(math::Vector3d(-inf, 0.5, 0.5),
+        math::Vector3d::UnitX, 10, ids));
+  EXPECT_EQ(0u, tree.Raycast(math::Vector3d(-1, 0.5, 0.5),
+        math::Vector3d(1, nan, 0), 10, ids));
+  EXPECT_EQ(0u, tree.Raycast(math::Vector3d(-1, 0.5, 0.5),
+        math::Vector3d(inf, 0, 0), 10, ids));
+}
+
+/////////////////////////////////////////////////
+TEST(BoxTreeTest, Random)
+{
+  math::BoxTree tree(0.2);
+  std::vector<size_t> ids;
+  for (int i = 0; i < 500; ++i)
+    ids.push_back(tree.Add(RandomBox(20)));
+  EXPECT_LE(tree.Height(), 20u);
+  CheckQueries(tree, ids);
+
+  // Move, remove and add boxes
+  for (int step = 0; step < 5; ++step)
+  {
+    for (const size_t id : ids)
+    {
+      const math::Vector3d displacement(math::Rand::DblUniform(-0.5, 0.5),
+          math::Rand::DblUniform(-0.5, 0.5),
+          math::Rand::DblUniform(-0.5, 0.5));
+      math::Box box = tree.BoxOf(id);
+      tree.Move(id, math::Box(box.Min() + displacement,
+            box.Max() + displacement), displacement);
+    }
+    for (int i = 0; i < 50; ++i)
+    {
+      const size_t index = math::Rand::IntUniform(0,
+          static_cast<int>(ids.size()) - 1);
+      EXPECT_TRUE(tree.Remove(ids[index]));
+      ids.erase(ids.begin() + index);
+    }
+    for (int i = 0; i < 50; ++i)
+      ids.push_back(tree.Add(RandomBox(20)));
+    EXPECT_LE(tree.Height(), 20u);
+    CheckQueries(tree, ids);
+  }
+}
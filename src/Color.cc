@@ -22,6 +22,68 @@
 using namespace ignition;
 using namespace math;
 
+namespace
+{
+  /// \brief Bit offsets of the red, green, blue and alpha bytes in a
+  /// packed 32-bit color.
+  /// \param[in] _format Channel order.
+  /// \param[out] _r Offset of the red byte.
+  /// \param[out] _g Offset of the green byte.
+  /// \param[out] _b Offset of the blue byte.
+  /// \param[out] _a Offset of the alpha byte.
+  void PixelShifts(const Color::PixelFormat _format, unsigned int &_r,
+      unsigned int &_g, unsigned int &_b, unsigned int &_a)
+  {
+    switch (_format)
+    {
+      case Color::PIXEL_BGRA:
+        _b = 24; _g = 16; _r = 8; _a = 0;
+        break;
+      case Color::PIXEL_ARGB:
+        _a = 24; _r = 16; _g = 8; _b = 0;
+        break;
+      case Color::PIXEL_ABGR:
+        _a = 24; _b = 16; _g = 8; _r = 0;
+        break;
+      case Color::PIXEL_RGBA:
+      default:
+        _r = 24; _g = 16; _b = 8; _a = 0;
+        break;
+    }
+  }
+
+  /// \brief Saturate a color component to [0, 1]. NaN maps to 0.
+  /// \param[in] _v Color component.
+  /// \return Saturated component.
+  inline float Saturate(const float _v)
+  {
+    const float v = _v > 0 ? _v : 0.0f;
+    return v < 1 ? v : 1.0f;
+  }
+
+  /// \brief Clamp a color component like Color::Clamp does for red,
+  /// green and blue: negative and NaN values map to 0, and values above 1
+  /// are taken as 8-bit values and divided by 255.
+  /// \param[in] _v Color component.
+  /// \return Clamped component.
+  inline float ClampComponent(const float _v)
+  {
+    const float v = _v < 0 || std::isnan(_v) ? 0.0f : _v;
+    return v > 1 ? v / 255.0f : v;
+  }
+
+  /// \brief Convert a color component to an 8-bit value, truncating
+  /// like AsRGBA.
+  /// \param[in] _v Color component.
+  /// \return Value in [0, 255].
+  inline unsigned int ToByte(const float _v)
+  {
+    // Convert through int, which has a vector instruction on all x86
+    // targets, unlike unsigned int.
+    return static_cast<unsigned int>(static_cast<int>(Saturate(_v) * 255));
+  }
+}
+
 const Color Color::White = Color(1, 1, 1, 1);
 const Color Color::Black = Color(0, 0, 0, 1);
 const Color Color::Red = Color(1, 0, 0, 1);
@@ -366,6 +428,154 @@ void Color::SetFromABGR(const Color::ABGR _v)
   this->r = (val32 & 0xFF) / 255.0f;
 }
 
+//////////////////////////////////////////////////
+void Color::PackedToFloat(const unsigned int *_in, float *_out,
+    const size_t _n, const PixelFormat _format)
+{
+  unsigned int rs, gs, bs, as;
+  PixelShifts(_format, rs, gs, bs, as);
+
+  for (size_t i = 0; i < _n; ++i)
+  {
+    const unsigned int val32 = _in[i];
+    _out[4*i] = ((val32 >> rs) & 0xFF) / 255.0f;
+    _out[4*i+1] = ((val32 >> gs) & 0xFF) / 255.0f;
+    _out[4*i+2] = ((val32 >> bs) & 0xFF) / 255.0f;
+    _out[4*i+3] = ((val32 >> as) & 0xFF) / 255.0f;
+  }
+}
+
+//////////////////////////////////////////////////
+void Color::FloatToPacked(const float *_in, unsigned int *_out,
+    const size_t _n, const PixelFormat _format)
+{
+  unsigned int rs, gs, bs, as;
+  PixelShifts(_format, rs, gs, bs, as);
+
+  for (size_t i = 0; i < _n; ++i)
+  {
+    _out[i] = (ToByte(_in[4*i]) << rs) |
+              (ToByte(_in[4*i+1]) << gs) |
+              (ToByte(_in[4*i+2]) << bs) |
+              (ToByte(_in[4*i+3]) << as);
+  }
+}
+
+//////////////////////////////////////////////////
+void Color::ConvertPacked(const unsigned int *_in, unsigned int *_out,
+    const size_t _n, const PixelFormat _from, const PixelFormat _to)
+{
+  unsigned int rIn, gIn, bIn, aIn;
+  unsigned int rOut, gOut, bOut, aOut;
+  PixelShifts(_from, rIn, gIn, bIn, aIn);
+  PixelShifts(_to, rOut, gOut, bOut, aOut);
+
+  for (size_t i = 0; i < _n; ++i)
+  {
+    const unsigned int val32 = _in[i];
+    _out[i] = (((val32 >> rIn) & 0xFF) << rOut) |
+              (((val32 >> gIn) & 0xFF) << gOut) |
+              (((val32 >> bIn) & 0xFF) << bOut) |
+              (((val32 >> aIn) & 0xFF) << aOut);
+  }
+}
+
+//////////////////////////////////////////////////
+void Color::RGBAToHSV(const float *_rgba, float *_hsv, const size_t _n)
+{
+  // Same as HSV(), with the branches written as selects so that the
+  // loop has a single path.
+  for (size_t i = 0; i < _n; ++i)
+  {
+    const float r = _rgba[4*i];
+    const float g = _rgba[4*i+1];
+    const float b = _rgba[4*i+2];
+
+    const float min = std::min(r, std::min(g, b));
+    const float max = std::max(r, std::max(g, b));
+    const float delta = max - min;
+    const bool grey = equal(delta, 0.0f);
+
+    float h = 1 - ((r - g) / delta);
+    h = equal(g, min) ? 5 - ((b - r) / delta) : h;
+    h = equal(r, min) ? 3 - ((g - b) / delta) : h;
+
+    _hsv[3*i] = grey ? -1.0f : h;
+    _hsv[3*i+1] = grey ? 0.0f : delta / max;
+    _hsv[3*i+2] = max;
+  }
+}
+
+//////////////////////////////////////////////////
+void Color::HSVToRGBA(const float *_hsv, float *_rgba, const size_t _n)
+{
+  // Same as SetFromHSV(), with the sector switch written as selects.
+  for (size_t i = 0; i < _n; ++i)
+  {
+    const float hue = _hsv[3*i];
+    const float s = _hsv[3*i+1];
+    const float v = _hsv[3*i+2];
+
+    const float h =
+      static_cast<float>(static_cast<int>(hue < 0 ? 0 : hue) % 360) / 60;
+    const int sector = static_cast<int>(floor(h));
+    const float f = h - sector;
+
+    const float p = v * (1 - s);
+    const float q = v * (1 - s * f);
+    const float t = v * (1 - s * (1 - f));
+
+    float r = (sector == 1) ? q : ((sector == 4) ? t : p);
+    r = (sector == 0 || sector == 5) ? v : r;
+    float g = (sector == 0) ? t : ((sector == 3) ? q : p);
+    g = (sector == 1 || sector == 2) ? v : g;
+    float b = (sector == 2) ? t : ((sector == 5) ? q : p);
+    b = (sector == 3 || sector == 4) ? v : b;
+
+    // Acromatic (grey) colors are not clamped
+    const bool grey = equal(s, 0.0f);
+    _rgba[4*i] = grey ? v : ClampComponent(r);
+    _rgba[4*i+1] = grey ? v : ClampComponent(g);
+    _rgba[4*i+2] = grey ? v : ClampComponent(b);
+    _rgba[4*i+3] = 1.0f;
+  }
+}
+
+//////////////////////////////////////////////////
+void Color::RGBAToYUV(const float *_rgba, float *_yuv, const size_t _n)
+{
+  for (size_t i = 0; i < _n; ++i)
+  {
+    const float r = _rgba[4*i];
+    const float g = _rgba[4*i+1];
+    const float b = _rgba[4*i+2];
+
+    const float y = 0.299f*r + 0.587f*g + 0.114f*b;
+    const float u = -0.1679f*r - 0.332f*g + 0.5f*b + 0.5f;
+    const float v = 0.5f*r - 0.4189f*g - 0.08105f*b + 0.5f;
+
+    _yuv[3*i] = std::min(std::max(y, 0.0f), 255.0f);
+    _yuv[3*i+1] = std::min(std::max(u, 0.0f), 255.0f);
+    _yuv[3*i+2] = std::min(std::max(v, 0.0f), 255.0f);
+  }
+}
+
+//////////////////////////////////////////////////
+void Color::YUVToRGBA(const float *_yuv, float *_rgba, const size_t _n)
+{
+  for (size_t i = 0; i < _n; ++i)
+  {
+    const float y = _yuv[3*i];
+    const float u = _yuv[3*i+1];
+    const float v = _yuv[3*i+2];
+
+    _rgba[4*i] = ClampComponent(y + 1.140f*v);
+    _rgba[4*i+1] = ClampComponent(y - 0.395f*u - 0.581f*v);
+    _rgba[4*i+2] = ClampComponent(y + 2.032f*u);
+    _rgba[4*i+3] = 1.0f;
+  }
+}
+
 //////////////////////////////////////////////////
 Color &Color::operator=(const Color &_clr)
 {
@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <cmath>
+#include <vector>
+#include "ignition/math/ColorMap.hh"
+#include "ignition/math/ColorMapPrivate.hh"
+
+using namespace ignition;
+using namespace math;
+
+/////////////////////////////////////////////////
+ColorMap::ColorMap()
+: dataPtr(new ColorMapPrivate)
+{
+  this->SetPreset(GRAYSCALE);
+}
+
+/////////////////////////////////////////////////
+ColorMap::ColorMap(const Preset _preset, const size_t _size)
+: dataPtr(new ColorMapPrivate)
+{
+  this->dataPtr->size = _size < 2 ? 2 : _size;
+  this->SetRange(0, 1);
+  this->SetPreset(_preset);
+}
+
+/////////////////////////////////////////////////
+ColorMap::ColorMap(const ColorMap &_map)
+: dataPtr(new ColorMapPrivate(*_map.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+ColorMap::~ColorMap()
+{
+}
+
+/////////////////////////////////////////////////
+ColorMap &ColorMap::operator=(const ColorMap &_map)
+{
+  if (this == &_map)
+    return *this;
+
+  *this->dataPtr = *_map.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+void ColorMap::SetPreset(const Preset _preset)
+{
+  std::vector<double> positions;
+  std::vector<Color> colors;
+
+  switch (_preset)
+  {
+    case JET:
+      positions = {0.0, 0.125, 0.375, 0.625, 0.875, 1.0};
+      colors = {Color(0, 0, 0.5f), Color(0, 0, 1), Color(0, 1, 1),
+                Color(1, 1, 0), Color(1, 0, 0), Color(0.5f, 0, 0)};
+      break;
+    case HOT:
+      positions = {0.0, 0.365, 0.746, 1.0};
+      colors = {Color(0, 0, 0), Color(1, 0, 0), Color(1, 1, 0),
+                Color(1, 1, 1)};
+      break;
+    case HSV:
+      // SetFromHSV is linear in hue within each 60 degree sector, so one
+      // stop per sector boundary reproduces it.
+      for (int h = 0; h <= 300; h += 60)
+      {
+        Color clr;
+        clr.SetFromHSV(static_cast<float>(h), 1, 1);
+        positions.push_back(h / 300.0);
+        colors.push_back(clr);
+      }
+      break;
+    case VIRIDIS:
+      // Nine evenly spaced samples of the map
+      positions = {0.0, 0.125, 0.25, 0.375, 0.5, 0.625, 0.75, 0.875, 1.0};
+      colors = {Color(68/255.0f, 1/255.0f, 84/255.0f),
+                Color(71/255.0f, 45/255.0f, 123/255.0f),
+                Color(59/255.0f, 82/255.0f, 139/255.0f),
+                Color(44/255.0f, 114/255.0f, 142/255.0f),
+                Color(33/255.0f, 144/255.0f, 140/255.0f),
+                Color(39/255.0f, 173/255.0f, 129/255.0f),
+                Color(93/255.0f, 200/255.0f, 99/255.0f),
+                Color(170/255.0f, 220/255.0f, 50/255.0f),
+                Color(253/255.0f, 231/255.0f, 37/255.0f)};
+      break;
+    case GRAYSCALE:
+    default:
+      positions = {0.0, 1.0};
+      colors = {Color::Black, Color::White};
+      break;
+  }
+
+  this->SetGradient(positions, colors);
+}
+
+/////////////////////////////////////////////////
+bool ColorMap::SetGradient(const std::vector<Color> &_colors)
+{
+  if (_colors.size() < 2)
+    return false;
+
+  std::vector<double> positions(_colors.size());
+  for (size_t i = 0; i < _colors.size(); ++i)
+    positions[i] = static_cast<double>(i) / (_colors.size() - 1);
+
+  return this->SetGradient(positions, _colors);
+}
+
+/////////////////////////////////////////////////
+bool ColorMap::SetGradient(const std::vector<double> &_positions,
+                           const std::vector<Color> &_colors)
+{
+  if (_positions.empty() || _positions.size() != _colors.size())
+    return false;
+
+  for (size_t i = 0; i < _positions.size(); ++i)
+  {
+    if (!(_positions[i] >= 0 && _positions[i] <= 1))
+      return false;
+    if (i > 0 && _positions[i] < _positions[i-1])
+      return false;
+  }
+
+  this->dataPtr->positions = _positions;
+  this->dataPtr->colors = _colors;
+  this->dataPtr->Bake();
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool ColorMap::SetSize(const size_t _size)
+{
+  if (_size < 2)
+    return false;
+
+  this->dataPtr->size = _size;
+  // Update the scale for the new table size
+  this->SetRange(this->dataPtr->min, this->dataPtr->max);
+  this->dataPtr->Bake();
+  return true;
+}
+
+/////////////////////////////////////////////////
+size_t ColorMap::Size() const
+{
+  return this->dataPtr->size;
+}
+
+/////////////////////////////////////////////////
+bool ColorMap::SetRange(const double _min, const double _max)
+{
+  if (!std::isfinite(_min) || !std::isfinite(_max) || equal(_min, _max, 0.0))
+    return false;
+
+  this->dataPtr->min = _min;
+  this->dataPtr->max = _max;
+  this->dataPtr->last = static_cast<double>(this->dataPtr->size - 1);
+  this->dataPtr->scale = this->dataPtr->last / (_max - _min);
+  return true;
+}
+
+/////////////////////////////////////////////////
+double ColorMap::Min() const
+{
+  return this->dataPtr->min;
+}
+
+/////////////////////////////////////////////////
+double ColorMap::Max() const
+{
+  return this->dataPtr->max;
+}
+
+/////////////////////////////////////////////////
+void ColorMap::SetInvalidColor(const Color &_color)
+{
+  this->dataPtr->invalid = _color;
+  this->dataPtr->Bake();
+}
+
+/////////////////////////////////////////////////
+Color ColorMap::InvalidColor() const
+{
+  return this->dataPtr->invalid;
+}
+
+/////////////////////////////////////////////////
+Color ColorMap::Value(const double _value) const
+{
+  const float *entry = &this->dataPtr->table[4 * this->dataPtr->Index(_value)];
+  return Color(entry[0], entry[1], entry[2], entry[3]);
+}
+
+/////////////////////////////////////////////////
+void ColorMap::Apply(const float *_values, unsigned int *_out,
+    const size_t _n, const Color::PixelFormat _format) const
+{
+  const unsigned int *lut = this->dataPtr->packed[_format & 3].data();
+  for (size_t i = 0; i < _n; ++i)
+    _out[i] = lut[this->dataPtr->Index(_values[i])];
+}
+
+/////////////////////////////////////////////////
+void ColorMap::Apply(const double *_values, unsigned int *_out,
+    const size_t _n, const Color::PixelFormat _format) const
+{
+  const unsigned int *lut = this->dataPtr->packed[_format & 3].data();
+  for (size_t i = 0; i < _n; ++i)
+    _out[i] = lut[this->dataPtr->Index(_values[i])];
+}
+
+/////////////////////////////////////////////////
+void ColorMap::Apply(const float *_values, float *_out,
+    const size_t _n) const
+{
+  const float *lut = this->dataPtr->table.data();
+  for (size_t i = 0; i < _n; ++i)
+  {
+    const float *entry = lut + 4 * this->dataPtr->Index(_values[i]);
+    _out[4*i] = entry[0];
+    _out[4*i+1] = entry[1];
+    _out[4*i+2] = entry[2];
+    _out[4*i+3] = entry[3];
+  }
+}
+
+/////////////////////////////////////////////////
+void ColorMapPrivate::Bake()
+{
+  this->table.resize(4 * (this->size + 1));
+
+  size_t stop = 0;
+  for (size_t i = 0; i < this->size; ++i)
+  {
+    const double t = static_cast<double>(i) / (this->size - 1);
+
+    // Find the first stop after t
+    while (stop < this->positions.size() && this->positions[stop] <= t)
+      ++stop;
+
+    Color clr;
+    if (stop == 0)
+    {
+      clr = this->colors.front();
+    }
+    else if (stop == this->positions.size())
+    {
+      clr = this->colors.back();
+    }
+    else
+    {
+      const Color &c0 = this->colors[stop-1];
+      const Color &c1 = this->colors[stop];
+      const float w = static_cast<float>((t - this->positions[stop-1]) /
+          (this->positions[stop] - this->positions[stop-1]));
+      clr.Set(c0.R() + w * (c1.R() - c0.R()),
+              c0.G() + w * (c1.G() - c0.G()),
+              c0.B() + w * (c1.B() - c0.B()),
+              c0.A() + w * (c1.A() - c0.A()));
+    }
+
+    this->table[4*i] = clr.R();
+    this->table[4*i+1] = clr.G();
+    this->table[4*i+2] = clr.B();
+    this->table[4*i+3] = clr.A();
+  }
+
+  this->table[4*this->size] = this->invalid.R();
+  this->table[4*this->size+1] = this->invalid.G();
+  this->table[4*this->size+2] = this->invalid.B();
+  this->table[4*this->size+3] = this->invalid.A();
+
+  const Color::PixelFormat formats[4] = {Color::PIXEL_RGBA,
+    Color::PIXEL_BGRA, Color::PIXEL_ARGB, Color::PIXEL_ABGR};
+  for (int f = 0; f < 4; ++f)
+  {
+    this->packed[f].resize(this->size + 1);
+    Color::FloatToPacked(this->table.data(), this->packed[f].data(),
+        this->size + 1, formats[f]);
+  }
+}
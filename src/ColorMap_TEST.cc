@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "ignition/math/ColorMap.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+TEST(ColorMapTest, Grayscale)
+{
+  math::ColorMap map;
+  EXPECT_EQ(256u, map.Size());
+  EXPECT_DOUBLE_EQ(0.0, map.Min());
+  EXPECT_DOUBLE_EQ(1.0, map.Max());
+
+  EXPECT_EQ(math::Color::Black, map.Value(0.0));
+  EXPECT_EQ(math::Color::White, map.Value(1.0));
+  EXPECT_NEAR(0.5f, map.Value(0.5).R(), 1.0 / 255);
+
+  // Values outside the range are clamped
+  EXPECT_EQ(math::Color::Black, map.Value(-3.0));
+  EXPECT_EQ(math::Color::White, map.Value(7.0));
+
+  // NaN values give the invalid color
+  EXPECT_EQ(math::Color(0, 0, 0, 0), map.Value(math::NAN_D));
+  map.SetInvalidColor(math::Color::Red);
+  EXPECT_EQ(math::Color::Red, map.InvalidColor());
+  EXPECT_EQ(math::Color::Red, map.Value(math::NAN_D));
+
+  // Range
+  EXPECT_FALSE(map.SetRange(2.0, 2.0));
+  EXPECT_FALSE(map.SetRange(0.0, math::INF_D));
+  EXPECT_TRUE(map.SetRange(10.0, 20.0));
+  EXPECT_EQ(math::Color::Black, map.Value(10.0));
+  EXPECT_EQ(math::Color::White, map.Value(20.0));
+
+  // Reversed range
+  EXPECT_TRUE(map.SetRange(20.0, 10.0));
+  EXPECT_EQ(math::Color::White, map.Value(10.0));
+  EXPECT_EQ(math::Color::Black, map.Value(20.0));
+
+  // Size
+  EXPECT_FALSE(map.SetSize(1));
+  EXPECT_TRUE(map.SetSize(4096));
+  EXPECT_EQ(4096u, map.Size());
+  EXPECT_NEAR(0.25f, map.Value(17.5).R(), 1.0 / 4095);
+}
+
+/////////////////////////////////////////////////
+TEST(ColorMapTest, Gradient)
+{
+  math::ColorMap map;
+
+  // Invalid gradients leave the map unchanged
+  EXPECT_FALSE(map.SetGradient({math::Color::Red}));
+  EXPECT_FALSE(map.SetGradient({0.0, 1.0}, {math::Color::Red}));
+  EXPECT_FALSE(map.SetGradient({0.5, 0.2},
+        {math::Color::Red, math::Color::Blue}));
+  EXPECT_FALSE(map.SetGradient({0.0, 1.5},
+        {math::Color::Red, math::Color::Blue}));
+  EXPECT_EQ(math::Color::White, map.Value(1.0));
+
+  EXPECT_TRUE(map.SetGradient(
+        {math::Color::Red, math::Color::Green, math::Color::Blue}));
+  EXPECT_EQ(math::Color::Red, map.Value(0.0));
+  EXPECT_EQ(math::Color::Blue, map.Value(1.0));
+  math::Color mid = map.Value(0.25);
+  EXPECT_NEAR(0.5f, mid.R(), 0.01);
+  EXPECT_NEAR(0.5f, mid.G(), 0.01);
+  EXPECT_NEAR(0.0f, mid.B(), 0.01);
+
+  // Stops not covering [0, 1] extend the end colors, and alpha is
+  // interpolated
+  EXPECT_TRUE(map.SetGradient({0.25, 0.75},
+        {math::Color(1, 0, 0, 0), math::Color(0, 0, 1, 1)}));
+  EXPECT_EQ(math::Color(1, 0, 0, 0), map.Value(0.1));
+  EXPECT_EQ(math::Color(0, 0, 1, 1), map.Value(0.9));
+  EXPECT_NEAR(0.5f, map.Value(0.5).A(), 0.01);
+
+  // Copy
+  math::ColorMap copy(map);
+  EXPECT_EQ(map.Value(0.6), copy.Value(0.6));
+  math::ColorMap assigned;
+  assigned = map;
+  EXPECT_EQ(map.Value(0.6), assigned.Value(0.6));
+}
+
+/////////////////////////////////////////////////
+TEST(ColorMapTest, Presets)
+{
+  math::ColorMap jet(math::ColorMap::JET);
+  EXPECT_EQ(math::Color(0, 0, 0.5f), jet.Value(0.0));
+  EXPECT_EQ(math::Color(0.5f, 0, 0), jet.Value(1.0));
+
+  math::ColorMap hot(math::ColorMap::HOT, 4096);
+  EXPECT_EQ(4096u, hot.Size());
+  EXPECT_EQ(math::Color::Black, hot.Value(0.0));
+  EXPECT_EQ(math::Color::White, hot.Value(1.0));
+
+  math::ColorMap viridis(math::ColorMap::VIRIDIS);
+  EXPECT_NEAR(68/255.0f, viridis.Value(0.0).R(), 1e-6);
+  EXPECT_NEAR(37/255.0f, viridis.Value(1.0).B(), 1e-6);
+
+  // The HSV map matches SetFromHSV
+  math::ColorMap hsv(math::ColorMap::HSV, 301);
+  for (int h = 0; h <= 300; h += 5)
+  {
+    math::Color expected;
+    expected.SetFromHSV(static_cast<float>(h), 1, 1);
+    math::Color clr = hsv.Value(h / 300.0);
+    EXPECT_NEAR(expected.R(), clr.R(), 1e-5);
+    EXPECT_NEAR(expected.G(), clr.G(), 1e-5);
+    EXPECT_NEAR(expected.B(), clr.B(), 1e-5);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(ColorMapTest, Apply)
+{
+  math::ColorMap map(math::ColorMap::JET, 4096);
+  EXPECT_TRUE(map.SetRange(0.5, 8.0));
+
+  std::vector<float> values;
+  for (int i = 0; i < 100; ++i)
+    values.push_back(i * 0.1f);
+  values.push_back(math::NAN_F);
+  const size_t n = values.size();
+
+  std::vector<unsigned int> rgba(n);
+  std::vector<unsigned int> bgra(n);
+  std::vector<float> rgbaFloat(4*n);
+  map.Apply(values.data(), rgba.data(), n);
+  map.Apply(values.data(), bgra.data(), n, math::Color::PIXEL_BGRA);
+  map.Apply(values.data(), rgbaFloat.data(), n);
+
+  std::vector<double> valuesD(values.begin(), values.end());
+  std::vector<unsigned int> rgbaD(n);
+  map.Apply(valuesD.data(), rgbaD.data(), n);
+
+  for (size_t i = 0; i < n; ++i)
+  {
+    math::Color clr = map.Value(values[i]);
+    EXPECT_EQ(clr.AsRGBA(), rgba[i]);
+    EXPECT_EQ(clr.AsBGRA(), bgra[i]);
+    EXPECT_EQ(clr.AsRGBA(), rgbaD[i]);
+    EXPECT_FLOAT_EQ(clr.R(), rgbaFloat[4*i]);
+    EXPECT_FLOAT_EQ(clr.G(), rgbaFloat[4*i+1]);
+    EXPECT_FLOAT_EQ(clr.B(), rgbaFloat[4*i+2]);
+    EXPECT_FLOAT_EQ(clr.A(), rgbaFloat[4*i+3]);
+  }
+  EXPECT_EQ(0u, rgba.back());
+}
@@ -16,6 +16,7 @@
 */
 
 #include <math.h>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include <ignition/math/Color.hh>
@@ -371,6 +372,198 @@ TEST(Color, HSV)
   EXPECT_NEAR(clr.A(), 1.0, 1e-3);
 }
 
+/////////////////////////////////////////////////
+TEST(Color, BulkPacked)
+{
+  const size_t n = 256;
+  std::vector<float> rgba(4*n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    rgba[4*i] = i / 255.0f;
+    rgba[4*i+1] = ((i * 37) % 256) / 255.0f;
+    rgba[4*i+2] = ((i * 101 + 7) % 256) / 255.0f;
+    rgba[4*i+3] = ((255 - i) % 256) / 255.0f;
+  }
+
+  const math::Color::PixelFormat formats[] = {
+    math::Color::PIXEL_RGBA, math::Color::PIXEL_BGRA,
+    math::Color::PIXEL_ARGB, math::Color::PIXEL_ABGR};
+
+  std::vector<unsigned int> packed[4];
+  for (int f = 0; f < 4; ++f)
+  {
+    packed[f].resize(n);
+    math::Color::FloatToPacked(rgba.data(), packed[f].data(), n, formats[f]);
+  }
+
+  std::vector<float> back(4*n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    math::Color clr(rgba[4*i], rgba[4*i+1], rgba[4*i+2], rgba[4*i+3]);
+    EXPECT_EQ(clr.AsRGBA(), packed[0][i]);
+    EXPECT_EQ(clr.AsBGRA(), packed[1][i]);
+    EXPECT_EQ(clr.AsARGB(), packed[2][i]);
+    EXPECT_EQ(clr.AsABGR(), packed[3][i]);
+  }
+
+  for (int f = 0; f < 4; ++f)
+  {
+    math::Color::PackedToFloat(packed[f].data(), back.data(), n, formats[f]);
+    for (size_t i = 0; i < n; ++i)
+    {
+      math::Color clr;
+      switch (formats[f])
+      {
+        case math::Color::PIXEL_BGRA:
+          clr.SetFromBGRA(packed[f][i]);
+          break;
+        case math::Color::PIXEL_ARGB:
+          clr.SetFromARGB(packed[f][i]);
+          break;
+        case math::Color::PIXEL_ABGR:
+          clr.SetFromABGR(packed[f][i]);
+          break;
+        case math::Color::PIXEL_RGBA:
+        default:
+          clr.SetFromRGBA(packed[f][i]);
+          break;
+      }
+      EXPECT_FLOAT_EQ(clr.R(), back[4*i]);
+      EXPECT_FLOAT_EQ(clr.G(), back[4*i+1]);
+      EXPECT_FLOAT_EQ(clr.B(), back[4*i+2]);
+      EXPECT_FLOAT_EQ(clr.A(), back[4*i+3]);
+    }
+
+    // Swizzle to every other format
+    for (int t = 0; t < 4; ++t)
+    {
+      std::vector<unsigned int> out(n);
+      math::Color::ConvertPacked(packed[f].data(), out.data(), n,
+          formats[f], formats[t]);
+      EXPECT_EQ(packed[t], out);
+    }
+  }
+
+  // In place conversion
+  std::vector<unsigned int> inPlace = packed[0];
+  math::Color::ConvertPacked(inPlace.data(), inPlace.data(), n,
+      math::Color::PIXEL_RGBA, math::Color::PIXEL_ABGR);
+  EXPECT_EQ(packed[3], inPlace);
+
+  // Out of range components saturate
+  const float bad[4] = {-1.0f, 2.0f, math::NAN_F, 0.5f};
+  unsigned int v = 0;
+  math::Color::FloatToPacked(bad, &v, 1);
+  EXPECT_EQ(0x00FF007Fu, v);
+}
+
+/////////////////////////////////////////////////
+TEST(Color, BulkHSVYUV)
+{
+  // Colors on a grid, including greys and black
+  std::vector<float> rgba;
+  for (int r = 0; r <= 10; ++r)
+  {
+    for (int g = 0; g <= 10; ++g)
+    {
+      for (int b = 0; b <= 10; ++b)
+      {
+        rgba.push_back(r * 0.1f);
+        rgba.push_back(g * 0.1f);
+        rgba.push_back(b * 0.1f);
+        rgba.push_back(1.0f);
+      }
+    }
+  }
+  const size_t n = rgba.size() / 4;
+
+  std::vector<float> hsv(3*n);
+  std::vector<float> yuv(3*n);
+  math::Color::RGBAToHSV(rgba.data(), hsv.data(), n);
+  math::Color::RGBAToYUV(rgba.data(), yuv.data(), n);
+
+  for (size_t i = 0; i < n; ++i)
+  {
+    math::Color clr(rgba[4*i], rgba[4*i+1], rgba[4*i+2], rgba[4*i+3]);
+
+    math::Vector3f expected = clr.HSV();
+    EXPECT_FLOAT_EQ(expected.X(), hsv[3*i]);
+    EXPECT_FLOAT_EQ(expected.Y(), hsv[3*i+1]);
+    EXPECT_FLOAT_EQ(expected.Z(), hsv[3*i+2]);
+
+    expected = clr.YUV();
+    EXPECT_FLOAT_EQ(expected.X(), yuv[3*i]);
+    EXPECT_FLOAT_EQ(expected.Y(), yuv[3*i+1]);
+    EXPECT_FLOAT_EQ(expected.Z(), yuv[3*i+2]);
+  }
+
+  // HSV with hue in degrees, as used by SetFromHSV
+  std::vector<float> hsvDeg;
+  for (int h = 0; h < 720; h += 15)
+  {
+    for (int s = 0; s <= 4; ++s)
+    {
+      hsvDeg.push_back(static_cast<float>(h));
+      hsvDeg.push_back(s * 0.25f);
+      hsvDeg.push_back(0.8f);
+    }
+  }
+  const size_t m = hsvDeg.size() / 3;
+  std::vector<float> out(4*m);
+  math::Color::HSVToRGBA(hsvDeg.data(), out.data(), m);
+  for (size_t i = 0; i < m; ++i)
+  {
+    math::Color clr;
+    clr.SetFromHSV(hsvDeg[3*i], hsvDeg[3*i+1], hsvDeg[3*i+2]);
+    EXPECT_FLOAT_EQ(clr.R(), out[4*i]);
+    EXPECT_FLOAT_EQ(clr.G(), out[4*i+1]);
+    EXPECT_FLOAT_EQ(clr.B(), out[4*i+2]);
+    EXPECT_FLOAT_EQ(1.0f, out[4*i+3]);
+  }
+
+  // Values above 1 are clamped like SetFromHSV does
+  const float hsvBig[9] = {120.0f, 0.5f, 2.0f, 30.0f, 0.25f, 80.0f,
+                           300.0f, 0.9f, 1.5f};
+  math::Color::HSVToRGBA(hsvBig, out.data(), 3);
+  for (size_t i = 0; i < 3; ++i)
+  {
+    math::Color clr;
+    clr.SetFromHSV(hsvBig[3*i], hsvBig[3*i+1], hsvBig[3*i+2]);
+    EXPECT_FLOAT_EQ(clr.R(), out[4*i]);
+    EXPECT_FLOAT_EQ(clr.G(), out[4*i+1]);
+    EXPECT_FLOAT_EQ(clr.B(), out[4*i+2]);
+  }
+  EXPECT_FLOAT_EQ(2.0f / 255.0f, out[1]);
+
+  // YUV back to RGBA, for values that stay in range
+  const float yuvIn[6] = {0.5f, 0.0f, 0.0f, 0.4f, 0.1f, 0.2f};
+  math::Color::YUVToRGBA(yuvIn, out.data(), 2);
+  for (size_t i = 0; i < 2; ++i)
+  {
+    math::Color clr;
+    clr.SetFromYUV(yuvIn[3*i], yuvIn[3*i+1], yuvIn[3*i+2]);
+    EXPECT_FLOAT_EQ(clr.R(), out[4*i]);
+    EXPECT_FLOAT_EQ(clr.G(), out[4*i+1]);
+    EXPECT_FLOAT_EQ(clr.B(), out[4*i+2]);
+    EXPECT_FLOAT_EQ(1.0f, out[4*i+3]);
+  }
+
+  // Out of range values are clamped like SetFromYUV does
+  const float yuvBig[9] = {1.0f, 0.5f, 0.5f, 200.0f, 100.0f, 100.0f,
+                           0.1f, -0.5f, 0.5f};
+  math::Color::YUVToRGBA(yuvBig, out.data(), 3);
+  for (size_t i = 0; i < 3; ++i)
+  {
+    math::Color clr;
+    clr.SetFromYUV(yuvBig[3*i], yuvBig[3*i+1], yuvBig[3*i+2]);
+    EXPECT_FLOAT_EQ(clr.R(), out[4*i]);
+    EXPECT_FLOAT_EQ(clr.G(), out[4*i+1]);
+    EXPECT_FLOAT_EQ(clr.B(), out[4*i+2]);
+    EXPECT_FLOAT_EQ(1.0f, out[4*i+3]);
+  }
+  EXPECT_FLOAT_EQ(1.57f / 255.0f, out[0]);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
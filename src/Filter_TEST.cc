@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <vector>
+
 #include "ignition/math/Filter.hh"
 
 using namespace ignition;
@@ -103,3 +106,220 @@ TEST(FilterTest, BiquadVector3)
   EXPECT_EQ(filterB.Process(math::Vector3d(0.1, 20.3, 33.45)),
             math::Vector3d(0.031748, 6.44475, 10.6196));
 }
+
+/////////////////////////////////////////////////
+TEST(FilterTest, BiquadBank)
+{
+  math::BiQuadBankd empty;
+  EXPECT_EQ(empty.Channels(), 0u);
+
+  const size_t channels = 5;
+  math::BiQuadBankd bank(channels, 0.3, 1.4);
+  EXPECT_EQ(bank.Channels(), channels);
+
+  // Each channel of the bank matches a standalone BiQuad
+  std::vector<math::BiQuad<double>> filters(channels);
+  for (size_t c = 0; c < channels; ++c)
+  {
+    double fc = 0.1 + 0.1 * c;
+    double q = 0.3 + 0.2 * c;
+    bank.ChannelFc(c, fc, 1.4, q);
+    filters[c].Fc(fc, 1.4, q);
+    EXPECT_DOUBLE_EQ(bank.Value(c), 0.0);
+  }
+
+  std::vector<double> in(channels);
+  std::vector<double> out(channels);
+  for (int f = 0; f < 20; ++f)
+  {
+    for (size_t c = 0; c < channels; ++c)
+      in[c] = std::sin(0.3 * f + c) + 0.1 * c;
+
+    bank.Process(in.data(), out.data());
+    for (size_t c = 0; c < channels; ++c)
+    {
+      double expected = filters[c].Process(in[c]);
+      EXPECT_NEAR(out[c], expected, 1e-12);
+      EXPECT_DOUBLE_EQ(bank.Values()[c], out[c]);
+    }
+  }
+
+  // Several interleaved frames in place
+  const size_t frames = 8;
+  std::vector<double> block(frames * channels);
+  for (size_t i = 0; i < block.size(); ++i)
+    block[i] = std::cos(0.05 * i);
+  std::vector<double> expected(block.size());
+  for (size_t f = 0; f < frames; ++f)
+  {
+    for (size_t c = 0; c < channels; ++c)
+    {
+      expected[f * channels + c] =
+        filters[c].Process(block[f * channels + c]);
+    }
+  }
+  bank.Process(block.data(), block.data(), frames);
+  for (size_t i = 0; i < block.size(); ++i)
+    EXPECT_NEAR(block[i], expected[i], 1e-12);
+
+  bank.Set(4.5);
+  for (size_t c = 0; c < channels; ++c)
+    EXPECT_DOUBLE_EQ(bank.Value(c), 4.5);
+  bank.Set(2, 1.5);
+  EXPECT_DOUBLE_EQ(bank.Value(2), 1.5);
+
+  // A constant input stays constant once the state is settled on it
+  bank.Set(1.5);
+  std::vector<double> constant(channels, 1.5);
+  bank.Process(constant.data(), out.data());
+  for (size_t c = 0; c < channels; ++c)
+    EXPECT_NEAR(out[c], 1.5, 1e-12);
+
+  // Float bank against the double implementation
+  math::BiQuadBankf bankf(channels, 0.3, 1.4);
+  math::BiQuad<double> filterd(0.3, 1.4);
+  std::vector<float> inf(channels, 1.2f);
+  std::vector<float> outf(channels);
+  bankf.Process(inf.data(), outf.data());
+  double expectedd = filterd.Process(1.2);
+  for (size_t c = 0; c < channels; ++c)
+    EXPECT_NEAR(outf[c], expectedd, 1e-6);
+
+  bankf.Resize(7);
+  EXPECT_EQ(bankf.Channels(), 7u);
+  EXPECT_FLOAT_EQ(bankf.Value(6), 0.0f);
+
+  // Integer literal channel with the default Q
+  math::BiQuadBankd literal(2, 0.3, 1.4);
+  literal.ChannelFc(0, 10.0, 100.0);
+  math::BiQuad<double> single(10.0, 100.0);
+  const double input[2] = {1.0, 1.0};
+  double output[2];
+  literal.Process(input, output);
+  EXPECT_DOUBLE_EQ(single.Process(1.0), output[0]);
+  math::BiQuad<double> unchanged(0.3, 1.4);
+  EXPECT_DOUBLE_EQ(unchanged.Process(1.0), output[1]);
+}
+
+/////////////////////////////////////////////////
+TEST(FilterTest, BlockProcess)
+{
+  const size_t n = 32;
+  std::vector<double> in(n);
+  for (size_t i = 0; i < n; ++i)
+    in[i] = std::sin(0.4 * i) + 0.2;
+  std::vector<double> out(n);
+
+  // OnePole
+  {
+    math::OnePole<double> single(0.6, 1.4);
+    math::OnePole<double> block(0.6, 1.4);
+    block.Process(in.data(), out.data(), n);
+    for (size_t i = 0; i < n; ++i)
+      EXPECT_DOUBLE_EQ(out[i], single.Process(in[i]));
+    EXPECT_DOUBLE_EQ(block.Value(), single.Value());
+  }
+
+  // BiQuad, in place and in two chunks
+  {
+    math::BiQuad<double> single(0.3, 1.4);
+    math::BiQuad<double> block(0.3, 1.4);
+    std::vector<double> buffer(in);
+    block.Process(buffer.data(), buffer.data(), 10);
+    block.Process(buffer.data() + 10, buffer.data() + 10, n - 10);
+    for (size_t i = 0; i < n; ++i)
+      EXPECT_DOUBLE_EQ(buffer[i], single.Process(in[i]));
+    EXPECT_DOUBLE_EQ(block.Value(), single.Value());
+
+    // Empty block leaves the state untouched
+    block.Process(buffer.data(), buffer.data(), 0);
+    EXPECT_DOUBLE_EQ(block.Value(), single.Value());
+  }
+
+  // Vector3 filters
+  {
+    std::vector<math::Vector3d> vin(n);
+    for (size_t i = 0; i < n; ++i)
+      vin[i] = math::Vector3d(in[i], -in[i], 2 * in[i]);
+    std::vector<math::Vector3d> vout(n);
+
+    math::OnePoleVector3 onePole(6.5, 22.4);
+    math::OnePoleVector3 onePoleBlock(6.5, 22.4);
+    onePoleBlock.Process(vin.data(), vout.data(), n);
+    for (size_t i = 0; i < n; ++i)
+      EXPECT_EQ(vout[i], onePole.Process(vin[i]));
+
+    math::BiQuadVector3 biQuad(6.5, 22.4);
+    math::BiQuadVector3 biQuadBlock(6.5, 22.4);
+    biQuadBlock.Process(vin.data(), vout.data(), n);
+    for (size_t i = 0; i < n; ++i)
+      EXPECT_EQ(vout[i], biQuad.Process(vin[i]));
+  }
+
+  // OnePoleQuaternion
+  {
+    std::vector<math::Quaterniond> qin(n);
+    for (size_t i = 0; i < n; ++i)
+      qin[i] = math::Quaterniond(0, 0, 0.1 * i);
+    std::vector<math::Quaterniond> qout(n);
+
+    math::OnePoleQuaternion single(6.5, 22.4);
+    math::OnePoleQuaternion block(6.5, 22.4);
+    block.Process(qin.data(), qout.data(), n);
+    for (size_t i = 0; i < n; ++i)
+      EXPECT_EQ(qout[i], single.Process(qin[i]));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(FilterTest, BiquadCascade)
+{
+  math::BiQuadCascade<double> empty;
+  EXPECT_EQ(empty.Sections(), 0u);
+  EXPECT_DOUBLE_EQ(empty.Process(1.5), 1.5);
+
+  // A single section is a second-order Butterworth filter
+  math::BiQuadCascade<double> second(1, 0.3, 1.4);
+  math::BiQuad<double> biQuad;
+  biQuad.Fc(0.3, 1.4, 1.0 / std::sqrt(2.0));
+  for (int i = 0; i < 10; ++i)
+  {
+    double x = std::cos(0.7 * i);
+    EXPECT_NEAR(second.Process(x), biQuad.Process(x), 1e-12);
+  }
+
+  // Fourth order, compared with two sections run by hand
+  math::BiQuadCascade<double> fourth(2);
+  EXPECT_EQ(fourth.Sections(), 2u);
+  fourth.SectionFc(0, 0.2, 1.4, 0.6);
+  fourth.SectionFc(1, 0.2, 1.4, 1.3);
+  math::BiQuad<double> first;
+  first.Fc(0.2, 1.4, 0.6);
+  math::BiQuad<double> last;
+  last.Fc(0.2, 1.4, 1.3);
+
+  const size_t n = 40;
+  std::vector<double> in(n);
+  for (size_t i = 0; i < n; ++i)
+    in[i] = std::sin(0.25 * i) + (i % 3 == 0 ? 0.5 : 0.0);
+  std::vector<double> out(n);
+
+  math::BiQuadCascade<double> fourthBlock(fourth);
+  fourthBlock.Process(in.data(), out.data(), n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    double expected = last.Process(first.Process(in[i]));
+    EXPECT_NEAR(fourth.Process(in[i]), expected, 1e-12);
+    EXPECT_NEAR(out[i], expected, 1e-12);
+  }
+  EXPECT_NEAR(fourthBlock.Value(), fourth.Value(), 1e-12);
+
+  // Unity gain at DC
+  math::BiQuadCascade<double> dc(3, 10, 100);
+  dc.Set(2.0);
+  EXPECT_DOUBLE_EQ(dc.Value(), 2.0);
+  std::vector<double> constant(n, 2.0);
+  dc.Process(constant.data(), out.data(), n);
+  for (size_t i = 0; i < n; ++i)
+    EXPECT_NEAR(out[i], 2.0, 1e-12);
+}
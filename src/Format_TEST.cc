@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "ignition/math/Format.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+TEST(FormatTest, Vectors)
+{
+  char buffer[128];
+
+  EXPECT_EQ(6u, math::format(buffer, sizeof(buffer),
+        math::Vector2d(1.5, -2)));
+  EXPECT_STREQ("1.5 -2", buffer);
+
+  EXPECT_EQ(11u, math::format(buffer, sizeof(buffer),
+        math::Vector3d(0.1, 0.2, 0.3)));
+  EXPECT_STREQ("0.1 0.2 0.3", buffer);
+
+  EXPECT_EQ(7u, math::format(buffer, sizeof(buffer),
+        math::Vector4i(1, 2, 3, 4)));
+  EXPECT_STREQ("1 2 3 4", buffer);
+
+  math::format(buffer, sizeof(buffer), math::Vector3d(1, 2, 3), 2);
+  EXPECT_STREQ("1.00 2.00 3.00", buffer);
+
+  // Float vectors are written at float precision
+  math::format(buffer, sizeof(buffer), math::Vector3f(0.1f, 0, -2.5e-7f));
+  EXPECT_STREQ("0.1 0 -2.5e-7", buffer);
+  math::format(buffer, sizeof(buffer), math::Vector2f(1.0f / 3, 1e30f));
+  EXPECT_STREQ("0.33333334 1e+30", buffer);
+  math::format(buffer, sizeof(buffer), math::Vector3f(0.1f, 0, 0), 3);
+  EXPECT_STREQ("0.100 0.000 0.000", buffer);
+
+  // Too small
+  EXPECT_EQ(0u, math::format(buffer, 5, math::Vector3d(1, 2, 3)));
+  EXPECT_STREQ("", buffer);
+  EXPECT_EQ(5u, math::format(buffer, 6, math::Vector3d(1, 2, 3)));
+  EXPECT_STREQ("1 2 3", buffer);
+}
+
+/////////////////////////////////////////////////
+TEST(FormatTest, RoundTrip)
+{
+  // Text written by format is parsed back exactly by Parse
+  char buffer[256];
+  const math::Vector3d v(1.0 / 3.0, -1e-300, 12345.6789);
+  size_t len = math::format(buffer, sizeof(buffer), v);
+  const char *pos = buffer;
+  math::Vector3d parsedV;
+  EXPECT_TRUE(math::Vector3d::Parse(pos, buffer + len, parsedV));
+  EXPECT_DOUBLE_EQ(v.X(), parsedV.X());
+  EXPECT_DOUBLE_EQ(v.Y(), parsedV.Y());
+  EXPECT_DOUBLE_EQ(v.Z(), parsedV.Z());
+
+  const math::Pose3d pose(1, -2, 3, 0.1, -0.2, 0.3);
+  len = math::format(buffer, sizeof(buffer), pose);
+  pos = buffer;
+  math::Pose3d parsedPose;
+  EXPECT_TRUE(math::Pose3d::Parse(pos, buffer + len, parsedPose));
+  EXPECT_EQ(pose, parsedPose);
+}
+
+/////////////////////////////////////////////////
+TEST(FormatTest, Types)
+{
+  char buffer[256];
+
+  math::format(buffer, sizeof(buffer), math::Angle(0.5));
+  EXPECT_STREQ("0.5", buffer);
+
+  // Rotations are written as Euler angles
+  char euler[128];
+  const math::Quaterniond q(0.1, 0.2, 0.3);
+  math::format(euler, sizeof(euler), q.Euler());
+  math::format(buffer, sizeof(buffer), q);
+  EXPECT_STREQ(euler, buffer);
+
+  math::format(buffer, sizeof(buffer),
+      math::Pose3d(1, 2, 3, 0.5, 0, 0), 1);
+  EXPECT_EQ(0, std::strncmp("1.0 2.0 3.0 0.5 ", buffer, 16));
+
+  math::format(buffer, sizeof(buffer), math::Matrix3d::Identity);
+  EXPECT_STREQ("1 0 0 0 1 0 0 0 1", buffer);
+
+  math::format(buffer, sizeof(buffer), math::Matrix4d::Identity);
+  EXPECT_STREQ("1 0 0 0 0 1 0 0 0 0 1 0 0 0 0 1", buffer);
+
+  math::format(buffer, sizeof(buffer), math::Line2d(0, 1, 2, 3));
+  EXPECT_STREQ("0 1 2 3", buffer);
+
+  math::format(buffer, sizeof(buffer), math::Line3d(0, 1, 2, 3, 4, 5));
+  EXPECT_STREQ("0 1 2 3 4 5", buffer);
+
+  math::format(buffer, sizeof(buffer), math::Color(1, 0.5f, 0, 1));
+  EXPECT_STREQ("1 0.5 0 1", buffer);
+  math::format(buffer, sizeof(buffer), math::Color(0.1f, 0.2f, 0.3f, 0.7f));
+  EXPECT_STREQ("0.1 0.2 0.3 0.7", buffer);
+
+  const math::Box box(math::Vector3d(-1, -2, -3), math::Vector3d(1, 2, 3));
+  EXPECT_EQ(24u, math::format(buffer, sizeof(buffer), box));
+  EXPECT_STREQ("Min[-1 -2 -3] Max[1 2 3]", buffer);
+  EXPECT_EQ(0u, math::format(buffer, 20, box));
+  EXPECT_STREQ("", buffer);
+  EXPECT_EQ(24u, math::format(buffer, 25, box));
+}
@@ -14,8 +14,664 @@
  * limitations under the License.
  *
 */
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
 #include "ignition/math/Helpers.hh"
 
+namespace
+{
+  /// \brief Powers of ten that are exactly representable as doubles.
+  const double kExactPow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+  /// \brief Check whether a character separates numbers.
+  /// \param[in] _c Character to check.
+  /// \return True for white spaces and commas.
+  inline bool isSeparator(const char _c)
+  {
+    return _c == ' ' || _c == ',' || _c == '\t' || _c == '\n' ||
+           _c == '\r' || _c == '\v' || _c == '\f';
+  }
+
+  /// \brief Check whether a character is a decimal digit.
+  /// \param[in] _c Character to check.
+  /// \return True for '0' to '9'.
+  inline bool isDigit(const char _c)
+  {
+    return static_cast<unsigned char>(_c - '0') < 10;
+  }
+
+  /// \brief Skip white spaces and commas.
+  /// \param[in] _pos Start of the text.
+  /// \param[in] _end End of the text.
+  /// \return First character that is not a separator, or _end.
+  inline const char *skipSeparators(const char *_pos, const char *_end)
+  {
+    while (_pos < _end && isSeparator(*_pos))
+      ++_pos;
+    return _pos;
+  }
+
+  /// \brief Case insensitive match of a lower case word.
+  /// \param[in] _pos Start of the text.
+  /// \param[in] _end End of the text.
+  /// \param[in] _word Lower case word.
+  /// \return Pointer past the word, or nullptr if it does not match.
+  const char *matchWord(const char *_pos, const char *_end, const char *_word)
+  {
+    for (; *_word; ++_word, ++_pos)
+    {
+      if (_pos == _end || (*_pos | 0x20) != *_word)
+        return nullptr;
+    }
+    return _pos;
+  }
+
+  /// \brief Convert a number with strtod, for the rare values that
+  /// cannot be computed exactly from a 64 bit mantissa.
+  /// \param[in] _begin Start of the number, without sign.
+  /// \param[in] _end End of the number.
+  /// \param[out] _value Parsed value.
+  /// \return False if the number is too long.
+  bool slowParse(const char *_begin, const char *_end, double &_value)
+  {
+    char buffer[512];
+    const size_t len = static_cast<size_t>(_end - _begin);
+    if (len >= sizeof(buffer))
+      return false;
+
+    std::memcpy(buffer, _begin, len);
+    buffer[len] = '\0';
+
+    // strtod expects the decimal point of the current locale
+    const char point = *std::localeconv()->decimal_point;
+    char *dot = static_cast<char *>(std::memchr(buffer, '.', len));
+    if (dot)
+      *dot = point;
+
+    _value = std::strtod(buffer, nullptr);
+    return true;
+  }
+
+  /// \brief Powers of ten as 64 bit integers, up to 10^19.
+  const uint64_t kPow10U64[] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull,
+    10000000ull, 100000000ull, 1000000000ull, 10000000000ull,
+    100000000000ull, 1000000000000ull, 10000000000000ull,
+    100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+    100000000000000000ull, 1000000000000000000ull,
+    10000000000000000000ull};
+
+  /// \brief Normalized 64 bit significands of 10^-348, 10^-340, ...,
+  /// 10^340, used by the Grisu2 algorithm.
+  const uint64_t kCachedPowersF[] = {
+    0xfa8fd5a0081c0288ull, 0xbaaee17fa23ebf76ull, 0x8b16fb203055ac76ull,
+    0xcf42894a5dce35eaull, 0x9a6bb0aa55653b2dull, 0xe61acf033d1a45dfull,
+    0xab70fe17c79ac6caull, 0xff77b1fcbebcdc4full, 0xbe5691ef416bd60cull,
+    0x8dd01fad907ffc3cull, 0xd3515c2831559a83ull, 0x9d71ac8fada6c9b5ull,
+    0xea9c227723ee8bcbull, 0xaecc49914078536dull, 0x823c12795db6ce57ull,
+    0xc21094364dfb5637ull, 0x9096ea6f3848984full, 0xd77485cb25823ac7ull,
+    0xa086cfcd97bf97f4ull, 0xef340a98172aace5ull, 0xb23867fb2a35b28eull,
+    0x84c8d4dfd2c63f3bull, 0xc5dd44271ad3cdbaull, 0x936b9fcebb25c996ull,
+    0xdbac6c247d62a584ull, 0xa3ab66580d5fdaf6ull, 0xf3e2f893dec3f126ull,
+    0xb5b5ada8aaff80b8ull, 0x87625f056c7c4a8bull, 0xc9bcff6034c13053ull,
+    0x964e858c91ba2655ull, 0xdff9772470297ebdull, 0xa6dfbd9fb8e5b88full,
+    0xf8a95fcf88747d94ull, 0xb94470938fa89bcfull, 0x8a08f0f8bf0f156bull,
+    0xcdb02555653131b6ull, 0x993fe2c6d07b7facull, 0xe45c10c42a2b3b06ull,
+    0xaa242499697392d3ull, 0xfd87b5f28300ca0eull, 0xbce5086492111aebull,
+    0x8cbccc096f5088ccull, 0xd1b71758e219652cull, 0x9c40000000000000ull,
+    0xe8d4a51000000000ull, 0xad78ebc5ac620000ull, 0x813f3978f8940984ull,
+    0xc097ce7bc90715b3ull, 0x8f7e32ce7bea5c70ull, 0xd5d238a4abe98068ull,
+    0x9f4f2726179a2245ull, 0xed63a231d4c4fb27ull, 0xb0de65388cc8ada8ull,
+    0x83c7088e1aab65dbull, 0xc45d1df942711d9aull, 0x924d692ca61be758ull,
+    0xda01ee641a708deaull, 0xa26da3999aef774aull, 0xf209787bb47d6b85ull,
+    0xb454e4a179dd1877ull, 0x865b86925b9bc5c2ull, 0xc83553c5c8965d3dull,
+    0x952ab45cfa97a0b3ull, 0xde469fbd99a05fe3ull, 0xa59bc234db398c25ull,
+    0xf6c69a72a3989f5cull, 0xb7dcbf5354e9beceull, 0x88fcf317f22241e2ull,
+    0xcc20ce9bd35c78a5ull, 0x98165af37b2153dfull, 0xe2a0b5dc971f303aull,
+    0xa8d9d1535ce3b396ull, 0xfb9b7cd9a4a7443cull, 0xbb764c4ca7a44410ull,
+    0x8bab8eefb6409c1aull, 0xd01fef10a657842cull, 0x9b10a4e5e9913129ull,
+    0xe7109bfba19c0c9dull, 0xac2820d9623bf429ull, 0x80444b5e7aa7cf85ull,
+    0xbf21e44003acdd2dull, 0x8e679c2f5e44ff8full, 0xd433179d9c8cb841ull,
+    0x9e19db92b4e31ba9ull, 0xeb96bf6ebadf77d9ull, 0xaf87023b9bf0ee6bull
+};
+
+  /// \brief Binary exponents matching kCachedPowersF.
+  const int16_t kCachedPowersE[] = {
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+    -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+    -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+    -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+    -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+    109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+    641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+    907, 933, 960, 986, 1013, 1039, 1066
+};
+
+  /// \brief A floating point number with a 64 bit significand, f * 2^e,
+  /// as described in "Printing Floating-Point Numbers Quickly and
+  /// Accurately with Integers" by Florian Loitsch.
+  class DiyFp
+  {
+    /// \brief Constructor.
+    /// \param[in] _f Significand.
+    /// \param[in] _e Binary exponent.
+    public: DiyFp(const uint64_t _f, const int _e)
+    : f(_f), e(_e)
+    {
+    }
+
+    /// \brief Constructor from a finite positive double.
+    /// \param[in] _d Value.
+    public: explicit DiyFp(const double _d)
+    {
+      uint64_t bits;
+      std::memcpy(&bits, &_d, sizeof(bits));
+      const int biased = static_cast<int>((bits >> 52) & 0x7FF);
+      const uint64_t significand = bits & kSignificandMask;
+      if (biased != 0)
+      {
+        this->f = significand + kHiddenBit;
+        this->e = biased - kExponentBias;
+      }
+      else
+      {
+        this->f = significand;
+        this->e = 1 - kExponentBias;
+      }
+    }
+
+    /// \brief Constructor from a finite positive float.
+    /// \param[in] _d Value.
+    public: explicit DiyFp(const float _d)
+    {
+      uint32_t bits;
+      std::memcpy(&bits, &_d, sizeof(bits));
+      const int biased = static_cast<int>((bits >> 23) & 0xFF);
+      const uint64_t significand = bits & kFloatSignificandMask;
+      if (biased != 0)
+      {
+        this->f = significand + kFloatHiddenBit;
+        this->e = biased - kFloatExponentBias;
+      }
+      else
+      {
+        this->f = significand;
+        this->e = 1 - kFloatExponentBias;
+      }
+    }
+
+    /// \brief Subtraction, both numbers must have the same exponent.
+    /// \param[in] _d Number to subtract.
+    /// \return Difference.
+    public: DiyFp operator-(const DiyFp &_d) const
+    {
+      return DiyFp(this->f - _d.f, this->e);
+    }
+
+    /// \brief Multiplication, keeping the rounded upper 64 bits of the
+    /// product of the significands.
+    /// \param[in] _d Number to multiply by.
+    /// \return Product.
+    public: DiyFp operator*(const DiyFp &_d) const
+    {
+      const uint64_t mask = 0xFFFFFFFFull;
+      const uint64_t a = this->f >> 32;
+      const uint64_t b = this->f & mask;
+      const uint64_t c = _d.f >> 32;
+      const uint64_t d = _d.f & mask;
+      const uint64_t ac = a * c;
+      const uint64_t bc = b * c;
+      const uint64_t ad = a * d;
+      const uint64_t bd = b * d;
+      uint64_t tmp = (bd >> 32) + (ad & mask) + (bc & mask);
+      // Round
+      tmp += 1ull << 31;
+      return DiyFp(ac + (ad >> 32) + (bc >> 32) + (tmp >> 32),
+                   this->e + _d.e + 64);
+    }
+
+    /// \brief Shift the significand so that its highest bit is set.
+    /// \return Normalized number.
+    public: DiyFp Normalize() const
+    {
+      DiyFp res = *this;
+      while (!(res.f & (1ull << 63)))
+      {
+        res.f <<= 1;
+        res.e--;
+      }
+      return res;
+    }
+
+    /// \brief Compute the normalized boundaries of the interval of
+    /// numbers that round to this double or float.
+    /// \param[in] _hiddenBit Hidden bit of the type of the number,
+    /// kHiddenBit or kFloatHiddenBit.
+    /// \param[out] _minus Lower boundary.
+    /// \param[out] _plus Upper boundary.
+    public: void NormalizedBoundaries(const uint64_t _hiddenBit,
+                                      DiyFp &_minus, DiyFp &_plus) const
+    {
+      DiyFp pl = DiyFp((this->f << 1) + 1, this->e - 1).Normalize();
+      // The lower boundary is closer when f is a power of two
+      DiyFp mi = (this->f == _hiddenBit) ?
+        DiyFp((this->f << 2) - 1, this->e - 2) :
+        DiyFp((this->f << 1) - 1, this->e - 1);
+      mi.f <<= mi.e - pl.e;
+      mi.e = pl.e;
+      _plus = pl;
+      _minus = mi;
+    }
+
+    /// \brief Hidden bit of a normal double.
+    public: static const uint64_t kHiddenBit = 0x0010000000000000ull;
+
+    /// \brief Explicit significand bits of a double.
+    public: static const uint64_t kSignificandMask = 0x000FFFFFFFFFFFFFull;
+
+    /// \brief Exponent bias of a double, including the significand size.
+    public: static const int kExponentBias = 0x3FF + 52;
+
+    /// \brief Hidden bit of a normal float.
+    public: static const uint64_t kFloatHiddenBit = 0x00800000ull;
+
+    /// \brief Explicit significand bits of a float.
+    public: static const uint64_t kFloatSignificandMask = 0x007FFFFFull;
+
+    /// \brief Exponent bias of a float, including the significand size.
+    public: static const int kFloatExponentBias = 0x7F + 23;
+
+    /// \brief Significand.
+    public: uint64_t f;
+
+    /// \brief Binary exponent.
+    public: int e;
+  };
+
+  /// \brief Get the cached power of ten that brings a number with binary
+  /// exponent _e into the range used by DigitGen.
+  /// \param[in] _e Binary exponent of the number.
+  /// \param[out] _k Decimal exponent of the result, negated.
+  /// \return Cached power of ten.
+  DiyFp cachedPower(const int _e, int &_k)
+  {
+    // 0.30102999566398114 is log10(2)
+    const double dk = (-61 - _e) * 0.30102999566398114 + 347;
+    int k = static_cast<int>(dk);
+    if (dk - k > 0.0)
+      ++k;
+
+    const unsigned int index = static_cast<unsigned int>((k >> 3) + 1);
+    _k = -(-348 + static_cast<int>(index) * 8);
+    return DiyFp(kCachedPowersF[index], kCachedPowersE[index]);
+  }
+
+  /// \brief Move the last digit towards the exact value while staying
+  /// inside the rounding interval.
+  /// \param[in,out] _buffer Digits.
+  /// \param[in] _len Number of digits.
+  /// \param[in] _delta Width of the rounding interval.
+  /// \param[in] _rest Distance from the digits to the upper boundary.
+  /// \param[in] _tenKappa Weight of the last digit.
+  /// \param[in] _wpW Distance from the exact value to the upper boundary.
+  void grisuRound(char *_buffer, const int _len, const uint64_t _delta,
+      uint64_t _rest, const uint64_t _tenKappa, const uint64_t _wpW)
+  {
+    while (_rest < _wpW && _delta - _rest >= _tenKappa &&
+           (_rest + _tenKappa < _wpW ||
+            _wpW - _rest > _rest + _tenKappa - _wpW))
+    {
+      _buffer[_len - 1]--;
+      _rest += _tenKappa;
+    }
+  }
+
+  /// \brief Generate the digits of the shortest number inside the
+  /// rounding interval.
+  /// \param[in] _w Scaled value.
+  /// \param[in] _mp Scaled upper boundary.
+  /// \param[in] _delta Width of the scaled rounding interval.
+  /// \param[out] _buffer Digits.
+  /// \param[out] _len Number of digits.
+  /// \param[in,out] _k Decimal exponent of the digits.
+  void digitGen(const DiyFp &_w, const DiyFp &_mp, uint64_t _delta,
+      char *_buffer, int &_len, int &_k)
+  {
+    const DiyFp one(1ull << -_mp.e, _mp.e);
+    const DiyFp wpW = _mp - _w;
+    uint32_t p1 = static_cast<uint32_t>(_mp.f >> -one.e);
+    uint64_t p2 = _mp.f & (one.f - 1);
+
+    int kappa = 1;
+    while (kappa < 10 && p1 >= kPow10U64[kappa])
+      ++kappa;
+
+    _len = 0;
+    while (kappa > 0)
+    {
+      const uint32_t div = static_cast<uint32_t>(kPow10U64[kappa - 1]);
+      const uint32_t d = p1 / div;
+      p1 %= div;
+      if (d || _len)
+        _buffer[_len++] = static_cast<char>('0' + d);
+      --kappa;
+      const uint64_t tmp = (static_cast<uint64_t>(p1) << -one.e) + p2;
+      if (tmp <= _delta)
+      {
+        _k += kappa;
+        grisuRound(_buffer, _len, _delta, tmp,
+            kPow10U64[kappa] << -one.e, wpW.f);
+        return;
+      }
+    }
+
+    for (;;)
+    {
+      p2 *= 10;
+      _delta *= 10;
+      const char d = static_cast<char>(p2 >> -one.e);
+      if (d || _len)
+        _buffer[_len++] = static_cast<char>('0' + d);
+      p2 &= one.f - 1;
+      --kappa;
+      if (p2 < _delta)
+      {
+        _k += kappa;
+        const int index = -kappa;
+        grisuRound(_buffer, _len, _delta, p2, one.f,
+            wpW.f * (index < 20 ? kPow10U64[index] : 0));
+        return;
+      }
+    }
+  }
+
+  /// \brief Write an exponent as e+X or e-X.
+  /// \param[in] _k Exponent.
+  /// \param[out] _buffer Destination.
+  /// \return Number of characters written.
+  int writeExponent(int _k, char *_buffer)
+  {
+    char *p = _buffer;
+    *p++ = 'e';
+    if (_k < 0)
+    {
+      *p++ = '-';
+      _k = -_k;
+    }
+    else
+    {
+      *p++ = '+';
+    }
+
+    if (_k >= 100)
+    {
+      *p++ = static_cast<char>('0' + _k / 100);
+      _k %= 100;
+      *p++ = static_cast<char>('0' + _k / 10);
+    }
+    else if (_k >= 10)
+    {
+      *p++ = static_cast<char>('0' + _k / 10);
+    }
+    *p++ = static_cast<char>('0' + _k % 10);
+    return static_cast<int>(p - _buffer);
+  }
+
+  /// \brief Write the shortest round trip text of a finite positive
+  /// double or float with Grisu2.
+  /// \param[in] _value Value, finite and greater than zero.
+  /// \param[in] _hiddenBit Hidden bit of the type of _value.
+  /// \param[out] _buffer Destination, at least 32 characters.
+  /// \return Number of characters written.
+  int shortest(const DiyFp &_value, const uint64_t _hiddenBit,
+      char *_buffer)
+  {
+    const DiyFp &v = _value;
+    DiyFp wm(0, 0), wp(0, 0);
+    v.NormalizedBoundaries(_hiddenBit, wm, wp);
+
+    int k = 0;
+    const DiyFp cmk = cachedPower(wp.e, k);
+    const DiyFp w = v.Normalize() * cmk;
+    DiyFp wpc = wp * cmk;
+    DiyFp wmc = wm * cmk;
+    wmc.f++;
+    wpc.f--;
+
+    int len = 0;
+    digitGen(w, wpc, wpc.f - wmc.f, _buffer, len, k);
+
+    // The value is digits * 10^k, with 10^(kk-1) <= value < 10^kk
+    const int kk = len + k;
+    if (k >= 0 && kk <= 21)
+    {
+      // 1234e7 -> 12340000000
+      for (int i = len; i < kk; ++i)
+        _buffer[i] = '0';
+      return kk;
+    }
+    else if (kk > 0 && kk <= 21)
+    {
+      // 1234e-2 -> 12.34
+      std::memmove(&_buffer[kk + 1], &_buffer[kk], len - kk);
+      _buffer[kk] = '.';
+      return len + 1;
+    }
+    else if (kk > -6 && kk <= 0)
+    {
+      // 1234e-6 -> 0.001234
+      const int offset = 2 - kk;
+      std::memmove(&_buffer[offset], &_buffer[0], len);
+      _buffer[0] = '0';
+      _buffer[1] = '.';
+      for (int i = 2; i < offset; ++i)
+        _buffer[i] = '0';
+      return len + offset;
+    }
+    else if (len == 1)
+    {
+      // 1e30
+      return 1 + writeExponent(kk - 1, &_buffer[1]);
+    }
+
+    // 1234e30 -> 1.234e+33
+    std::memmove(&_buffer[2], &_buffer[1], len - 1);
+    _buffer[1] = '.';
+    return len + 1 + writeExponent(kk - 1, &_buffer[len + 1]);
+  }
+
+  /// \brief Write a non-negative number with a fixed number of decimal
+  /// places.
+  /// \param[in] _value Value, finite and not negative.
+  /// \param[in] _precision Number of decimal places, in [0, 17].
+  /// \param[out] _buffer Destination, at least 400 characters.
+  /// \return Number of characters written.
+  int fixed(const double _value, const int _precision, char *_buffer)
+  {
+    // The digits are the rounded product when it decides the rounding of
+    // the exact product: below 2^52, where r + 0.5 is a double and the
+    // rounded product falls on the same side of it as the exact one, or
+    // below 2^53 when the product is exact. Otherwise the digits past
+    // the product's precision matter, such as 0.1 with 17 decimal places
+    // giving 0.10000000000000001.
+    const double scaled = _value * kExactPow10[_precision];
+    if (scaled < 4503599627370496.0 || (scaled < 9007199254740992.0 &&
+        std::fma(_value, kExactPow10[_precision], -scaled) == 0))
+    {
+      // Round to nearest, ties to even like printf. The remainder is
+      // exact, and a tie is checked against the rounding error of the
+      // product, which fma gives exactly.
+      uint64_t r = static_cast<uint64_t>(scaled);
+      const double rem = scaled - static_cast<double>(r);
+      if (rem > 0.5)
+      {
+        ++r;
+      }
+      else if (!(rem < 0.5))
+      {
+        const double err =
+          std::fma(_value, kExactPow10[_precision], -scaled);
+        if (err > 0 || (!(err < 0) && (r & 1)))
+          ++r;
+      }
+
+      char digits[24];
+      int n = 0;
+      do
+      {
+        digits[n++] = static_cast<char>('0' + r % 10);
+        r /= 10;
+      }
+      while (r > 0 || n <= _precision);
+
+      // Digits are in reverse order
+      int len = 0;
+      for (int i = n - 1; i >= 0; --i)
+      {
+        if (i == _precision - 1)
+          _buffer[len++] = '.';
+        _buffer[len++] = digits[i];
+      }
+      return len;
+    }
+
+    // Large values and many decimal places are rare, let printf handle
+    // them and restore the decimal point in case the locale changed it.
+    const int len = std::snprintf(_buffer, 400, "%.*f", _precision, _value);
+    const char point = *std::localeconv()->decimal_point;
+    for (int i = 0; i < len; ++i)
+    {
+      if (_buffer[i] == point)
+        _buffer[i] = '.';
+    }
+    return len;
+  }
+
+  /// \brief Write the shortest round trip text of a finite positive
+  /// double.
+  /// \param[in] _value Value, finite and greater than zero.
+  /// \param[out] _buffer Destination, at least 32 characters.
+  /// \return Number of characters written.
+  int shortest(const double _value, char *_buffer)
+  {
+    return shortest(DiyFp(_value), DiyFp::kHiddenBit, _buffer);
+  }
+
+  /// \brief Write the shortest text of a finite positive float that
+  /// parses back to the same float.
+  /// \param[in] _value Value, finite and greater than zero.
+  /// \param[out] _buffer Destination, at least 32 characters.
+  /// \return Number of characters written.
+  int shortest(const float _value, char *_buffer)
+  {
+    return shortest(DiyFp(_value), DiyFp::kFloatHiddenBit, _buffer);
+  }
+
+  /// \brief Write a double or a float, see formatFloat.
+  /// \param[out] _buffer Destination buffer.
+  /// \param[in] _size Size of _buffer.
+  /// \param[in] _value Number to write.
+  /// \param[in] _precision Number of decimal places, or a negative value
+  /// for the shortest round trip text.
+  /// \return Number of characters written, or 0 if _buffer is too small.
+  template<typename T>
+  size_t formatNumber(char *_buffer, const size_t _size, const T _value,
+      const int _precision)
+  {
+    char text[400];
+    char *p = text;
+    if (std::signbit(_value) && !std::isnan(_value))
+      *p++ = '-';
+
+    const T magnitude = std::fabs(_value);
+    int len = 0;
+    if (std::isnan(_value))
+    {
+      std::memcpy(p, "nan", 3);
+      len = 3;
+    }
+    else if (std::isinf(_value))
+    {
+      std::memcpy(p, "inf", 3);
+      len = 3;
+    }
+    else if (_precision >= 0)
+    {
+      len = fixed(magnitude, std::min(_precision, 17), p);
+    }
+    else if (std::fpclassify(_value) == FP_ZERO)
+    {
+      *p = '0';
+      len = 1;
+    }
+    else
+    {
+      len = shortest(magnitude, p);
+    }
+
+    const size_t total = static_cast<size_t>(p - text + len);
+    if (total >= _size)
+    {
+      if (_size > 0)
+        _buffer[0] = '\0';
+      return 0;
+    }
+
+    std::memcpy(_buffer, text, total);
+    _buffer[total] = '\0';
+    return total;
+  }
+
+  /// \brief Write a list of doubles or floats, see formatFloats.
+  /// \param[out] _buffer Destination buffer.
+  /// \param[in] _size Size of _buffer.
+  /// \param[in] _values Numbers to write.
+  /// \param[in] _n Number of values.
+  /// \param[in] _precision Number of decimal places, or a negative value
+  /// for the shortest round trip text.
+  /// \param[in] _separator Character written between values.
+  /// \return Number of characters written, or 0 if _buffer is too small.
+  template<typename T>
+  size_t formatNumbers(char *_buffer, const size_t _size, const T *_values,
+      const size_t _n, const int _precision, const char _separator)
+  {
+    size_t total = 0;
+    for (size_t i = 0; i < _n; ++i)
+    {
+      if (i > 0)
+      {
+        if (total + 1 >= _size)
+        {
+          _buffer[0] = '\0';
+          return 0;
+        }
+        _buffer[total++] = _separator;
+      }
+
+      const size_t len = formatNumber(_buffer + total, _size - total,
+          _values[i], _precision);
+      if (len == 0)
+      {
+        if (_size > 0)
+          _buffer[0] = '\0';
+        return 0;
+      }
+      total += len;
+    }
+
+    if (_size > 0)
+      _buffer[total] = '\0';
+    return total;
+  }
+}
+
+
 /////////////////////////////////////////////
 ignition::math::PairOutput ignition::math::Pair(
     const ignition::math::PairInput _a, const ignition::math::PairInput _b)
@@ -45,3 +701,212 @@ ignition::math::Unpair(const ignition::math::PairOutput _key)
     std::make_tuple(static_cast<PairInput>(_key - sq),
                     static_cast<PairInput>(sqrt));
 }
+
+/////////////////////////////////////////////
+bool ignition::math::parseInt(const char *&_pos, const char *_end,
+    int &_value)
+{
+  const char *p = skipSeparators(_pos, _end);
+  const char *start = p;
+
+  bool negative = false;
+  if (p < _end && (*p == '-' || *p == '+'))
+    negative = *p++ == '-';
+
+  // Accumulate in 64 bits to detect overflow
+  const int64_t limit = negative ?
+    -static_cast<int64_t>(std::numeric_limits<int>::min()) :
+    std::numeric_limits<int>::max();
+  int64_t acc = 0;
+  const char *digits = p;
+  while (p < _end && isDigit(*p))
+  {
+    acc = acc * 10 + (*p++ - '0');
+    if (acc > limit)
+    {
+      _pos = start;
+      return false;
+    }
+  }
+
+  if (p == digits || (p < _end && !isSeparator(*p)))
+  {
+    _pos = start;
+    return false;
+  }
+
+  _value = static_cast<int>(negative ? -acc : acc);
+  _pos = p;
+  return true;
+}
+
+/////////////////////////////////////////////
+bool ignition::math::parseFloat(const char *&_pos, const char *_end,
+    double &_value)
+{
+  const char *p = skipSeparators(_pos, _end);
+  const char *start = p;
+
+  bool negative = false;
+  if (p < _end && (*p == '-' || *p == '+'))
+    negative = *p++ == '-';
+  const char *number = p;
+
+  double value = 0;
+  const char *special = nullptr;
+  if ((special = matchWord(p, _end, "nan")) != nullptr)
+  {
+    value = std::numeric_limits<double>::quiet_NaN();
+    p = special;
+  }
+  else if ((special = matchWord(p, _end, "inf")) != nullptr)
+  {
+    value = std::numeric_limits<double>::infinity();
+    const char *infinity = matchWord(p, _end, "infinity");
+    p = infinity ? infinity : special;
+  }
+  else
+  {
+    // Keep up to 19 significant digits, which always fit in 64 bits
+    uint64_t mantissa = 0;
+    int significant = 0;
+    int exponent = 0;
+    bool truncated = false;
+    bool anyDigit = false;
+
+    for (; p < _end && isDigit(*p); ++p)
+    {
+      anyDigit = true;
+      if (significant < 19)
+      {
+        mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+        significant += mantissa > 0;
+      }
+      else
+      {
+        truncated = true;
+        ++exponent;
+      }
+    }
+
+    if (p < _end && *p == '.')
+    {
+      for (++p; p < _end && isDigit(*p); ++p)
+      {
+        anyDigit = true;
+        if (significant < 19)
+        {
+          mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+          significant += mantissa > 0;
+          --exponent;
+        }
+        else
+        {
+          truncated = true;
+        }
+      }
+    }
+
+    if (!anyDigit)
+    {
+      _pos = start;
+      return false;
+    }
+
+    if (p < _end && (*p == 'e' || *p == 'E'))
+    {
+      ++p;
+      bool negativeExp = false;
+      if (p < _end && (*p == '-' || *p == '+'))
+        negativeExp = *p++ == '-';
+
+      if (p == _end || !isDigit(*p))
+      {
+        _pos = start;
+        return false;
+      }
+
+      int exp = 0;
+      for (; p < _end && isDigit(*p); ++p)
+      {
+        // Saturate, anything beyond this overflows or underflows anyway
+        if (exp < 100000)
+          exp = exp * 10 + (*p - '0');
+      }
+      exponent += negativeExp ? -exp : exp;
+    }
+
+    if (mantissa == 0 && !truncated)
+    {
+      value = 0;
+    }
+    else if (!truncated && mantissa <= (1ull << 53) &&
+             exponent >= -22 && exponent <= 22)
+    {
+      // Both operands are exact, so the result is correctly rounded
+      const double m = static_cast<double>(mantissa);
+      value = exponent < 0 ? m / kExactPow10[-exponent] :
+                             m * kExactPow10[exponent];
+    }
+    else if (!slowParse(number, p, value))
+    {
+      _pos = start;
+      return false;
+    }
+  }
+
+  if (p < _end && !isSeparator(*p))
+  {
+    _pos = start;
+    return false;
+  }
+
+  _value = negative ? -value : value;
+  _pos = p;
+  return true;
+}
+
+/////////////////////////////////////////////
+size_t ignition::math::parseInts(const char *&_pos, const char *_end,
+    int *_values, const size_t _max)
+{
+  size_t count = 0;
+  while (count < _max && parseInt(_pos, _end, _values[count]))
+    ++count;
+  return count;
+}
+
+/////////////////////////////////////////////
+size_t ignition::math::parseFloats(const char *&_pos, const char *_end,
+    double *_values, const size_t _max)
+{
+  size_t count = 0;
+  while (count < _max && parseFloat(_pos, _end, _values[count]))
+    ++count;
+  return count;
+}
+
+/////////////////////////////////////////////
+size_t ignition::math::formatFloat(char *_buffer, const size_t _size,
+    const double _value, const int _precision)
+{
+  return formatNumber(_buffer, _size, _value, _precision);
+}
+
+/////////////////////////////////////////////
+size_t ignition::math::formatFloats(char *_buffer, const size_t _size,
+    const double *_values, const size_t _n, const int _precision,
+    const char _separator)
+{
+  return formatNumbers(_buffer, _size, _values, _n, _precision,
+      _separator);
+}
+
+/////////////////////////////////////////////
+size_t ignition::math::formatFloats(char *_buffer, const size_t _size,
+    const float *_values, const size_t _n, const int _precision,
+    const char _separator)
+{
+  return formatNumbers(_buffer, _size, _values, _n, _precision,
+      _separator);
+}
@@ -17,6 +17,12 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
 #include "ignition/math/Rand.hh"
 #include "ignition/math/Vector3.hh"
 #include "ignition/math/Helpers.hh"
@@ -515,3 +521,277 @@ TEST(HelpersTest, Pair)
 #endif
   }
 }
+
+/////////////////////////////////////////////////
+TEST(HelpersTest, ParseRange)
+{
+  // Integers
+  const char *text = " 12, -7\t+3\n0 2147483647 -2147483648";
+  const char *end = text + std::strlen(text);
+  const char *pos = text;
+  int ints[8];
+  EXPECT_EQ(6u, math::parseInts(pos, end, ints, 8));
+  EXPECT_EQ(end, pos);
+  EXPECT_EQ(12, ints[0]);
+  EXPECT_EQ(-7, ints[1]);
+  EXPECT_EQ(3, ints[2]);
+  EXPECT_EQ(0, ints[3]);
+  EXPECT_EQ(2147483647, ints[4]);
+  EXPECT_EQ(-2147483647 - 1, ints[5]);
+
+  // Integer errors report the position of the invalid token
+  text = "1 2 3x 4";
+  end = text + std::strlen(text);
+  pos = text;
+  EXPECT_EQ(2u, math::parseInts(pos, end, ints, 8));
+  EXPECT_EQ(text + 4, pos);
+
+  text = "2147483648";
+  pos = text;
+  EXPECT_FALSE(math::parseInt(pos, text + std::strlen(text), ints[0]));
+  EXPECT_EQ(text, pos);
+
+  text = "1.5";
+  pos = text;
+  EXPECT_FALSE(math::parseInt(pos, text + 3, ints[0]));
+
+  // Floats
+  text = "1.5,-2.25e2 .5 5. 1E-3 +7 -0 nan -inf Infinity";
+  end = text + std::strlen(text);
+  pos = text;
+  double values[12];
+  EXPECT_EQ(10u, math::parseFloats(pos, end, values, 12));
+  EXPECT_EQ(end, pos);
+  EXPECT_DOUBLE_EQ(1.5, values[0]);
+  EXPECT_DOUBLE_EQ(-225.0, values[1]);
+  EXPECT_DOUBLE_EQ(0.5, values[2]);
+  EXPECT_DOUBLE_EQ(5.0, values[3]);
+  EXPECT_DOUBLE_EQ(0.001, values[4]);
+  EXPECT_DOUBLE_EQ(7.0, values[5]);
+  EXPECT_TRUE(std::signbit(values[6]));
+  EXPECT_TRUE(std::isnan(values[7]));
+  EXPECT_TRUE(std::isinf(values[8]) && values[8] < 0);
+  EXPECT_TRUE(std::isinf(values[9]) && values[9] > 0);
+
+  // The range does not need to be null terminated
+  text = "3.25e1xyz";
+  pos = text;
+  EXPECT_TRUE(math::parseFloat(pos, text + 6, values[0]));
+  EXPECT_DOUBLE_EQ(32.5, values[0]);
+  EXPECT_EQ(text + 6, pos);
+
+  // Float errors
+  const char *invalid[] = {"abc", "1.2.3", "1e", "1e+", "-", ".", "--1",
+    "1,5x", "0x10"};
+  for (const char *bad : invalid)
+  {
+    end = bad + std::strlen(bad);
+    pos = bad;
+    double v = 42;
+    const size_t count = math::parseFloats(pos, end, &v, 2);
+    EXPECT_NE(end, pos) << bad;
+    if (count == 0)
+    {
+      EXPECT_DOUBLE_EQ(42.0, v) << bad;
+      EXPECT_EQ(bad, pos) << bad;
+    }
+  }
+
+  // Running out of text leaves the position at the end
+  text = "1 2 ";
+  end = text + std::strlen(text);
+  pos = text;
+  EXPECT_EQ(2u, math::parseFloats(pos, end, values, 3));
+  EXPECT_EQ(end, pos);
+}
+
+/////////////////////////////////////////////////
+TEST(HelpersTest, ParseRoundTrip)
+{
+  // Values printed with enough digits to round trip must be parsed to
+  // the same double, including long mantissas and extreme exponents.
+  std::mt19937_64 gen(1234);
+  std::uniform_int_distribution<uint64_t> bits;
+  const char *formats[] = {"%.17g", "%.6g", "%.15e", "%.3f"};
+  char buffer[512];
+  for (int i = 0; i < 20000; ++i)
+  {
+    uint64_t b = bits(gen);
+    double d;
+    std::memcpy(&d, &b, sizeof(d));
+    if (!std::isfinite(d))
+      continue;
+
+    for (const char *format : formats)
+    {
+      const int len = std::snprintf(buffer, sizeof(buffer), format, d);
+      ASSERT_GT(len, 0);
+      const char *pos = buffer;
+      double parsed = 0;
+      ASSERT_TRUE(math::parseFloat(pos, buffer + len, parsed)) << buffer;
+      const double expected = std::strtod(buffer, nullptr);
+      EXPECT_EQ(0, std::memcmp(&expected, &parsed, sizeof(double)))
+        << buffer;
+    }
+  }
+
+  // Fast path boundaries
+  const char *exact[] = {"9007199254740993", "1e22", "1e23", "123456789e-22",
+    "4.9406564584124654e-324", "1.7976931348623157e308", "1e-400", "1e400",
+    "0.1", "0.000000000000000000000000000001", "12345678901234567890123"};
+  for (const char *text : exact)
+  {
+    const char *pos = text;
+    double parsed = 0;
+    ASSERT_TRUE(math::parseFloat(pos, text + std::strlen(text), parsed));
+    const double expected = std::strtod(text, nullptr);
+    EXPECT_EQ(0, std::memcmp(&expected, &parsed, sizeof(double))) << text;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(HelpersTest, FormatFloat)
+{
+  char buffer[64];
+  struct Expected
+  {
+    double value;
+    const char *text;
+  };
+  const Expected shortest[] = {
+    {0.0, "0"}, {-0.0, "-0"}, {1.0, "1"}, {-2.5, "-2.5"}, {0.1, "0.1"},
+    {1.0 / 3.0, "0.3333333333333333"}, {123456.0, "123456"},
+    {1e21, "1e+21"}, {1e20, "100000000000000000000"}, {1.5e-7, "1.5e-7"},
+    {0.000001, "0.000001"}, {1.7976931348623157e308,
+      "1.7976931348623157e+308"}, {5e-324, "5e-324"},
+    {math::NAN_D, "nan"}, {math::INF_D, "inf"}, {-math::INF_D, "-inf"}};
+  for (const Expected &e : shortest)
+  {
+    EXPECT_EQ(std::strlen(e.text),
+        math::formatFloat(buffer, sizeof(buffer), e.value));
+    EXPECT_STREQ(e.text, buffer);
+  }
+
+  const Expected fixed[] = {
+    {0.0, "0.000"}, {1.0, "1.000"}, {-2.5, "-2.500"}, {0.0005, "0.001"},
+    {1234.5678, "1234.568"}, {-0.0004, "-0.000"}, {1e30,
+      "1000000000000000019884624838656.000"}};
+  for (const Expected &e : fixed)
+  {
+    EXPECT_EQ(std::strlen(e.text),
+        math::formatFloat(buffer, sizeof(buffer), e.value, 3));
+    EXPECT_STREQ(e.text, buffer);
+  }
+  EXPECT_EQ(2u, math::formatFloat(buffer, sizeof(buffer), 12.4, 0));
+  EXPECT_STREQ("12", buffer);
+
+  // Exact ties are rounded to even, as printf does
+  math::formatFloat(buffer, sizeof(buffer), 0.25, 1);
+  EXPECT_STREQ("0.2", buffer);
+  math::formatFloat(buffer, sizeof(buffer), 0.375, 2);
+  EXPECT_STREQ("0.38", buffer);
+  math::formatFloat(buffer, sizeof(buffer), 2.5, 0);
+  EXPECT_STREQ("2", buffer);
+
+  // Buffer too small
+  EXPECT_EQ(0u, math::formatFloat(buffer, 4, 0.125));
+  EXPECT_STREQ("", buffer);
+  EXPECT_EQ(5u, math::formatFloat(buffer, 6, 0.125, -1));
+
+  // Lists
+  const double values[] = {1.5, -2.0, 0.25};
+  EXPECT_EQ(11u, math::formatFloats(buffer, sizeof(buffer), values, 3));
+  EXPECT_STREQ("1.5 -2 0.25", buffer);
+  EXPECT_EQ(15u, math::formatFloats(buffer, sizeof(buffer), values, 3, 2,
+        ','));
+  EXPECT_STREQ("1.50,-2.00,0.25", buffer);
+  EXPECT_EQ(0u, math::formatFloats(buffer, 8, values, 3));
+  EXPECT_STREQ("", buffer);
+}
+
+/////////////////////////////////////////////////
+TEST(HelpersTest, FormatRoundTrip)
+{
+  // The shortest text parses back to the same value, and is never longer
+  // than 17 significant digits.
+  std::mt19937_64 gen(4321);
+  std::uniform_int_distribution<uint64_t> bits;
+  std::uniform_real_distribution<double> uniform(-1000.0, 1000.0);
+  char buffer[32];
+  for (int i = 0; i < 100000; ++i)
+  {
+    uint64_t b = bits(gen);
+    double d;
+    std::memcpy(&d, &b, sizeof(d));
+    if (i % 2)
+      d = uniform(gen);
+    if (!std::isfinite(d))
+      continue;
+
+    const size_t len = math::formatFloat(buffer, sizeof(buffer), d);
+    ASSERT_GT(len, 0u);
+    const char *pos = buffer;
+    double parsed = 0;
+    ASSERT_TRUE(math::parseFloat(pos, buffer + len, parsed)) << buffer;
+    EXPECT_EQ(0, std::memcmp(&d, &parsed, sizeof(double))) << buffer;
+
+    // Count the significant digits
+    std::string digits;
+    for (const char *c = buffer; *c && *c != 'e'; ++c)
+    {
+      if (*c >= '0' && *c <= '9')
+        digits += *c;
+    }
+    digits.erase(0, digits.find_first_not_of('0'));
+    digits.erase(digits.find_last_not_of('0') + 1);
+    EXPECT_LE(digits.size(), 17u) << buffer;
+  }
+
+  // Fixed precision matches printf, including precisions where the
+  // scaled value has more digits than a double
+  char reference[32];
+  std::uniform_real_distribution<double> small(0.0, 10.0);
+  for (int i = 0; i < 10000; ++i)
+  {
+    const double d = i % 2 ? uniform(gen) : small(gen);
+    for (int precision = 0; precision <= 17; ++precision)
+    {
+      math::formatFloat(buffer, sizeof(buffer), d, precision);
+      std::snprintf(reference, sizeof(reference), "%.*f", precision, d);
+      EXPECT_STREQ(reference, buffer);
+    }
+  }
+
+  // The shortest text of a float parses back to the same float, and has
+  // at most 9 significant digits
+  for (int i = 0; i < 100000; ++i)
+  {
+    const uint32_t b = static_cast<uint32_t>(bits(gen));
+    float f;
+    std::memcpy(&f, &b, sizeof(f));
+    if (!std::isfinite(f))
+      continue;
+
+    const size_t len = math::formatFloats(buffer, sizeof(buffer), &f, 1);
+    ASSERT_GT(len, 0u);
+    const float parsed = std::strtof(buffer, nullptr);
+    EXPECT_EQ(0, std::memcmp(&f, &parsed, sizeof(float))) << buffer;
+
+    std::string digits;
+    for (const char *c = buffer; *c && *c != 'e'; ++c)
+    {
+      if (*c >= '0' && *c <= '9')
+        digits += *c;
+    }
+    digits.erase(0, digits.find_first_not_of('0'));
+    digits.erase(digits.find_last_not_of('0') + 1);
+    EXPECT_LE(digits.size(), 9u) << buffer;
+  }
+
+  math::formatFloat(buffer, sizeof(buffer), 0.1, 17);
+  EXPECT_STREQ("0.10000000000000001", buffer);
+  math::formatFloat(buffer, sizeof(buffer), 2.675, 16);
+  EXPECT_STREQ("2.6749999999999998", buffer);
+  math::formatFloat(buffer, sizeof(buffer), 2.675, 2);
+  EXPECT_STREQ("2.67", buffer);
+}
@@ -17,6 +17,7 @@
 
 #include <gtest/gtest.h>
 #include <cmath>
+#include <vector>
 
 #include "ignition/math/Inertial.hh"
 
@@ -465,6 +466,101 @@ TEST(Inertiald_Test, Addition)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(Inertiald_Test, AdditionOffAxis)
+{
+  // Two point-like cubes offset along a diagonal of the xy plane,
+  // which exercises the product terms of the parallel axis theorem
+  const double mass = 1.0;
+  math::MassMatrix3d small;
+  EXPECT_TRUE(small.SetFromBox(mass, math::Vector3d(1e-3, 1e-3, 1e-3)));
+  math::Inertiald a(small, math::Pose3d(1, 1, 0, 0, 0, 0));
+  math::Inertiald b(small, math::Pose3d(-1, -1, 0, 0, 0, 0));
+
+  math::Inertiald sum = a + b;
+  EXPECT_EQ(sum.Pose(), math::Pose3d::Zero);
+  const double tiny = 2 * small.IXX();
+  EXPECT_EQ(sum.MassMatrix().DiagonalMoments(),
+      math::Vector3d(2 + tiny, 2 + tiny, 4 + tiny));
+  EXPECT_EQ(sum.MassMatrix().OffDiagonalMoments(),
+      math::Vector3d(-2, 0, 0));
+}
+
+/////////////////////////////////////////////////
+TEST(Inertiald_Test, Combine)
+{
+  const double mass = 12.0;
+  const math::Vector3d size(1, 1, 1);
+  math::MassMatrix3d cubeMM3;
+  EXPECT_TRUE(cubeMM3.SetFromBox(mass, size));
+
+  // Eight rotated cubes into a larger cube
+  {
+    std::vector<math::Inertiald> cubes = {
+      math::Inertiald(cubeMM3, math::Pose3d(-0.5, -0.5, -0.5, 0, 0, 0)),
+      math::Inertiald(cubeMM3, math::Pose3d(-0.5,  0.5, -0.5, IGN_PI_2, 0, 0)),
+      math::Inertiald(cubeMM3, math::Pose3d(0.5,  -0.5, -0.5, 0, IGN_PI_2, 0)),
+      math::Inertiald(cubeMM3, math::Pose3d(0.5,   0.5, -0.5, 0, 0, IGN_PI_2)),
+      math::Inertiald(cubeMM3, math::Pose3d(-0.5, -0.5, 0.5, IGN_PI, 0, 0)),
+      math::Inertiald(cubeMM3, math::Pose3d(-0.5,  0.5, 0.5, 0, IGN_PI, 0)),
+      math::Inertiald(cubeMM3, math::Pose3d(0.5,  -0.5, 0.5, 0, 0, IGN_PI)),
+      math::Inertiald(cubeMM3, math::Pose3d(0.5,   0.5, 0.5, 0, 0, 0))};
+
+    math::Inertiald combined;
+    EXPECT_TRUE(math::Inertiald::Combine(cubes, combined));
+
+    math::MassMatrix3d trueCubeMM3;
+    EXPECT_TRUE(trueCubeMM3.SetFromBox(8*mass, 2*size));
+    EXPECT_EQ(combined, math::Inertiald(trueCubeMM3, math::Pose3d::Zero));
+  }
+
+  // Matches pairwise addition for bodies in arbitrary poses
+  {
+    std::vector<math::Inertiald> bodies;
+    for (int i = 0; i < 10; ++i)
+    {
+      math::MassMatrix3d mm;
+      EXPECT_TRUE(mm.SetFromBox(1.0 + i,
+            math::Vector3d(0.5 + 0.1*i, 1.0, 2.0 - 0.1*i)));
+      bodies.push_back(math::Inertiald(mm,
+            math::Pose3d(100 + 0.3*i, -0.2*i, 0.7*i, 0.1*i, -0.2*i, 0.3*i)));
+    }
+
+    math::Inertiald pairwise = bodies[0];
+    for (size_t i = 1; i < bodies.size(); ++i)
+      pairwise += bodies[i];
+
+    math::Inertiald combined;
+    EXPECT_TRUE(math::Inertiald::Combine(bodies, combined));
+    EXPECT_DOUBLE_EQ(combined.MassMatrix().Mass(),
+        pairwise.MassMatrix().Mass());
+    EXPECT_TRUE(combined.Pose().Pos().Equal(pairwise.Pose().Pos(), 1e-9));
+    EXPECT_EQ(combined.Pose().Rot(), math::Quaterniond::Identity);
+    EXPECT_TRUE(combined.MOI().Equal(pairwise.MOI(), 1e-8));
+  }
+
+  // Single body is moved to a frame aligned with the base frame
+  {
+    math::Inertiald body(cubeMM3, math::Pose3d(1, 2, 3, 0.1, 0.2, 0.3));
+    math::Inertiald combined;
+    EXPECT_TRUE(math::Inertiald::Combine({body}, combined));
+    EXPECT_EQ(combined.Pose().Pos(), body.Pose().Pos());
+    EXPECT_EQ(combined.MOI(), body.MOI());
+  }
+
+  // Invalid input leaves the result unchanged
+  {
+    const math::Inertiald original(cubeMM3, math::Pose3d(1, 2, 3, 0, 0, 0));
+    math::Inertiald result = original;
+    EXPECT_FALSE(math::Inertiald::Combine({}, result));
+    EXPECT_EQ(result, original);
+
+    std::vector<math::Inertiald> massless(3);
+    EXPECT_FALSE(math::Inertiald::Combine(massless, result));
+    EXPECT_EQ(result, original);
+  }
+}
+
 /////////////////////////////////////////////////
 // Addition operator has different behavior if mass is non-positive
 TEST(Inertiald_Test, AdditionInvalid)
@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "ignition/math/KdTree.hh"
+#include "ignition/math/Rand.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+/// \brief Points in four clusters of different spreads. The first 20
+/// points of the first cluster are copies of its center, more than fit in
+/// a leaf.
+/// \param[in] _count Number of points.
+/// \return Points.
+std::vector<math::Vector3d> ClusteredPoints(const size_t _count)
+{
+  const math::Vector3d centers[4] = {math::Vector3d(-8, -8, 0.5),
+    math::Vector3d(8, -6, 0), math::Vector3d(0, 7, 1),
+    math::Vector3d(5, 5, -0.5)};
+  const double sigmas[4] = {0.1, 1.0, 3.0, 0.5};
+
+  std::vector<math::Vector3d> points;
+  for (size_t i = 0; i < _count; ++i)
+  {
+    const size_t c = i % 4;
+    if (c == 0 && i < 80)
+    {
+      points.push_back(centers[c]);
+      continue;
+    }
+    points.push_back(centers[c] + math::Vector3d(
+          math::Rand::DblNormal(0, sigmas[c]),
+          math::Rand::DblNormal(0, sigmas[c]),
+          math::Rand::DblNormal(0, 0.1 * sigmas[c])));
+  }
+  return points;
+}
+
+/////////////////////////////////////////////////
+/// \brief Sorted distances from all points to a location.
+/// \param[in] _points Points.
+/// \param[in] _point Location.
+/// \return Distances.
+std::vector<double> SortedDistances(const std::vector<math::Vector3d> &_points,
+                                    const math::Vector3d &_point)
+{
+  std::vector<double> distances;
+  for (const math::Vector3d &p : _points)
+    distances.push_back(p.Distance(_point));
+  std::sort(distances.begin(), distances.end());
+  return distances;
+}
+
+/////////////////////////////////////////////////
+TEST(KdTreeTest, Empty)
+{
+  math::KdTreed tree;
+  EXPECT_EQ(0u, tree.Size());
+  EXPECT_EQ(0u, tree.Nearest(math::Vector3d::Zero));
+
+  std::vector<size_t> indices = {1};
+  std::vector<double> distances = {1.0};
+  EXPECT_EQ(0u, tree.Nearest(math::Vector3d::Zero, 3, indices, distances));
+  EXPECT_TRUE(indices.empty());
+  EXPECT_TRUE(distances.empty());
+  EXPECT_EQ(0u, tree.Radius(math::Vector3d::Zero, 1.0, indices));
+
+  // Only non finite points
+  std::vector<math::Vector3d> points = {
+    math::Vector3d(math::NAN_D, 0, 0), math::Vector3d(0, 0, math::INF_D)};
+  tree.Build(points);
+  EXPECT_EQ(2u, tree.Size());
+  EXPECT_EQ(2u, tree.Nearest(math::Vector3d::Zero));
+  EXPECT_EQ(0u, tree.Radius(math::Vector3d::Zero, 1e9, indices));
+
+  tree.Clear();
+  EXPECT_EQ(0u, tree.Size());
+}
+
+/////////////////////////////////////////////////
+TEST(KdTreeTest, Nearest)
+{
+  math::Rand::Seed(1);
+  const std::vector<math::Vector3d> points = ClusteredPoints(3000);
+  math::KdTreed tree(points);
+  EXPECT_EQ(points.size(), tree.Size());
+
+  std::vector<size_t> indices;
+  std::vector<double> distances;
+  for (int q = 0; q < 50; ++q)
+  {
+    const math::Vector3d point(math::Rand::DblUniform(-12, 12),
+        math::Rand::DblUniform(-12, 12), math::Rand::DblUniform(-1, 2));
+    const std::vector<double> expected = SortedDistances(points, point);
+
+    const size_t nearest = tree.Nearest(point);
+    ASSERT_LT(nearest, points.size());
+    EXPECT_DOUBLE_EQ(expected[0], points[nearest].Distance(point));
+
+    const size_t ks[] = {1, 7, 40};
+    for (size_t k : ks)
+    {
+      EXPECT_EQ(k, tree.Nearest(point, k, indices, distances));
+      ASSERT_EQ(k, indices.size());
+      for (size_t i = 0; i < k; ++i)
+      {
+        EXPECT_DOUBLE_EQ(expected[i], distances[i]);
+        EXPECT_DOUBLE_EQ(points[indices[i]].Distance(point), distances[i]);
+      }
+    }
+  }
+
+  // Exactly on a duplicated point, the lowest index comes first
+  EXPECT_EQ(2u, tree.Nearest(points[4], 2, indices, distances));
+  EXPECT_EQ(0u, indices[0]);
+  EXPECT_EQ(4u, indices[1]);
+  EXPECT_DOUBLE_EQ(0.0, distances[1]);
+  EXPECT_EQ(0u, tree.Nearest(points[76]));
+
+  // More neighbors than points
+  EXPECT_EQ(points.size(), tree.Nearest(math::Vector3d::Zero,
+        points.size() + 10, indices, distances));
+  EXPECT_TRUE(std::is_sorted(distances.begin(), distances.end()));
+
+  // Invalid queries
+  EXPECT_EQ(points.size(), tree.Nearest(math::Vector3d(math::NAN_D, 0, 0)));
+  EXPECT_EQ(0u, tree.Nearest(math::Vector3d::Zero, 0, indices, distances));
+}
+
+/////////////////////////////////////////////////
+TEST(KdTreeTest, Batch)
+{
+  math::Rand::Seed(2);
+  const std::vector<math::Vector3d> points = ClusteredPoints(1000);
+  math::KdTreed tree(points);
+
+  std::vector<math::Vector3d> queries = ClusteredPoints(100);
+  queries.push_back(math::Vector3d(math::NAN_D, 0, 0));
+
+  std::vector<size_t> indices;
+  std::vector<double> distances;
+  tree.Nearest(queries.data(), queries.size(), 5, indices, distances);
+  ASSERT_EQ(5 * queries.size(), indices.size());
+  ASSERT_EQ(5 * queries.size(), distances.size());
+
+  std::vector<size_t> single;
+  std::vector<double> singleDistances;
+  for (size_t q = 0; q + 1 < queries.size(); ++q)
+  {
+    EXPECT_EQ(5u, tree.Nearest(queries[q], 5, single, singleDistances));
+    for (size_t i = 0; i < 5; ++i)
+    {
+      EXPECT_EQ(single[i], indices[5 * q + i]);
+      EXPECT_DOUBLE_EQ(singleDistances[i], distances[5 * q + i]);
+    }
+  }
+
+  // The invalid query has no neighbor
+  for (size_t i = 5 * (queries.size() - 1); i < indices.size(); ++i)
+  {
+    EXPECT_EQ(points.size(), indices[i]);
+    EXPECT_TRUE(std::isinf(distances[i]));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(KdTreeTest, Radius)
+{
+  math::Rand::Seed(3);
+  const std::vector<math::Vector3d> points = ClusteredPoints(2000);
+  math::KdTreed tree(points);
+
+  std::vector<size_t> indices;
+  const double radii[] = {0.0, 0.5, 2.0, 50.0};
+  for (int q = 0; q < 30; ++q)
+  {
+    const math::Vector3d center = q == 0 ? points[4] :
+      math::Vector3d(math::Rand::DblUniform(-12, 12),
+          math::Rand::DblUniform(-12, 12), math::Rand::DblUniform(-1, 2));
+    for (double radius : radii)
+    {
+      std::vector<size_t> expected;
+      for (size_t i = 0; i < points.size(); ++i)
+      {
+        if (points[i].Distance(center) <= radius)
+          expected.push_back(i);
+      }
+      EXPECT_EQ(expected.size(), tree.Radius(center, radius, indices));
+      std::sort(indices.begin(), indices.end());
+      EXPECT_EQ(expected, indices);
+    }
+  }
+
+  EXPECT_EQ(0u, tree.Radius(math::Vector3d::Zero, -1.0, indices));
+  EXPECT_EQ(0u, tree.Radius(math::Vector3d::Zero, math::NAN_D, indices));
+}
+
+/////////////////////////////////////////////////
+TEST(KdTreeTest, Approximate)
+{
+  math::Rand::Seed(4);
+  const std::vector<math::Vector3d> points = ClusteredPoints(5000);
+  math::KdTreed tree(points);
+
+  std::vector<size_t> indices;
+  std::vector<double> distances;
+  const double epsilons[] = {0.1, 0.5, 2.0};
+  for (double epsilon : epsilons)
+  {
+    for (int q = 0; q < 50; ++q)
+    {
+      const math::Vector3d point(math::Rand::DblUniform(-12, 12),
+          math::Rand::DblUniform(-12, 12), math::Rand::DblUniform(-1, 2));
+      const std::vector<double> expected = SortedDistances(points, point);
+
+      // The error on each distance is bounded
+      EXPECT_EQ(10u, tree.Nearest(point, 10, indices, distances, epsilon));
+      for (size_t i = 0; i < 10; ++i)
+      {
+        EXPECT_LE(distances[i], expected[i] * (1 + epsilon) + 1e-12);
+        EXPECT_DOUBLE_EQ(points[indices[i]].Distance(point), distances[i]);
+      }
+
+      const size_t nearest = tree.Nearest(point, epsilon);
+      EXPECT_LE(points[nearest].Distance(point),
+          expected[0] * (1 + epsilon) + 1e-12);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(KdTreeTest, Float)
+{
+  std::vector<math::Vector3f> points;
+  for (int i = 0; i < 20; ++i)
+  {
+    for (int j = 0; j < 20; ++j)
+      points.push_back(math::Vector3f(i, j, 0));
+  }
+  math::KdTreef tree(points);
+  EXPECT_EQ(400u, tree.Size());
+
+  EXPECT_EQ(5u * 20u + 7u, tree.Nearest(math::Vector3f(5.2f, 6.9f, 1.0f)));
+
+  std::vector<size_t> indices;
+  EXPECT_EQ(5u, tree.Radius(math::Vector3f(3, 3, 0), 1.0f, indices));
+  EXPECT_EQ(9u, tree.Radius(math::Vector3f(3, 3, 0), 1.5f, indices));
+}
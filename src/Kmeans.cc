@@ -16,6 +16,7 @@
 */
 
 #include <iostream>
+#include <ignition/math/KdTree.hh>
 #include <ignition/math/Kmeans.hh>
 #include <ignition/math/Rand.hh>
 #include "ignition/math/KmeansPrivate.hh"
@@ -117,8 +118,16 @@ bool Kmeans::Cluster(int _k,
   for (auto i = 0u; i < this->dataPtr->obs.size(); ++i)
     this->dataPtr->labels[i] = 0;
 
+  // Many centroids are searched with a k-d tree rebuilt every iteration,
+  // which is cheaper than testing all the centroids for each observation.
+  const bool useTree = _k >= 16;
+  KdTreed tree;
+
   do
   {
+    if (useTree)
+      tree.Build(this->dataPtr->centroids);
+
     // Reset sums and counters.
     for (auto i = 0u; i < this->dataPtr->centroids.size(); ++i)
     {
@@ -130,7 +139,18 @@ bool Kmeans::Cluster(int _k,
     for (auto i = 0u; i < this->dataPtr->obs.size(); ++i)
     {
       // Update the labels containing the closest centroid for each point.
-      auto label = this->ClosestCentroid(this->dataPtr->obs[i]);
+      unsigned int label = 0;
+      if (useTree)
+      {
+        // Empty clusters have no finite centroid and are never returned
+        const size_t closest = tree.Nearest(this->dataPtr->obs[i]);
+        if (closest < tree.Size())
+          label = static_cast<unsigned int>(closest);
+      }
+      else
+      {
+        label = this->ClosestCentroid(this->dataPtr->obs[i]);
+      }
       if (this->dataPtr->labels[i] != label)
       {
         this->dataPtr->labels[i] = label;
@@ -140,3 +140,33 @@ TEST(KmeansTest, Append)
   std::vector<math::Vector3d> emptyVector;
   EXPECT_FALSE(kmeans.AppendObservations(emptyVector));
 }
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, ManyClusters)
+{
+  // 20 well separated clusters of 5 observations. The first 20
+  // observations, which seed the centroids, belong to different clusters.
+  const int clusters = 20;
+  std::vector<math::Vector3d> obs;
+  for (int j = 0; j < 5; ++j)
+  {
+    for (int i = 0; i < clusters; ++i)
+    {
+      obs.push_back(math::Vector3d(10.0 * (i % 5), 10.0 * (i / 5), 0.0) +
+                    math::Vector3d(0.1 * j, -0.1 * j, 0.05 * j));
+    }
+  }
+
+  math::Kmeans kmeans(obs);
+  std::vector<math::Vector3d> centroids;
+  std::vector<unsigned int> labels;
+  EXPECT_TRUE(kmeans.Cluster(clusters, centroids, labels));
+  ASSERT_EQ(static_cast<size_t>(clusters), centroids.size());
+  ASSERT_EQ(obs.size(), labels.size());
+
+  for (size_t i = 0; i < obs.size(); ++i)
+  {
+    EXPECT_EQ(i % clusters, labels[i]);
+    EXPECT_LT(centroids[labels[i]].Distance(obs[i]), 0.5);
+  }
+}
@@ -17,9 +17,12 @@
 
 #include <gtest/gtest.h>
 #include <cmath>
+#include <vector>
 
 #include "ignition/math/Helpers.hh"
 #include "ignition/math/MassMatrix3.hh"
+#include "ignition/math/Pose3.hh"
+#include "ignition/math/Triangle3.hh"
 
 using namespace ignition;
 
@@ -637,6 +640,107 @@ TEST(MassMatrix3dTest, PrincipalAxesOffsetNoRepeat)
     math::Vector3d(2, 2, 2));
 }
 
+/////////////////////////////////////////////////
+/// \brief Closed-form eigenvalues of a symmetric 3x3 matrix, used by
+/// previous versions of MassMatrix3::PrincipalMoments. Based on
+/// http://arxiv.org/abs/1306.6291v4 by Maarten Kronenburg.
+math::Vector3d ClosedFormMoments(const math::Vector3d &_id,
+                                 const math::Vector3d &_ip)
+{
+  double b = _id.Sum();
+  double c = _id[0]*_id[1] - std::pow(_ip[0], 2)
+           + _id[0]*_id[2] - std::pow(_ip[1], 2)
+           + _id[1]*_id[2] - std::pow(_ip[2], 2);
+  double d = _id[0]*std::pow(_ip[2], 2)
+           + _id[1]*std::pow(_ip[1], 2)
+           + _id[2]*std::pow(_ip[0], 2)
+           - _id[0]*_id[1]*_id[2]
+           - 2*_ip[0]*_ip[1]*_ip[2];
+  double p = std::pow(b, 2) - 3*c;
+  double q = 2*std::pow(b, 3) - 9*b*c - 27*d;
+  double delta = acos(math::clamp<double>(0.5 * q / std::pow(p, 1.5), -1, 1));
+  double moment0 = (b + 2*sqrt(p) * cos(delta / 3.0)) / 3.0;
+  double moment1 = (b + 2*sqrt(p) * cos((delta + 2*IGN_PI)/3.0)) / 3.0;
+  double moment2 = (b + 2*sqrt(p) * cos((delta - 2*IGN_PI)/3.0)) / 3.0;
+  math::sort3(moment0, moment1, moment2);
+  return math::Vector3d(moment0, moment1, moment2);
+}
+
+/////////////////////////////////////////////////
+TEST(MassMatrix3dTest, PrincipalMomentsClosedForm)
+{
+  // Compare against the closed-form solution on a set of
+  // rotated inertia matrices
+  for (int i = 0; i < 100; ++i)
+  {
+    math::Vector3d moments(2 + 0.1*i, 3 + 0.05*i, 4 + 0.13*i);
+    math::Quaterniond rot(0.3*i, -0.17*i, 0.07*i);
+    math::Matrix3d R(rot);
+    math::Matrix3d L(moments[0], 0, 0,
+                     0, moments[1], 0,
+                     0, 0, moments[2]);
+    math::MassMatrix3d m(1.0, math::Vector3d::Zero, math::Vector3d::Zero);
+    EXPECT_TRUE(m.MOI(R * L * R.Transposed()));
+
+    double m0 = moments[0];
+    double m1 = moments[1];
+    double m2 = moments[2];
+    math::sort3(m0, m1, m2);
+    math::Vector3d sorted(m0, m1, m2);
+    EXPECT_TRUE(m.PrincipalMoments(-1e-6).Equal(sorted, 1e-12));
+
+    // The closed-form solution loses accuracy for nearly repeated moments
+    math::Vector3d closedForm = ClosedFormMoments(m.DiagonalMoments(),
+        m.OffDiagonalMoments());
+    EXPECT_TRUE(m.PrincipalMoments(-1e-6).Equal(closedForm, 1e-6));
+    VerifyPrincipalMomentsAndAxes(m, -1e-6);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(MassMatrix3dTest, PrincipalMomentsAndAxesBatch)
+{
+  std::vector<math::MassMatrix3d> matrices;
+  // diagonal
+  matrices.push_back(math::MassMatrix3d(1.0, math::Vector3d(2, 3, 4),
+      math::Vector3d::Zero));
+  matrices.push_back(math::MassMatrix3d(1.0, math::Vector3d(4, 2, 3),
+      math::Vector3d::Zero));
+  // repeated moments
+  matrices.push_back(math::MassMatrix3d(1.0, math::Vector3d(4, 4, 5),
+      math::Vector3d(0, 1, 1)));
+  // all moments equal
+  matrices.push_back(math::MassMatrix3d(1.0, math::Vector3d(3, 3, 3),
+      math::Vector3d::Zero));
+  // non-repeated moments
+  matrices.push_back(math::MassMatrix3d(1.0, math::Vector3d(13, 11.75, 11.25),
+      math::Vector3d(-0.5*sqrt(3), 1.5, 0.25*sqrt(3))));
+  matrices.push_back(math::MassMatrix3d(1.0, math::Vector3d(4, 5, 6),
+      math::Vector3d(-1, 0, -1)));
+
+  for (const double tol : {1e-6, -1e-6})
+  {
+    std::vector<math::Vector3d> moments;
+    std::vector<math::Quaterniond> offsets;
+    math::MassMatrix3d::PrincipalMomentsAndAxes(matrices, moments, offsets,
+        tol);
+    ASSERT_EQ(moments.size(), matrices.size());
+    ASSERT_EQ(offsets.size(), matrices.size());
+    for (size_t i = 0; i < matrices.size(); ++i)
+    {
+      EXPECT_EQ(moments[i], matrices[i].PrincipalMoments(tol));
+      EXPECT_EQ(offsets[i], matrices[i].PrincipalAxesOffset(tol));
+    }
+  }
+
+  std::vector<math::Vector3d> moments(3);
+  std::vector<math::Quaterniond> offsets(3);
+  math::MassMatrix3d::PrincipalMomentsAndAxes(
+      std::vector<math::MassMatrix3d>(), moments, offsets);
+  EXPECT_TRUE(moments.empty());
+  EXPECT_TRUE(offsets.empty());
+}
+
 /////////////////////////////////////////////////
 TEST(MassMatrix3dTest, EquivalentBox)
 {
@@ -855,3 +959,166 @@ TEST(MassMatrix3dTest, SetFromSphere)
   }
 }
 
+
+/////////////////////////////////////////////////
+/// \brief Build a box mesh with outward facing triangles.
+/// \param[in] _size Box dimensions.
+/// \param[in] _pose Pose of the box center.
+/// \param[out] _vertices Mesh vertices.
+/// \param[out] _indices Triangle vertex indices.
+void BoxMesh(const math::Vector3d &_size, const math::Pose3d &_pose,
+             std::vector<math::Vector3d> &_vertices,
+             std::vector<unsigned int> &_indices)
+{
+  _vertices.clear();
+  for (int i = 0; i < 8; ++i)
+  {
+    math::Vector3d v(
+      (i & 1 ? 0.5 : -0.5) * _size.X(),
+      (i & 2 ? 0.5 : -0.5) * _size.Y(),
+      (i & 4 ? 0.5 : -0.5) * _size.Z());
+    _vertices.push_back(_pose.CoordPositionAdd(v));
+  }
+  _indices = {
+    0, 2, 1,  1, 2, 3,  // -z
+    4, 5, 6,  5, 7, 6,  // +z
+    0, 1, 4,  1, 5, 4,  // -y
+    2, 6, 3,  3, 6, 7,  // +y
+    0, 4, 2,  2, 4, 6,  // -x
+    1, 3, 5,  3, 7, 5   // +x
+  };
+}
+
+/////////////////////////////////////////////////
+TEST(MassMatrix3dTest, SetFromMesh)
+{
+  const double density = 2.5;
+  const math::Vector3d size(1, 4, 9);
+  const double mass = density * size.X() * size.Y() * size.Z();
+
+  // Box centered at the origin
+  {
+    std::vector<math::Vector3d> vertices;
+    std::vector<unsigned int> indices;
+    BoxMesh(size, math::Pose3d::Zero, vertices, indices);
+
+    math::MassMatrix3d m;
+    math::Vector3d com;
+    EXPECT_TRUE(m.SetFromMesh(density, vertices, indices, com));
+    EXPECT_DOUBLE_EQ(m.Mass(), mass);
+    EXPECT_EQ(com, math::Vector3d::Zero);
+
+    math::MassMatrix3d expected;
+    EXPECT_TRUE(expected.SetFromBox(mass, size));
+    EXPECT_EQ(m, expected);
+
+    // Same result from Triangle3 input
+    std::vector<math::Triangle3d> triangles;
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+      triangles.push_back(math::Triangle3d(vertices[indices[i]],
+            vertices[indices[i+1]], vertices[indices[i+2]]));
+    }
+    math::MassMatrix3d m2;
+    math::Vector3d com2;
+    EXPECT_TRUE(m2.SetFromMesh(density, triangles, com2));
+    EXPECT_EQ(m2, expected);
+    EXPECT_EQ(com2, com);
+  }
+
+  // Rotated box far from the origin
+  {
+    const math::Pose3d pose(1e3, -2e3, 5e2, 0.1, 0.4, -0.7);
+    std::vector<math::Vector3d> vertices;
+    std::vector<unsigned int> indices;
+    BoxMesh(size, pose, vertices, indices);
+
+    math::MassMatrix3d m;
+    math::Vector3d com;
+    EXPECT_TRUE(m.SetFromMesh(density, vertices, indices, com));
+    EXPECT_NEAR(m.Mass(), mass, 1e-9);
+    EXPECT_TRUE(com.Equal(pose.Pos(), 1e-9));
+
+    math::MassMatrix3d expected;
+    EXPECT_TRUE(expected.SetFromBox(mass, size, pose.Rot()));
+    EXPECT_TRUE(m.MOI().Equal(expected.MOI(), 1e-8));
+  }
+
+  // Tetrahedron with known properties
+  {
+    std::vector<math::Vector3d> vertices = {
+      {0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+    std::vector<unsigned int> indices = {
+      0, 2, 1,  0, 1, 3,  0, 3, 2,  1, 2, 3};
+    math::MassMatrix3d m;
+    math::Vector3d com;
+    EXPECT_TRUE(m.SetFromMesh(6.0, vertices, indices, com));
+    EXPECT_DOUBLE_EQ(m.Mass(), 1.0);
+    EXPECT_EQ(com, math::Vector3d(0.25, 0.25, 0.25));
+    // Inertia of unit right tetrahedron about its centroid
+    EXPECT_EQ(m.DiagonalMoments(), math::Vector3d(0.075, 0.075, 0.075));
+    EXPECT_EQ(m.OffDiagonalMoments(),
+        math::Vector3d(0.0125, 0.0125, 0.0125));
+  }
+
+  // Invalid input
+  {
+    std::vector<math::Vector3d> vertices;
+    std::vector<unsigned int> indices;
+    BoxMesh(size, math::Pose3d::Zero, vertices, indices);
+
+    math::MassMatrix3d m;
+    math::Vector3d com;
+    EXPECT_FALSE(m.SetFromMesh(0.0, vertices, indices, com));
+    EXPECT_FALSE(m.SetFromMesh(-1.0, vertices, indices, com));
+    EXPECT_FALSE(m.SetFromMesh(density, vertices,
+          std::vector<unsigned int>(), com));
+    EXPECT_FALSE(m.SetFromMesh(density, std::vector<math::Triangle3d>(),
+          com));
+
+    std::vector<unsigned int> partial(indices.begin(), indices.end() - 1);
+    EXPECT_FALSE(m.SetFromMesh(density, vertices, partial, com));
+
+    std::vector<unsigned int> outOfRange = indices;
+    outOfRange[4] = 8;
+    EXPECT_FALSE(m.SetFromMesh(density, vertices, outOfRange, com));
+
+    // Inverted winding gives a negative volume
+    std::vector<unsigned int> inverted = indices;
+    for (size_t i = 0; i < inverted.size(); i += 3)
+      std::swap(inverted[i+1], inverted[i+2]);
+    EXPECT_FALSE(m.SetFromMesh(density, vertices, inverted, com));
+  }
+
+  // A positive volume with invalid moments leaves the object unchanged
+  {
+    std::vector<math::Vector3d> vertices;
+    std::vector<unsigned int> indices;
+    BoxMesh(size, math::Pose3d::Zero, vertices, indices);
+
+    math::MassMatrix3d m;
+    math::Vector3d com;
+    ASSERT_TRUE(m.SetFromMesh(density, vertices, indices, com));
+    const math::MassMatrix3d valid = m;
+
+    // Subtract a small box far away, by adding it with inverted winding
+    std::vector<math::Vector3d> holeVertices;
+    std::vector<unsigned int> holeIndices;
+    BoxMesh(math::Vector3d(0.5, 0.5, 0.5), math::Pose3d(50, 0, 0, 0, 0, 0),
+        holeVertices, holeIndices);
+    for (size_t i = 0; i < holeIndices.size(); i += 3)
+    {
+      indices.push_back(holeIndices[i] + 8);
+      indices.push_back(holeIndices[i+2] + 8);
+      indices.push_back(holeIndices[i+1] + 8);
+    }
+    vertices.insert(vertices.end(), holeVertices.begin(),
+        holeVertices.end());
+
+    const math::Vector3d previous(1, 2, 3);
+    com = previous;
+    EXPECT_FALSE(m.SetFromMesh(density, vertices, indices, com));
+    EXPECT_EQ(valid, m);
+    EXPECT_EQ(previous, com);
+  }
+}
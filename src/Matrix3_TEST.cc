@@ -398,3 +398,75 @@ TEST(Matrix3dTest, From2Axes)
   m1.From2Axes(v1, v2);
   EXPECT_EQ(math::Matrix3d::Zero - math::Matrix3d::Identity, m1);
 }
+
+/////////////////////////////////////////////////
+TEST(Matrix3dTest, SymmetricEigen)
+{
+  // Diagonal matrix, eigenvalues are sorted
+  {
+    math::Matrix3d m(3, 0, 0,
+                     0, 1, 0,
+                     0, 0, 2);
+    EXPECT_EQ(m.SymmetricEigenvalues(), math::Vector3d(1, 2, 3));
+
+    math::Vector3d values;
+    math::Matrix3d vectors;
+    m.SymmetricEigen(values, vectors);
+    EXPECT_EQ(values, math::Vector3d(1, 2, 3));
+    EXPECT_DOUBLE_EQ(vectors.Determinant(), 1.0);
+    math::Matrix3d L(values[0], 0, 0, 0, values[1], 0, 0, 0, values[2]);
+    EXPECT_EQ(m, vectors * L * vectors.Transposed());
+  }
+
+  // Matrix from Strang's Intro to Linear Algebra textbook
+  {
+    math::Matrix3d m(2, -1, 0,
+                     -1, 2, -1,
+                     0, -1, 2);
+    math::Vector3d values;
+    math::Matrix3d vectors;
+    m.SymmetricEigen(values, vectors);
+    EXPECT_EQ(values, math::Vector3d(2-IGN_SQRT2, 2, 2+IGN_SQRT2));
+    EXPECT_EQ(values, m.SymmetricEigenvalues());
+    EXPECT_DOUBLE_EQ(vectors.Determinant(), 1.0);
+    EXPECT_EQ(vectors.Transposed() * vectors, math::Matrix3d::Identity);
+    math::Matrix3d L(values[0], 0, 0, 0, values[1], 0, 0, 0, values[2]);
+    EXPECT_EQ(m, vectors * L * vectors.Transposed());
+
+    // First and last eigenvectors have a positive largest component
+    EXPECT_GT(vectors(1, 0), 0.0);
+    EXPECT_GT(vectors(1, 2), 0.0);
+  }
+
+  // Repeated eigenvalues
+  {
+    math::Matrix3d m(4, 1, 1,
+                     1, 4, 1,
+                     1, 1, 4);
+    math::Vector3d values;
+    math::Matrix3d vectors;
+    m.SymmetricEigen(values, vectors);
+    EXPECT_EQ(values, math::Vector3d(3, 3, 6));
+    EXPECT_DOUBLE_EQ(vectors.Determinant(), 1.0);
+    math::Matrix3d L(values[0], 0, 0, 0, values[1], 0, 0, 0, values[2]);
+    EXPECT_EQ(m, vectors * L * vectors.Transposed());
+  }
+
+  // Only the upper triangle is used
+  {
+    math::Matrix3d m(2, -1, 0,
+                     5, 2, -1,
+                     7, 9, 2);
+    EXPECT_EQ(m.SymmetricEigenvalues(),
+        math::Vector3d(2-IGN_SQRT2, 2, 2+IGN_SQRT2));
+  }
+
+  // Zero matrix
+  {
+    math::Vector3d values;
+    math::Matrix3d vectors;
+    math::Matrix3d::Zero.SymmetricEigen(values, vectors);
+    EXPECT_EQ(values, math::Vector3d::Zero);
+    EXPECT_EQ(vectors, math::Matrix3d::Identity);
+  }
+}
@@ -0,0 +1,320 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include "ignition/math/PIDBank.hh"
+#include "ignition/math/PIDBankPrivate.hh"
+
+using namespace ignition;
+using namespace math;
+
+/////////////////////////////////////////////////
+PIDBank::PIDBank()
+: dataPtr(new PIDBankPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+PIDBank::PIDBank(const size_t _size)
+: dataPtr(new PIDBankPrivate)
+{
+  this->Resize(_size);
+}
+
+/////////////////////////////////////////////////
+PIDBank::PIDBank(const PIDBank &_bank)
+: dataPtr(new PIDBankPrivate(*_bank.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+PIDBank::~PIDBank()
+{
+}
+
+/////////////////////////////////////////////////
+PIDBank &PIDBank::operator=(const PIDBank &_bank)
+{
+  if (this == &_bank)
+    return *this;
+
+  *this->dataPtr = *_bank.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+size_t PIDBank::Size() const
+{
+  return this->dataPtr->cmd.size();
+}
+
+/////////////////////////////////////////////////
+void PIDBank::Resize(const size_t _size)
+{
+  // Defaults match the PID constructor
+  this->dataPtr->pGain.resize(_size, 0.0);
+  this->dataPtr->iGain.resize(_size, 0.0);
+  this->dataPtr->dGain.resize(_size, 0.0);
+  this->dataPtr->iMax.resize(_size, -1.0);
+  this->dataPtr->iMin.resize(_size, 0.0);
+  this->dataPtr->cmdMax.resize(_size, -1.0);
+  this->dataPtr->cmdMin.resize(_size, 0.0);
+  this->dataPtr->cmdOffset.resize(_size, 0.0);
+  this->dataPtr->pErrLast.resize(_size, 0.0);
+  this->dataPtr->pErr.resize(_size, 0.0);
+  this->dataPtr->iErr.resize(_size, 0.0);
+  this->dataPtr->dErr.resize(_size, 0.0);
+  this->dataPtr->cmd.resize(_size, 0.0);
+  this->dataPtr->enabled.resize(_size, 1);
+}
+
+/////////////////////////////////////////////////
+void PIDBank::Set(const size_t _i, const PID &_pid)
+{
+  this->dataPtr->pGain[_i] = _pid.PGain();
+  this->dataPtr->iGain[_i] = _pid.IGain();
+  this->dataPtr->dGain[_i] = _pid.DGain();
+  this->dataPtr->iMax[_i] = _pid.IMax();
+  this->dataPtr->iMin[_i] = _pid.IMin();
+  this->dataPtr->cmdMax[_i] = _pid.CmdMax();
+  this->dataPtr->cmdMin[_i] = _pid.CmdMin();
+  this->dataPtr->cmdOffset[_i] = _pid.CmdOffset();
+  this->Reset(_i);
+}
+
+/////////////////////////////////////////////////
+PID PIDBank::Controller(const size_t _i) const
+{
+  PID pid(this->dataPtr->pGain[_i], this->dataPtr->iGain[_i],
+          this->dataPtr->dGain[_i], this->dataPtr->iMax[_i],
+          this->dataPtr->iMin[_i], this->dataPtr->cmdMax[_i],
+          this->dataPtr->cmdMin[_i], this->dataPtr->cmdOffset[_i]);
+  pid.SetCmd(this->dataPtr->cmd[_i]);
+  return pid;
+}
+
+/////////////////////////////////////////////////
+void PIDBank::SetPGain(const size_t _i, const double _p)
+{
+  this->dataPtr->pGain[_i] = _p;
+}
+
+/////////////////////////////////////////////////
+void PIDBank::SetIGain(const size_t _i, const double _g)
+{
+  this->dataPtr->iGain[_i] = _g;
+}
+
+/////////////////////////////////////////////////
+void PIDBank::SetDGain(const size_t _i, const double _d)
+{
+  this->dataPtr->dGain[_i] = _d;
+}
+
+/////////////////////////////////////////////////
+void PIDBank::SetIMax(const size_t _i, const double _max)
+{
+  this->dataPtr->iMax[_i] = _max;
+}
+
+/////////////////////////////////////////////////
+void PIDBank::SetIMin(const size_t _i, const double _min)
+{
+  this->dataPtr->iMin[_i] = _min;
+}
+
+/////////////////////////////////////////////////
+void PIDBank::SetCmdMax(const size_t _i, const double _c)
+{
+  this->dataPtr->cmdMax[_i] = _c;
+}
+
+/////////////////////////////////////////////////
+void PIDBank::SetCmdMin(const size_t _i, const double _c)
+{
+  this->dataPtr->cmdMin[_i] = _c;
+}
+
+/////////////////////////////////////////////////
+void PIDBank::SetCmdOffset(const size_t _i, const double _c)
+{
+  this->dataPtr->cmdOffset[_i] = _c;
+}
+
+/////////////////////////////////////////////////
+double PIDBank::PGain(const size_t _i) const
+{
+  return this->dataPtr->pGain[_i];
+}
+
+/////////////////////////////////////////////////
+double PIDBank::IGain(const size_t _i) const
+{
+  return this->dataPtr->iGain[_i];
+}
+
+/////////////////////////////////////////////////
+double PIDBank::DGain(const size_t _i) const
+{
+  return this->dataPtr->dGain[_i];
+}
+
+/////////////////////////////////////////////////
+double PIDBank::IMax(const size_t _i) const
+{
+  return this->dataPtr->iMax[_i];
+}
+
+/////////////////////////////////////////////////
+double PIDBank::IMin(const size_t _i) const
+{
+  return this->dataPtr->iMin[_i];
+}
+
+/////////////////////////////////////////////////
+double PIDBank::CmdMax(const size_t _i) const
+{
+  return this->dataPtr->cmdMax[_i];
+}
+
+/////////////////////////////////////////////////
+double PIDBank::CmdMin(const size_t _i) const
+{
+  return this->dataPtr->cmdMin[_i];
+}
+
+/////////////////////////////////////////////////
+double PIDBank::CmdOffset(const size_t _i) const
+{
+  return this->dataPtr->cmdOffset[_i];
+}
+
+/////////////////////////////////////////////////
+void PIDBank::SetEnabled(const size_t _i, const bool _enabled)
+{
+  this->dataPtr->enabled[_i] = _enabled ? 1 : 0;
+}
+
+/////////////////////////////////////////////////
+bool PIDBank::Enabled(const size_t _i) const
+{
+  return this->dataPtr->enabled[_i] != 0;
+}
+
+/////////////////////////////////////////////////
+void PIDBank::Update(const double *_errors,
+                     const std::chrono::duration<double> &_dt,
+                     double *_cmds)
+{
+  const size_t n = this->Size();
+  const double dt = _dt.count();
+
+  const double *pGain = this->dataPtr->pGain.data();
+  const double *iGain = this->dataPtr->iGain.data();
+  const double *dGain = this->dataPtr->dGain.data();
+  const double *iMax = this->dataPtr->iMax.data();
+  const double *iMin = this->dataPtr->iMin.data();
+  const double *cmdMax = this->dataPtr->cmdMax.data();
+  const double *cmdMin = this->dataPtr->cmdMin.data();
+  const double *cmdOffset = this->dataPtr->cmdOffset.data();
+  const unsigned char *enabled = this->dataPtr->enabled.data();
+  double *pErrLast = this->dataPtr->pErrLast.data();
+  double *pErr = this->dataPtr->pErr.data();
+  double *iErr = this->dataPtr->iErr.data();
+  double *dErr = this->dataPtr->dErr.data();
+  double *cmd = this->dataPtr->cmd.data();
+
+  if (_dt == std::chrono::duration<double>(0))
+  {
+    for (size_t i = 0; i < n; ++i)
+      _cmds[i] = enabled[i] ? 0.0 : cmd[i];
+    return;
+  }
+
+  // Same arithmetic as PID::Update, with every branch turned into a
+  // select so that the loop body is straight-line code.
+  for (size_t i = 0; i < n; ++i)
+  {
+    const double e = _errors[i];
+    const bool on = enabled[i] != 0;
+    const bool valid = on && std::isfinite(e);
+
+    double ie = iErr[i] + iGain[i] * dt * e;
+    const double ieClamped = std::max(std::min(ie, iMax[i]), iMin[i]);
+    ie = iMax[i] >= iMin[i] ? ieClamped : ie;
+
+    const double de = (e - pErrLast[i]) / dt;
+
+    double c = cmdOffset[i] - pGain[i] * e - ie - dGain[i] * de;
+    const double cClamped = std::max(std::min(c, cmdMax[i]), cmdMin[i]);
+    c = cmdMax[i] >= cmdMin[i] ? cClamped : c;
+
+    const double held = cmd[i];
+    pErr[i] = valid ? e : pErr[i];
+    pErrLast[i] = valid ? e : pErrLast[i];
+    iErr[i] = valid ? ie : iErr[i];
+    dErr[i] = valid ? de : dErr[i];
+    cmd[i] = valid ? c : held;
+    _cmds[i] = valid ? c : (on ? 0.0 : held);
+  }
+}
+
+/////////////////////////////////////////////////
+void PIDBank::SetCmd(const size_t _i, const double _cmd)
+{
+  this->dataPtr->cmd[_i] = _cmd;
+}
+
+/////////////////////////////////////////////////
+double PIDBank::Cmd(const size_t _i) const
+{
+  return this->dataPtr->cmd[_i];
+}
+
+/////////////////////////////////////////////////
+const double *PIDBank::Cmds() const
+{
+  return this->dataPtr->cmd.data();
+}
+
+/////////////////////////////////////////////////
+void PIDBank::Errors(const size_t _i,
+                     double &_pe, double &_ie, double &_de) const
+{
+  _pe = this->dataPtr->pErr[_i];
+  _ie = this->dataPtr->iErr[_i];
+  _de = this->dataPtr->dErr[_i];
+}
+
+/////////////////////////////////////////////////
+void PIDBank::Reset()
+{
+  for (size_t i = 0; i < this->Size(); ++i)
+    this->Reset(i);
+}
+
+/////////////////////////////////////////////////
+void PIDBank::Reset(const size_t _i)
+{
+  this->dataPtr->pErrLast[_i] = 0.0;
+  this->dataPtr->pErr[_i] = 0.0;
+  this->dataPtr->iErr[_i] = 0.0;
+  this->dataPtr->dErr[_i] = 0.0;
+  this->dataPtr->cmd[_i] = 0.0;
+}
@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "ignition/math/PID.hh"
+#include "ignition/math/PIDBank.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+TEST(PIDBankTest, Construct)
+{
+  math::PIDBank empty;
+  EXPECT_EQ(empty.Size(), 0u);
+
+  // Channels default to the same configuration as a default PID
+  math::PIDBank bank(3);
+  const math::PID pid;
+  EXPECT_EQ(bank.Size(), 3u);
+  for (size_t i = 0; i < bank.Size(); ++i)
+  {
+    EXPECT_DOUBLE_EQ(bank.PGain(i), pid.PGain());
+    EXPECT_DOUBLE_EQ(bank.IGain(i), pid.IGain());
+    EXPECT_DOUBLE_EQ(bank.DGain(i), pid.DGain());
+    EXPECT_DOUBLE_EQ(bank.IMax(i), pid.IMax());
+    EXPECT_DOUBLE_EQ(bank.IMin(i), pid.IMin());
+    EXPECT_DOUBLE_EQ(bank.CmdMax(i), pid.CmdMax());
+    EXPECT_DOUBLE_EQ(bank.CmdMin(i), pid.CmdMin());
+    EXPECT_DOUBLE_EQ(bank.CmdOffset(i), pid.CmdOffset());
+    EXPECT_DOUBLE_EQ(bank.Cmd(i), 0.0);
+    EXPECT_TRUE(bank.Enabled(i));
+  }
+
+  bank.SetPGain(1, 1.0);
+  bank.SetIGain(1, 2.1);
+  bank.SetDGain(1, -4.5);
+  bank.SetIMax(1, 10.5);
+  bank.SetIMin(1, 1.4);
+  bank.SetCmdMax(1, 45);
+  bank.SetCmdMin(1, -35);
+  bank.SetCmdOffset(1, 1.3);
+  bank.SetCmd(1, 2.5);
+  bank.SetEnabled(1, false);
+
+  math::PID copy = bank.Controller(1);
+  EXPECT_DOUBLE_EQ(copy.PGain(), 1.0);
+  EXPECT_DOUBLE_EQ(copy.IGain(), 2.1);
+  EXPECT_DOUBLE_EQ(copy.DGain(), -4.5);
+  EXPECT_DOUBLE_EQ(copy.IMax(), 10.5);
+  EXPECT_DOUBLE_EQ(copy.IMin(), 1.4);
+  EXPECT_DOUBLE_EQ(copy.CmdMax(), 45);
+  EXPECT_DOUBLE_EQ(copy.CmdMin(), -35);
+  EXPECT_DOUBLE_EQ(copy.CmdOffset(), 1.3);
+  EXPECT_DOUBLE_EQ(copy.Cmd(), 2.5);
+  EXPECT_FALSE(bank.Enabled(1));
+
+  math::PIDBank bank2(bank);
+  EXPECT_EQ(bank2.Size(), 3u);
+  EXPECT_DOUBLE_EQ(bank2.IMax(1), 10.5);
+  EXPECT_FALSE(bank2.Enabled(1));
+
+  math::PIDBank bank3;
+  bank3 = bank;
+  EXPECT_DOUBLE_EQ(bank3.Cmd(1), 2.5);
+
+  bank3.Resize(5);
+  EXPECT_EQ(bank3.Size(), 5u);
+  EXPECT_DOUBLE_EQ(bank3.DGain(1), -4.5);
+  EXPECT_DOUBLE_EQ(bank3.IMax(4), -1.0);
+  EXPECT_TRUE(bank3.Enabled(4));
+}
+
+/////////////////////////////////////////////////
+TEST(PIDBankTest, UpdateMatchesPID)
+{
+  std::vector<math::PID> pids;
+  // No clamping
+  pids.push_back(math::PID(1.0, 0.1, 0.5));
+  // Integral clamping
+  pids.push_back(math::PID(2.0, 3.0, 0.1, 0.5, -0.5));
+  // Command clamping
+  pids.push_back(math::PID(5.0, 0.2, 1.0, -1.0, 0.0, 1.0, -2.0));
+  // Both, with an offset
+  pids.push_back(math::PID(0.7, 1.5, 0.3, 0.2, -0.1, 0.8, -0.6, 0.25));
+
+  math::PIDBank bank(pids.size());
+  for (size_t i = 0; i < pids.size(); ++i)
+    bank.Set(i, pids[i]);
+
+  const std::chrono::duration<double> dt(0.01);
+  std::vector<double> errors(pids.size());
+  std::vector<double> cmds(pids.size());
+  for (int step = 0; step < 50; ++step)
+  {
+    for (size_t i = 0; i < errors.size(); ++i)
+      errors[i] = std::sin(0.2 * step + i) * (1.0 + i);
+
+    bank.Update(errors.data(), dt, cmds.data());
+    for (size_t i = 0; i < pids.size(); ++i)
+    {
+      EXPECT_NEAR(cmds[i], pids[i].Update(errors[i], dt), 1e-12);
+      EXPECT_NEAR(bank.Cmd(i), pids[i].Cmd(), 1e-12);
+      EXPECT_DOUBLE_EQ(bank.Cmds()[i], bank.Cmd(i));
+
+      double pe, ie, de, bpe, bie, bde;
+      pids[i].Errors(pe, ie, de);
+      bank.Errors(i, bpe, bie, bde);
+      EXPECT_NEAR(bpe, pe, 1e-12);
+      EXPECT_NEAR(bie, ie, 1e-12);
+      EXPECT_NEAR(bde, de, 1e-12);
+    }
+  }
+
+  bank.Reset();
+  for (size_t i = 0; i < bank.Size(); ++i)
+  {
+    double pe, ie, de;
+    bank.Errors(i, pe, ie, de);
+    EXPECT_DOUBLE_EQ(pe, 0.0);
+    EXPECT_DOUBLE_EQ(ie, 0.0);
+    EXPECT_DOUBLE_EQ(de, 0.0);
+    EXPECT_DOUBLE_EQ(bank.Cmd(i), 0.0);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(PIDBankTest, EnableMaskAndInvalidInput)
+{
+  math::PIDBank bank(3);
+  for (size_t i = 0; i < bank.Size(); ++i)
+    bank.Set(i, math::PID(1.0, 0.1, 0.0));
+
+  const std::chrono::duration<double> dt(0.1);
+  std::vector<double> errors = {1.0, 2.0, 3.0};
+  std::vector<double> cmds(3);
+  bank.Update(errors.data(), dt, cmds.data());
+  EXPECT_NEAR(cmds[1], -2.02, 1e-12);
+
+  // Disabled channel holds its command and state
+  bank.SetEnabled(1, false);
+  errors = {1.0, 10.0, 3.0};
+  bank.Update(errors.data(), dt, cmds.data());
+  EXPECT_NEAR(cmds[1], -2.02, 1e-12);
+  double pe, ie, de;
+  bank.Errors(1, pe, ie, de);
+  EXPECT_DOUBLE_EQ(pe, 2.0);
+  EXPECT_NEAR(ie, 0.02, 1e-12);
+
+  // Non-finite error outputs 0 and keeps the state, like PID::Update
+  errors = {std::numeric_limits<double>::quiet_NaN(), 10.0,
+            std::numeric_limits<double>::infinity()};
+  bank.Update(errors.data(), dt, cmds.data());
+  EXPECT_DOUBLE_EQ(cmds[0], 0.0);
+  EXPECT_NEAR(cmds[1], -2.02, 1e-12);
+  EXPECT_DOUBLE_EQ(cmds[2], 0.0);
+  EXPECT_NEAR(bank.Cmd(2), -3.06, 1e-12);
+
+  // Zero time step
+  errors = {1.0, 1.0, 1.0};
+  bank.Update(errors.data(), std::chrono::duration<double>(0), cmds.data());
+  EXPECT_DOUBLE_EQ(cmds[0], 0.0);
+  EXPECT_NEAR(cmds[1], -2.02, 1e-12);
+  EXPECT_DOUBLE_EQ(cmds[2], 0.0);
+
+  // Re-enabled channel resumes from its frozen state
+  bank.SetEnabled(1, true);
+  math::PID pid(1.0, 0.1, 0.0);
+  pid.Update(2.0, dt);
+  bank.Update(errors.data(), dt, cmds.data());
+  EXPECT_NEAR(cmds[1], pid.Update(1.0, dt), 1e-12);
+
+  // In place
+  bank.Reset();
+  errors = {1.0, 2.0, 3.0};
+  bank.Update(errors.data(), dt, errors.data());
+  EXPECT_NEAR(errors[2], -3.03, 1e-12);
+}
@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include "ignition/math/PhiloxRand.hh"
+
+using namespace ignition;
+using namespace math;
+
+namespace
+{
+  /// \brief Philox multipliers.
+  const uint64_t kPhiloxM0 = 0xD2511F53u;
+  const uint64_t kPhiloxM1 = 0xCD9E8D57u;
+
+  /// \brief Philox key increments (Weyl sequence).
+  const uint32_t kPhiloxW0 = 0x9E3779B9u;
+  const uint32_t kPhiloxW1 = 0xBB67AE85u;
+
+  /// \brief Convert two words to a double in [0, 1) with 53 random bits.
+  /// \param[in] _a Word giving the 27 high bits.
+  /// \param[in] _b Word giving the 26 low bits.
+  /// \return The number.
+  inline double ToUnit(const uint32_t _a, const uint32_t _b)
+  {
+    return ((_a >> 5) * 67108864.0 + (_b >> 6)) *
+      (1.0 / 9007199254740992.0);
+  }
+}
+
+/////////////////////////////////////////////////
+PhiloxRand::PhiloxRand(const uint64_t _seed, const uint64_t _stream)
+: seed(_seed), stream(_stream)
+{
+}
+
+/////////////////////////////////////////////////
+uint64_t PhiloxRand::Seed() const
+{
+  return this->seed;
+}
+
+/////////////////////////////////////////////////
+void PhiloxRand::SetSeed(const uint64_t _seed)
+{
+  this->seed = _seed;
+  this->Seek(0);
+}
+
+/////////////////////////////////////////////////
+uint64_t PhiloxRand::Stream() const
+{
+  return this->stream;
+}
+
+/////////////////////////////////////////////////
+void PhiloxRand::SetStream(const uint64_t _stream)
+{
+  this->stream = _stream;
+  this->Seek(0);
+}
+
+/////////////////////////////////////////////////
+uint64_t PhiloxRand::Position() const
+{
+  return this->position;
+}
+
+/////////////////////////////////////////////////
+void PhiloxRand::Seek(const uint64_t _position)
+{
+  this->position = _position;
+  this->bufferValid = false;
+  this->hasNormal = false;
+}
+
+/////////////////////////////////////////////////
+void PhiloxRand::Discard(const uint64_t _count)
+{
+  this->Seek(this->position + _count);
+}
+
+/////////////////////////////////////////////////
+uint32_t PhiloxRand::UInt32()
+{
+  const uint64_t block = this->position >> 2;
+  if (!this->bufferValid || this->bufferBlock != block)
+  {
+    Block(this->seed, this->stream, block, this->buffer);
+    this->bufferBlock = block;
+    this->bufferValid = true;
+  }
+  return this->buffer[this->position++ & 3];
+}
+
+/////////////////////////////////////////////////
+double PhiloxRand::DblUniform(const double _min, const double _max)
+{
+  const uint32_t a = this->UInt32();
+  const uint32_t b = this->UInt32();
+  return _min + (_max - _min) * ToUnit(a, b);
+}
+
+/////////////////////////////////////////////////
+double PhiloxRand::DblNormal(const double _mean, const double _sigma)
+{
+  if (this->hasNormal)
+  {
+    this->hasNormal = false;
+    return _mean + _sigma * this->normal;
+  }
+
+  double a;
+  this->NormalPair(a, this->normal);
+  this->hasNormal = true;
+  return _mean + _sigma * a;
+}
+
+/////////////////////////////////////////////////
+void PhiloxRand::FillDblUniform(double *_out, const size_t _n,
+                                const double _min, const double _max)
+{
+  const double range = _max - _min;
+  size_t i = 0;
+
+  // Reach a block boundary one number at a time
+  while (i < _n && (this->position & 3) != 0)
+    _out[i++] = this->DblUniform(_min, _max);
+
+  // Then compute whole blocks directly, two numbers per block
+  uint32_t words[4];
+  for (; i + 1 < _n; i += 2)
+  {
+    Block(this->seed, this->stream, this->position >> 2, words);
+    this->position += 4;
+    _out[i] = _min + range * ToUnit(words[0], words[1]);
+    _out[i + 1] = _min + range * ToUnit(words[2], words[3]);
+  }
+
+  if (i < _n)
+    _out[i] = this->DblUniform(_min, _max);
+}
+
+/////////////////////////////////////////////////
+void PhiloxRand::FillDblNormal(double *_out, const size_t _n,
+                               const double _mean, const double _sigma)
+{
+  size_t i = 0;
+  if (i < _n && this->hasNormal)
+    _out[i++] = this->DblNormal(_mean, _sigma);
+
+  for (; i + 1 < _n; i += 2)
+  {
+    double a, b;
+    this->NormalPair(a, b);
+    _out[i] = _mean + _sigma * a;
+    _out[i + 1] = _mean + _sigma * b;
+  }
+
+  if (i < _n)
+    _out[i] = this->DblNormal(_mean, _sigma);
+}
+
+/////////////////////////////////////////////////
+void PhiloxRand::NormalPair(double &_a, double &_b)
+{
+  // Box-Muller transform. The first uniform is taken in (0, 1] so that
+  // its logarithm is finite.
+  const uint32_t w0 = this->UInt32();
+  const uint32_t w1 = this->UInt32();
+  const uint32_t w2 = this->UInt32();
+  const uint32_t w3 = this->UInt32();
+  const double u1 = 1.0 - ToUnit(w0, w1);
+  const double u2 = ToUnit(w2, w3);
+  const double r = std::sqrt(-2.0 * std::log(u1));
+  const double theta = 2.0 * IGN_PI * u2;
+  _a = r * std::cos(theta);
+  _b = r * std::sin(theta);
+}
+
+/////////////////////////////////////////////////
+void PhiloxRand::Block(const uint64_t _seed, const uint64_t _stream,
+                       const uint64_t _block, uint32_t _out[4])
+{
+  uint32_t c0 = static_cast<uint32_t>(_block);
+  uint32_t c1 = static_cast<uint32_t>(_block >> 32);
+  uint32_t c2 = static_cast<uint32_t>(_stream);
+  uint32_t c3 = static_cast<uint32_t>(_stream >> 32);
+  uint32_t k0 = static_cast<uint32_t>(_seed);
+  uint32_t k1 = static_cast<uint32_t>(_seed >> 32);
+
+  for (int round = 0; round < 10; ++round)
+  {
+    const uint64_t p0 = kPhiloxM0 * c0;
+    const uint64_t p1 = kPhiloxM1 * c2;
+    c0 = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+    c1 = static_cast<uint32_t>(p1);
+    c2 = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+    c3 = static_cast<uint32_t>(p0);
+    k0 += kPhiloxW0;
+    k1 += kPhiloxW1;
+  }
+
+  _out[0] = c0;
+  _out[1] = c1;
+  _out[2] = c2;
+  _out[3] = c3;
+}
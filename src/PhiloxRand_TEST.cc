@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "ignition/math/PhiloxRand.hh"
+
+using namespace ignition;
+
+//////////////////////////////////////////////////
+TEST(PhiloxRandTest, KnownAnswers)
+{
+  // Known answer tests from the Random123 library
+  uint32_t out[4];
+  math::PhiloxRand::Block(0, 0, 0, out);
+  EXPECT_EQ(out[0], 0x6627e8d5u);
+  EXPECT_EQ(out[1], 0xe169c58du);
+  EXPECT_EQ(out[2], 0xbc57ac4cu);
+  EXPECT_EQ(out[3], 0x9b00dbd8u);
+
+  math::PhiloxRand::Block(0xffffffffffffffffull, 0xffffffffffffffffull,
+      0xffffffffffffffffull, out);
+  EXPECT_EQ(out[0], 0x408f276du);
+  EXPECT_EQ(out[1], 0x41c83b0eu);
+  EXPECT_EQ(out[2], 0xa20bc7c6u);
+  EXPECT_EQ(out[3], 0x6d5451fdu);
+
+  math::PhiloxRand::Block(0x299f31d0a4093822ull, 0x0370734413198a2eull,
+      0x85a308d3243f6a88ull, out);
+  EXPECT_EQ(out[0], 0xd16cfe09u);
+  EXPECT_EQ(out[1], 0x94fdccebu);
+  EXPECT_EQ(out[2], 0x5001e420u);
+  EXPECT_EQ(out[3], 0x24126ea1u);
+}
+
+//////////////////////////////////////////////////
+TEST(PhiloxRandTest, StreamsAndSkipAhead)
+{
+  math::PhiloxRand rand(1234, 5);
+  EXPECT_EQ(rand.Seed(), 1234u);
+  EXPECT_EQ(rand.Stream(), 5u);
+  EXPECT_EQ(rand.Position(), 0u);
+
+  std::vector<uint32_t> words;
+  for (int i = 0; i < 11; ++i)
+    words.push_back(rand.UInt32());
+  EXPECT_EQ(rand.Position(), 11u);
+
+  // Words match the blocks of the stream
+  uint32_t block[4];
+  math::PhiloxRand::Block(1234, 5, 2, block);
+  EXPECT_EQ(words[8], block[0]);
+  EXPECT_EQ(words[10], block[2]);
+
+  // Seek and discard
+  math::PhiloxRand other(1234, 5);
+  other.Seek(7);
+  EXPECT_EQ(other.UInt32(), words[7]);
+  other.Seek(0);
+  other.Discard(3);
+  EXPECT_EQ(other.UInt32(), words[3]);
+  other.Discard(5);
+  EXPECT_EQ(other.Position(), 9u);
+  EXPECT_EQ(other.UInt32(), words[9]);
+
+  // Other streams and seeds differ
+  other.SetStream(6);
+  EXPECT_EQ(other.Position(), 0u);
+  EXPECT_NE(other.UInt32(), words[0]);
+  other.SetStream(5);
+  EXPECT_EQ(other.UInt32(), words[0]);
+  other.SetSeed(1235);
+  EXPECT_NE(other.UInt32(), words[0]);
+
+  // Values only depend on the position, whatever was drawn before
+  math::PhiloxRand a(99, 1);
+  math::PhiloxRand b(99, 1);
+  a.Seek(1000);
+  for (int i = 0; i < 500; ++i)
+    b.DblUniform();
+  EXPECT_EQ(b.Position(), 1000u);
+  EXPECT_DOUBLE_EQ(a.DblUniform(-1, 1), b.DblUniform(-1, 1));
+}
+
+//////////////////////////////////////////////////
+TEST(PhiloxRandTest, Batch)
+{
+  // Batches give the same values as single calls, from any position
+  for (uint64_t start = 0; start < 4; ++start)
+  {
+    math::PhiloxRand single(7, 3);
+    math::PhiloxRand batch(7, 3);
+    single.Seek(start);
+    batch.Seek(start);
+
+    std::vector<double> values(37);
+    batch.FillDblUniform(values.data(), values.size(), 2.0, 5.0);
+    for (double v : values)
+      EXPECT_DOUBLE_EQ(v, single.DblUniform(2.0, 5.0));
+    EXPECT_EQ(batch.Position(), single.Position());
+
+    // Odd count, so that the next batch starts with a cached value
+    std::vector<double> normals(15);
+    batch.FillDblNormal(normals.data(), normals.size(), 1.0, 0.5);
+    for (double v : normals)
+      EXPECT_DOUBLE_EQ(v, single.DblNormal(1.0, 0.5));
+    batch.FillDblNormal(normals.data(), normals.size(), 1.0, 0.5);
+    for (double v : normals)
+      EXPECT_DOUBLE_EQ(v, single.DblNormal(1.0, 0.5));
+    EXPECT_EQ(batch.Position(), single.Position());
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(PhiloxRandTest, Distributions)
+{
+  math::PhiloxRand rand(42);
+  const size_t n = 100000;
+  std::vector<double> values(n);
+
+  rand.FillDblUniform(values.data(), n, -2.0, 4.0);
+  double sum = 0;
+  for (double v : values)
+  {
+    EXPECT_GE(v, -2.0);
+    EXPECT_LT(v, 4.0);
+    sum += v;
+  }
+  EXPECT_NEAR(sum / n, 1.0, 0.05);
+
+  rand.FillDblNormal(values.data(), n, 3.0, 2.0);
+  double mean = 0;
+  for (double v : values)
+  {
+    EXPECT_TRUE(std::isfinite(v));
+    mean += v;
+  }
+  mean /= n;
+  double var = 0;
+  for (double v : values)
+    var += (v - mean) * (v - mean);
+  var /= n - 1;
+  EXPECT_NEAR(mean, 3.0, 0.05);
+  EXPECT_NEAR(std::sqrt(var), 2.0, 0.05);
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "ignition/math/Helpers.hh"
+#include "ignition/math/Pose3Array.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+std::vector<math::Pose3d> TestPoses()
+{
+  std::vector<math::Pose3d> poses;
+  poses.push_back(math::Pose3d());
+  poses.push_back(math::Pose3d(1, 0, 0, 0, 0, IGN_PI/4.0));
+  poses.push_back(math::Pose3d(1, 2, 3, 0.1, -0.2, 0.3));
+  poses.push_back(math::Pose3d(-4, 0.5, 2, IGN_PI/2.0, 0.4, -1.2));
+  poses.push_back(math::Pose3d(0, -3, 1, -0.7, 1.1, 2.9));
+  // Non-normalized rotation
+  poses.push_back(math::Pose3d(0.3, 0.2, 0.1, 2, 0, 0, 1));
+  return poses;
+}
+
+/////////////////////////////////////////////////
+void ExpectPoseNear(const math::Pose3d &_a, const math::Pose3d &_b)
+{
+  EXPECT_NEAR(_a.Pos().X(), _b.Pos().X(), 1e-9);
+  EXPECT_NEAR(_a.Pos().Y(), _b.Pos().Y(), 1e-9);
+  EXPECT_NEAR(_a.Pos().Z(), _b.Pos().Z(), 1e-9);
+  EXPECT_NEAR(_a.Rot().W(), _b.Rot().W(), 1e-9);
+  EXPECT_NEAR(_a.Rot().X(), _b.Rot().X(), 1e-9);
+  EXPECT_NEAR(_a.Rot().Y(), _b.Rot().Y(), 1e-9);
+  EXPECT_NEAR(_a.Rot().Z(), _b.Rot().Z(), 1e-9);
+}
+
+/////////////////////////////////////////////////
+TEST(Pose3ArrayTest, Construct)
+{
+  math::Pose3Arrayd empty;
+  EXPECT_EQ(empty.Size(), 0u);
+
+  math::Pose3Arrayd identity(3);
+  EXPECT_EQ(identity.Size(), 3u);
+  for (size_t i = 0; i < identity.Size(); ++i)
+    EXPECT_EQ(identity.Pose(i), math::Pose3d::Zero);
+
+  std::vector<math::Pose3d> poses = TestPoses();
+  math::Pose3Arrayd array(poses);
+  ASSERT_EQ(array.Size(), poses.size());
+  for (size_t i = 0; i < poses.size(); ++i)
+  {
+    EXPECT_EQ(array.Pose(i), poses[i]);
+    EXPECT_DOUBLE_EQ(array.PosX()[i], poses[i].Pos().X());
+    EXPECT_DOUBLE_EQ(array.RotW()[i], poses[i].Rot().W());
+  }
+  EXPECT_EQ(array.Poses(), poses);
+
+  array.Set(1, math::Pose3d(5, 6, 7, 0, 0, 0));
+  EXPECT_EQ(array.Pose(1), math::Pose3d(5, 6, 7, 0, 0, 0));
+
+  array.PosZ()[1] = 8;
+  EXPECT_EQ(array.Pose(1), math::Pose3d(5, 6, 8, 0, 0, 0));
+}
+
+/////////////////////////////////////////////////
+TEST(Pose3ArrayTest, Add)
+{
+  std::vector<math::Pose3d> a = TestPoses();
+  std::vector<math::Pose3d> b(a.rbegin(), a.rend());
+
+  math::Pose3Arrayd arrayA(a);
+  math::Pose3Arrayd arrayB(b);
+
+  math::Pose3Arrayd sum = arrayA + arrayB;
+  ASSERT_EQ(sum.Size(), a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    ExpectPoseNear(sum.Pose(i), a[i] + b[i]);
+
+  // In place
+  arrayA.Add(arrayB, arrayA);
+  for (size_t i = 0; i < a.size(); ++i)
+    ExpectPoseNear(arrayA.Pose(i), a[i] + b[i]);
+
+  // Single pose
+  math::Pose3d parent(1, -2, 0.5, 0.3, 0.2, -0.1);
+  math::Pose3Arrayd arrayC(a);
+  arrayC.Add(parent, arrayC);
+  for (size_t i = 0; i < a.size(); ++i)
+    ExpectPoseNear(arrayC.Pose(i), a[i] + parent);
+}
+
+/////////////////////////////////////////////////
+TEST(Pose3ArrayTest, Inverse)
+{
+  std::vector<math::Pose3d> a = TestPoses();
+  math::Pose3Arrayd array(a);
+
+  math::Pose3Arrayd inv = array.Inverse();
+  ASSERT_EQ(inv.Size(), a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    ExpectPoseNear(inv.Pose(i), a[i].Inverse());
+
+  // Zero rotation is treated like Quaternion::Inverse
+  math::Pose3Arrayd zero(1);
+  zero.Set(0, math::Pose3d(1, 2, 3, 0, 0, 0, 0));
+  zero.Inverse(zero);
+  ExpectPoseNear(zero.Pose(0),
+      math::Pose3d(1, 2, 3, 0, 0, 0, 0).Inverse());
+}
+
+/////////////////////////////////////////////////
+TEST(Pose3ArrayTest, CoordPoseSolve)
+{
+  std::vector<math::Pose3d> a = TestPoses();
+  std::vector<math::Pose3d> b(a.rbegin(), a.rend());
+
+  math::Pose3Arrayd arrayA(a);
+  math::Pose3Arrayd arrayB(b);
+
+  math::Pose3Arrayd solved = arrayA.CoordPoseSolve(arrayB);
+  ASSERT_EQ(solved.Size(), a.size());
+  for (size_t i = 0; i < a.size(); ++i)
+    ExpectPoseNear(solved.Pose(i), a[i].CoordPoseSolve(b[i]));
+}
+
+/////////////////////////////////////////////////
+TEST(Pose3ArrayTest, Float)
+{
+  math::Pose3f a(1, 2, 3, 0.1f, 0.2f, 0.3f);
+  math::Pose3f b(-1, 0.5f, 2, -0.3f, 0.2f, 1.0f);
+  math::Pose3Arrayf arrayA(std::vector<math::Pose3f>(4, a));
+  math::Pose3Arrayf arrayB(std::vector<math::Pose3f>(4, b));
+
+  math::Pose3Arrayf sum = arrayA + arrayB;
+  math::Pose3f expected = a + b;
+  for (size_t i = 0; i < sum.Size(); ++i)
+  {
+    EXPECT_NEAR(sum.Pose(i).Pos().X(), expected.Pos().X(), 1e-5);
+    EXPECT_NEAR(sum.Pose(i).Pos().Y(), expected.Pos().Y(), 1e-5);
+    EXPECT_NEAR(sum.Pose(i).Pos().Z(), expected.Pos().Z(), 1e-5);
+    EXPECT_NEAR(sum.Pose(i).Rot().W(), expected.Rot().W(), 1e-5);
+    EXPECT_NEAR(sum.Pose(i).Rot().Z(), expected.Rot().Z(), 1e-5);
+  }
+}
@@ -0,0 +1,486 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "ignition/math/PoseTrajectory.hh"
+#include "ignition/math/Quaternion.hh"
+#include "ignition/math/Vector3.hh"
+
+using namespace ignition;
+using namespace math;
+
+/// \internal
+/// \brief Private data for the PoseTrajectory class
+class ignition::math::PoseTrajectoryPrivate
+{
+  /// \brief Get the position in the arrays of a sample.
+  /// \param[in] _index Index of the sample, 0 is the oldest.
+  /// \return Position of the sample in the arrays.
+  public: size_t Slot(const size_t _index) const
+  {
+    size_t slot = this->start + _index;
+    if (slot >= this->time.size())
+      slot -= this->time.size();
+    return slot;
+  }
+
+  /// \brief Get the time of a sample.
+  /// \param[in] _index Index of the sample, 0 is the oldest.
+  /// \return Time of the sample.
+  public: double Time(const size_t _index) const
+  {
+    return this->time[this->Slot(_index)];
+  }
+
+  /// \brief Get the position of a sample.
+  /// \param[in] _index Index of the sample, 0 is the oldest.
+  /// \return Position of the sample.
+  public: Vector3d Position(const size_t _index) const
+  {
+    const size_t i = this->Slot(_index);
+    return Vector3d(this->px[i], this->py[i], this->pz[i]);
+  }
+
+  /// \brief Get the rotation of a sample.
+  /// \param[in] _index Index of the sample, 0 is the oldest.
+  /// \return Rotation of the sample.
+  public: Quaterniond Rotation(const size_t _index) const
+  {
+    const size_t i = this->Slot(_index);
+    return Quaterniond(this->qw[i], this->qx[i], this->qy[i], this->qz[i]);
+  }
+
+  /// \brief Get the pose of a sample.
+  /// \param[in] _index Index of the sample, 0 is the oldest.
+  /// \return Pose of the sample.
+  public: Pose3d Sample(const size_t _index) const
+  {
+    return Pose3d(this->Position(_index), this->Rotation(_index));
+  }
+
+  /// \brief Store a sample at a position in the arrays.
+  /// \param[in] _slot Position in the arrays.
+  /// \param[in] _time Time of the sample.
+  /// \param[in] _pose Pose of the sample.
+  public: void Store(const size_t _slot, const double _time,
+                     const Pose3d &_pose)
+  {
+    this->time[_slot] = _time;
+    this->px[_slot] = _pose.Pos().X();
+    this->py[_slot] = _pose.Pos().Y();
+    this->pz[_slot] = _pose.Pos().Z();
+    this->qw[_slot] = _pose.Rot().W();
+    this->qx[_slot] = _pose.Rot().X();
+    this->qy[_slot] = _pose.Rot().Y();
+    this->qz[_slot] = _pose.Rot().Z();
+  }
+
+  /// \brief Resize all arrays.
+  /// \param[in] _size New size of the arrays.
+  public: void Resize(const size_t _size)
+  {
+    this->time.resize(_size);
+    this->px.resize(_size);
+    this->py.resize(_size);
+    this->pz.resize(_size);
+    this->qw.resize(_size);
+    this->qx.resize(_size);
+    this->qy.resize(_size);
+    this->qz.resize(_size);
+  }
+
+  /// \brief Find the segment which contains a time with a binary search.
+  /// \param[in] _time Time to look for.
+  /// \param[in] _low Index of a sample with a time lower than or equal
+  /// to _time.
+  /// \param[in] _high Index of a sample with a time greater than or equal
+  /// to _time, greater than _low.
+  /// \return Index k of the first sample of the segment, such that
+  /// Time(k) <= _time <= Time(k+1).
+  public: size_t Segment(const double _time, size_t _low, size_t _high) const
+  {
+    while (_high - _low > 1)
+    {
+      const size_t middle = _low + (_high - _low) / 2;
+      if (_time < this->Time(middle))
+        _high = middle;
+      else
+        _low = middle;
+    }
+    return _low;
+  }
+
+  /// \brief Rotation tangent of a sample, computed as in
+  /// RotationSpline::RecalcTangents.
+  /// \param[in] _prev Rotation of the previous sample.
+  /// \param[in] _q Rotation of the sample.
+  /// \param[in] _next Rotation of the next sample.
+  /// \return Tangent at _q.
+  public: static Quaterniond Tangent(const Quaterniond &_prev,
+                                     const Quaterniond &_q,
+                                     const Quaterniond &_next)
+  {
+    const Quaterniond inv = _q.Inverse();
+    const Quaterniond preExp =
+      ((inv * _next).Log() + (inv * _prev).Log()) * -0.25;
+    return _q * preExp.Exp();
+  }
+
+  /// \brief Interpolate the pose inside of a segment.
+  /// \param[in] _index Index k of the first sample of the segment.
+  /// \param[in] _time Time between Time(k) and Time(k+1).
+  /// \param[in] _type Interpolation type.
+  /// \param[out] _pose Interpolated pose.
+  public: void Evaluate(const size_t _index, const double _time,
+                        const PoseTrajectory::InterpolationType _type,
+                        Pose3d &_pose) const
+  {
+    const double t0 = this->Time(_index);
+    const double t1 = this->Time(_index + 1);
+
+    // Samples are returned exactly
+    if (!(_time > t0))
+    {
+      _pose = this->Sample(_index);
+      return;
+    }
+    if (!(_time < t1))
+    {
+      _pose = this->Sample(_index + 1);
+      return;
+    }
+
+    const double dt = t1 - t0;
+    const double s = (_time - t0) / dt;
+    const Vector3d p0 = this->Position(_index);
+    const Vector3d p1 = this->Position(_index + 1);
+    const Quaterniond q0 = this->Rotation(_index);
+    Quaterniond q1 = this->Rotation(_index + 1);
+
+    if (_type == PoseTrajectory::LINEAR)
+    {
+      _pose.Set(p0 + (p1 - p0) * s, Quaterniond::Slerp(s, q0, q1, true));
+      return;
+    }
+
+    // Catmull-Rom tangents, scaled to the duration of this segment so
+    // that samples do not have to be evenly spaced in time. The end
+    // points use half of the segment as in Spline.
+    Vector3d m0, m1;
+    if (_index == 0)
+    {
+      m0 = (p1 - p0) * 0.5;
+    }
+    else
+    {
+      m0 = (p1 - this->Position(_index - 1)) *
+        (dt / (t1 - this->Time(_index - 1)));
+    }
+    if (_index + 2 == this->count)
+    {
+      m1 = (p1 - p0) * 0.5;
+    }
+    else
+    {
+      m1 = (this->Position(_index + 2) - p0) *
+        (dt / (this->Time(_index + 2) - t0));
+    }
+
+    // Cubic Hermite basis
+    const double s2 = s * s;
+    const double s3 = s2 * s;
+    const double h00 = 2 * s3 - 3 * s2 + 1;
+    const double h10 = s3 - 2 * s2 + s;
+    const double h01 = -2 * s3 + 3 * s2;
+    const double h11 = s3 - s2;
+    const Vector3d pos = p0 * h00 + m0 * h10 + p1 * h01 + m1 * h11;
+
+    // Neighbours are flipped onto the same hemisphere so that the
+    // tangents follow the shortest path.
+    if (q0.Dot(q1) < 0)
+      q1 = -q1;
+    Quaterniond prev = q0;
+    if (_index > 0)
+    {
+      prev = this->Rotation(_index - 1);
+      if (prev.Dot(q0) < 0)
+        prev = -prev;
+    }
+    Quaterniond next = q1;
+    if (_index + 2 < this->count)
+    {
+      next = this->Rotation(_index + 2);
+      if (next.Dot(q1) < 0)
+        next = -next;
+    }
+
+    _pose.Set(pos, Quaterniond::Squad(s, q0, Tangent(prev, q0, q1),
+          Tangent(q0, q1, next), q1, true));
+  }
+
+  /// \brief Maximum number of samples, 0 for no limit.
+  public: size_t capacity = 0;
+
+  /// \brief Position in the arrays of the oldest sample.
+  public: size_t start = 0;
+
+  /// \brief Number of samples.
+  public: size_t count = 0;
+
+  /// \brief Sample times.
+  public: std::vector<double> time;
+
+  /// \brief Position x components.
+  public: std::vector<double> px;
+
+  /// \brief Position y components.
+  public: std::vector<double> py;
+
+  /// \brief Position z components.
+  public: std::vector<double> pz;
+
+  /// \brief Rotation w components.
+  public: std::vector<double> qw;
+
+  /// \brief Rotation x components.
+  public: std::vector<double> qx;
+
+  /// \brief Rotation y components.
+  public: std::vector<double> qy;
+
+  /// \brief Rotation z components.
+  public: std::vector<double> qz;
+};
+
+/////////////////////////////////////////////////
+PoseTrajectory::PoseTrajectory()
+: dataPtr(new PoseTrajectoryPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+PoseTrajectory::PoseTrajectory(const size_t _capacity)
+: dataPtr(new PoseTrajectoryPrivate)
+{
+  this->dataPtr->capacity = _capacity;
+}
+
+/////////////////////////////////////////////////
+PoseTrajectory::PoseTrajectory(const PoseTrajectory &_trajectory)
+: dataPtr(new PoseTrajectoryPrivate(*_trajectory.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+PoseTrajectory::~PoseTrajectory()
+{
+}
+
+/////////////////////////////////////////////////
+PoseTrajectory &PoseTrajectory::operator=(const PoseTrajectory &_trajectory)
+{
+  if (this == &_trajectory)
+    return *this;
+
+  *this->dataPtr = *_trajectory.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+void PoseTrajectory::SetCapacity(const size_t _capacity)
+{
+  // Copy the newest samples in order, so that the oldest one is first
+  PoseTrajectoryPrivate resized;
+  resized.capacity = _capacity;
+  resized.count = this->dataPtr->count;
+  if (_capacity > 0 && resized.count > _capacity)
+    resized.count = _capacity;
+
+  resized.Resize(resized.count);
+  const size_t first = this->dataPtr->count - resized.count;
+  for (size_t i = 0; i < resized.count; ++i)
+  {
+    resized.Store(i, this->dataPtr->Time(first + i),
+        this->dataPtr->Sample(first + i));
+  }
+
+  *this->dataPtr = std::move(resized);
+}
+
+/////////////////////////////////////////////////
+size_t PoseTrajectory::Capacity() const
+{
+  return this->dataPtr->capacity;
+}
+
+/////////////////////////////////////////////////
+bool PoseTrajectory::Add(const double _time, const Pose3d &_pose)
+{
+  if (!std::isfinite(_time))
+    return false;
+
+  PoseTrajectoryPrivate &d = *this->dataPtr;
+  if (d.count > 0 && !(_time > d.Time(d.count - 1)))
+    return false;
+
+  if (d.capacity == 0 || d.count < d.capacity)
+  {
+    // The arrays grow until the capacity is reached, the oldest sample
+    // stays at the start.
+    d.Resize(d.count + 1);
+    d.Store(d.count, _time, _pose);
+    ++d.count;
+  }
+  else
+  {
+    // Overwrite the oldest sample
+    d.Store(d.start, _time, _pose);
+    ++d.start;
+    if (d.start == d.capacity)
+      d.start = 0;
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+void PoseTrajectory::Clear()
+{
+  this->dataPtr->start = 0;
+  this->dataPtr->count = 0;
+  this->dataPtr->Resize(0);
+}
+
+/////////////////////////////////////////////////
+size_t PoseTrajectory::Size() const
+{
+  return this->dataPtr->count;
+}
+
+/////////////////////////////////////////////////
+bool PoseTrajectory::Empty() const
+{
+  return this->dataPtr->count == 0;
+}
+
+/////////////////////////////////////////////////
+double PoseTrajectory::StartTime() const
+{
+  return this->Time(0);
+}
+
+/////////////////////////////////////////////////
+double PoseTrajectory::EndTime() const
+{
+  if (this->dataPtr->count == 0)
+    return NAN_D;
+  return this->Time(this->dataPtr->count - 1);
+}
+
+/////////////////////////////////////////////////
+double PoseTrajectory::Time(const size_t _index) const
+{
+  if (_index >= this->dataPtr->count)
+    return NAN_D;
+  return this->dataPtr->Time(_index);
+}
+
+/////////////////////////////////////////////////
+Pose3d PoseTrajectory::Pose(const size_t _index) const
+{
+  if (_index >= this->dataPtr->count)
+    return Pose3d::Zero;
+  return this->dataPtr->Sample(_index);
+}
+
+/////////////////////////////////////////////////
+bool PoseTrajectory::Interpolate(const double _time, Pose3d &_pose,
+    const InterpolationType _type) const
+{
+  const PoseTrajectoryPrivate &d = *this->dataPtr;
+  if (d.count == 0)
+    return false;
+
+  const size_t last = d.count - 1;
+  if (!(_time >= d.Time(0) && _time <= d.Time(last)))
+    return false;
+
+  if (last == 0)
+    _pose = d.Sample(0);
+  else
+    d.Evaluate(d.Segment(_time, 0, last), _time, _type, _pose);
+  return true;
+}
+
+/////////////////////////////////////////////////
+size_t PoseTrajectory::Interpolate(const double *_times, const size_t _count,
+    Pose3d *_poses, const InterpolationType _type) const
+{
+  const PoseTrajectoryPrivate &d = *this->dataPtr;
+  if (d.count == 0)
+    return 0;
+
+  const size_t last = d.count - 1;
+  const double startTime = d.Time(0);
+  const double endTime = d.Time(last);
+
+  size_t inside = 0;
+  size_t segment = 0;
+  for (size_t i = 0; i < _count; ++i)
+  {
+    const double t = _times[i];
+    if (!(t >= startTime && t <= endTime))
+    {
+      _poses[i] = d.Sample(t > endTime ? last : 0);
+      continue;
+    }
+
+    ++inside;
+    if (last == 0)
+    {
+      _poses[i] = d.Sample(0);
+      continue;
+    }
+
+    if (t < d.Time(segment))
+    {
+      // Going back in time
+      segment = d.Segment(t, 0, segment);
+    }
+    else if (t > d.Time(segment + 1))
+    {
+      // Going forward, gallop from the current segment so that close
+      // times are found in a few steps
+      size_t low = segment + 1;
+      size_t step = 1;
+      size_t high = low + step;
+      while (high < last && d.Time(high) < t)
+      {
+        low = high;
+        step *= 2;
+        high = low + step;
+      }
+      if (high > last)
+        high = last;
+      segment = d.Segment(t, low, high);
+    }
+
+    d.Evaluate(segment, t, _type, _poses[i]);
+  }
+  return inside;
+}
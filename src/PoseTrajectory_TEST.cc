@@ -0,0 +1,319 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "ignition/math/PoseTrajectory.hh"
+#include "ignition/math/RotationSpline.hh"
+#include "ignition/math/Spline.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+/// \brief Sample pose of the test trajectories.
+/// \param[in] _i Index of the sample.
+/// \return Pose.
+math::Pose3d TestPose(const int _i)
+{
+  return math::Pose3d(std::sin(0.3 * _i), 0.5 * _i, 0.1 * _i * _i,
+                      0.2 * _i, 0.1, -0.15 * _i);
+}
+
+/////////////////////////////////////////////////
+/// \brief Expect two poses to be close, with rotations compared as
+/// rotations so that q and -q are equal.
+/// \param[in] _a First pose.
+/// \param[in] _b Second pose.
+void ExpectNear(const math::Pose3d &_a, const math::Pose3d &_b)
+{
+  EXPECT_NEAR(_a.Pos().X(), _b.Pos().X(), 1e-9);
+  EXPECT_NEAR(_a.Pos().Y(), _b.Pos().Y(), 1e-9);
+  EXPECT_NEAR(_a.Pos().Z(), _b.Pos().Z(), 1e-9);
+  EXPECT_NEAR(1.0, std::abs(_a.Rot().Dot(_b.Rot())), 1e-9);
+}
+
+/////////////////////////////////////////////////
+TEST(PoseTrajectoryTest, Empty)
+{
+  math::PoseTrajectory trajectory;
+  EXPECT_TRUE(trajectory.Empty());
+  EXPECT_EQ(0u, trajectory.Size());
+  EXPECT_EQ(0u, trajectory.Capacity());
+  EXPECT_TRUE(std::isnan(trajectory.StartTime()));
+  EXPECT_TRUE(std::isnan(trajectory.EndTime()));
+  EXPECT_TRUE(std::isnan(trajectory.Time(0)));
+  EXPECT_EQ(math::Pose3d::Zero, trajectory.Pose(0));
+
+  math::Pose3d pose(1, 2, 3, 0, 0, 0);
+  EXPECT_FALSE(trajectory.Interpolate(0.0, pose));
+  EXPECT_EQ(math::Pose3d(1, 2, 3, 0, 0, 0), pose);
+
+  double time = 0;
+  EXPECT_EQ(0u, trajectory.Interpolate(&time, 1, &pose));
+
+  // A single sample
+  EXPECT_TRUE(trajectory.Add(2.0, TestPose(3)));
+  EXPECT_FALSE(trajectory.Empty());
+  EXPECT_DOUBLE_EQ(2.0, trajectory.StartTime());
+  EXPECT_DOUBLE_EQ(2.0, trajectory.EndTime());
+  EXPECT_TRUE(trajectory.Interpolate(2.0, pose));
+  EXPECT_EQ(TestPose(3), pose);
+  EXPECT_FALSE(trajectory.Interpolate(2.1, pose));
+  time = 2.0;
+  EXPECT_EQ(1u, trajectory.Interpolate(&time, 1, &pose));
+  EXPECT_EQ(TestPose(3), pose);
+
+  trajectory.Clear();
+  EXPECT_TRUE(trajectory.Empty());
+}
+
+/////////////////////////////////////////////////
+TEST(PoseTrajectoryTest, Add)
+{
+  math::PoseTrajectory trajectory;
+  EXPECT_TRUE(trajectory.Add(1.0, TestPose(0)));
+  EXPECT_TRUE(trajectory.Add(1.5, TestPose(1)));
+
+  // Times must increase
+  EXPECT_FALSE(trajectory.Add(1.5, TestPose(2)));
+  EXPECT_FALSE(trajectory.Add(0.5, TestPose(2)));
+  EXPECT_FALSE(trajectory.Add(math::NAN_D, TestPose(2)));
+  EXPECT_FALSE(trajectory.Add(math::INF_D, TestPose(2)));
+  EXPECT_EQ(2u, trajectory.Size());
+
+  EXPECT_DOUBLE_EQ(1.0, trajectory.Time(0));
+  EXPECT_DOUBLE_EQ(1.5, trajectory.Time(1));
+  EXPECT_EQ(TestPose(0), trajectory.Pose(0));
+  EXPECT_EQ(TestPose(1), trajectory.Pose(1));
+
+  // Copy
+  math::PoseTrajectory copy(trajectory);
+  EXPECT_EQ(2u, copy.Size());
+  EXPECT_TRUE(trajectory.Add(2.0, TestPose(2)));
+  EXPECT_EQ(2u, copy.Size());
+  copy = trajectory;
+  EXPECT_EQ(3u, copy.Size());
+  EXPECT_EQ(TestPose(2), copy.Pose(2));
+}
+
+/////////////////////////////////////////////////
+TEST(PoseTrajectoryTest, Linear)
+{
+  math::PoseTrajectory trajectory;
+  for (int i = 0; i < 10; ++i)
+    EXPECT_TRUE(trajectory.Add(i * i * 0.1, TestPose(i)));
+
+  math::Pose3d pose;
+  EXPECT_FALSE(trajectory.Interpolate(-0.01, pose));
+  EXPECT_FALSE(trajectory.Interpolate(8.11, pose));
+  EXPECT_FALSE(trajectory.Interpolate(math::NAN_D, pose));
+
+  // Samples are returned exactly
+  for (int i = 0; i < 10; ++i)
+  {
+    EXPECT_TRUE(trajectory.Interpolate(i * i * 0.1, pose));
+    EXPECT_EQ(TestPose(i), pose);
+    EXPECT_TRUE(trajectory.Interpolate(i * i * 0.1, pose,
+          math::PoseTrajectory::SPLINE));
+    EXPECT_EQ(TestPose(i), pose);
+  }
+
+  // Between samples 3 and 4, a quarter of the way
+  const double t = 0.9 + 0.25 * 0.7;
+  EXPECT_TRUE(trajectory.Interpolate(t, pose));
+  math::Pose3d expected(
+      TestPose(3).Pos() + (TestPose(4).Pos() - TestPose(3).Pos()) * 0.25,
+      math::Quaterniond::Slerp(0.25, TestPose(3).Rot(), TestPose(4).Rot(),
+                               true));
+  ExpectNear(expected, pose);
+}
+
+/////////////////////////////////////////////////
+TEST(PoseTrajectoryTest, Spline)
+{
+  // With evenly spaced samples the result matches Spline and
+  // RotationSpline
+  math::PoseTrajectory trajectory;
+  math::Spline spline;
+  spline.Tension(0.0);
+  math::RotationSpline rotationSpline;
+  for (int i = 0; i < 8; ++i)
+  {
+    EXPECT_TRUE(trajectory.Add(10 + 0.5 * i, TestPose(i)));
+    spline.AddPoint(TestPose(i).Pos());
+    rotationSpline.AddPoint(TestPose(i).Rot());
+  }
+
+  math::Pose3d pose;
+  for (unsigned int i = 0; i < 7; ++i)
+  {
+    for (double s = 0.1; s < 1.0; s += 0.2)
+    {
+      EXPECT_TRUE(trajectory.Interpolate(10 + 0.5 * (i + s), pose,
+            math::PoseTrajectory::SPLINE));
+      ExpectNear(math::Pose3d(spline.Interpolate(i, s),
+                              rotationSpline.Interpolate(i, s)), pose);
+    }
+  }
+
+  // Unevenly spaced samples on a straight line at constant speed stay on
+  // the line
+  math::PoseTrajectory line;
+  const double times[] = {0.0, 0.1, 0.5, 0.6, 2.0, 2.2};
+  for (double time : times)
+    EXPECT_TRUE(line.Add(time, math::Pose3d(2 * time, -time, 0, 0, 0, 0)));
+  for (double time = 0.15; time < 2.0; time += 0.1)
+  {
+    EXPECT_TRUE(line.Interpolate(time, pose, math::PoseTrajectory::SPLINE));
+    EXPECT_NEAR(2 * time, pose.Pos().X(), 1e-9);
+    EXPECT_NEAR(-time, pose.Pos().Y(), 1e-9);
+  }
+
+  // Rotations of opposite signs do not make a full turn
+  math::PoseTrajectory flip;
+  math::Quaterniond q0(0, 0, 0.1);
+  math::Quaterniond q1(0, 0, 0.2);
+  math::Quaterniond q2(0, 0, 0.3);
+  EXPECT_TRUE(flip.Add(0, math::Pose3d(math::Vector3d::Zero, q0)));
+  EXPECT_TRUE(flip.Add(1, math::Pose3d(math::Vector3d::Zero, -q1)));
+  EXPECT_TRUE(flip.Add(2, math::Pose3d(math::Vector3d::Zero, q2)));
+  EXPECT_TRUE(flip.Interpolate(0.5, pose, math::PoseTrajectory::SPLINE));
+  EXPECT_NEAR(0.15, pose.Rot().Euler().Z(), 1e-2);
+  EXPECT_TRUE(flip.Interpolate(1.5, pose, math::PoseTrajectory::SPLINE));
+  EXPECT_NEAR(0.25, pose.Rot().Euler().Z(), 1e-2);
+}
+
+/////////////////////////////////////////////////
+TEST(PoseTrajectoryTest, Capacity)
+{
+  math::PoseTrajectory full;
+  math::PoseTrajectory ring(4);
+  EXPECT_EQ(4u, ring.Capacity());
+  for (int i = 0; i < 11; ++i)
+  {
+    EXPECT_TRUE(full.Add(i, TestPose(i)));
+    EXPECT_TRUE(ring.Add(i, TestPose(i)));
+  }
+
+  // Only the newest samples are kept
+  EXPECT_EQ(4u, ring.Size());
+  EXPECT_DOUBLE_EQ(7.0, ring.StartTime());
+  EXPECT_DOUBLE_EQ(10.0, ring.EndTime());
+  for (int i = 0; i < 4; ++i)
+  {
+    EXPECT_DOUBLE_EQ(7.0 + i, ring.Time(i));
+    EXPECT_EQ(TestPose(7 + i), ring.Pose(i));
+  }
+  EXPECT_FALSE(ring.Add(9.5, TestPose(0)));
+
+  math::Pose3d pose;
+  EXPECT_FALSE(ring.Interpolate(6.9, pose));
+  for (double t = 7.0; t <= 10.0; t += 0.125)
+  {
+    math::Pose3d expected;
+    EXPECT_TRUE(full.Interpolate(t, expected));
+    EXPECT_TRUE(ring.Interpolate(t, pose));
+    ExpectNear(expected, pose);
+
+    // The spline tangents at the first sample differ, since the older
+    // samples are gone
+    if (t >= 8.0)
+    {
+      EXPECT_TRUE(full.Interpolate(t, expected,
+            math::PoseTrajectory::SPLINE));
+      EXPECT_TRUE(ring.Interpolate(t, pose, math::PoseTrajectory::SPLINE));
+      ExpectNear(expected, pose);
+    }
+  }
+
+  // Shrink
+  ring.SetCapacity(2);
+  EXPECT_EQ(2u, ring.Capacity());
+  EXPECT_EQ(2u, ring.Size());
+  EXPECT_EQ(TestPose(9), ring.Pose(0));
+  EXPECT_EQ(TestPose(10), ring.Pose(1));
+
+  // Grow, and remove the limit
+  ring.SetCapacity(3);
+  EXPECT_TRUE(ring.Add(11, TestPose(11)));
+  EXPECT_TRUE(ring.Add(12, TestPose(12)));
+  EXPECT_EQ(3u, ring.Size());
+  EXPECT_DOUBLE_EQ(10.0, ring.StartTime());
+  ring.SetCapacity(0);
+  EXPECT_TRUE(ring.Add(13, TestPose(13)));
+  EXPECT_EQ(4u, ring.Size());
+  EXPECT_EQ(TestPose(10), ring.Pose(0));
+  EXPECT_EQ(TestPose(13), ring.Pose(3));
+
+  ring.Clear();
+  EXPECT_TRUE(ring.Empty());
+  EXPECT_EQ(0u, ring.Capacity());
+}
+
+/////////////////////////////////////////////////
+TEST(PoseTrajectoryTest, Batch)
+{
+  math::PoseTrajectory trajectory(50);
+  for (int i = 0; i < 120; ++i)
+    EXPECT_TRUE(trajectory.Add(0.01 * i * i, TestPose(i)));
+
+  // Increasing times with a varying stride, decreasing times and
+  // times outside of the trajectory
+  std::vector<double> times;
+  for (double t = 45.0; t < 142.0; t += 0.37)
+    times.push_back(t);
+  for (double t = 141.0; t > 50.0; t -= 7.3)
+    times.push_back(t);
+  times.push_back(140.0);
+  times.push_back(70.0);
+  times.push_back(200.0);
+  times.push_back(math::NAN_D);
+
+  const int types[] = {math::PoseTrajectory::LINEAR,
+                       math::PoseTrajectory::SPLINE};
+  for (int type : types)
+  {
+    const math::PoseTrajectory::InterpolationType interpolation =
+      static_cast<math::PoseTrajectory::InterpolationType>(type);
+    std::vector<math::Pose3d> poses(times.size());
+    const size_t inside = trajectory.Interpolate(times.data(), times.size(),
+        poses.data(), interpolation);
+
+    size_t expectedInside = 0;
+    for (size_t i = 0; i < times.size(); ++i)
+    {
+      math::Pose3d expected;
+      if (trajectory.Interpolate(times[i], expected, interpolation))
+      {
+        ++expectedInside;
+        ExpectNear(expected, poses[i]);
+      }
+      else if (times[i] > trajectory.EndTime())
+      {
+        EXPECT_EQ(trajectory.Pose(49), poses[i]);
+      }
+      else
+      {
+        EXPECT_EQ(trajectory.Pose(0), poses[i]);
+      }
+    }
+    EXPECT_EQ(expectedInside, inside);
+    EXPECT_LT(inside, times.size());
+  }
+}
@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+
+
 #include "ignition/math/Helpers.hh"
 #include "ignition/math/Pose3.hh"
 
@@ -155,3 +158,24 @@ TEST(PoseTest, OperatorStreamOut)
   EXPECT_EQ(stream.str(), "0.1 1.2 2.3 0 0.1 1");
 }
 
+/////////////////////////////////////////////////
+TEST(PoseTest, Parse)
+{
+  // A CSV line with two poses
+  const char *text = "1,2,3,0,0,1.5707963\n-1,0.5,2e-1,0.1,0.2,0.3";
+  const char *end = text + std::strlen(text);
+  const char *pos = text;
+
+  math::Pose3d pose;
+  EXPECT_TRUE(math::Pose3d::Parse(pos, end, pose));
+  EXPECT_EQ(math::Pose3d(1, 2, 3, 0, 0, 1.5707963), pose);
+  EXPECT_TRUE(math::Pose3d::Parse(pos, end, pose));
+  EXPECT_EQ(math::Pose3d(-1, 0.5, 0.2, 0.1, 0.2, 0.3), pose);
+  EXPECT_EQ(end, pos);
+  EXPECT_FALSE(math::Pose3d::Parse(pos, end, pose));
+
+  text = "1 2 3 0 bad 0";
+  pos = text;
+  EXPECT_FALSE(math::Pose3d::Parse(pos, text + std::strlen(text), pose));
+  EXPECT_EQ(text + 8, pos);
+}
@@ -18,6 +18,7 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <sstream>
 
 #include "ignition/math/Helpers.hh"
 #include "ignition/math/Quaternion.hh"
@@ -566,3 +567,23 @@ TEST(QuaterniondTest, From2Axes)
   EXPECT_TRUE(math::equal(q2.Z(), 0.0));
 }
 
+/////////////////////////////////////////////////
+TEST(QuaternionTest, Parse)
+{
+  const char *text = "0.1 0.2 0.3";
+  const char *pos = text;
+  math::Quaterniond q;
+  EXPECT_TRUE(math::Quaterniond::Parse(pos, text + 11, q));
+  EXPECT_EQ(math::Quaterniond(0.1, 0.2, 0.3), q);
+
+  // Same result as the stream operator
+  std::istringstream stream(text);
+  math::Quaterniond streamed;
+  stream >> streamed;
+  EXPECT_EQ(streamed, q);
+
+  text = "0.1 0.2";
+  pos = text;
+  EXPECT_FALSE(math::Quaterniond::Parse(pos, text + 7, q));
+  EXPECT_EQ(math::Quaterniond(0.1, 0.2, 0.3), q);
+}
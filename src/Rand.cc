@@ -16,6 +16,8 @@
 */
 
 #include <sys/types.h>
+#include <atomic>
+#include <cmath>
 #include <ctime>
 
 #ifdef _WIN32
@@ -30,39 +32,235 @@
 using namespace ignition;
 using namespace math;
 
-// We don't seed with time for the cases when two processes are started the
-// same time (this mostly happens with launch scripts that start a server
-// and gui simultaneously).
-uint32_t Rand::seed = std::random_device {}();
+namespace
+{
+  /// \brief Global seed in the low 32 bits, and in the high 32 bits a
+  /// count incremented every time the seed is set, so that threads know
+  /// when to reseed their generator. Both are in one atomic so that a
+  /// thread never reads the seed of one call to Seed with the count of
+  /// another.
+  ///
+  /// We don't seed with time for the cases when two processes are started
+  /// the same time (this mostly happens with launch scripts that start a
+  /// server and gui simultaneously).
+  std::atomic<uint64_t> seedState(std::random_device {}());
+
+  /// \brief Stream given to the next thread which draws a number without
+  /// selecting a stream with Rand::SetStream.
+  std::atomic<uint64_t> nextStream(0);
+
+  /// \brief Generator owned by a thread.
+  struct ThreadGenerator
+  {
+    /// \brief The random number generator.
+    GeneratorType generator;
+
+    /// \brief Value of seedState when the generator was seeded.
+    uint64_t state = 0;
+
+    /// \brief Stream of the thread, valid once hasStream is true.
+    uint64_t stream = 0;
+
+    /// \brief True once the thread has a stream, either selected with
+    /// Rand::SetStream or taken from nextStream.
+    bool hasStream = false;
+
+    /// \brief True once the generator has been seeded.
+    bool seeded = false;
+  };
+
+  thread_local ThreadGenerator threadGenerator;
+
+  /// \brief Get the generator of the calling thread, after giving the
+  /// thread the next default stream if it has none.
+  /// \return The generator of the calling thread.
+  ThreadGenerator &LocalGenerator()
+  {
+    ThreadGenerator &local = threadGenerator;
+    if (!local.hasStream)
+    {
+      local.stream = nextStream++;
+      local.hasStream = true;
+    }
+    return local;
+  }
+
+  /// \brief Number of layers of the ziggurat.
+  const int kZigguratLayers = 128;
+
+  /// \brief Start of the tail of the ziggurat.
+  const double kZigguratR = 3.442619855899;
+
+  /// \brief Area of each layer of the ziggurat.
+  const double kZigguratV = 9.91256303526217e-3;
+
+  /// \brief Tables for the ziggurat method of sampling a normal
+  /// distribution, as described by J. A. Doornik, "An Improved Ziggurat
+  /// Method to Generate Normal Random Samples" (2005).
+  struct Ziggurat
+  {
+    /// \brief Compute the tables.
+    Ziggurat()
+    {
+      const double f = std::exp(-0.5 * kZigguratR * kZigguratR);
+      this->x[0] = kZigguratV / f;
+      this->x[1] = kZigguratR;
+      this->x[kZigguratLayers] = 0;
+      for (int i = 2; i < kZigguratLayers; ++i)
+      {
+        this->x[i] = std::sqrt(-2.0 * std::log(kZigguratV / this->x[i - 1] +
+              std::exp(-0.5 * this->x[i - 1] * this->x[i - 1])));
+      }
+      for (int i = 0; i < kZigguratLayers; ++i)
+        this->ratio[i] = this->x[i + 1] / this->x[i];
+    }
 
-std::unique_ptr<GeneratorType> Rand::randGenerator(new GeneratorType(seed));
+    /// \brief Right edge of each layer.
+    double x[kZigguratLayers + 1];
+
+    /// \brief Ratio of the right edges of consecutive layers, below
+    /// which a sample is accepted without evaluating the density.
+    double ratio[kZigguratLayers];
+  };
+
+  /// \brief Get a double in [0, 1) with 53 random bits.
+  /// \param[in] _gen Generator.
+  /// \return The number.
+  inline double Unit(GeneratorType &_gen)
+  {
+    const uint32_t a = _gen();
+    const uint32_t b = _gen();
+    return ((a >> 5) * 67108864.0 + (b >> 6)) * (1.0 / 9007199254740992.0);
+  }
+
+  /// \brief Sample the tail of the normal distribution beyond
+  /// kZigguratR.
+  /// \param[in] _gen Generator.
+  /// \param[in] _negative True to return a sample below -kZigguratR.
+  /// \return The sample.
+  double ZigguratTail(GeneratorType &_gen, const bool _negative)
+  {
+    double x, y;
+    do
+    {
+      x = std::log(1.0 - Unit(_gen)) / kZigguratR;
+      y = std::log(1.0 - Unit(_gen));
+    } while (-2.0 * y < x * x);
+    return _negative ? x - kZigguratR : kZigguratR - x;
+  }
+
+  /// \brief Sample a normal distribution with mean 0 and sigma 1 using
+  /// the ziggurat method.
+  /// \param[in] _gen Generator.
+  /// \param[in] _zig Ziggurat tables.
+  /// \return The sample.
+  double ZigguratNormal(GeneratorType &_gen, const Ziggurat &_zig)
+  {
+    while (true)
+    {
+      // 53 bits for the uniform number and 7 independent bits for the
+      // layer, from two 32 bit words.
+      const uint32_t a = _gen();
+      const uint32_t b = _gen();
+      const double u = 2.0 * ((a >> 5) * 67108864.0 + (b >> 6)) *
+        (1.0 / 9007199254740992.0) - 1.0;
+      const int i = static_cast<int>(((a & 0x1F) << 2) | (b & 0x3));
+
+      // Inside the rectangle of the layer below
+      if (std::abs(u) < _zig.ratio[i])
+        return u * _zig.x[i];
+
+      if (i == 0)
+        return ZigguratTail(_gen, u < 0);
+
+      // In the wedge between the two layers
+      const double x = u * _zig.x[i];
+      const double f0 = std::exp(-0.5 * (_zig.x[i] * _zig.x[i] - x * x));
+      const double f1 = std::exp(-0.5 *
+          (_zig.x[i + 1] * _zig.x[i + 1] - x * x));
+      if (f1 + Unit(_gen) * (f0 - f1) < 1.0)
+        return x;
+    }
+  }
+
+  /// \brief Get the ziggurat tables, computed on first use.
+  /// \return The tables.
+  const Ziggurat &ZigguratTables()
+  {
+    static const Ziggurat tables;
+    return tables;
+  }
+}
 
 //////////////////////////////////////////////////
 void Rand::Seed(unsigned int _seed)
 {
-  std::seed_seq seq{_seed};
-  seed = _seed;
-  randGenerator->seed(seq);
+  uint64_t state = seedState.load();
+  uint64_t next;
+  do
+  {
+    next = (((state >> 32) + 1) << 32) | static_cast<uint32_t>(_seed);
+  } while (!seedState.compare_exchange_weak(state, next));
 }
 
 //////////////////////////////////////////////////
 unsigned int Rand::Seed()
 {
-  return seed;
+  return static_cast<uint32_t>(seedState.load());
+}
+
+//////////////////////////////////////////////////
+void Rand::SetStream(size_t _stream)
+{
+  ThreadGenerator &local = threadGenerator;
+  local.stream = _stream;
+  local.hasStream = true;
+  local.seeded = false;
+}
+
+//////////////////////////////////////////////////
+size_t Rand::Stream()
+{
+  return static_cast<size_t>(LocalGenerator().stream);
+}
+
+//////////////////////////////////////////////////
+GeneratorType &Rand::Generator()
+{
+  ThreadGenerator &local = LocalGenerator();
+  const uint64_t state = seedState.load();
+  if (!local.seeded || local.state != state)
+  {
+    const uint32_t seed = static_cast<uint32_t>(state);
+    if (local.stream == 0)
+    {
+      std::seed_seq seq{seed};
+      local.generator.seed(seq);
+    }
+    else
+    {
+      std::seed_seq seq{seed, static_cast<uint32_t>(local.stream),
+                        static_cast<uint32_t>(local.stream >> 32)};
+      local.generator.seed(seq);
+    }
+    local.state = state;
+    local.seeded = true;
+  }
+  return local.generator;
 }
 
 //////////////////////////////////////////////////
 double Rand::DblUniform(double _min, double _max)
 {
   UniformRealDist d(_min, _max);
-  return d(*randGenerator);
+  return d(Generator());
 }
 
 //////////////////////////////////////////////////
 double Rand::DblNormal(double _mean, double _sigma)
 {
   NormalRealDist d(_mean, _sigma);
-  return d(*randGenerator);
+  return d(Generator());
 }
 
 //////////////////////////////////////////////////
@@ -70,7 +268,7 @@ int32_t Rand::IntUniform(int _min, int _max)
 {
   UniformIntDist d(_min, _max);
 
-  return d(*randGenerator);
+  return d(Generator());
 }
 
 //////////////////////////////////////////////////
@@ -78,5 +276,68 @@ int32_t Rand::IntNormal(int _mean, int _sigma)
 {
   NormalRealDist d(_mean, _sigma);
 
-  return static_cast<int32_t>(d(*randGenerator));
+  return static_cast<int32_t>(d(Generator()));
+}
+
+//////////////////////////////////////////////////
+void Rand::FillDblUniform(double *_out, size_t _n,
+                          double _min, double _max)
+{
+  GeneratorType &gen = Generator();
+  const double range = _max - _min;
+  for (size_t i = 0; i < _n; ++i)
+    _out[i] = _min + range * Unit(gen);
+}
+
+//////////////////////////////////////////////////
+void Rand::FillDblNormal(double *_out, size_t _n,
+                         double _mean, double _sigma)
+{
+  GeneratorType &gen = Generator();
+  const Ziggurat &zig = ZigguratTables();
+  for (size_t i = 0; i < _n; ++i)
+    _out[i] = _mean + _sigma * ZigguratNormal(gen, zig);
+}
+
+//////////////////////////////////////////////////
+void Rand::FillVector3InBox(Vector3d *_out, size_t _n,
+                            const Vector3d &_min, const Vector3d &_max)
+{
+  GeneratorType &gen = Generator();
+  const Vector3d range = _max - _min;
+  for (size_t i = 0; i < _n; ++i)
+  {
+    const double x = Unit(gen);
+    const double y = Unit(gen);
+    const double z = Unit(gen);
+    _out[i].Set(_min.X() + range.X() * x,
+                _min.Y() + range.Y() * y,
+                _min.Z() + range.Z() * z);
+  }
+}
+
+//////////////////////////////////////////////////
+void Rand::FillVector3InSphere(Vector3d *_out, size_t _n,
+                               const Vector3d &_center, double _radius)
+{
+  GeneratorType &gen = Generator();
+  const Ziggurat &zig = ZigguratTables();
+  for (size_t i = 0; i < _n; ++i)
+  {
+    // A normally distributed vector has a uniformly distributed
+    // direction, and the cube root of a uniform number gives a radius
+    // with density proportional to r^2.
+    double x, y, z, len2;
+    do
+    {
+      x = ZigguratNormal(gen, zig);
+      y = ZigguratNormal(gen, zig);
+      z = ZigguratNormal(gen, zig);
+      len2 = x * x + y * y + z * z;
+    } while (len2 <= 0.0);
+    const double scale = _radius * std::cbrt(Unit(gen)) / std::sqrt(len2);
+    _out[i].Set(_center.X() + scale * x,
+                _center.Y() + scale * y,
+                _center.Z() + scale * z);
+  }
 }
@@ -17,6 +17,10 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <thread>
+#include <vector>
+
 #include "ignition/math/Helpers.hh"
 #include "ignition/math/Rand.hh"
 
@@ -77,3 +81,207 @@ TEST(RandTest, SetSeed)
     EXPECT_EQ(second[i], math::Rand::IntUniform(-10, 10));
   }
 }
+
+//////////////////////////////////////////////////
+std::vector<double> DrawInThread(const size_t _stream, const int _n)
+{
+  std::vector<double> values;
+  std::thread thread([&values, _stream, _n]()
+  {
+    math::Rand::SetStream(_stream);
+    for (int i = 0; i < _n; ++i)
+      values.push_back(math::Rand::DblUniform());
+  });
+  thread.join();
+  return values;
+}
+
+//////////////////////////////////////////////////
+TEST(RandTest, Threads)
+{
+  const int n = 100;
+
+  // A thread gets the same numbers for the same seed and stream, and
+  // different streams get different numbers.
+  math::Rand::Seed(42);
+  EXPECT_EQ(math::Rand::Stream(), 0u);
+  const double main1 = math::Rand::DblUniform();
+  const std::vector<double> a1 = DrawInThread(1, n);
+  const std::vector<double> b1 = DrawInThread(2, n);
+
+  math::Rand::Seed(42);
+  const std::vector<double> b2 = DrawInThread(2, n);
+  const std::vector<double> a2 = DrawInThread(1, n);
+  const double main2 = math::Rand::DblUniform();
+
+  EXPECT_DOUBLE_EQ(main1, main2);
+  EXPECT_EQ(a1, a2);
+  EXPECT_EQ(b1, b2);
+  EXPECT_NE(a1, b1);
+
+  // Stream 0 is the single generator sequence, in any thread
+  const std::vector<double> first = DrawInThread(0, 1);
+  ASSERT_EQ(first.size(), 1u);
+  EXPECT_DOUBLE_EQ(first[0], main1);
+
+  // Selecting a stream restarts its sequence
+  math::Rand::SetStream(1);
+  EXPECT_EQ(math::Rand::Stream(), 1u);
+  EXPECT_DOUBLE_EQ(math::Rand::DblUniform(), a1[0]);
+  math::Rand::SetStream(0);
+  EXPECT_DOUBLE_EQ(math::Rand::DblUniform(), main1);
+
+  // Threads which do not select a stream get different ones
+  size_t streams[2];
+  std::vector<double> values[2];
+  for (int t = 0; t < 2; ++t)
+  {
+    std::thread thread([&streams, &values, t, n]()
+    {
+      for (int i = 0; i < n; ++i)
+        values[t].push_back(math::Rand::DblUniform());
+      streams[t] = math::Rand::Stream();
+    });
+    thread.join();
+  }
+  EXPECT_NE(streams[0], 0u);
+  EXPECT_NE(streams[1], 0u);
+  EXPECT_NE(streams[0], streams[1]);
+  EXPECT_NE(values[0], values[1]);
+
+  // Concurrent draws, the same whatever the scheduling
+  std::vector<std::vector<double>> results[2];
+  for (auto &result : results)
+  {
+    math::Rand::Seed(7);
+    result.resize(4);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < result.size(); ++t)
+    {
+      threads.push_back(std::thread([&result, t, n]()
+      {
+        math::Rand::SetStream(t);
+        for (int i = 0; i < n; ++i)
+          result[t].push_back(math::Rand::DblNormal(0, 1));
+      }));
+    }
+    for (auto &thread : threads)
+      thread.join();
+  }
+  EXPECT_EQ(results[0], results[1]);
+  for (size_t t = 0; t < results[0].size(); ++t)
+  {
+    EXPECT_EQ(results[0][t].size(), static_cast<size_t>(n));
+    for (size_t u = t + 1; u < results[0].size(); ++u)
+      EXPECT_NE(results[0][t], results[0][u]);
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(RandTest, BulkUniform)
+{
+  math::Rand::Seed(11);
+  const size_t n = 100000;
+  std::vector<double> values(n);
+  math::Rand::FillDblUniform(values.data(), n, -1.0, 3.0);
+  double sum = 0;
+  for (double v : values)
+  {
+    EXPECT_GE(v, -1.0);
+    EXPECT_LT(v, 3.0);
+    sum += v;
+  }
+  EXPECT_NEAR(sum / n, 1.0, 0.02);
+
+  // Same seed, same values
+  std::vector<double> again(n);
+  math::Rand::Seed(11);
+  math::Rand::FillDblUniform(again.data(), n, -1.0, 3.0);
+  EXPECT_EQ(values, again);
+}
+
+//////////////////////////////////////////////////
+TEST(RandTest, BulkNormal)
+{
+  math::Rand::Seed(12);
+  const size_t n = 200000;
+  std::vector<double> values(n);
+  math::Rand::FillDblNormal(values.data(), n, 2.0, 3.0);
+
+  double mean = 0;
+  for (double v : values)
+    mean += v;
+  mean /= n;
+
+  double var = 0;
+  double kurt = 0;
+  size_t beyond2 = 0;
+  size_t beyond3 = 0;
+  for (double v : values)
+  {
+    double z = (v - 2.0) / 3.0;
+    var += (v - mean) * (v - mean);
+    kurt += z * z * z * z;
+    if (std::abs(z) > 2.0)
+      ++beyond2;
+    if (std::abs(z) > 3.5)
+      ++beyond3;
+  }
+  var /= n - 1;
+  kurt /= n;
+
+  EXPECT_NEAR(mean, 2.0, 0.03);
+  EXPECT_NEAR(std::sqrt(var), 3.0, 0.03);
+  EXPECT_NEAR(kurt, 3.0, 0.1);
+  // P(|z| > 2) = 0.0455, P(|z| > 3.5) = 0.000465, which also exercises
+  // the tail beyond the base layer of the ziggurat.
+  EXPECT_NEAR(static_cast<double>(beyond2) / n, 0.0455, 0.003);
+  EXPECT_NEAR(static_cast<double>(beyond3) / n, 0.000465, 0.0002);
+}
+
+//////////////////////////////////////////////////
+TEST(RandTest, BulkVector3)
+{
+  math::Rand::Seed(13);
+  const size_t n = 50000;
+  std::vector<math::Vector3d> points(n);
+
+  const math::Vector3d min(-1, 2, 10);
+  const math::Vector3d max(1, 5, 10.5);
+  math::Rand::FillVector3InBox(points.data(), n, min, max);
+  math::Vector3d sum;
+  for (const auto &p : points)
+  {
+    EXPECT_GE(p.X(), min.X());
+    EXPECT_GE(p.Y(), min.Y());
+    EXPECT_GE(p.Z(), min.Z());
+    EXPECT_LT(p.X(), max.X());
+    EXPECT_LT(p.Y(), max.Y());
+    EXPECT_LT(p.Z(), max.Z());
+    sum += p;
+  }
+  sum /= static_cast<double>(n);
+  EXPECT_NEAR(sum.X(), 0.0, 0.02);
+  EXPECT_NEAR(sum.Y(), 3.5, 0.02);
+  EXPECT_NEAR(sum.Z(), 10.25, 0.02);
+
+  const math::Vector3d center(1, -2, 3);
+  const double radius = 2.0;
+  math::Rand::FillVector3InSphere(points.data(), n, center, radius);
+  size_t inner = 0;
+  sum.Set(0, 0, 0);
+  for (const auto &p : points)
+  {
+    double dist = p.Distance(center);
+    EXPECT_LE(dist, radius);
+    if (dist < radius * 0.5)
+      ++inner;
+    sum += p;
+  }
+  sum /= static_cast<double>(n);
+  // An eighth of the volume is within half the radius
+  EXPECT_NEAR(static_cast<double>(inner) / n, 0.125, 0.01);
+  EXPECT_NEAR(sum.X(), center.X(), 0.03);
+  EXPECT_NEAR(sum.Y(), center.Y(), 0.03);
+  EXPECT_NEAR(sum.Z(), center.Z(), 0.03);
+}
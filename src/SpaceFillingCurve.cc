@@ -0,0 +1,424 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
+#include "ignition/math/SpaceFillingCurve.hh"
+
+using namespace ignition;
+using namespace math;
+
+namespace
+{
+  /// \brief Number of bits of a radix sort digit.
+  const int kDigitBits = 11;
+
+  /// \brief Number of radix sort digits of a 64 bit code.
+  const int kDigits = (64 + kDigitBits - 1) / kDigitBits;
+
+  /// \brief Number of values of a radix sort digit.
+  const size_t kBuckets = size_t(1) << kDigitBits;
+
+  /// \brief Below this number of codes, sortCodes uses a comparison sort.
+  const size_t kSmallSort = 256;
+
+  /// \brief Spread the bits of a 32 bit value to the even bits of a 64 bit
+  /// value.
+  /// \param[in] _v Value.
+  /// \return Spread value.
+  uint64_t spread2(const uint32_t _v)
+  {
+#ifdef __BMI2__
+    return _pdep_u64(_v, 0x5555555555555555ull);
+#else
+    uint64_t x = _v;
+    x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+    x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+    x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+    x = (x | (x << 2)) & 0x3333333333333333ull;
+    return (x | (x << 1)) & 0x5555555555555555ull;
+#endif
+  }
+
+  /// \brief Gather the even bits of a 64 bit value, reverse of spread2.
+  /// \param[in] _v Value.
+  /// \return Gathered value.
+  uint32_t compact2(const uint64_t _v)
+  {
+#ifdef __BMI2__
+    return static_cast<uint32_t>(_pext_u64(_v, 0x5555555555555555ull));
+#else
+    uint64_t x = _v & 0x5555555555555555ull;
+    x = (x | (x >> 1)) & 0x3333333333333333ull;
+    x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+    x = (x | (x >> 4)) & 0x00FF00FF00FF00FFull;
+    x = (x | (x >> 8)) & 0x0000FFFF0000FFFFull;
+    return static_cast<uint32_t>(x | (x >> 16));
+#endif
+  }
+
+  /// \brief Spread the low 21 bits of a value to every third bit of a 64
+  /// bit value.
+  /// \param[in] _v Value.
+  /// \return Spread value.
+  uint64_t spread3(const uint32_t _v)
+  {
+#ifdef __BMI2__
+    return _pdep_u64(_v, 0x1249249249249249ull);
+#else
+    uint64_t x = _v & 0x1FFFFFu;
+    x = (x | (x << 32)) & 0x001F00000000FFFFull;
+    x = (x | (x << 16)) & 0x001F0000FF0000FFull;
+    x = (x | (x << 8)) & 0x100F00F00F00F00Full;
+    x = (x | (x << 4)) & 0x10C30C30C30C30C3ull;
+    return (x | (x << 2)) & 0x1249249249249249ull;
+#endif
+  }
+
+  /// \brief Gather every third bit of a 64 bit value, reverse of spread3.
+  /// \param[in] _v Value.
+  /// \return Gathered value.
+  uint32_t compact3(const uint64_t _v)
+  {
+#ifdef __BMI2__
+    return static_cast<uint32_t>(_pext_u64(_v, 0x1249249249249249ull));
+#else
+    uint64_t x = _v & 0x1249249249249249ull;
+    x = (x | (x >> 2)) & 0x10C30C30C30C30C3ull;
+    x = (x | (x >> 4)) & 0x100F00F00F00F00Full;
+    x = (x | (x >> 8)) & 0x001F0000FF0000FFull;
+    x = (x | (x >> 16)) & 0x001F00000000FFFFull;
+    return static_cast<uint32_t>((x | (x >> 32)) & 0x1FFFFFu);
+#endif
+  }
+
+  /// \brief Convert cell coordinates to the transposed form of their
+  /// Hilbert code, whose bits interleaved give the code. This is Skilling's
+  /// algorithm, "Programming the Hilbert curve", AIP 2004.
+  /// \param[in,out] _x Cell coordinates, replaced by the transposed code.
+  /// \param[in] _bits Number of bits of each coordinate.
+  template<int N>
+  void axesToTranspose(uint32_t (&_x)[N], const int _bits)
+  {
+    // Inverse undo. The bits of random cells are unpredictable, so the
+    // branches of the original algorithm are replaced by masks.
+    for (uint32_t q = 1u << (_bits - 1); q > 1; q >>= 1)
+    {
+      const uint32_t p = q - 1;
+      for (int i = 0; i < N; ++i)
+      {
+        // All ones if bit q of _x[i] is set: invert the low bits of _x[0],
+        // otherwise exchange the low bits of _x[0] and _x[i]
+        const uint32_t set = 0u - ((_x[i] & q) != 0);
+        const uint32_t t = (_x[0] ^ _x[i]) & p & ~set;
+        _x[0] ^= (p & set) | t;
+        _x[i] ^= t;
+      }
+    }
+
+    // Gray encode
+    for (int i = 1; i < N; ++i)
+      _x[i] ^= _x[i - 1];
+    uint32_t t = 0;
+    for (uint32_t q = 1u << (_bits - 1); q > 1; q >>= 1)
+      t ^= (q - 1) & (0u - ((_x[N - 1] & q) != 0));
+    for (int i = 0; i < N; ++i)
+      _x[i] ^= t;
+  }
+
+  /// \brief Convert the transposed form of a Hilbert code to cell
+  /// coordinates, reverse of axesToTranspose.
+  /// \param[in,out] _x Transposed code, replaced by the cell coordinates.
+  /// \param[in] _bits Number of bits of each coordinate.
+  template<int N>
+  void transposeToAxes(uint32_t (&_x)[N], const int _bits)
+  {
+    // Gray decode
+    uint32_t t = _x[N - 1] >> 1;
+    for (int i = N - 1; i > 0; --i)
+      _x[i] ^= _x[i - 1];
+    _x[0] ^= t;
+
+    // Undo excess work
+    const uint64_t end = uint64_t(1) << _bits;
+    for (uint64_t q = 2; q != end; q <<= 1)
+    {
+      const uint32_t p = static_cast<uint32_t>(q - 1);
+      for (int i = N - 1; i >= 0; --i)
+      {
+        const uint32_t set = 0u - ((_x[i] & q) != 0);
+        t = (_x[0] ^ _x[i]) & p & ~set;
+        _x[0] ^= (p & set) | t;
+        _x[i] ^= t;
+      }
+    }
+  }
+
+  /// \brief Map of points to the cells of a grid over a box.
+  class Quantizer
+  {
+    /// \brief Constructor.
+    /// \param[in] _domain Box covered by the grid.
+    /// \param[in] _bits Number of bits of a cell coordinate.
+    public: Quantizer(const Box &_domain, const int _bits)
+    : maxCell(static_cast<double>((uint64_t(1) << _bits) - 1))
+    {
+      const Vector3d size = _domain.Max() - _domain.Min();
+      const double cells = this->maxCell + 1;
+      for (int i = 0; i < 3; ++i)
+      {
+        this->min[i] = _domain.Min()[i];
+        this->scale[i] = size[i] > 0 ? cells / size[i] : 0;
+      }
+    }
+
+    /// \brief Get the cell coordinate of a point coordinate.
+    /// \param[in] _value Point coordinate.
+    /// \param[in] _axis Axis of the coordinate.
+    /// \return Cell coordinate.
+    public: uint32_t Cell(const double _value, const int _axis) const
+    {
+      const double cell = (_value - this->min[_axis]) * this->scale[_axis];
+      // Also catches NaN
+      if (!(cell > 0))
+        return 0;
+      if (cell >= this->maxCell)
+        return static_cast<uint32_t>(this->maxCell);
+      return static_cast<uint32_t>(cell);
+    }
+
+    /// \brief Largest cell coordinate.
+    private: double maxCell;
+
+    /// \brief Minimum corner of the box.
+    private: double min[3];
+
+    /// \brief Number of cells per unit length along each axis.
+    private: double scale[3];
+  };
+
+  /// \brief A code and its index, sorted by sortCodes.
+  struct Item
+  {
+    /// \brief Code.
+    uint64_t code;
+
+    /// \brief Index of the code in the input array.
+    size_t index;
+  };
+}
+
+/////////////////////////////////////////////////
+uint64_t ignition::math::mortonEncode(const uint32_t _x, const uint32_t _y)
+{
+  return spread2(_x) | (spread2(_y) << 1);
+}
+
+/////////////////////////////////////////////////
+uint64_t ignition::math::mortonEncode(const uint32_t _x, const uint32_t _y,
+    const uint32_t _z)
+{
+  return spread3(_x) | (spread3(_y) << 1) | (spread3(_z) << 2);
+}
+
+/////////////////////////////////////////////////
+void ignition::math::mortonDecode(const uint64_t _code,
+    uint32_t &_x, uint32_t &_y)
+{
+  _x = compact2(_code);
+  _y = compact2(_code >> 1);
+}
+
+/////////////////////////////////////////////////
+void ignition::math::mortonDecode(const uint64_t _code,
+    uint32_t &_x, uint32_t &_y, uint32_t &_z)
+{
+  _x = compact3(_code);
+  _y = compact3(_code >> 1);
+  _z = compact3(_code >> 2);
+}
+
+/////////////////////////////////////////////////
+uint64_t ignition::math::hilbertEncode(const uint32_t _x, const uint32_t _y)
+{
+  uint32_t x[2] = {_x, _y};
+  axesToTranspose(x, 32);
+  // The first coordinate holds the most significant bit of each pair
+  return mortonEncode(x[1], x[0]);
+}
+
+/////////////////////////////////////////////////
+uint64_t ignition::math::hilbertEncode(const uint32_t _x, const uint32_t _y,
+    const uint32_t _z)
+{
+  uint32_t x[3] = {_x & 0x1FFFFFu, _y & 0x1FFFFFu, _z & 0x1FFFFFu};
+  axesToTranspose(x, 21);
+  return mortonEncode(x[2], x[1], x[0]);
+}
+
+/////////////////////////////////////////////////
+void ignition::math::hilbertDecode(const uint64_t _code,
+    uint32_t &_x, uint32_t &_y)
+{
+  uint32_t x[2];
+  mortonDecode(_code, x[1], x[0]);
+  transposeToAxes(x, 32);
+  _x = x[0];
+  _y = x[1];
+}
+
+/////////////////////////////////////////////////
+void ignition::math::hilbertDecode(const uint64_t _code,
+    uint32_t &_x, uint32_t &_y, uint32_t &_z)
+{
+  uint32_t x[3];
+  mortonDecode(_code, x[2], x[1], x[0]);
+  transposeToAxes(x, 21);
+  _x = x[0];
+  _y = x[1];
+  _z = x[2];
+}
+
+/////////////////////////////////////////////////
+uint64_t ignition::math::mortonCode(const Vector2d &_point,
+    const Box &_domain)
+{
+  const Quantizer quantizer(_domain, 32);
+  return mortonEncode(quantizer.Cell(_point.X(), 0),
+                      quantizer.Cell(_point.Y(), 1));
+}
+
+/////////////////////////////////////////////////
+uint64_t ignition::math::mortonCode(const Vector3d &_point,
+    const Box &_domain)
+{
+  const Quantizer quantizer(_domain, 21);
+  return mortonEncode(quantizer.Cell(_point.X(), 0),
+                      quantizer.Cell(_point.Y(), 1),
+                      quantizer.Cell(_point.Z(), 2));
+}
+
+/////////////////////////////////////////////////
+uint64_t ignition::math::hilbertCode(const Vector2d &_point,
+    const Box &_domain)
+{
+  const Quantizer quantizer(_domain, 32);
+  return hilbertEncode(quantizer.Cell(_point.X(), 0),
+                       quantizer.Cell(_point.Y(), 1));
+}
+
+/////////////////////////////////////////////////
+uint64_t ignition::math::hilbertCode(const Vector3d &_point,
+    const Box &_domain)
+{
+  const Quantizer quantizer(_domain, 21);
+  return hilbertEncode(quantizer.Cell(_point.X(), 0),
+                       quantizer.Cell(_point.Y(), 1),
+                       quantizer.Cell(_point.Z(), 2));
+}
+
+/////////////////////////////////////////////////
+void ignition::math::mortonCodes(const Vector3d *_points,
+    const size_t _count, const Box &_domain, uint64_t *_codes)
+{
+  const Quantizer quantizer(_domain, 21);
+  for (size_t i = 0; i < _count; ++i)
+  {
+    _codes[i] = mortonEncode(quantizer.Cell(_points[i].X(), 0),
+                             quantizer.Cell(_points[i].Y(), 1),
+                             quantizer.Cell(_points[i].Z(), 2));
+  }
+}
+
+/////////////////////////////////////////////////
+void ignition::math::hilbertCodes(const Vector3d *_points,
+    const size_t _count, const Box &_domain, uint64_t *_codes)
+{
+  const Quantizer quantizer(_domain, 21);
+  for (size_t i = 0; i < _count; ++i)
+  {
+    _codes[i] = hilbertEncode(quantizer.Cell(_points[i].X(), 0),
+                              quantizer.Cell(_points[i].Y(), 1),
+                              quantizer.Cell(_points[i].Z(), 2));
+  }
+}
+
+/////////////////////////////////////////////////
+void ignition::math::sortCodes(const uint64_t *_codes, const size_t _count,
+    std::vector<size_t> &_order)
+{
+  _order.resize(_count);
+  for (size_t i = 0; i < _count; ++i)
+    _order[i] = i;
+
+  if (_count < kSmallSort)
+  {
+    std::stable_sort(_order.begin(), _order.end(),
+        [_codes](const size_t _a, const size_t _b)
+        {
+          return _codes[_a] < _codes[_b];
+        });
+    return;
+  }
+
+  // Count the values of all digits in a single pass
+  std::vector<size_t> histograms(kDigits * kBuckets, 0);
+  std::vector<Item> items(_count);
+  for (size_t i = 0; i < _count; ++i)
+  {
+    const uint64_t code = _codes[i];
+    items[i].code = code;
+    items[i].index = i;
+    for (int d = 0; d < kDigits; ++d)
+    {
+      const size_t digit = (code >> (d * kDigitBits)) & (kBuckets - 1);
+      ++histograms[d * kBuckets + digit];
+    }
+  }
+
+  std::vector<Item> buffer(_count);
+  for (int d = 0; d < kDigits; ++d)
+  {
+    const int shift = d * kDigitBits;
+    size_t *histogram = &histograms[d * kBuckets];
+
+    // Skip the digit if it is the same for all codes
+    if (histogram[(_codes[0] >> shift) & (kBuckets - 1)] == _count)
+      continue;
+
+    // Turn the counts into offsets in the sorted array
+    size_t offset = 0;
+    for (size_t b = 0; b < kBuckets; ++b)
+    {
+      const size_t n = histogram[b];
+      histogram[b] = offset;
+      offset += n;
+    }
+
+    for (const Item &item : items)
+      buffer[histogram[(item.code >> shift) & (kBuckets - 1)]++] = item;
+    items.swap(buffer);
+  }
+
+  for (size_t i = 0; i < _count; ++i)
+    _order[i] = items[i].index;
+}
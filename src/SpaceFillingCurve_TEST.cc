@@ -0,0 +1,268 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "ignition/math/Rand.hh"
+#include "ignition/math/SpaceFillingCurve.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+/// \brief Random 32 bit value.
+/// \return Value.
+uint32_t RandomBits()
+{
+  return (static_cast<uint32_t>(math::Rand::IntUniform(0, 0xFFFF)) << 16) |
+    static_cast<uint32_t>(math::Rand::IntUniform(0, 0xFFFF));
+}
+
+/////////////////////////////////////////////////
+/// \brief Squared distance between two cells.
+/// \param[in] _a First cell.
+/// \param[in] _b Second cell.
+/// \return Squared distance.
+int64_t Distance(const std::vector<uint32_t> &_a,
+                 const std::vector<uint32_t> &_b)
+{
+  int64_t distance = 0;
+  for (size_t i = 0; i < _a.size(); ++i)
+  {
+    const int64_t d = static_cast<int64_t>(_a[i]) - _b[i];
+    distance += d * d;
+  }
+  return distance;
+}
+
+/////////////////////////////////////////////////
+TEST(SpaceFillingCurveTest, Morton)
+{
+  EXPECT_EQ(0u, math::mortonEncode(0, 0));
+  EXPECT_EQ(1u, math::mortonEncode(1, 0));
+  EXPECT_EQ(2u, math::mortonEncode(0, 1));
+  EXPECT_EQ(39u, math::mortonEncode(3, 5));
+  EXPECT_EQ(UINT64_MAX, math::mortonEncode(UINT32_MAX, UINT32_MAX));
+
+  EXPECT_EQ(1u, math::mortonEncode(1, 0, 0));
+  EXPECT_EQ(2u, math::mortonEncode(0, 1, 0));
+  EXPECT_EQ(4u, math::mortonEncode(0, 0, 1));
+  EXPECT_EQ(0u, math::mortonEncode(1 << 21, 1 << 21, 1 << 21));
+  EXPECT_EQ(INT64_MAX, math::mortonEncode(0x1FFFFF, 0x1FFFFF, 0x1FFFFF));
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    const uint32_t x = RandomBits();
+    const uint32_t y = RandomBits();
+    const uint32_t z = RandomBits();
+    uint32_t outX, outY, outZ;
+    math::mortonDecode(math::mortonEncode(x, y), outX, outY);
+    EXPECT_EQ(x, outX);
+    EXPECT_EQ(y, outY);
+
+    math::mortonDecode(math::mortonEncode(x, y, z), outX, outY, outZ);
+    EXPECT_EQ(x & 0x1FFFFF, outX);
+    EXPECT_EQ(y & 0x1FFFFF, outY);
+    EXPECT_EQ(z & 0x1FFFFF, outZ);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SpaceFillingCurveTest, Hilbert2)
+{
+  EXPECT_EQ(0u, math::hilbertEncode(0, 0));
+
+  // The first 16 codes cover a 4x4 square, and consecutive codes are
+  // neighbor cells
+  std::vector<bool> covered(16, false);
+  std::vector<uint32_t> last = {0, 0};
+  for (uint64_t code = 0; code < 4096; ++code)
+  {
+    uint32_t x, y;
+    math::hilbertDecode(code, x, y);
+    EXPECT_EQ(code, math::hilbertEncode(x, y));
+    if (code < 16)
+    {
+      ASSERT_LT(x, 4u);
+      ASSERT_LT(y, 4u);
+      covered[x * 4 + y] = true;
+    }
+    if (code > 0)
+    {
+      EXPECT_EQ(1, Distance(last, {x, y}));
+    }
+    last = {x, y};
+  }
+  for (const bool c : covered)
+    EXPECT_TRUE(c);
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    const uint32_t x = RandomBits();
+    const uint32_t y = RandomBits();
+    const uint64_t code = math::hilbertEncode(x, y);
+    uint32_t outX, outY;
+    math::hilbertDecode(code, outX, outY);
+    EXPECT_EQ(x, outX);
+    EXPECT_EQ(y, outY);
+
+    // The next cell along the curve is a neighbor
+    if (code < UINT64_MAX)
+    {
+      math::hilbertDecode(code + 1, outX, outY);
+      EXPECT_EQ(1, Distance({x, y}, {outX, outY}));
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SpaceFillingCurveTest, Hilbert3)
+{
+  EXPECT_EQ(0u, math::hilbertEncode(0, 0, 0));
+  EXPECT_EQ(math::hilbertEncode(1, 2, 3),
+            math::hilbertEncode((1 << 21) | 1, 2, 3));
+
+  // The first 64 codes cover a 4x4x4 cube
+  std::vector<bool> covered(64, false);
+  for (uint64_t code = 0; code < 64; ++code)
+  {
+    uint32_t x, y, z;
+    math::hilbertDecode(code, x, y, z);
+    ASSERT_LT(x, 4u);
+    ASSERT_LT(y, 4u);
+    ASSERT_LT(z, 4u);
+    covered[(x * 4 + y) * 4 + z] = true;
+  }
+  for (const bool c : covered)
+    EXPECT_TRUE(c);
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    const uint32_t x = RandomBits() & 0x1FFFFF;
+    const uint32_t y = RandomBits() & 0x1FFFFF;
+    const uint32_t z = RandomBits() & 0x1FFFFF;
+    const uint64_t code = math::hilbertEncode(x, y, z);
+    EXPECT_LE(code, static_cast<uint64_t>(INT64_MAX));
+    uint32_t outX, outY, outZ;
+    math::hilbertDecode(code, outX, outY, outZ);
+    EXPECT_EQ(x, outX);
+    EXPECT_EQ(y, outY);
+    EXPECT_EQ(z, outZ);
+
+    // The next cell along the curve is a neighbor
+    if (code < static_cast<uint64_t>(INT64_MAX))
+    {
+      math::hilbertDecode(code + 1, outX, outY, outZ);
+      EXPECT_EQ(1, Distance({x, y, z}, {outX, outY, outZ}));
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SpaceFillingCurveTest, Points)
+{
+  const math::Box domain(-1, -1, -1, 1, 1, 1);
+
+  EXPECT_EQ(0u, math::mortonCode(math::Vector3d(-1, -1, -1), domain));
+  EXPECT_EQ(0u, math::mortonCode(math::Vector3d(-5, -5, -5), domain));
+  EXPECT_EQ(INT64_MAX, math::mortonCode(math::Vector3d(1, 1, 1), domain));
+  EXPECT_EQ(INT64_MAX, math::mortonCode(math::Vector3d(5, 5, 5), domain));
+  EXPECT_EQ(uint64_t(1) << 60,
+            math::mortonCode(math::Vector3d(0, -1, -1), domain));
+  EXPECT_EQ(uint64_t(1) << 61,
+            math::mortonCode(math::Vector3d(-1, 0, -1), domain));
+  EXPECT_EQ(uint64_t(1) << 61, math::mortonCode(
+        math::Vector3d(math::NAN_D, 0, -1), domain));
+
+  EXPECT_EQ(0u, math::mortonCode(math::Vector2d(-1, -1), domain));
+  EXPECT_EQ(UINT64_MAX, math::mortonCode(math::Vector2d(1, 1), domain));
+  EXPECT_EQ(uint64_t(1) << 63,
+            math::mortonCode(math::Vector2d(-1, 0), domain));
+
+  EXPECT_EQ(0u, math::hilbertCode(math::Vector3d(-1, -1, -1), domain));
+  EXPECT_EQ(math::hilbertEncode(0x1FFFFF, 0x1FFFFF, 0x1FFFFF),
+            math::hilbertCode(math::Vector3d(1, 1, 1), domain));
+  EXPECT_EQ(math::hilbertEncode(0x100000, 0, 0x1FFFFF),
+            math::hilbertCode(math::Vector3d(0, -1, 1), domain));
+  EXPECT_EQ(math::hilbertEncode(0x80000000u, 0),
+            math::hilbertCode(math::Vector2d(0, -1), domain));
+
+  // Flat domain
+  const math::Box flat(0, 0, 0, 1, 1, 0);
+  EXPECT_EQ(math::mortonEncode(0x1FFFFF, 0x1FFFFF, 0),
+            math::mortonCode(math::Vector3d(1, 1, 1), flat));
+
+  // Arrays of points give the same codes as single points
+  std::vector<math::Vector3d> points;
+  for (int i = 0; i < 100; ++i)
+  {
+    points.push_back(math::Vector3d(math::Rand::DblUniform(-1, 1),
+          math::Rand::DblUniform(-1, 1), math::Rand::DblUniform(-1, 1)));
+  }
+  std::vector<uint64_t> morton(points.size());
+  std::vector<uint64_t> hilbert(points.size());
+  math::mortonCodes(points.data(), points.size(), domain, morton.data());
+  math::hilbertCodes(points.data(), points.size(), domain, hilbert.data());
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    EXPECT_EQ(math::mortonCode(points[i], domain), morton[i]);
+    EXPECT_EQ(math::hilbertCode(points[i], domain), hilbert[i]);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SpaceFillingCurveTest, Sort)
+{
+  std::vector<size_t> order;
+  math::sortCodes(nullptr, 0, order);
+  EXPECT_TRUE(order.empty());
+
+  // Small arrays, full range codes, and codes which differ in few bits
+  for (const size_t count : {10u, 10000u})
+  {
+    for (const uint64_t mask : {UINT64_MAX, uint64_t(0xF0F00)})
+    {
+      std::vector<uint64_t> codes(count);
+      for (uint64_t &code : codes)
+      {
+        code = ((static_cast<uint64_t>(RandomBits()) << 32) | RandomBits()) &
+          mask;
+      }
+      // Duplicates to check stability
+      codes[count / 2] = codes[count / 3];
+
+      math::sortCodes(codes.data(), codes.size(), order);
+      ASSERT_EQ(count, order.size());
+      std::vector<bool> seen(count, false);
+      for (size_t i = 0; i < count; ++i)
+      {
+        ASSERT_LT(order[i], count);
+        EXPECT_FALSE(seen[order[i]]);
+        seen[order[i]] = true;
+        if (i > 0)
+        {
+          EXPECT_LE(codes[order[i - 1]], codes[order[i]]);
+          if (codes[order[i - 1]] == codes[order[i]])
+          {
+            EXPECT_LT(order[i - 1], order[i]);
+          }
+        }
+      }
+    }
+  }
+}
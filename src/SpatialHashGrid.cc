@@ -0,0 +1,565 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "ignition/math/SpatialHashGrid.hh"
+
+using namespace ignition;
+using namespace math;
+
+namespace
+{
+  /// \brief Largest cell coordinate. Coordinates are clamped to
+  /// [-kMaxCell, kMaxCell], which keeps the arithmetic on cell coordinates
+  /// from overflowing. Far away points share the border cells.
+  const int64_t kMaxCell = 1 << 30;
+
+  /// \brief Value of an empty slot of the hash table.
+  const uint32_t kEmptySlot = std::numeric_limits<uint32_t>::max();
+
+  /// \brief Hash the coordinates of a cell.
+  /// \param[in] _x X coordinate of the cell.
+  /// \param[in] _y Y coordinate of the cell.
+  /// \param[in] _z Z coordinate of the cell.
+  /// \return Hash value.
+  uint64_t hashCell(const int64_t _x, const int64_t _y, const int64_t _z)
+  {
+    uint64_t h = static_cast<uint64_t>(_x) * 0x9E3779B97F4A7C15ull;
+    h ^= static_cast<uint64_t>(_y) * 0xC2B2AE3D27D4EB4Full;
+    h ^= static_cast<uint64_t>(_z) * 0x165667B19E3779F9ull;
+    // Finish with the MurmurHash3 mix, the low bits used by the table
+    // otherwise depend little on the high bits of the coordinates.
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    return h ^ (h >> 33);
+  }
+
+  /// \brief A point found by a nearest neighbor query.
+  struct Candidate
+  {
+    /// \brief Squared distance to the query point.
+    double distance;
+
+    /// \brief Index of the point.
+    size_t index;
+
+    /// \brief Order by distance, then by index.
+    /// \param[in] _other Candidate to compare with.
+    /// \return True if this candidate is closer.
+    bool operator<(const Candidate &_other) const
+    {
+      return this->distance < _other.distance ||
+        (!(_other.distance < this->distance) && this->index < _other.index);
+    }
+  };
+}
+
+/// \internal
+/// \brief Private data for the SpatialHashGrid class
+class ignition::math::SpatialHashGridPrivate
+{
+  /// \brief Get the cell coordinate of a point coordinate.
+  /// \param[in] _value Point coordinate.
+  /// \return Cell coordinate.
+  public: int64_t Cell(const double _value) const
+  {
+    const double cell = std::floor(_value * this->inverseCellSize);
+    if (cell < -kMaxCell)
+      return -kMaxCell;
+    if (cell > kMaxCell)
+      return kMaxCell;
+    return static_cast<int64_t>(cell);
+  }
+
+  /// \brief Find a cell in the hash table.
+  /// \param[in] _x X coordinate of the cell.
+  /// \param[in] _y Y coordinate of the cell.
+  /// \param[in] _z Z coordinate of the cell.
+  /// \return Index of the cell, kEmptySlot if the cell holds no point.
+  public: uint32_t Find(const int64_t _x, const int64_t _y,
+                        const int64_t _z) const
+  {
+    if (this->table.empty())
+      return kEmptySlot;
+
+    const size_t mask = this->table.size() - 1;
+    size_t slot = hashCell(_x, _y, _z) & mask;
+    while (true)
+    {
+      const uint32_t cell = this->table[slot];
+      if (cell == kEmptySlot ||
+          (this->cellX[cell] == _x && this->cellY[cell] == _y &&
+           this->cellZ[cell] == _z))
+      {
+        return cell;
+      }
+      slot = (slot + 1) & mask;
+    }
+  }
+
+  /// \brief Find a cell in the hash table, adding it when missing.
+  /// \param[in] _x X coordinate of the cell.
+  /// \param[in] _y Y coordinate of the cell.
+  /// \param[in] _z Z coordinate of the cell.
+  /// \return Index of the cell.
+  public: uint32_t Insert(const int64_t _x, const int64_t _y,
+                          const int64_t _z)
+  {
+    const size_t mask = this->table.size() - 1;
+    size_t slot = hashCell(_x, _y, _z) & mask;
+    while (true)
+    {
+      const uint32_t cell = this->table[slot];
+      if (cell == kEmptySlot)
+      {
+        const uint32_t added = static_cast<uint32_t>(this->cellX.size());
+        this->table[slot] = added;
+        this->cellX.push_back(_x);
+        this->cellY.push_back(_y);
+        this->cellZ.push_back(_z);
+        this->cellStart.push_back(0);
+        return added;
+      }
+      if (this->cellX[cell] == _x && this->cellY[cell] == _y &&
+          this->cellZ[cell] == _z)
+      {
+        return cell;
+      }
+      slot = (slot + 1) & mask;
+    }
+  }
+
+  /// \brief Squared distance between a sorted point and a location.
+  /// \param[in] _i Position of the point in the sorted arrays.
+  /// \param[in] _p Location.
+  /// \return Squared distance.
+  public: double DistanceSquared(const size_t _i, const Vector3d &_p) const
+  {
+    const double dx = this->x[_i] - _p.X();
+    const double dy = this->y[_i] - _p.Y();
+    const double dz = this->z[_i] - _p.Z();
+    return dx * dx + dy * dy + dz * dz;
+  }
+
+  /// \brief Offer the points of a cell to a nearest neighbor query.
+  /// \param[in] _cell Index of the cell.
+  /// \param[in] _p Location of the query.
+  /// \param[in] _k Number of points to find.
+  /// \param[in,out] _heap Max heap of the best candidates so far.
+  public: void Offer(const uint32_t _cell, const Vector3d &_p,
+                     const size_t _k, std::vector<Candidate> &_heap) const
+  {
+    const size_t end = this->cellStart[_cell + 1];
+    for (size_t i = this->cellStart[_cell]; i < end; ++i)
+    {
+      const Candidate candidate = {this->DistanceSquared(i, _p),
+                                   this->sortedIndex[i]};
+      if (_heap.size() < _k)
+      {
+        _heap.push_back(candidate);
+        std::push_heap(_heap.begin(), _heap.end());
+      }
+      else if (candidate < _heap.front())
+      {
+        std::pop_heap(_heap.begin(), _heap.end());
+        _heap.back() = candidate;
+        std::push_heap(_heap.begin(), _heap.end());
+      }
+    }
+  }
+
+  /// \brief Length of the side of a cell.
+  public: double cellSize = 1.0;
+
+  /// \brief Inverse of the cell size.
+  public: double inverseCellSize = 1.0;
+
+  /// \brief Number of points given to Build.
+  public: size_t size = 0;
+
+  /// \brief Open addressing hash table of cell indices, with a power of
+  /// two size.
+  public: std::vector<uint32_t> table;
+
+  /// \brief X coordinate of each cell.
+  public: std::vector<int64_t> cellX;
+
+  /// \brief Y coordinate of each cell.
+  public: std::vector<int64_t> cellY;
+
+  /// \brief Z coordinate of each cell.
+  public: std::vector<int64_t> cellZ;
+
+  /// \brief Position in the sorted arrays of the first point of each
+  /// cell, with one more entry for the end of the last cell.
+  public: std::vector<size_t> cellStart;
+
+  /// \brief Smallest coordinates of the cells which hold points.
+  public: int64_t minCell[3] = {0, 0, 0};
+
+  /// \brief Largest coordinates of the cells which hold points.
+  public: int64_t maxCell[3] = {-1, -1, -1};
+
+  /// \brief Cell of each point given to Build, kEmptySlot for points
+  /// with a non finite coordinate.
+  public: std::vector<uint32_t> pointCell;
+
+  /// \brief X coordinates of the points, sorted by cell.
+  public: std::vector<double> x;
+
+  /// \brief Y coordinates of the points, sorted by cell.
+  public: std::vector<double> y;
+
+  /// \brief Z coordinates of the points, sorted by cell.
+  public: std::vector<double> z;
+
+  /// \brief Index in the array given to Build of each sorted point.
+  public: std::vector<size_t> sortedIndex;
+};
+
+/////////////////////////////////////////////////
+SpatialHashGrid::SpatialHashGrid()
+: dataPtr(new SpatialHashGridPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+SpatialHashGrid::SpatialHashGrid(const double _cellSize)
+: dataPtr(new SpatialHashGridPrivate)
+{
+  this->SetCellSize(_cellSize);
+}
+
+/////////////////////////////////////////////////
+SpatialHashGrid::SpatialHashGrid(const SpatialHashGrid &_grid)
+: dataPtr(new SpatialHashGridPrivate(*_grid.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+SpatialHashGrid::~SpatialHashGrid()
+{
+}
+
+/////////////////////////////////////////////////
+SpatialHashGrid &SpatialHashGrid::operator=(const SpatialHashGrid &_grid)
+{
+  if (this == &_grid)
+    return *this;
+
+  *this->dataPtr = *_grid.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+bool SpatialHashGrid::SetCellSize(const double _cellSize)
+{
+  if (!(_cellSize > 0) || !std::isfinite(_cellSize))
+    return false;
+
+  this->Clear();
+  this->dataPtr->cellSize = _cellSize;
+  this->dataPtr->inverseCellSize = 1.0 / _cellSize;
+  return true;
+}
+
+/////////////////////////////////////////////////
+double SpatialHashGrid::CellSize() const
+{
+  return this->dataPtr->cellSize;
+}
+
+/////////////////////////////////////////////////
+void SpatialHashGrid::Build(const Vector3d *_points, const size_t _count)
+{
+  SpatialHashGridPrivate &d = *this->dataPtr;
+
+  // Keep the table at most half full
+  size_t tableSize = 16;
+  while (tableSize < 2 * _count)
+    tableSize *= 2;
+  d.table.assign(tableSize, kEmptySlot);
+  d.cellX.clear();
+  d.cellY.clear();
+  d.cellZ.clear();
+  d.cellStart.clear();
+  d.pointCell.resize(_count);
+  d.size = _count;
+
+  for (int j = 0; j < 3; ++j)
+  {
+    d.minCell[j] = kMaxCell;
+    d.maxCell[j] = -kMaxCell;
+  }
+
+  // Find the cell of each point and count the points of each cell
+  size_t valid = 0;
+  for (size_t i = 0; i < _count; ++i)
+  {
+    const Vector3d &p = _points[i];
+    if (!std::isfinite(p.X()) || !std::isfinite(p.Y()) ||
+        !std::isfinite(p.Z()))
+    {
+      d.pointCell[i] = kEmptySlot;
+      continue;
+    }
+
+    const int64_t c[3] = {d.Cell(p.X()), d.Cell(p.Y()), d.Cell(p.Z())};
+    const uint32_t cell = d.Insert(c[0], c[1], c[2]);
+    d.pointCell[i] = cell;
+    ++d.cellStart[cell];
+    ++valid;
+    for (int j = 0; j < 3; ++j)
+    {
+      d.minCell[j] = std::min(d.minCell[j], c[j]);
+      d.maxCell[j] = std::max(d.maxCell[j], c[j]);
+    }
+  }
+
+  // Turn the counts into end positions
+  size_t total = 0;
+  for (size_t &start : d.cellStart)
+  {
+    total += start;
+    start = total;
+  }
+  d.cellStart.push_back(total);
+
+  // Scatter the points in reverse order, which turns the end positions
+  // into start positions and keeps the points of a cell in their
+  // original order
+  d.x.resize(valid);
+  d.y.resize(valid);
+  d.z.resize(valid);
+  d.sortedIndex.resize(valid);
+  for (size_t i = _count; i-- > 0;)
+  {
+    const uint32_t cell = d.pointCell[i];
+    if (cell == kEmptySlot)
+      continue;
+
+    const size_t pos = --d.cellStart[cell];
+    d.x[pos] = _points[i].X();
+    d.y[pos] = _points[i].Y();
+    d.z[pos] = _points[i].Z();
+    d.sortedIndex[pos] = i;
+  }
+}
+
+/////////////////////////////////////////////////
+void SpatialHashGrid::Build(const std::vector<Vector3d> &_points)
+{
+  this->Build(_points.data(), _points.size());
+}
+
+/////////////////////////////////////////////////
+void SpatialHashGrid::Clear()
+{
+  this->Build(nullptr, 0);
+}
+
+/////////////////////////////////////////////////
+size_t SpatialHashGrid::Size() const
+{
+  return this->dataPtr->size;
+}
+
+/////////////////////////////////////////////////
+size_t SpatialHashGrid::CellCount() const
+{
+  return this->dataPtr->cellX.size();
+}
+
+/////////////////////////////////////////////////
+size_t SpatialHashGrid::Radius(const Vector3d &_center, const double _radius,
+    std::vector<size_t> &_indices) const
+{
+  const SpatialHashGridPrivate &d = *this->dataPtr;
+  _indices.clear();
+  if (!(_radius >= 0) || d.cellX.empty() || !std::isfinite(_center.X()) ||
+      !std::isfinite(_center.Y()) || !std::isfinite(_center.Z()))
+  {
+    return 0;
+  }
+
+  const double radius2 = _radius * _radius;
+
+  // Range of cells which may hold points within the radius, restricted
+  // to the cells which hold points
+  int64_t low[3], high[3];
+  double cells = 1;
+  for (int j = 0; j < 3; ++j)
+  {
+    low[j] = std::max(d.Cell(_center[j] - _radius), d.minCell[j]);
+    high[j] = std::min(d.Cell(_center[j] + _radius), d.maxCell[j]);
+    if (high[j] < low[j])
+      return 0;
+    cells *= static_cast<double>(high[j] - low[j] + 1);
+  }
+
+  // A large range visits every stored cell instead
+  if (cells > static_cast<double>(d.cellX.size()))
+  {
+    for (size_t cell = 0; cell < d.cellX.size(); ++cell)
+    {
+      if (d.cellX[cell] < low[0] || d.cellX[cell] > high[0] ||
+          d.cellY[cell] < low[1] || d.cellY[cell] > high[1] ||
+          d.cellZ[cell] < low[2] || d.cellZ[cell] > high[2])
+      {
+        continue;
+      }
+      for (size_t i = d.cellStart[cell]; i < d.cellStart[cell + 1]; ++i)
+      {
+        if (d.DistanceSquared(i, _center) <= radius2)
+          _indices.push_back(d.sortedIndex[i]);
+      }
+    }
+    return _indices.size();
+  }
+
+  for (int64_t cx = low[0]; cx <= high[0]; ++cx)
+  {
+    for (int64_t cy = low[1]; cy <= high[1]; ++cy)
+    {
+      for (int64_t cz = low[2]; cz <= high[2]; ++cz)
+      {
+        const uint32_t cell = d.Find(cx, cy, cz);
+        if (cell == kEmptySlot)
+          continue;
+        for (size_t i = d.cellStart[cell]; i < d.cellStart[cell + 1]; ++i)
+        {
+          if (d.DistanceSquared(i, _center) <= radius2)
+            _indices.push_back(d.sortedIndex[i]);
+        }
+      }
+    }
+  }
+  return _indices.size();
+}
+
+/////////////////////////////////////////////////
+size_t SpatialHashGrid::Nearest(const Vector3d &_point, const size_t _k,
+    std::vector<size_t> &_indices) const
+{
+  std::vector<double> distances;
+  return this->Nearest(_point, _k, _indices, distances);
+}
+
+/////////////////////////////////////////////////
+size_t SpatialHashGrid::Nearest(const Vector3d &_point, const size_t _k,
+    std::vector<size_t> &_indices, std::vector<double> &_distances) const
+{
+  const SpatialHashGridPrivate &d = *this->dataPtr;
+  _indices.clear();
+  _distances.clear();
+  if (_k == 0 || d.cellX.empty() || !std::isfinite(_point.X()) ||
+      !std::isfinite(_point.Y()) || !std::isfinite(_point.Z()))
+  {
+    return 0;
+  }
+
+  const size_t k = std::min(_k, d.x.size());
+  std::vector<Candidate> heap;
+  heap.reserve(k);
+
+  const int64_t center[3] = {d.Cell(_point.X()), d.Cell(_point.Y()),
+                             d.Cell(_point.Z())};
+
+  // Largest ring of cells around the center which can hold points, and
+  // distance from the query to the closest face of its cell
+  int64_t maxRing = 0;
+  double margin = d.cellSize;
+  for (int j = 0; j < 3; ++j)
+  {
+    maxRing = std::max(maxRing, center[j] - d.minCell[j]);
+    maxRing = std::max(maxRing, d.maxCell[j] - center[j]);
+    const double low = _point[j] - static_cast<double>(center[j]) * d.cellSize;
+    margin = std::min(margin, std::min(low, d.cellSize - low));
+  }
+  margin = std::max(margin, 0.0);
+
+  // Visit rings of cells at increasing Chebyshev distance from the cell
+  // of the query. Every cell of ring r + 1 is at least r cells plus the
+  // margin away from the query, so the search stops once the k-th
+  // candidate is closer.
+  bool scanAll = false;
+  for (int64_t ring = 0; ring <= maxRing; ++ring)
+  {
+    // Large rings visit every stored cell instead
+    const double side = static_cast<double>(2 * ring + 1);
+    if (side * side * side > static_cast<double>(d.cellX.size()))
+    {
+      scanAll = true;
+      break;
+    }
+
+    for (int64_t dx = -ring; dx <= ring; ++dx)
+    {
+      const int64_t cx = center[0] + dx;
+      if (cx < d.minCell[0] || cx > d.maxCell[0])
+        continue;
+      for (int64_t dy = -ring; dy <= ring; ++dy)
+      {
+        const int64_t cy = center[1] + dy;
+        if (cy < d.minCell[1] || cy > d.maxCell[1])
+          continue;
+
+        // Inside of the ring only the two faces along z are visited
+        const bool face = dx == -ring || dx == ring ||
+          dy == -ring || dy == ring;
+        const int64_t step = face || ring == 0 ? 1 : 2 * ring;
+        for (int64_t dz = -ring; dz <= ring; dz += step)
+        {
+          const int64_t cz = center[2] + dz;
+          if (cz < d.minCell[2] || cz > d.maxCell[2])
+            continue;
+          const uint32_t cell = d.Find(cx, cy, cz);
+          if (cell != kEmptySlot)
+            d.Offer(cell, _point, k, heap);
+        }
+      }
+    }
+
+    const double reach = static_cast<double>(ring) * d.cellSize + margin;
+    if (heap.size() == k && heap.front().distance <= reach * reach)
+      break;
+  }
+
+  if (scanAll)
+  {
+    heap.clear();
+    for (uint32_t cell = 0; cell < d.cellX.size(); ++cell)
+      d.Offer(cell, _point, k, heap);
+  }
+
+  std::sort_heap(heap.begin(), heap.end());
+  _indices.resize(heap.size());
+  _distances.resize(heap.size());
+  for (size_t i = 0; i < heap.size(); ++i)
+  {
+    _indices[i] = heap[i].index;
+    _distances[i] = std::sqrt(heap[i].distance);
+  }
+  return heap.size();
+}
@@ -0,0 +1,281 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "ignition/math/Rand.hh"
+#include "ignition/math/SpatialHashGrid.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+/// \brief Random points in a box, with some duplicates.
+/// \param[in] _count Number of points.
+/// \param[in] _size Side of the box.
+/// \return Points.
+std::vector<math::Vector3d> RandomPoints(const size_t _count,
+                                         const double _size)
+{
+  std::vector<math::Vector3d> points;
+  for (size_t i = 0; i < _count; ++i)
+  {
+    if (i % 10 == 9)
+    {
+      points.push_back(points[i - 5]);
+      continue;
+    }
+    points.push_back(math::Vector3d(
+          math::Rand::DblUniform(-_size, _size),
+          math::Rand::DblUniform(-_size, _size),
+          math::Rand::DblUniform(0, 0.1 * _size)));
+  }
+  return points;
+}
+
+/////////////////////////////////////////////////
+/// \brief Check a radius query against a brute force search.
+/// \param[in] _grid Grid built over _points.
+/// \param[in] _points Points.
+/// \param[in] _center Center of the query.
+/// \param[in] _radius Radius of the query.
+void CheckRadius(const math::SpatialHashGrid &_grid,
+                 const std::vector<math::Vector3d> &_points,
+                 const math::Vector3d &_center, const double _radius)
+{
+  std::vector<size_t> expected;
+  for (size_t i = 0; i < _points.size(); ++i)
+  {
+    if (_points[i].Distance(_center) <= _radius)
+      expected.push_back(i);
+  }
+
+  std::vector<size_t> indices;
+  EXPECT_EQ(expected.size(), _grid.Radius(_center, _radius, indices));
+  std::sort(indices.begin(), indices.end());
+  EXPECT_EQ(expected, indices);
+}
+
+/////////////////////////////////////////////////
+/// \brief Check a nearest neighbor query against a brute force search.
+/// \param[in] _grid Grid built over _points.
+/// \param[in] _points Points.
+/// \param[in] _point Location of the query.
+/// \param[in] _k Number of neighbors.
+void CheckNearest(const math::SpatialHashGrid &_grid,
+                  const std::vector<math::Vector3d> &_points,
+                  const math::Vector3d &_point, const size_t _k)
+{
+  std::vector<double> expected;
+  for (const math::Vector3d &p : _points)
+    expected.push_back(p.Distance(_point));
+  std::sort(expected.begin(), expected.end());
+  expected.resize(std::min(_k, expected.size()));
+
+  std::vector<size_t> indices;
+  std::vector<double> distances;
+  EXPECT_EQ(expected.size(), _grid.Nearest(_point, _k, indices, distances));
+  ASSERT_EQ(expected.size(), indices.size());
+  ASSERT_EQ(expected.size(), distances.size());
+  for (size_t i = 0; i < expected.size(); ++i)
+  {
+    EXPECT_NEAR(expected[i], distances[i], 1e-12);
+    EXPECT_NEAR(_points[indices[i]].Distance(_point), distances[i], 1e-12);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialHashGridTest, Construct)
+{
+  math::SpatialHashGrid grid;
+  EXPECT_DOUBLE_EQ(1.0, grid.CellSize());
+  EXPECT_EQ(0u, grid.Size());
+  EXPECT_EQ(0u, grid.CellCount());
+
+  std::vector<size_t> indices = {3};
+  EXPECT_EQ(0u, grid.Radius(math::Vector3d::Zero, 10, indices));
+  EXPECT_TRUE(indices.empty());
+  indices.push_back(3);
+  EXPECT_EQ(0u, grid.Nearest(math::Vector3d::Zero, 3, indices));
+  EXPECT_TRUE(indices.empty());
+
+  EXPECT_FALSE(grid.SetCellSize(0.0));
+  EXPECT_FALSE(grid.SetCellSize(-1.0));
+  EXPECT_FALSE(grid.SetCellSize(math::NAN_D));
+  EXPECT_FALSE(grid.SetCellSize(math::INF_D));
+  EXPECT_DOUBLE_EQ(1.0, grid.CellSize());
+  EXPECT_TRUE(grid.SetCellSize(0.25));
+  EXPECT_DOUBLE_EQ(0.25, grid.CellSize());
+
+  math::SpatialHashGrid grid2(2.0);
+  EXPECT_DOUBLE_EQ(2.0, grid2.CellSize());
+
+  // Points in cells (0, 0, 0), (0, 0, 0), (-1, 0, 0) and (0, 1, 2)
+  std::vector<math::Vector3d> points = {
+    math::Vector3d(0.5, 0.5, 0.5), math::Vector3d(1.5, 0, 0),
+    math::Vector3d(-0.5, 0, 0), math::Vector3d(0, 2, 4)};
+  grid2.Build(points);
+  EXPECT_EQ(4u, grid2.Size());
+  EXPECT_EQ(3u, grid2.CellCount());
+
+  // Copy
+  math::SpatialHashGrid copy(grid2);
+  EXPECT_EQ(3u, copy.CellCount());
+  EXPECT_EQ(2u, copy.Nearest(math::Vector3d(1.4, 0, 0), 2, indices));
+  EXPECT_EQ(1u, indices[0]);
+  EXPECT_EQ(0u, indices[1]);
+  grid = copy;
+  EXPECT_DOUBLE_EQ(2.0, grid.CellSize());
+  EXPECT_EQ(4u, grid.Size());
+
+  // Changing the cell size empties the grid
+  EXPECT_TRUE(grid.SetCellSize(1.0));
+  EXPECT_EQ(0u, grid.Size());
+  EXPECT_EQ(4u, copy.Size());
+
+  copy.Clear();
+  EXPECT_EQ(0u, copy.Size());
+  EXPECT_EQ(0u, copy.CellCount());
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialHashGridTest, Radius)
+{
+  math::Rand::Seed(1);
+  const std::vector<math::Vector3d> points = RandomPoints(2000, 10.0);
+  const double cellSizes[] = {0.3, 1.0, 7.0, 100.0};
+  for (double cellSize : cellSizes)
+  {
+    math::SpatialHashGrid grid(cellSize);
+    grid.Build(points);
+    EXPECT_EQ(points.size(), grid.Size());
+
+    for (int i = 0; i < 20; ++i)
+    {
+      const math::Vector3d center(math::Rand::DblUniform(-12, 12),
+          math::Rand::DblUniform(-12, 12), math::Rand::DblUniform(-1, 2));
+      CheckRadius(grid, points, center, 0.0);
+      CheckRadius(grid, points, center, 0.5);
+      CheckRadius(grid, points, center, 2.0);
+      CheckRadius(grid, points, center, 30.0);
+    }
+
+    // Exactly on a point, with a zero radius
+    std::vector<size_t> indices;
+    EXPECT_GE(grid.Radius(points[4], 0.0, indices), 2u);
+    EXPECT_NE(indices.end(), std::find(indices.begin(), indices.end(), 9u));
+
+    // Far away and invalid queries
+    EXPECT_EQ(0u, grid.Radius(math::Vector3d(1e3, 0, 0), 5, indices));
+    EXPECT_EQ(0u, grid.Radius(math::Vector3d::Zero, -1, indices));
+    EXPECT_EQ(0u, grid.Radius(math::Vector3d::Zero, math::NAN_D, indices));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialHashGridTest, Nearest)
+{
+  math::Rand::Seed(2);
+  const std::vector<math::Vector3d> points = RandomPoints(2000, 10.0);
+  const double cellSizes[] = {0.3, 1.0, 7.0, 100.0};
+  for (double cellSize : cellSizes)
+  {
+    math::SpatialHashGrid grid(cellSize);
+    grid.Build(points);
+
+    for (int i = 0; i < 20; ++i)
+    {
+      const math::Vector3d point(math::Rand::DblUniform(-12, 12),
+          math::Rand::DblUniform(-12, 12), math::Rand::DblUniform(-1, 2));
+      CheckNearest(grid, points, point, 1);
+      CheckNearest(grid, points, point, 8);
+      CheckNearest(grid, points, point, 50);
+    }
+    CheckNearest(grid, points, math::Vector3d(500, -300, 20), 4);
+    CheckNearest(grid, points, math::Vector3d::Zero, 5000);
+
+    std::vector<size_t> indices;
+    EXPECT_EQ(0u, grid.Nearest(math::Vector3d::Zero, 0, indices));
+    EXPECT_EQ(0u, grid.Nearest(math::Vector3d(math::NAN_D, 0, 0), 1,
+          indices));
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialHashGridTest, Rebuild)
+{
+  math::Rand::Seed(3);
+  math::SpatialHashGrid grid(0.5);
+  std::vector<math::Vector3d> points = RandomPoints(500, 5.0);
+
+  // Move the points as particles, rebuilding each step
+  for (int step = 0; step < 5; ++step)
+  {
+    for (math::Vector3d &p : points)
+      p += math::Vector3d(0.3, -0.1, 0.05 * step);
+    grid.Build(points);
+    EXPECT_EQ(points.size(), grid.Size());
+    CheckRadius(grid, points, points[7], 1.0);
+    CheckNearest(grid, points, points[11], 6);
+  }
+
+  // Fewer points
+  points.resize(20);
+  grid.Build(points);
+  EXPECT_EQ(20u, grid.Size());
+  CheckRadius(grid, points, points[3], 4.0);
+  CheckNearest(grid, points, points[3], 30);
+}
+
+/////////////////////////////////////////////////
+TEST(SpatialHashGridTest, NonFinite)
+{
+  std::vector<math::Vector3d> points = {
+    math::Vector3d(0, 0, 0), math::Vector3d(math::NAN_D, 0, 0),
+    math::Vector3d(0, math::INF_D, 0), math::Vector3d(1, 0, 0),
+    math::Vector3d(1e300, -1e300, 0)};
+
+  math::SpatialHashGrid grid(1.0);
+  grid.Build(points);
+  EXPECT_EQ(5u, grid.Size());
+
+  std::vector<size_t> indices;
+  EXPECT_EQ(2u, grid.Radius(math::Vector3d::Zero, 1.0, indices));
+  std::sort(indices.begin(), indices.end());
+  EXPECT_EQ(0u, indices[0]);
+  EXPECT_EQ(3u, indices[1]);
+
+  // Only the finite points are returned
+  EXPECT_EQ(3u, grid.Nearest(math::Vector3d(0.1, 0, 0), 10, indices));
+  EXPECT_EQ(0u, indices[0]);
+  EXPECT_EQ(3u, indices[1]);
+  EXPECT_EQ(4u, indices[2]);
+
+  // Far away points share the border cells
+  EXPECT_EQ(1u, grid.Nearest(math::Vector3d(1e300, -1e300, 1), 1, indices));
+  EXPECT_EQ(4u, indices[0]);
+  EXPECT_EQ(1u, grid.Radius(math::Vector3d(1e300, -1e300, 0), 1, indices));
+  EXPECT_EQ(4u, indices[0]);
+
+  // Non finite centers find nothing
+  EXPECT_EQ(0u, grid.Radius(math::Vector3d(math::NAN_D, 0, 0), 1, indices));
+  EXPECT_TRUE(indices.empty());
+  EXPECT_EQ(0u, grid.Radius(math::Vector3d(0, 0, math::INF_D), 1, indices));
+  EXPECT_EQ(0u, grid.Nearest(math::Vector3d(0, math::NAN_D, 0), 1, indices));
+}
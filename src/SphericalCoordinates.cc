@@ -14,6 +14,8 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <cmath>
 #include <string>
 
 #include "ignition/math/Matrix3.hh"
@@ -37,6 +39,77 @@ const double g_EarthWGS84Flattening = 1.0/298.257223563;
 // Radius of the Earth (meters).
 const double g_EarthRadius = 6371000.0;
 
+namespace
+{
+  /// \brief Convert a geodetic position to ECEF.
+  /// \param[in] _pos Latitude (rad), longitude (rad) and altitude (m).
+  /// \param[in] _a Semi-major axis of the ellipsoid.
+  /// \param[in] _b Semi-minor axis of the ellipsoid.
+  /// \param[in] _e First eccentricity of the ellipsoid.
+  /// \return ECEF position.
+  inline Vector3d GeodeticToECEF(const Vector3d &_pos,
+      const double _a, const double _b, const double _e)
+  {
+    double cosLat = cos(_pos.X());
+    double sinLat = sin(_pos.X());
+    double cosLon = cos(_pos.Y());
+    double sinLon = sin(_pos.Y());
+
+    // Radius of planet curvature (meters)
+    double curvature = _a / sqrt(1.0 - _e * _e * sinLat * sinLat);
+
+    return Vector3d(
+        (_pos.Z() + curvature) * cosLat * cosLon,
+        (_pos.Z() + curvature) * cosLat * sinLon,
+        ((_b * _b) / (_a * _a) * curvature + _pos.Z()) * sinLat);
+  }
+
+  /// \brief Convert an ECEF position to geodetic coordinates, using
+  /// Bowring's method. The sine and cosine of the intermediate angles are
+  /// computed from their tangents, so that the only trigonometric calls
+  /// are the two arc tangents giving latitude and longitude.
+  /// \param[in] _ecef ECEF position.
+  /// \param[in] _a Semi-major axis of the ellipsoid.
+  /// \param[in] _b Semi-minor axis of the ellipsoid.
+  /// \param[in] _e First eccentricity of the ellipsoid.
+  /// \param[in] _ep Second eccentricity of the ellipsoid.
+  /// \return Latitude (rad), longitude (rad) and altitude (m).
+  inline Vector3d ECEFToGeodetic(const Vector3d &_ecef,
+      const double _a, const double _b, const double _e, const double _ep)
+  {
+    double p = sqrt(_ecef.X() * _ecef.X() + _ecef.Y() * _ecef.Y());
+
+    // Parametric latitude theta, with tan(theta) = z * a / (p * b)
+    double za = _ecef.Z() * _a;
+    double pb = p * _b;
+    double h = sqrt(za * za + pb * pb);
+    double sinTheta = za / h;
+    double cosTheta = pb / h;
+
+    // Geodetic latitude, lat = atan(num / den)
+    double num = _ecef.Z() +
+      _ep * _ep * _b * sinTheta * sinTheta * sinTheta;
+    double den = p - _e * _e * _a * cosTheta * cosTheta * cosTheta;
+    double sign = den < 0 ? -1.0 : 1.0;
+    double r = sqrt(num * num + den * den);
+    double sinLat = sign * num / r;
+    double cosLat = sign * den / r;
+    double lat = atan2(sinLat, cosLat);
+
+    double lon = atan2(_ecef.Y(), _ecef.X());
+
+    // On the polar axis cos(lat) is 0, and the altitude is the distance
+    // to the pole.
+    if (p < 1e-9 * _a)
+      return Vector3d(lat, lon, std::abs(_ecef.Z()) - _b);
+
+    // Radius of planet curvature at the current latitude.
+    double nCurvature = _a / sqrt(1.0 - _e * _e * sinLat * sinLat);
+
+    return Vector3d(lat, lon, p / cosLat - nCurvature);
+  }
+}
+
 // Private data for the SphericalCoordinates class.
 class ignition::math::SphericalCoordinatesPrivate
 {
@@ -85,8 +158,137 @@ class ignition::math::SphericalCoordinatesPrivate
 
   /// \brief Cache sine head transform
   public: double sinHea;
+
+  /// \brief Convert a geodetic position to ECEF.
+  /// \param[in] _pos Latitude (rad), longitude (rad) and altitude (m).
+  /// \return ECEF position.
+  public: Vector3d SphericalToECEF(const Vector3d &_pos) const
+  {
+    return GeodeticToECEF(_pos, this->ellA, this->ellB, this->ellE);
+  }
+
+  /// \brief Convert an ECEF position to geodetic coordinates.
+  /// \param[in] _ecef ECEF position.
+  /// \return Latitude (rad), longitude (rad) and altitude (m).
+  public: Vector3d ECEFToSpherical(const Vector3d &_ecef) const
+  {
+    return ECEFToGeodetic(_ecef, this->ellA, this->ellB, this->ellE,
+        this->ellP);
+  }
+
+  /// \brief Rotate a LOCAL vector to the GLOBAL frame.
+  /// \param[in] _vec Vector in the LOCAL frame.
+  /// \return Vector in the GLOBAL frame.
+  public: Vector3d LocalToGlobal(const Vector3d &_vec) const
+  {
+    return Vector3d(
+        -_vec.X() * this->cosHea + _vec.Y() * this->sinHea,
+        -_vec.X() * this->sinHea - _vec.Y() * this->cosHea,
+        _vec.Z());
+  }
+
+  /// \brief Rotate a GLOBAL vector to the LOCAL frame.
+  /// \param[in] _vec Vector in the GLOBAL frame.
+  /// \return Vector in the LOCAL frame.
+  public: Vector3d GlobalToLocal(const Vector3d &_vec) const
+  {
+    return Vector3d(
+        _vec.X() * this->cosHea - _vec.Y() * this->sinHea,
+        _vec.X() * this->sinHea + _vec.Y() * this->cosHea,
+        _vec.Z());
+  }
 };
 
+namespace
+{
+  /// \brief Distance between two points on an ellipsoid, using
+  /// Vincenty's inverse formula
+  /// (https://en.wikipedia.org/wiki/Vincenty%27s_formulae).
+  /// \param[in] _latA Latitude of point A (rad).
+  /// \param[in] _lonA Longitude of point A (rad).
+  /// \param[in] _latB Latitude of point B (rad).
+  /// \param[in] _lonB Longitude of point B (rad).
+  /// \param[in] _a Semi-major axis of the ellipsoid.
+  /// \param[in] _b Semi-minor axis of the ellipsoid.
+  /// \param[in] _f Flattening of the ellipsoid.
+  /// \return Distance in meters, or NaN if the iteration does not
+  /// converge.
+  double Vincenty(const double _latA, const double _lonA,
+                  const double _latB, const double _lonB,
+                  const double _a, const double _b, const double _f)
+  {
+    // Reduced latitudes
+    const double u1 = atan((1 - _f) * tan(_latA));
+    const double u2 = atan((1 - _f) * tan(_latB));
+    const double sinU1 = sin(u1);
+    const double cosU1 = cos(u1);
+    const double sinU2 = sin(u2);
+    const double cosU2 = cos(u2);
+
+    const double l = _lonB - _lonA;
+    double lambda = l;
+
+    double sinSigma = 0, cosSigma = 0, sigma = 0;
+    double cosSqAlpha = 0, cos2SigmaM = 0;
+    bool converged = false;
+    for (int iter = 0; iter < 200 && !converged; ++iter)
+    {
+      const double sinLambda = sin(lambda);
+      const double cosLambda = cos(lambda);
+      const double t1 = cosU2 * sinLambda;
+      const double t2 = cosU1 * sinU2 - sinU1 * cosU2 * cosLambda;
+      sinSigma = sqrt(t1 * t1 + t2 * t2);
+
+      // Coincident points
+      if (sinSigma <= 0)
+        return 0;
+
+      cosSigma = sinU1 * sinU2 + cosU1 * cosU2 * cosLambda;
+      sigma = atan2(sinSigma, cosSigma);
+      const double sinAlpha = cosU1 * cosU2 * sinLambda / sinSigma;
+      cosSqAlpha = 1 - sinAlpha * sinAlpha;
+
+      // Both points on the equator
+      cos2SigmaM = cosSqAlpha > 0 ?
+        cosSigma - 2 * sinU1 * sinU2 / cosSqAlpha : 0;
+
+      const double c = _f / 16 * cosSqAlpha * (4 + _f * (4 - 3 * cosSqAlpha));
+      const double lambdaPrev = lambda;
+      lambda = l + (1 - c) * _f * sinAlpha *
+        (sigma + c * sinSigma *
+         (cos2SigmaM + c * cosSigma * (-1 + 2 * cos2SigmaM * cos2SigmaM)));
+      converged = std::abs(lambda - lambdaPrev) < 1e-12;
+    }
+
+    if (!converged)
+      return NAN_D;
+
+    const double uSq = cosSqAlpha * (_a * _a - _b * _b) / (_b * _b);
+    const double bigA = 1 + uSq / 16384 *
+      (4096 + uSq * (-768 + uSq * (320 - 175 * uSq)));
+    const double bigB = uSq / 1024 *
+      (256 + uSq * (-128 + uSq * (74 - 47 * uSq)));
+    const double deltaSigma = bigB * sinSigma *
+      (cos2SigmaM + bigB / 4 *
+       (cosSigma * (-1 + 2 * cos2SigmaM * cos2SigmaM) -
+        bigB / 6 * cos2SigmaM * (-3 + 4 * sinSigma * sinSigma) *
+        (-3 + 4 * cos2SigmaM * cos2SigmaM)));
+
+    return _b * bigA * (sigma - deltaSigma);
+  }
+
+  /// \brief Check that a coordinate type is one of the enum values.
+  /// \param[in] _type Coordinate type.
+  /// \return True if valid.
+  bool ValidCoordinateType(const SphericalCoordinates::CoordinateType _type)
+  {
+    return _type == SphericalCoordinates::SPHERICAL ||
+           _type == SphericalCoordinates::ECEF ||
+           _type == SphericalCoordinates::GLOBAL ||
+           _type == SphericalCoordinates::LOCAL;
+  }
+}
+
 //////////////////////////////////////////////////
 SphericalCoordinates::SurfaceType SphericalCoordinates::Convert(
   const std::string &_str)
@@ -302,6 +504,65 @@ double SphericalCoordinates::Distance(const ignition::math::Angle &_latA,
   return d;
 }
 
+//////////////////////////////////////////////////
+void SphericalCoordinates::Distance(const ignition::math::Angle &_latA,
+                                    const ignition::math::Angle &_lonA,
+                                    const double *_latB, const double *_lonB,
+                                    double *_dist, const size_t _n)
+{
+  const double latA = _latA.Radian();
+  const double lonA = _lonA.Radian();
+  const double cosLatA = cos(latA);
+
+  for (size_t i = 0; i < _n; ++i)
+  {
+    const double sinDLat = sin((_latB[i] - latA) / 2);
+    const double sinDLon = sin((_lonB[i] - lonA) / 2);
+    const double a = sinDLat * sinDLat +
+      sinDLon * sinDLon * cosLatA * cos(_latB[i]);
+    _dist[i] = g_EarthRadius * 2 * atan2(sqrt(a), sqrt(1 - a));
+  }
+}
+
+//////////////////////////////////////////////////
+void SphericalCoordinates::Distance(const double *_latA, const double *_lonA,
+                                    const double *_latB, const double *_lonB,
+                                    double *_dist, const size_t _n)
+{
+  for (size_t i = 0; i < _n; ++i)
+  {
+    const double sinDLat = sin((_latB[i] - _latA[i]) / 2);
+    const double sinDLon = sin((_lonB[i] - _lonA[i]) / 2);
+    const double a = sinDLat * sinDLat +
+      sinDLon * sinDLon * cos(_latA[i]) * cos(_latB[i]);
+    _dist[i] = g_EarthRadius * 2 * atan2(sqrt(a), sqrt(1 - a));
+  }
+}
+
+//////////////////////////////////////////////////
+double SphericalCoordinates::DistanceVincenty(
+    const ignition::math::Angle &_latA, const ignition::math::Angle &_lonA,
+    const ignition::math::Angle &_latB, const ignition::math::Angle &_lonB)
+    const
+{
+  return Vincenty(_latA.Radian(), _lonA.Radian(),
+      _latB.Radian(), _lonB.Radian(),
+      this->dataPtr->ellA, this->dataPtr->ellB, this->dataPtr->ellF);
+}
+
+//////////////////////////////////////////////////
+void SphericalCoordinates::DistanceVincenty(
+    const double *_latA, const double *_lonA,
+    const double *_latB, const double *_lonB,
+    double *_dist, const size_t _n) const
+{
+  const double a = this->dataPtr->ellA;
+  const double b = this->dataPtr->ellB;
+  const double f = this->dataPtr->ellF;
+  for (size_t i = 0; i < _n; ++i)
+    _dist[i] = Vincenty(_latA[i], _lonA[i], _latB[i], _lonB[i], a, b, f);
+}
+
 //////////////////////////////////////////////////
 void SphericalCoordinates::UpdateTransformationMatrix()
 {
@@ -351,44 +612,21 @@ ignition::math::Vector3d SphericalCoordinates::PositionTransform(
 {
   ignition::math::Vector3d tmp = _pos;
 
-  // Cache trig results
-  double cosLat = cos(_pos.X());
-  double sinLat = sin(_pos.X());
-  double cosLon = cos(_pos.Y());
-  double sinLon = sin(_pos.Y());
-
-  // Radius of planet curvature (meters)
-  double curvature = 1.0 -
-    this->dataPtr->ellE * this->dataPtr->ellE * sinLat * sinLat;
-  curvature = this->dataPtr->ellA / sqrt(curvature);
-
   // Convert whatever arrives to a more flexible ECEF coordinate
   switch (_in)
   {
-    // East, North, Up (ENU), note no break at end of case
     case LOCAL:
-      {
-        tmp.X(-_pos.X() * this->dataPtr->cosHea + _pos.Y() *
-            this->dataPtr->sinHea);
-        tmp.Y(-_pos.X() * this->dataPtr->sinHea - _pos.Y() *
-            this->dataPtr->cosHea);
-      }
+      tmp = this->dataPtr->origin +
+        this->dataPtr->rotGlobalToECEF * this->dataPtr->LocalToGlobal(_pos);
+      break;
 
     case GLOBAL:
-      {
-        tmp = this->dataPtr->origin + this->dataPtr->rotGlobalToECEF * tmp;
-        break;
-      }
+      tmp = this->dataPtr->origin + this->dataPtr->rotGlobalToECEF * _pos;
+      break;
 
     case SPHERICAL:
-      {
-        tmp.X((_pos.Z() + curvature) * cosLat * cosLon);
-        tmp.Y((_pos.Z() + curvature) * cosLat * sinLon);
-        tmp.Z(((this->dataPtr->ellB * this->dataPtr->ellB)/
-              (this->dataPtr->ellA * this->dataPtr->ellA) *
-              curvature + _pos.Z()) * sinLat);
-        break;
-      }
+      tmp = this->dataPtr->SphericalToECEF(_pos);
+      break;
 
     // Do nothing
     case ECEF:
@@ -404,33 +642,8 @@ ignition::math::Vector3d SphericalCoordinates::PositionTransform(
   switch (_out)
   {
     case SPHERICAL:
-      {
-        // Convert from ECEF to SPHERICAL
-        double p = sqrt(tmp.X() * tmp.X() + tmp.Y() * tmp.Y());
-        double theta = atan((tmp.Z() * this->dataPtr->ellA) /
-            (p * this->dataPtr->ellB));
-
-        // Calculate latitude and longitude
-        double lat = atan(
-            (tmp.Z() + std::pow(this->dataPtr->ellP, 2) * this->dataPtr->ellB *
-             std::pow(sin(theta), 3)) /
-            (p - std::pow(this->dataPtr->ellE, 2) *
-             this->dataPtr->ellA * std::pow(cos(theta), 3)));
-
-        double lon = atan2(tmp.Y(), tmp.X());
-
-        // Recalculate radius of planet curvature at the current latitude.
-        double nCurvature = 1.0 - std::pow(this->dataPtr->ellE, 2) *
-          std::pow(sin(lat), 2);
-        nCurvature = this->dataPtr->ellA / sqrt(nCurvature);
-
-        tmp.X(lat);
-        tmp.Y(lon);
-
-        // Now calculate Z
-        tmp.Z(p/cos(lat) - nCurvature);
-        break;
-      }
+      tmp = this->dataPtr->ECEFToSpherical(tmp);
+      break;
 
     // Convert from ECEF TO GLOBAL
     case GLOBAL:
@@ -439,12 +652,8 @@ ignition::math::Vector3d SphericalCoordinates::PositionTransform(
 
     // Convert from ECEF TO LOCAL
     case LOCAL:
-      tmp = this->dataPtr->rotECEFToGlobal * (tmp - this->dataPtr->origin);
-
-      tmp = ignition::math::Vector3d(
-          tmp.X() * this->dataPtr->cosHea - tmp.Y() * this->dataPtr->sinHea,
-          tmp.X() * this->dataPtr->sinHea + tmp.Y() * this->dataPtr->cosHea,
-          tmp.Z());
+      tmp = this->dataPtr->GlobalToLocal(
+          this->dataPtr->rotECEFToGlobal * (tmp - this->dataPtr->origin));
       break;
 
     // Return ECEF (do nothing)
@@ -459,6 +668,21 @@ ignition::math::Vector3d SphericalCoordinates::PositionTransform(
   return tmp;
 }
 
+/////////////////////////////////////////////////
+void SphericalCoordinates::PositionTransform(
+    const ignition::math::Vector3d *_pos, ignition::math::Vector3d *_result,
+    const size_t _n,
+    const CoordinateType &_in, const CoordinateType &_out) const
+{
+  PositionConverter converter(*this, _in, _out);
+  if (!converter.Valid())
+  {
+    std::cerr << "Invalid coordinate type[" << _in << "] or ["
+      << _out << "]\n";
+  }
+  converter.Convert(_pos, _result, _n);
+}
+
 //////////////////////////////////////////////////
 ignition::math::Vector3d SphericalCoordinates::VelocityTransform(
     const ignition::math::Vector3d &_vel,
@@ -478,10 +702,7 @@ ignition::math::Vector3d SphericalCoordinates::VelocityTransform(
   {
     // ENU (note no break at end of case)
     case LOCAL:
-      tmp.X(-_vel.X() * this->dataPtr->cosHea + _vel.Y() *
-            this->dataPtr->sinHea);
-      tmp.Y(-_vel.X() * this->dataPtr->sinHea - _vel.Y() *
-            this->dataPtr->cosHea);
+      tmp = this->dataPtr->LocalToGlobal(_vel);
     // spherical
     case GLOBAL:
       tmp = this->dataPtr->rotGlobalToECEF * tmp;
@@ -509,11 +730,7 @@ ignition::math::Vector3d SphericalCoordinates::VelocityTransform(
 
     // Convert from ECEF to local
     case LOCAL:
-      tmp = this->dataPtr->rotECEFToGlobal * tmp;
-      tmp = ignition::math::Vector3d(
-          tmp.X() * this->dataPtr->cosHea - tmp.Y() * this->dataPtr->sinHea,
-          tmp.X() * this->dataPtr->sinHea + tmp.Y() * this->dataPtr->cosHea,
-          tmp.Z());
+      tmp = this->dataPtr->GlobalToLocal(this->dataPtr->rotECEFToGlobal * tmp);
       break;
 
     default:
@@ -524,6 +741,61 @@ ignition::math::Vector3d SphericalCoordinates::VelocityTransform(
   return tmp;
 }
 
+//////////////////////////////////////////////////
+void SphericalCoordinates::VelocityTransform(
+    const ignition::math::Vector3d *_vel, ignition::math::Vector3d *_result,
+    const size_t _n,
+    const CoordinateType &_in, const CoordinateType &_out) const
+{
+  // Velocities are not expressed in spherical coordinates, and unknown
+  // types leave the input unchanged, as in the single vector version.
+  if (_in == SPHERICAL || _out == SPHERICAL ||
+      !ValidCoordinateType(_in) || !ValidCoordinateType(_out))
+  {
+    if (!ValidCoordinateType(_in) || !ValidCoordinateType(_out))
+    {
+      std::cerr << "Unknown coordinate type[" << _in << "] or ["
+        << _out << "]\n";
+    }
+    if (_result != _vel)
+      std::copy(_vel, _vel + _n, _result);
+    return;
+  }
+
+  const SphericalCoordinatesPrivate &d = *this->dataPtr;
+
+  // Rotations compose, so a single matrix does the whole conversion.
+  Matrix3d toECEF = Matrix3d::Identity;
+  if (_in == LOCAL)
+  {
+    toECEF = d.rotGlobalToECEF * Matrix3d(
+        -d.cosHea,  d.sinHea, 0,
+        -d.sinHea, -d.cosHea, 0,
+         0,         0,        1);
+  }
+  else if (_in == GLOBAL)
+  {
+    toECEF = d.rotGlobalToECEF;
+  }
+
+  Matrix3d fromECEF = Matrix3d::Identity;
+  if (_out == LOCAL)
+  {
+    fromECEF = Matrix3d(
+        d.cosHea, -d.sinHea, 0,
+        d.sinHea,  d.cosHea, 0,
+        0,         0,        1) * d.rotECEFToGlobal;
+  }
+  else if (_out == GLOBAL)
+  {
+    fromECEF = d.rotECEFToGlobal;
+  }
+
+  const Matrix3d rot = fromECEF * toECEF;
+  for (size_t i = 0; i < _n; ++i)
+    _result[i] = rot * _vel[i];
+}
+
 //////////////////////////////////////////////////
 bool SphericalCoordinates::operator==(const SphericalCoordinates &_sc) const
 {
@@ -555,3 +827,152 @@ SphericalCoordinates &SphericalCoordinates::operator=(
 
   return *this;
 }
+
+//////////////////////////////////////////////////
+SphericalCoordinates::PositionConverter::PositionConverter()
+: in(ECEF), out(ECEF), valid(true),
+  inRot(Matrix3d::Identity), outRot(Matrix3d::Identity),
+  rot(Matrix3d::Identity),
+  ellA(g_EarthWGS84AxisEquatorial), ellB(g_EarthWGS84AxisPolar),
+  ellE(0), ellP(0)
+{
+  this->ellE = sqrt(1.0 - (this->ellB * this->ellB) /
+      (this->ellA * this->ellA));
+  this->ellP = sqrt((this->ellA * this->ellA) /
+      (this->ellB * this->ellB) - 1.0);
+}
+
+//////////////////////////////////////////////////
+SphericalCoordinates::PositionConverter::PositionConverter(
+    const SphericalCoordinates &_sc,
+    const CoordinateType _in, const CoordinateType _out)
+: in(_in), out(_out),
+  valid(ValidCoordinateType(_in) && ValidCoordinateType(_out)),
+  inRot(Matrix3d::Identity), outRot(Matrix3d::Identity),
+  rot(Matrix3d::Identity),
+  ellA(_sc.dataPtr->ellA), ellB(_sc.dataPtr->ellB),
+  ellE(_sc.dataPtr->ellE), ellP(_sc.dataPtr->ellP)
+{
+  const SphericalCoordinatesPrivate &d = *_sc.dataPtr;
+
+  // Same rotation as SphericalCoordinatesPrivate::LocalToGlobal
+  const Matrix3d localToGlobal(
+      -d.cosHea,  d.sinHea, 0,
+      -d.sinHea, -d.cosHea, 0,
+       0,         0,        1);
+
+  // Same rotation as SphericalCoordinatesPrivate::GlobalToLocal
+  const Matrix3d globalToLocal(
+      d.cosHea, -d.sinHea, 0,
+      d.sinHea,  d.cosHea, 0,
+      0,         0,        1);
+
+  // Input frame to ECEF: ecef = inRot * pos + inOffset
+  if (_in == LOCAL)
+  {
+    this->inRot = d.rotGlobalToECEF * localToGlobal;
+    this->inOffset = d.origin;
+  }
+  else if (_in == GLOBAL)
+  {
+    this->inRot = d.rotGlobalToECEF;
+    this->inOffset = d.origin;
+  }
+
+  // ECEF to output frame: result = outRot * ecef + outOffset
+  if (_out == LOCAL)
+  {
+    this->outRot = globalToLocal * d.rotECEFToGlobal;
+    this->outOffset = -(this->outRot * d.origin);
+  }
+  else if (_out == GLOBAL)
+  {
+    this->outRot = d.rotECEFToGlobal;
+    this->outOffset = -(this->outRot * d.origin);
+  }
+
+  // Fused transform, used when neither frame is SPHERICAL. Between the
+  // tangent frames the origin cancels exactly, which also avoids going
+  // through large ECEF values.
+  this->rot = this->outRot * this->inRot;
+  if ((_in == LOCAL || _in == GLOBAL) && (_out == LOCAL || _out == GLOBAL))
+    this->offset = Vector3d::Zero;
+  else
+    this->offset = this->outRot * this->inOffset + this->outOffset;
+}
+
+//////////////////////////////////////////////////
+bool SphericalCoordinates::PositionConverter::Valid() const
+{
+  return this->valid;
+}
+
+//////////////////////////////////////////////////
+SphericalCoordinates::CoordinateType
+SphericalCoordinates::PositionConverter::In() const
+{
+  return this->in;
+}
+
+//////////////////////////////////////////////////
+SphericalCoordinates::CoordinateType
+SphericalCoordinates::PositionConverter::Out() const
+{
+  return this->out;
+}
+
+//////////////////////////////////////////////////
+Vector3d SphericalCoordinates::PositionConverter::Convert(
+    const Vector3d &_pos) const
+{
+  Vector3d result;
+  this->Convert(&_pos, &result, 1);
+  return result;
+}
+
+//////////////////////////////////////////////////
+void SphericalCoordinates::PositionConverter::Convert(
+    const Vector3d *_pos, Vector3d *_result, const size_t _n) const
+{
+  if (!this->valid)
+  {
+    if (_result != _pos)
+      std::copy(_pos, _pos + _n, _result);
+    return;
+  }
+
+  const bool fromSpherical = this->in == SPHERICAL;
+  const bool toSpherical = this->out == SPHERICAL;
+
+  if (!fromSpherical && !toSpherical)
+  {
+    for (size_t i = 0; i < _n; ++i)
+      _result[i] = this->rot * _pos[i] + this->offset;
+  }
+  else if (fromSpherical && toSpherical)
+  {
+    for (size_t i = 0; i < _n; ++i)
+    {
+      _result[i] = ECEFToGeodetic(
+          GeodeticToECEF(_pos[i], this->ellA, this->ellB, this->ellE),
+          this->ellA, this->ellB, this->ellE, this->ellP);
+    }
+  }
+  else if (fromSpherical)
+  {
+    for (size_t i = 0; i < _n; ++i)
+    {
+      _result[i] = this->outRot *
+        GeodeticToECEF(_pos[i], this->ellA, this->ellB, this->ellE) +
+        this->outOffset;
+    }
+  }
+  else
+  {
+    for (size_t i = 0; i < _n; ++i)
+    {
+      _result[i] = ECEFToGeodetic(this->inRot * _pos[i] + this->inOffset,
+          this->ellA, this->ellB, this->ellE, this->ellP);
+    }
+  }
+}
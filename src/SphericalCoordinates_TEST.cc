@@ -16,6 +16,9 @@
 */
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <vector>
+
 #include "ignition/math/SphericalCoordinates.hh"
 
 using namespace ignition;
@@ -383,3 +386,279 @@ TEST(SphericalCoordinatesTest, AssignmentOp)
   math::SphericalCoordinates sc2 = sc1;
   EXPECT_EQ(sc1, sc2);
 }
+
+//////////////////////////////////////////////////
+void ExpectPositionNear(const math::Vector3d &_a, const math::Vector3d &_b,
+    const math::SphericalCoordinates::CoordinateType _type)
+{
+  // Converted positions may differ by rounding on ECEF magnitudes
+  if (_type == math::SphericalCoordinates::SPHERICAL)
+  {
+    EXPECT_NEAR(_a.X(), _b.X(), 1e-12);
+    EXPECT_NEAR(_a.Y(), _b.Y(), 1e-12);
+    EXPECT_NEAR(_a.Z(), _b.Z(), 1e-6);
+  }
+  else
+  {
+    EXPECT_NEAR(_a.X(), _b.X(), 1e-6);
+    EXPECT_NEAR(_a.Y(), _b.Y(), 1e-6);
+    EXPECT_NEAR(_a.Z(), _b.Z(), 1e-6);
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(SphericalCoordinatesTest, BatchTransforms)
+{
+  const std::vector<math::SphericalCoordinates::CoordinateType> types = {
+    math::SphericalCoordinates::SPHERICAL,
+    math::SphericalCoordinates::ECEF,
+    math::SphericalCoordinates::GLOBAL,
+    math::SphericalCoordinates::LOCAL};
+
+  math::SphericalCoordinates sc(math::SphericalCoordinates::EARTH_WGS84,
+      math::Angle(0.3), math::Angle(-1.2), 354.1, math::Angle(0.4));
+
+  // Sample points near the reference, expressed in every frame
+  std::vector<math::Vector3d> local;
+  for (int i = 0; i < 20; ++i)
+    local.push_back(math::Vector3d(150.0 * i - 900, 37.0 * i, 3.0 * i - 20));
+
+  for (auto in : types)
+  {
+    std::vector<math::Vector3d> input(local.size());
+    sc.PositionTransform(local.data(), input.data(), local.size(),
+        math::SphericalCoordinates::LOCAL, in);
+
+    for (auto out : types)
+    {
+      std::vector<math::Vector3d> result(input.size());
+      sc.PositionTransform(input.data(), result.data(), input.size(),
+          in, out);
+
+      std::vector<math::Vector3d> inPlace(input);
+      sc.PositionTransform(inPlace.data(), inPlace.data(), inPlace.size(),
+          in, out);
+
+      for (size_t i = 0; i < input.size(); ++i)
+      {
+        math::Vector3d expected = sc.PositionTransform(input[i], in, out);
+        ExpectPositionNear(result[i], expected, out);
+        EXPECT_EQ(inPlace[i], result[i]);
+      }
+
+      if (in == math::SphericalCoordinates::SPHERICAL ||
+          out == math::SphericalCoordinates::SPHERICAL)
+      {
+        continue;
+      }
+
+      sc.VelocityTransform(input.data(), result.data(), input.size(),
+          in, out);
+      for (size_t i = 0; i < input.size(); ++i)
+      {
+        math::Vector3d expected = sc.VelocityTransform(input[i], in, out);
+        EXPECT_NEAR(result[i].X(), expected.X(), 1e-6 * input[i].Length());
+        EXPECT_NEAR(result[i].Y(), expected.Y(), 1e-6 * input[i].Length());
+        EXPECT_NEAR(result[i].Z(), expected.Z(), 1e-6 * input[i].Length());
+      }
+    }
+  }
+
+  // Invalid types leave the input unchanged
+  std::vector<math::Vector3d> result(local.size());
+  sc.PositionTransform(local.data(), result.data(), local.size(),
+      static_cast<math::SphericalCoordinates::CoordinateType>(5),
+      math::SphericalCoordinates::ECEF);
+  EXPECT_EQ(result, local);
+  sc.VelocityTransform(local.data(), result.data(), local.size(),
+      math::SphericalCoordinates::SPHERICAL,
+      math::SphericalCoordinates::ECEF);
+  EXPECT_EQ(result, local);
+}
+
+//////////////////////////////////////////////////
+TEST(SphericalCoordinatesTest, Poles)
+{
+  math::SphericalCoordinates sc(math::SphericalCoordinates::EARTH_WGS84);
+  const double b = 6356752.314245;
+
+  // Points on and next to the polar axis, where cos(lat) vanishes
+  const math::Vector3d ecef[4] = {
+    math::Vector3d(0, 0, b + 100),
+    math::Vector3d(0, 0, -b - 250),
+    math::Vector3d(1e-4, 0, b + 100),
+    math::Vector3d(0, 0, b)};
+  math::Vector3d spherical[4];
+  sc.PositionTransform(ecef, spherical, 4,
+      math::SphericalCoordinates::ECEF,
+      math::SphericalCoordinates::SPHERICAL);
+
+  const double lat[4] = {IGN_PI_2, -IGN_PI_2, IGN_PI_2, IGN_PI_2};
+  const double alt[4] = {100, 250, 100, 0};
+  for (int i = 0; i < 4; ++i)
+  {
+    EXPECT_NEAR(spherical[i].X(), lat[i], 1e-6);
+    EXPECT_NEAR(spherical[i].Z(), alt[i], 1e-6);
+    EXPECT_EQ(spherical[i], sc.PositionTransform(ecef[i],
+        math::SphericalCoordinates::ECEF,
+        math::SphericalCoordinates::SPHERICAL));
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(SphericalCoordinatesTest, PositionConverter)
+{
+  const std::vector<math::SphericalCoordinates::CoordinateType> types = {
+    math::SphericalCoordinates::SPHERICAL,
+    math::SphericalCoordinates::ECEF,
+    math::SphericalCoordinates::GLOBAL,
+    math::SphericalCoordinates::LOCAL};
+
+  math::SphericalCoordinates::PositionConverter identity;
+  EXPECT_TRUE(identity.Valid());
+  EXPECT_EQ(identity.In(), math::SphericalCoordinates::ECEF);
+  EXPECT_EQ(identity.Out(), math::SphericalCoordinates::ECEF);
+  EXPECT_EQ(identity.Convert(math::Vector3d(1, 2, 3)),
+            math::Vector3d(1, 2, 3));
+
+  math::SphericalCoordinates sc(math::SphericalCoordinates::EARTH_WGS84,
+      math::Angle(-0.7), math::Angle(2.1), -12.5, math::Angle(-1.1));
+
+  // Points in the LOCAL frame, up to a few kilometers away
+  std::vector<math::Vector3d> local;
+  for (int i = 0; i < 10; ++i)
+  {
+    local.push_back(math::Vector3d(
+          500.0 * i - 2000, 120.0 * i * i - 3000, 40.0 * i - 100));
+  }
+
+  for (auto in : types)
+  {
+    for (auto out : types)
+    {
+      math::SphericalCoordinates::PositionConverter converter(sc, in, out);
+      EXPECT_TRUE(converter.Valid());
+      EXPECT_EQ(converter.In(), in);
+      EXPECT_EQ(converter.Out(), out);
+
+      for (const auto &l : local)
+      {
+        math::Vector3d pos = sc.PositionTransform(l,
+            math::SphericalCoordinates::LOCAL, in);
+        ExpectPositionNear(converter.Convert(pos),
+            sc.PositionTransform(pos, in, out), out);
+      }
+    }
+  }
+
+  // Known value: the reference point itself
+  math::SphericalCoordinates::PositionConverter toSpherical(sc,
+      math::SphericalCoordinates::GLOBAL,
+      math::SphericalCoordinates::SPHERICAL);
+  math::Vector3d ref = toSpherical.Convert(math::Vector3d::Zero);
+  EXPECT_NEAR(ref.X(), -0.7, 1e-12);
+  EXPECT_NEAR(ref.Y(), 2.1, 1e-12);
+  EXPECT_NEAR(ref.Z(), -12.5, 1e-6);
+
+  // Geodetic conversion near the poles
+  math::SphericalCoordinates::PositionConverter ecefToSpherical(sc,
+      math::SphericalCoordinates::ECEF,
+      math::SphericalCoordinates::SPHERICAL);
+  math::SphericalCoordinates::PositionConverter sphericalToEcef(sc,
+      math::SphericalCoordinates::SPHERICAL,
+      math::SphericalCoordinates::ECEF);
+  math::Vector3d polar(IGN_PI / 2 - 1e-9, 0.3, 250.0);
+  math::Vector3d back = ecefToSpherical.Convert(
+      sphericalToEcef.Convert(polar));
+  EXPECT_NEAR(back.X(), polar.X(), 1e-12);
+  EXPECT_NEAR(back.Y(), polar.Y(), 1e-6);
+  EXPECT_NEAR(back.Z(), polar.Z(), 1e-3);
+
+  // Invalid types leave the input unchanged
+  math::SphericalCoordinates::PositionConverter invalid(sc,
+      static_cast<math::SphericalCoordinates::CoordinateType>(7),
+      math::SphericalCoordinates::GLOBAL);
+  EXPECT_FALSE(invalid.Valid());
+  EXPECT_EQ(invalid.Convert(math::Vector3d(1, 2, 3)),
+            math::Vector3d(1, 2, 3));
+}
+
+//////////////////////////////////////////////////
+TEST(SphericalCoordinatesTest, DistanceArrays)
+{
+  const std::vector<double> latA = {0.80722, -0.3, 1.2, 0.0};
+  const std::vector<double> lonA = {-2.13366, 2.0, -0.4, 0.0};
+  const std::vector<double> latB = {0.80502, -0.31, -0.9, 0.0};
+  const std::vector<double> lonB = {-2.13369, 2.5, 2.8, 0.0};
+  std::vector<double> dist(latA.size());
+
+  // Pairwise
+  math::SphericalCoordinates::Distance(latA.data(), lonA.data(),
+      latB.data(), lonB.data(), dist.data(), dist.size());
+  for (size_t i = 0; i < dist.size(); ++i)
+  {
+    double expected = math::SphericalCoordinates::Distance(
+        math::Angle(latA[i]), math::Angle(lonA[i]),
+        math::Angle(latB[i]), math::Angle(lonB[i]));
+    EXPECT_NEAR(dist[i], expected, 1e-6);
+  }
+  EXPECT_DOUBLE_EQ(dist[3], 0.0);
+
+  // One to many
+  math::SphericalCoordinates::Distance(math::Angle(latA[0]),
+      math::Angle(lonA[0]), latB.data(), lonB.data(), dist.data(),
+      dist.size());
+  for (size_t i = 0; i < dist.size(); ++i)
+  {
+    double expected = math::SphericalCoordinates::Distance(
+        math::Angle(latA[0]), math::Angle(lonA[0]),
+        math::Angle(latB[i]), math::Angle(lonB[i]));
+    EXPECT_NEAR(dist[i], expected, 1e-6);
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(SphericalCoordinatesTest, DistanceVincenty)
+{
+  math::SphericalCoordinates sc;
+
+  // Flinders Peak to Buninyong, the example from Vincenty's paper
+  math::Angle latA, lonA, latB, lonB;
+  latA.Degree(-(37 + 57 / 60.0 + 3.72030 / 3600.0));
+  lonA.Degree(144 + 25 / 60.0 + 29.52440 / 3600.0);
+  latB.Degree(-(37 + 39 / 60.0 + 10.15610 / 3600.0));
+  lonB.Degree(143 + 55 / 60.0 + 35.38390 / 3600.0);
+  EXPECT_NEAR(sc.DistanceVincenty(latA, lonA, latB, lonB), 54972.271, 1e-3);
+
+  // Along the equator the distance is the arc of the semi-major axis
+  EXPECT_NEAR(sc.DistanceVincenty(math::Angle(0), math::Angle(0),
+        math::Angle(0), math::Angle(1.0)), 6378137.0, 1e-4);
+
+  // Coincident points
+  EXPECT_DOUBLE_EQ(sc.DistanceVincenty(latA, lonA, latA, lonA), 0.0);
+
+  // Nearly antipodal points do not converge
+  math::Angle latC, lonC;
+  latC.Degree(0.5);
+  lonC.Degree(179.7);
+  EXPECT_TRUE(std::isnan(sc.DistanceVincenty(math::Angle(0), math::Angle(0),
+          latC, lonC)));
+
+  // Arrays, and agreement with the spherical distance within 0.5%
+  const std::vector<double> lat1 = {latA.Radian(), 0.5, -1.0};
+  const std::vector<double> lon1 = {lonA.Radian(), 0.1, 2.0};
+  const std::vector<double> lat2 = {latB.Radian(), 0.52, 0.3};
+  const std::vector<double> lon2 = {lonB.Radian(), 0.15, -2.9};
+  std::vector<double> dist(lat1.size());
+  sc.DistanceVincenty(lat1.data(), lon1.data(), lat2.data(), lon2.data(),
+      dist.data(), dist.size());
+  for (size_t i = 0; i < dist.size(); ++i)
+  {
+    EXPECT_DOUBLE_EQ(dist[i], sc.DistanceVincenty(math::Angle(lat1[i]),
+          math::Angle(lon1[i]), math::Angle(lat2[i]), math::Angle(lon2[i])));
+    double sphere = math::SphericalCoordinates::Distance(
+        math::Angle(lat1[i]), math::Angle(lon1[i]),
+        math::Angle(lat2[i]), math::Angle(lon2[i]));
+    EXPECT_NEAR(dist[i], sphere, 0.005 * sphere);
+  }
+}
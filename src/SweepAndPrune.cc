@@ -0,0 +1,340 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "ignition/math/SweepAndPrune.hh"
+
+using namespace ignition;
+using namespace math;
+
+namespace
+{
+  /// \brief The insertion sort gives up for a full sort after this many
+  /// moves per box.
+  const size_t kMovesPerBox = 8;
+
+  /// \brief In SWEEP_AUTO mode, the sweep axis changes when the variance
+  /// along another axis is larger by this factor, so that it does not
+  /// flip between axes of similar variance.
+  const double kAxisHysteresis = 1.5;
+
+  /// \brief Bounds of a box, as plain values.
+  struct Bounds
+  {
+    /// \brief Minimum corner.
+    double min[3];
+
+    /// \brief Maximum corner.
+    double max[3];
+  };
+
+  /// \brief A box in the sorted list.
+  struct Entry
+  {
+    /// \brief Minimum along the sweep axis.
+    double min;
+
+    /// \brief Maximum along the sweep axis.
+    double max;
+
+    /// \brief Index of the box.
+    size_t index;
+  };
+
+  /// \brief Get the bounds of a box. Boxes with a NaN coordinate get
+  /// inverted infinite bounds, which overlap nothing and sort last.
+  /// \param[in] _box Box.
+  /// \param[out] _bounds Bounds of _box.
+  void boundsOf(const Box &_box, Bounds &_bounds)
+  {
+    const Vector3d &min = _box.Min();
+    const Vector3d &max = _box.Max();
+    _bounds.min[0] = min.X();
+    _bounds.min[1] = min.Y();
+    _bounds.min[2] = min.Z();
+    _bounds.max[0] = max.X();
+    _bounds.max[1] = max.Y();
+    _bounds.max[2] = max.Z();
+    for (int i = 0; i < 3; ++i)
+    {
+      if (std::isnan(_bounds.min[i]) || std::isnan(_bounds.max[i]))
+      {
+        for (int j = 0; j < 3; ++j)
+        {
+          _bounds.min[j] = std::numeric_limits<double>::infinity();
+          _bounds.max[j] = -std::numeric_limits<double>::infinity();
+        }
+        return;
+      }
+    }
+  }
+
+  /// \brief Compare entries by minimum.
+  /// \param[in] _a First entry.
+  /// \param[in] _b Second entry.
+  /// \return True if _a sorts before _b.
+  bool lessMin(const Entry &_a, const Entry &_b)
+  {
+    return _a.min < _b.min;
+  }
+}
+
+/// \internal
+/// \brief Private data for the SweepAndPrune class
+class ignition::math::SweepAndPrunePrivate
+{
+  /// \brief Choose the sweep axis of an update.
+  /// \return Axis index.
+  public: int ChooseAxis() const;
+
+  /// \brief Restore the order of the entries with an insertion sort, or
+  /// a full sort if the insertion sort moves too many entries.
+  public: void Sort();
+
+  /// \brief Sweep axis.
+  public: SweepAndPrune::SweepAxis axis = SweepAndPrune::SWEEP_AUTO;
+
+  /// \brief Axis used by the last update.
+  public: int currentAxis = 0;
+
+  /// \brief Bounds of the boxes, in input order.
+  public: std::vector<Bounds> bounds;
+
+  /// \brief Boxes sorted by minimum along the sweep axis.
+  public: std::vector<Entry> entries;
+
+  /// \brief Bounds of the boxes, in sorted order, with the axes rotated
+  /// so that the sweep axis comes first.
+  public: std::vector<Bounds> sorted;
+};
+
+/////////////////////////////////////////////////
+int SweepAndPrunePrivate::ChooseAxis() const
+{
+  if (this->axis != SweepAndPrune::SWEEP_AUTO)
+    return this->axis;
+
+  double sum[3] = {0, 0, 0};
+  double sumSquares[3] = {0, 0, 0};
+  size_t count = 0;
+  for (const Bounds &b : this->bounds)
+  {
+    double center[3];
+    bool finite = true;
+    for (int i = 0; i < 3; ++i)
+    {
+      center[i] = 0.5 * (b.min[i] + b.max[i]);
+      finite = finite && std::isfinite(center[i]);
+    }
+    if (!finite)
+      continue;
+
+    for (int i = 0; i < 3; ++i)
+    {
+      sum[i] += center[i];
+      sumSquares[i] += center[i] * center[i];
+    }
+    ++count;
+  }
+  if (count == 0)
+    return this->currentAxis;
+
+  // Variances times the count
+  double variance[3];
+  for (int i = 0; i < 3; ++i)
+    variance[i] = sumSquares[i] - sum[i] * sum[i] / count;
+
+  int best = this->currentAxis;
+  for (int i = 0; i < 3; ++i)
+  {
+    if (variance[i] > kAxisHysteresis * variance[best])
+      best = i;
+  }
+  return best;
+}
+
+/////////////////////////////////////////////////
+void SweepAndPrunePrivate::Sort()
+{
+  std::vector<Entry> &list = this->entries;
+  const size_t budget = kMovesPerBox * list.size();
+  size_t moves = 0;
+  for (size_t i = 1; i < list.size(); ++i)
+  {
+    const Entry entry = list[i];
+    size_t j = i;
+    while (j > 0 && list[j - 1].min > entry.min)
+    {
+      list[j] = list[j - 1];
+      --j;
+    }
+    list[j] = entry;
+
+    moves += i - j;
+    if (moves > budget)
+    {
+      std::sort(list.begin(), list.end(), lessMin);
+      return;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+SweepAndPrune::SweepAndPrune()
+: dataPtr(new SweepAndPrunePrivate)
+{
+}
+
+/////////////////////////////////////////////////
+SweepAndPrune::SweepAndPrune(const SweepAxis _axis)
+: dataPtr(new SweepAndPrunePrivate)
+{
+  this->SetAxis(_axis);
+}
+
+/////////////////////////////////////////////////
+SweepAndPrune::SweepAndPrune(const SweepAndPrune &_sap)
+: dataPtr(new SweepAndPrunePrivate(*_sap.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+SweepAndPrune::~SweepAndPrune()
+{
+}
+
+/////////////////////////////////////////////////
+SweepAndPrune &SweepAndPrune::operator=(const SweepAndPrune &_sap)
+{
+  if (this == &_sap)
+    return *this;
+
+  *this->dataPtr = *_sap.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+void SweepAndPrune::SetAxis(const SweepAxis _axis)
+{
+  this->dataPtr->axis = _axis;
+}
+
+/////////////////////////////////////////////////
+SweepAndPrune::SweepAxis SweepAndPrune::Axis() const
+{
+  return this->dataPtr->axis;
+}
+
+/////////////////////////////////////////////////
+SweepAndPrune::SweepAxis SweepAndPrune::CurrentAxis() const
+{
+  return static_cast<SweepAxis>(this->dataPtr->currentAxis);
+}
+
+/////////////////////////////////////////////////
+size_t SweepAndPrune::Update(const Box *_boxes, const size_t _count,
+    std::vector<std::pair<size_t, size_t>> &_pairs)
+{
+  _pairs.clear();
+  SweepAndPrunePrivate &d = *this->dataPtr;
+
+  d.bounds.resize(_count);
+  for (size_t i = 0; i < _count; ++i)
+    boundsOf(_boxes[i], d.bounds[i]);
+
+  // Keep the previous order unless the boxes or the axis changed
+  const int axis = d.ChooseAxis();
+  const bool rebuild = _count != d.entries.size() || axis != d.currentAxis;
+  if (rebuild)
+  {
+    d.entries.resize(_count);
+    for (size_t i = 0; i < _count; ++i)
+      d.entries[i].index = i;
+  }
+  d.currentAxis = axis;
+  for (Entry &entry : d.entries)
+  {
+    entry.min = d.bounds[entry.index].min[axis];
+    entry.max = d.bounds[entry.index].max[axis];
+  }
+  if (rebuild)
+    std::sort(d.entries.begin(), d.entries.end(), lessMin);
+  else
+    d.Sort();
+
+  // Copy the bounds in sorted order, so that the sweep reads memory
+  // sequentially, with the sweep axis first
+  d.sorted.resize(_count);
+  for (size_t i = 0; i < _count; ++i)
+  {
+    const Bounds &b = d.bounds[d.entries[i].index];
+    for (int k = 0; k < 3; ++k)
+    {
+      d.sorted[i].min[k] = b.min[(axis + k) % 3];
+      d.sorted[i].max[k] = b.max[(axis + k) % 3];
+    }
+  }
+
+  // Test each box against the following boxes which start before its
+  // end along the sweep axis
+  const Bounds *sorted = d.sorted.data();
+  for (size_t i = 0; i < _count; ++i)
+  {
+    const Bounds &a = sorted[i];
+    for (size_t j = i + 1; j < _count && sorted[j].min[0] <= a.max[0]; ++j)
+    {
+      // Each comparison alone is unpredictable, so they are combined
+      // without branches and only the rare overlaps branch
+      const Bounds &b = sorted[j];
+      const bool overlap = (a.max[1] >= b.min[1]) & (a.min[1] <= b.max[1]) &
+                           (a.max[2] >= b.min[2]) & (a.min[2] <= b.max[2]);
+      if (!overlap)
+        continue;
+
+      const size_t first = d.entries[i].index;
+      const size_t second = d.entries[j].index;
+      _pairs.push_back(first < second ? std::make_pair(first, second) :
+                                        std::make_pair(second, first));
+    }
+  }
+  return _pairs.size();
+}
+
+/////////////////////////////////////////////////
+size_t SweepAndPrune::Update(const std::vector<Box> &_boxes,
+    std::vector<std::pair<size_t, size_t>> &_pairs)
+{
+  return this->Update(_boxes.data(), _boxes.size(), _pairs);
+}
+
+/////////////////////////////////////////////////
+void SweepAndPrune::Clear()
+{
+  this->dataPtr->bounds.clear();
+  this->dataPtr->entries.clear();
+  this->dataPtr->sorted.clear();
+}
+
+/////////////////////////////////////////////////
+size_t SweepAndPrune::Size() const
+{
+  return this->dataPtr->entries.size();
+}
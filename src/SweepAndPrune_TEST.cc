@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "ignition/math/Rand.hh"
+#include "ignition/math/SweepAndPrune.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+/// \brief Find the overlapping pairs of boxes by testing all pairs.
+/// \param[in] _boxes Boxes.
+/// \return Sorted pairs of indices.
+std::vector<std::pair<size_t, size_t>> AllPairs(
+    const std::vector<math::Box> &_boxes)
+{
+  std::vector<std::pair<size_t, size_t>> pairs;
+  for (size_t i = 0; i < _boxes.size(); ++i)
+  {
+    for (size_t j = i + 1; j < _boxes.size(); ++j)
+    {
+      if (_boxes[i].Intersects(_boxes[j]))
+        pairs.push_back(std::make_pair(i, j));
+    }
+  }
+  return pairs;
+}
+
+/////////////////////////////////////////////////
+TEST(SweepAndPruneTest, Construct)
+{
+  math::SweepAndPrune sap;
+  EXPECT_EQ(math::SweepAndPrune::SWEEP_AUTO, sap.Axis());
+  EXPECT_EQ(0u, sap.Size());
+
+  math::SweepAndPrune sapY(math::SweepAndPrune::SWEEP_Y);
+  EXPECT_EQ(math::SweepAndPrune::SWEEP_Y, sapY.Axis());
+  sapY.SetAxis(math::SweepAndPrune::SWEEP_Z);
+  EXPECT_EQ(math::SweepAndPrune::SWEEP_Z, sapY.Axis());
+
+  std::vector<std::pair<size_t, size_t>> pairs(3);
+  EXPECT_EQ(0u, sap.Update(std::vector<math::Box>(), pairs));
+  EXPECT_TRUE(pairs.empty());
+
+  math::SweepAndPrune copy(sapY);
+  EXPECT_EQ(math::SweepAndPrune::SWEEP_Z, copy.Axis());
+  copy = sap;
+  EXPECT_EQ(math::SweepAndPrune::SWEEP_AUTO, copy.Axis());
+}
+
+/////////////////////////////////////////////////
+TEST(SweepAndPruneTest, Pairs)
+{
+  std::vector<math::Box> boxes;
+  boxes.push_back(math::Box(0, 0, 0, 1, 1, 1));
+  boxes.push_back(math::Box(2, 0, 0, 3, 1, 1));
+  boxes.push_back(math::Box(1, 1, 1, 2, 2, 2));
+  boxes.push_back(math::Box(0.5, 5, 0, 2.5, 6, 1));
+  boxes.push_back(math::Box(0, 0, 0, 1, math::NAN_D, 1));
+  boxes.push_back(math::Box(-math::INF_D, 5.5, -math::INF_D,
+                            math::INF_D, 5.5, math::INF_D));
+
+  math::SweepAndPrune sap(math::SweepAndPrune::SWEEP_X);
+  std::vector<std::pair<size_t, size_t>> pairs;
+  EXPECT_EQ(3u, sap.Update(boxes, pairs));
+  EXPECT_EQ(6u, sap.Size());
+  EXPECT_EQ(math::SweepAndPrune::SWEEP_X, sap.CurrentAxis());
+  std::sort(pairs.begin(), pairs.end());
+  EXPECT_EQ(std::make_pair(size_t(0), size_t(2)), pairs[0]);
+  EXPECT_EQ(std::make_pair(size_t(1), size_t(2)), pairs[1]);
+  EXPECT_EQ(std::make_pair(size_t(3), size_t(5)), pairs[2]);
+
+  // Move box 1 away, and box 3 across the others along x
+  boxes[1] = math::Box(2, 2.5, 0, 3, 3, 1);
+  boxes[3] = math::Box(-3, 0.5, 0.5, -0.5, 6, 1);
+  EXPECT_EQ(2u, sap.Update(boxes, pairs));
+  std::sort(pairs.begin(), pairs.end());
+  EXPECT_EQ(std::make_pair(size_t(0), size_t(2)), pairs[0]);
+  EXPECT_EQ(std::make_pair(size_t(3), size_t(5)), pairs[1]);
+
+  // Fewer boxes
+  boxes.resize(3);
+  EXPECT_EQ(1u, sap.Update(boxes, pairs));
+  EXPECT_EQ(3u, sap.Size());
+
+  sap.Clear();
+  EXPECT_EQ(0u, sap.Size());
+  EXPECT_EQ(1u, sap.Update(boxes.data(), boxes.size(), pairs));
+}
+
+/////////////////////////////////////////////////
+TEST(SweepAndPruneTest, Auto)
+{
+  // Boxes spread along y
+  std::vector<math::Box> boxes;
+  for (int i = 0; i < 100; ++i)
+  {
+    const math::Vector3d min(math::Rand::DblUniform(0, 5),
+        math::Rand::DblUniform(0, 100), math::Rand::DblUniform(0, 5));
+    boxes.push_back(math::Box(min, min + math::Vector3d(1, 1, 1)));
+  }
+
+  math::SweepAndPrune sap;
+  std::vector<std::pair<size_t, size_t>> pairs;
+  sap.Update(boxes, pairs);
+  EXPECT_EQ(math::SweepAndPrune::SWEEP_Y, sap.CurrentAxis());
+  std::sort(pairs.begin(), pairs.end());
+  EXPECT_EQ(AllPairs(boxes), pairs);
+
+  // Spread along z, the axis changes
+  for (math::Box &box : boxes)
+  {
+    const math::Vector3d min = box.Min();
+    box = math::Box(math::Vector3d(min.X(), min.Z(), min.Y() * 2),
+        math::Vector3d(min.X() + 1, min.Z() + 1, min.Y() * 2 + 1));
+  }
+  sap.Update(boxes, pairs);
+  EXPECT_EQ(math::SweepAndPrune::SWEEP_Z, sap.CurrentAxis());
+  std::sort(pairs.begin(), pairs.end());
+  EXPECT_EQ(AllPairs(boxes), pairs);
+}
+
+/////////////////////////////////////////////////
+TEST(SweepAndPruneTest, Moving)
+{
+  const int count = 400;
+  std::vector<math::Vector3d> positions(count);
+  std::vector<math::Vector3d> velocities(count);
+  std::vector<math::Vector3d> sizes(count);
+  for (int i = 0; i < count; ++i)
+  {
+    positions[i].Set(math::Rand::DblUniform(0, 20),
+        math::Rand::DblUniform(0, 20), math::Rand::DblUniform(0, 20));
+    velocities[i].Set(math::Rand::DblUniform(-0.2, 0.2),
+        math::Rand::DblUniform(-0.2, 0.2), math::Rand::DblUniform(-0.2, 0.2));
+    sizes[i].Set(math::Rand::DblUniform(0, 2), math::Rand::DblUniform(0, 2),
+        math::Rand::DblUniform(0, 2));
+  }
+
+  std::vector<math::SweepAndPrune> saps = {
+    math::SweepAndPrune(math::SweepAndPrune::SWEEP_X),
+    math::SweepAndPrune(math::SweepAndPrune::SWEEP_Y),
+    math::SweepAndPrune(math::SweepAndPrune::SWEEP_Z),
+    math::SweepAndPrune(math::SweepAndPrune::SWEEP_AUTO)};
+  std::vector<math::Box> boxes(count);
+  std::vector<std::pair<size_t, size_t>> pairs;
+  for (int step = 0; step < 20; ++step)
+  {
+    // Small motions, then a large jump which needs a full sort
+    const double scale = step == 10 ? 50 : 1;
+    for (int i = 0; i < count; ++i)
+    {
+      positions[i] += velocities[i] * scale;
+      boxes[i] = math::Box(positions[i], positions[i] + sizes[i]);
+    }
+
+    const std::vector<std::pair<size_t, size_t>> expected = AllPairs(boxes);
+    for (math::SweepAndPrune &sap : saps)
+    {
+      EXPECT_EQ(expected.size(), sap.Update(boxes, pairs));
+      for (const std::pair<size_t, size_t> &pair : pairs)
+        EXPECT_LT(pair.first, pair.second);
+      std::sort(pairs.begin(), pairs.end());
+      EXPECT_EQ(expected, pairs);
+    }
+  }
+}
@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+
+
 #include "ignition/math/Vector3.hh"
 #include "ignition/math/Helpers.hh"
 
@@ -413,3 +416,30 @@ TEST(Vector3dTest, NoException)
   EXPECT_DOUBLE_EQ(v[3], 3.0);
 }
 
+/////////////////////////////////////////////////
+TEST(Vector3dTest, Parse)
+{
+  const char *text = "1.5 -2, 3e2 4 5";
+  const char *end = text + std::strlen(text);
+  const char *pos = text;
+  math::Vector3d v;
+  EXPECT_TRUE(math::Vector3d::Parse(pos, end, v));
+  EXPECT_EQ(math::Vector3d(1.5, -2, 300), v);
+  EXPECT_EQ(text + 11, pos);
+
+  // Only two values left
+  EXPECT_FALSE(math::Vector3d::Parse(pos, end, v));
+  EXPECT_EQ(end, pos);
+  EXPECT_EQ(math::Vector3d(1.5, -2, 300), v);
+
+  text = "1 two 3";
+  pos = text;
+  EXPECT_FALSE(math::Vector3d::Parse(pos, text + 7, v));
+  EXPECT_EQ(text + 2, pos);
+
+  text = "1 2 3";
+  pos = text;
+  math::Vector3i vi;
+  EXPECT_TRUE(math::Vector3i::Parse(pos, text + 5, vi));
+  EXPECT_EQ(math::Vector3i(1, 2, 3), vi);
+}
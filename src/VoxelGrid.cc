@@ -0,0 +1,354 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "ignition/math/VoxelGrid.hh"
+
+using namespace ignition;
+using namespace math;
+
+namespace
+{
+  /// \brief Largest voxel coordinate. Coordinates are clamped to
+  /// [-kMaxVoxel, kMaxVoxel], far away points share the border voxels.
+  const int32_t kMaxVoxel = 1 << 30;
+
+  /// \brief Voxel index of an empty slot of the hash table.
+  const uint32_t kEmptySlot = std::numeric_limits<uint32_t>::max();
+
+  /// \brief Slot of the hash table. Slots are small so that the table
+  /// stays in cache, and hold bits of the hash so that probing rarely
+  /// reads the voxels.
+  struct Slot
+  {
+    /// \brief High bits of the hash of the voxel.
+    uint32_t tag;
+
+    /// \brief Index of the voxel, kEmptySlot for an empty slot.
+    uint32_t index;
+  };
+
+  /// \brief An occupied voxel.
+  struct Voxel
+  {
+    /// \brief Voxel coordinates.
+    int32_t key[3];
+
+    /// \brief Number of points.
+    uint32_t count;
+
+    /// \brief Sum of the coordinates of the points, or coordinates of
+    /// the first point.
+    double sum[3];
+  };
+
+  /// \brief Hash the coordinates of a voxel.
+  /// \param[in] _key Voxel coordinates.
+  /// \return Hash value.
+  uint64_t hashVoxel(const int32_t (&_key)[3])
+  {
+    // Pack the coordinates, then mix all bits with the MurmurHash3
+    // finalizer. Neighbor voxels differ in few low bits, and a weaker mix
+    // makes them collide in the table.
+    uint64_t h = static_cast<uint64_t>(static_cast<uint32_t>(_key[0]));
+    h = (h << 21) ^ static_cast<uint64_t>(static_cast<uint32_t>(_key[1]));
+    h = (h << 21) ^ static_cast<uint64_t>(static_cast<uint32_t>(_key[2]));
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    return h ^ (h >> 33);
+  }
+
+  /// \brief Get the voxel coordinate of a point coordinate.
+  /// \param[in] _value Point coordinate.
+  /// \param[in] _inverseSize Inverse of the voxel size.
+  /// \return Voxel coordinate.
+  int32_t voxelCoord(const double _value, const double _inverseSize)
+  {
+    const double voxel = std::floor(_value * _inverseSize);
+    if (voxel < -kMaxVoxel)
+      return -kMaxVoxel;
+    if (voxel > kMaxVoxel)
+      return kMaxVoxel;
+    return static_cast<int32_t>(voxel);
+  }
+
+  /// \brief Double the size of a hash table of voxels.
+  /// \param[in,out] _table Table to grow.
+  /// \param[in] _voxels Voxels in the table.
+  /// \return Mask of the new table size.
+  size_t growTable(std::vector<Slot> &_table,
+                   const std::vector<Voxel> &_voxels)
+  {
+    const Slot empty = {0, kEmptySlot};
+    _table.assign(2 * _table.size(), empty);
+    const size_t mask = _table.size() - 1;
+    for (size_t v = 0; v < _voxels.size(); ++v)
+    {
+      const uint64_t hash = hashVoxel(_voxels[v].key);
+      size_t i = hash & mask;
+      while (_table[i].index != kEmptySlot)
+        i = (i + 1) & mask;
+      _table[i].tag = static_cast<uint32_t>(hash >> 32);
+      _table[i].index = static_cast<uint32_t>(v);
+    }
+    return mask;
+  }
+
+  /// \brief Downsample points.
+  /// \param[in] _points Array of points.
+  /// \param[in] _count Number of points.
+  /// \param[in] _inverseSize Inverse of the voxel size.
+  /// \param[in] _centroid True to average the points of each voxel, false
+  /// to keep the first one.
+  /// \param[out] _output One point per occupied voxel.
+  /// \param[out] _voxels Index in _output of the voxel of each point, may
+  /// be nullptr.
+  /// \return Number of output points.
+  template<typename T>
+  size_t filterPoints(const Vector3<T> *_points, const size_t _count,
+                      const double _inverseSize, const bool _centroid,
+                      std::vector<Vector3<T>> &_output,
+                      std::vector<size_t> *_voxels)
+  {
+    // Open addressing table of voxels. It grows with the number of voxels
+    // rather than of points, so that it stays in cache when many points
+    // share voxels.
+    size_t mask = 1023;
+    const Slot empty = {0, kEmptySlot};
+    std::vector<Slot> table(mask + 1, empty);
+
+    // Occupied voxels, in order of their first point
+    std::vector<Voxel> voxels;
+
+    // Voxel of the previous point. Scans of a sensor are ordered, and
+    // consecutive points often share a voxel.
+    uint32_t last = kEmptySlot;
+
+    if (_voxels)
+      _voxels->resize(_count);
+
+    for (size_t i = 0; i < _count; ++i)
+    {
+      const Vector3<T> &p = _points[i];
+      if (!std::isfinite(p.X()) || !std::isfinite(p.Y()) ||
+          !std::isfinite(p.Z()))
+      {
+        if (_voxels)
+          (*_voxels)[i] = std::numeric_limits<size_t>::max();
+        continue;
+      }
+
+      const int32_t key[3] = {voxelCoord(p.X(), _inverseSize),
+                              voxelCoord(p.Y(), _inverseSize),
+                              voxelCoord(p.Z(), _inverseSize)};
+
+      if (last != kEmptySlot && voxels[last].key[0] == key[0] &&
+          voxels[last].key[1] == key[1] && voxels[last].key[2] == key[2])
+      {
+        Voxel &voxel = voxels[last];
+        if (_centroid)
+        {
+          voxel.sum[0] += p.X();
+          voxel.sum[1] += p.Y();
+          voxel.sum[2] += p.Z();
+          ++voxel.count;
+        }
+        if (_voxels)
+          (*_voxels)[i] = last;
+        continue;
+      }
+
+      // Find the voxel, adding it when missing
+      const uint64_t hash = hashVoxel(key);
+      const uint32_t tag = static_cast<uint32_t>(hash >> 32);
+      size_t s = hash & mask;
+      uint32_t v;
+      while (true)
+      {
+        Slot &slot = table[s];
+        v = slot.index;
+        if (v == kEmptySlot)
+        {
+          v = static_cast<uint32_t>(voxels.size());
+          slot.tag = tag;
+          slot.index = v;
+          const Voxel voxel = {{key[0], key[1], key[2]}, 1,
+                               {p.X(), p.Y(), p.Z()}};
+          voxels.push_back(voxel);
+          if (2 * voxels.size() > table.size())
+            mask = growTable(table, voxels);
+          break;
+        }
+        Voxel &voxel = voxels[v];
+        if (slot.tag == tag && voxel.key[0] == key[0] &&
+            voxel.key[1] == key[1] && voxel.key[2] == key[2])
+        {
+          if (_centroid)
+          {
+            voxel.sum[0] += p.X();
+            voxel.sum[1] += p.Y();
+            voxel.sum[2] += p.Z();
+            ++voxel.count;
+          }
+          break;
+        }
+        s = (s + 1) & mask;
+      }
+
+      last = v;
+      if (_voxels)
+        (*_voxels)[i] = v;
+    }
+
+    _output.resize(voxels.size());
+    for (size_t v = 0; v < voxels.size(); ++v)
+    {
+      const Voxel &voxel = voxels[v];
+      const double n = static_cast<double>(voxel.count);
+      _output[v].Set(static_cast<T>(voxel.sum[0] / n),
+                     static_cast<T>(voxel.sum[1] / n),
+                     static_cast<T>(voxel.sum[2] / n));
+    }
+
+    // Non finite points refer past the end of the output
+    if (_voxels)
+    {
+      for (size_t &v : *_voxels)
+      {
+        if (v == std::numeric_limits<size_t>::max())
+          v = _output.size();
+      }
+    }
+    return _output.size();
+  }
+}
+
+/// \internal
+/// \brief Private data for the VoxelGrid class
+class ignition::math::VoxelGridPrivate
+{
+  /// \brief Length of the side of a voxel.
+  public: double voxelSize = 1.0;
+
+  /// \brief Inverse of the voxel size.
+  public: double inverseVoxelSize = 1.0;
+
+  /// \brief How the points of a voxel are reduced.
+  public: VoxelGrid::ReductionType reduction = VoxelGrid::CENTROID;
+};
+
+/////////////////////////////////////////////////
+VoxelGrid::VoxelGrid()
+: dataPtr(new VoxelGridPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+VoxelGrid::VoxelGrid(const double _voxelSize,
+    const ReductionType _reduction)
+: dataPtr(new VoxelGridPrivate)
+{
+  this->SetVoxelSize(_voxelSize);
+  this->SetReduction(_reduction);
+}
+
+/////////////////////////////////////////////////
+VoxelGrid::VoxelGrid(const VoxelGrid &_grid)
+: dataPtr(new VoxelGridPrivate(*_grid.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+VoxelGrid::~VoxelGrid()
+{
+}
+
+/////////////////////////////////////////////////
+VoxelGrid &VoxelGrid::operator=(const VoxelGrid &_grid)
+{
+  if (this == &_grid)
+    return *this;
+
+  *this->dataPtr = *_grid.dataPtr;
+  return *this;
+}
+
+/////////////////////////////////////////////////
+bool VoxelGrid::SetVoxelSize(const double _voxelSize)
+{
+  if (!(_voxelSize > 0) || !std::isfinite(_voxelSize))
+    return false;
+
+  this->dataPtr->voxelSize = _voxelSize;
+  this->dataPtr->inverseVoxelSize = 1.0 / _voxelSize;
+  return true;
+}
+
+/////////////////////////////////////////////////
+double VoxelGrid::VoxelSize() const
+{
+  return this->dataPtr->voxelSize;
+}
+
+/////////////////////////////////////////////////
+void VoxelGrid::SetReduction(const ReductionType _reduction)
+{
+  this->dataPtr->reduction = _reduction;
+}
+
+/////////////////////////////////////////////////
+VoxelGrid::ReductionType VoxelGrid::Reduction() const
+{
+  return this->dataPtr->reduction;
+}
+
+/////////////////////////////////////////////////
+size_t VoxelGrid::Filter(const Vector3d *_points, const size_t _count,
+    std::vector<Vector3d> &_output) const
+{
+  return filterPoints(_points, _count, this->dataPtr->inverseVoxelSize,
+      this->dataPtr->reduction == CENTROID, _output, nullptr);
+}
+
+/////////////////////////////////////////////////
+size_t VoxelGrid::Filter(const Vector3d *_points, const size_t _count,
+    std::vector<Vector3d> &_output, std::vector<size_t> &_voxels) const
+{
+  return filterPoints(_points, _count, this->dataPtr->inverseVoxelSize,
+      this->dataPtr->reduction == CENTROID, _output, &_voxels);
+}
+
+/////////////////////////////////////////////////
+size_t VoxelGrid::Filter(const Vector3f *_points, const size_t _count,
+    std::vector<Vector3f> &_output) const
+{
+  return filterPoints(_points, _count, this->dataPtr->inverseVoxelSize,
+      this->dataPtr->reduction == CENTROID, _output, nullptr);
+}
+
+/////////////////////////////////////////////////
+size_t VoxelGrid::Filter(const Vector3f *_points, const size_t _count,
+    std::vector<Vector3f> &_output, std::vector<size_t> &_voxels) const
+{
+  return filterPoints(_points, _count, this->dataPtr->inverseVoxelSize,
+      this->dataPtr->reduction == CENTROID, _output, &_voxels);
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "ignition/math/Rand.hh"
+#include "ignition/math/VoxelGrid.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+TEST(VoxelGridTest, Construct)
+{
+  math::VoxelGrid grid;
+  EXPECT_DOUBLE_EQ(1.0, grid.VoxelSize());
+  EXPECT_EQ(math::VoxelGrid::CENTROID, grid.Reduction());
+
+  EXPECT_FALSE(grid.SetVoxelSize(0.0));
+  EXPECT_FALSE(grid.SetVoxelSize(-2.0));
+  EXPECT_FALSE(grid.SetVoxelSize(math::NAN_D));
+  EXPECT_FALSE(grid.SetVoxelSize(math::INF_D));
+  EXPECT_DOUBLE_EQ(1.0, grid.VoxelSize());
+  EXPECT_TRUE(grid.SetVoxelSize(0.2));
+  EXPECT_DOUBLE_EQ(0.2, grid.VoxelSize());
+  grid.SetReduction(math::VoxelGrid::FIRST_POINT);
+  EXPECT_EQ(math::VoxelGrid::FIRST_POINT, grid.Reduction());
+
+  math::VoxelGrid grid2(0.5, math::VoxelGrid::FIRST_POINT);
+  EXPECT_DOUBLE_EQ(0.5, grid2.VoxelSize());
+  EXPECT_EQ(math::VoxelGrid::FIRST_POINT, grid2.Reduction());
+
+  math::VoxelGrid invalid(-1.0);
+  EXPECT_DOUBLE_EQ(1.0, invalid.VoxelSize());
+
+  math::VoxelGrid copy(grid);
+  EXPECT_DOUBLE_EQ(0.2, copy.VoxelSize());
+  copy = grid2;
+  EXPECT_DOUBLE_EQ(0.5, copy.VoxelSize());
+
+  // Empty input
+  std::vector<math::Vector3d> output = {math::Vector3d::One};
+  std::vector<size_t> voxels = {3};
+  EXPECT_EQ(0u, grid.Filter(nullptr, 0, output, voxels));
+  EXPECT_TRUE(output.empty());
+  EXPECT_TRUE(voxels.empty());
+}
+
+/////////////////////////////////////////////////
+TEST(VoxelGridTest, Filter)
+{
+  const std::vector<math::Vector3d> points = {
+    math::Vector3d(0.1, 0.1, 0.1),
+    math::Vector3d(-0.1, 0.1, 0.1),
+    math::Vector3d(0.3, 0.5, 0.7),
+    math::Vector3d(math::NAN_D, 0, 0),
+    math::Vector3d(-0.9, 0.5, 0.5),
+    math::Vector3d(1.5, 0, 0),
+    math::Vector3d(0.9, 0.9, 0.9)};
+
+  // Voxels (0,0,0), (-1,0,0) and (1,0,0), in order of first point
+  math::VoxelGrid grid(1.0);
+  std::vector<math::Vector3d> output;
+  std::vector<size_t> voxels;
+  EXPECT_EQ(3u, grid.Filter(points.data(), points.size(), output, voxels));
+  ASSERT_EQ(3u, output.size());
+  EXPECT_EQ(math::Vector3d(1.3 / 3, 1.5 / 3, 1.7 / 3), output[0]);
+  EXPECT_EQ(math::Vector3d(-0.5, 0.3, 0.3), output[1]);
+  EXPECT_EQ(math::Vector3d(1.5, 0, 0), output[2]);
+
+  const std::vector<size_t> expected = {0, 1, 0, 3, 1, 2, 0};
+  EXPECT_EQ(expected, voxels);
+
+  grid.SetReduction(math::VoxelGrid::FIRST_POINT);
+  EXPECT_EQ(3u, grid.Filter(points.data(), points.size(), output));
+  ASSERT_EQ(3u, output.size());
+  EXPECT_EQ(points[0], output[0]);
+  EXPECT_EQ(points[1], output[1]);
+  EXPECT_EQ(points[5], output[2]);
+
+  // With smaller voxels every finite point is in its own voxel
+  grid.SetVoxelSize(0.25);
+  EXPECT_EQ(6u, grid.Filter(points.data(), points.size(), output, voxels));
+}
+
+/////////////////////////////////////////////////
+TEST(VoxelGridTest, Cloud)
+{
+  // Dense random cloud, every point is within half of a voxel diagonal
+  // of its voxel centroid
+  std::vector<math::Vector3d> points;
+  for (int i = 0; i < 100000; ++i)
+  {
+    points.push_back(math::Vector3d(math::Rand::DblUniform(-5, 5),
+          math::Rand::DblUniform(-5, 5), math::Rand::DblUniform(0, 1.9)));
+  }
+
+  const double size = 0.5;
+  math::VoxelGrid grid(size);
+  std::vector<math::Vector3d> output;
+  std::vector<size_t> voxels;
+  const size_t count = grid.Filter(points.data(), points.size(), output,
+      voxels);
+
+  // 20 x 20 x 4 voxels, all occupied
+  EXPECT_EQ(1600u, count);
+  std::vector<size_t> perVoxel(count, 0);
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    ASSERT_LT(voxels[i], count);
+    ++perVoxel[voxels[i]];
+    EXPECT_LE(points[i].Distance(output[voxels[i]]), size * std::sqrt(3.0));
+    EXPECT_DOUBLE_EQ(std::floor(points[i].X() / size),
+                     std::floor(output[voxels[i]].X() / size));
+  }
+  for (size_t n : perVoxel)
+    EXPECT_GT(n, 0u);
+
+  // Float points give the same voxels
+  std::vector<math::Vector3f> pointsf;
+  for (const math::Vector3d &p : points)
+    pointsf.push_back(math::Vector3f(p.X(), p.Y(), p.Z()));
+  std::vector<math::Vector3f> outputf;
+  std::vector<size_t> voxelsf;
+  grid.SetVoxelSize(2.0);
+  EXPECT_EQ(36u, grid.Filter(pointsf.data(), pointsf.size(), outputf,
+        voxelsf));
+  EXPECT_EQ(outputf.size(), grid.Filter(pointsf.data(), pointsf.size(),
+        outputf));
+  EXPECT_EQ(pointsf.size(), voxelsf.size());
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ignition/math/BoxTree.hh"
+#include "ignition/math/Rand.hh"
+
+#include "report.hh"
+
+using namespace ignition;
+
+// Number of boxes
+static const int kBoxes = 5000;
+
+// Number of simulation steps
+static const int kSteps = 20;
+
+/////////////////////////////////////////////////
+TEST(BoxTree, MovingBoxes)
+{
+  // Unit boxes in a 60 m cube, moving up to 5 cm per step
+  std::vector<math::Vector3d> positions(kBoxes);
+  std::vector<math::Vector3d> velocities(kBoxes);
+  for (int i = 0; i < kBoxes; ++i)
+  {
+    positions[i].Set(math::Rand::DblUniform(0, 60),
+        math::Rand::DblUniform(0, 60), math::Rand::DblUniform(0, 60));
+    velocities[i].Set(math::Rand::DblUniform(-0.05, 0.05),
+        math::Rand::DblUniform(-0.05, 0.05),
+        math::Rand::DblUniform(-0.05, 0.05));
+  }
+  const std::vector<math::Vector3d> initial = positions;
+  const math::Vector3d half(0.5, 0.5, 0.5);
+
+  math::BoxTree tree(0.1);
+  std::vector<size_t> ids(kBoxes);
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kBoxes; ++i)
+    ids[i] = tree.Add(math::Box(positions[i] - half, positions[i] + half));
+  ReportStep("BoxTree build", start, 1);
+
+  std::vector<std::pair<size_t, size_t>> pairs;
+  size_t treePairs = 0;
+  int changes = 0;
+  start = std::chrono::steady_clock::now();
+  for (int step = 0; step < kSteps; ++step)
+  {
+    for (int i = 0; i < kBoxes; ++i)
+    {
+      positions[i] += velocities[i];
+      if (tree.Move(ids[i], math::Box(positions[i] - half,
+              positions[i] + half), velocities[i]))
+      {
+        ++changes;
+      }
+    }
+    treePairs += tree.Pairs(pairs);
+  }
+  ReportStep("BoxTree move and pairs per step", start, kSteps);
+  std::cout << "Tree changes per step: " << changes / kSteps << std::endl;
+
+  // Same steps, testing all pairs
+  positions = initial;
+  std::vector<math::Box> boxes(kBoxes);
+  size_t brutePairs = 0;
+  start = std::chrono::steady_clock::now();
+  for (int step = 0; step < kSteps; ++step)
+  {
+    for (int i = 0; i < kBoxes; ++i)
+    {
+      positions[i] += velocities[i];
+      boxes[i] = math::Box(positions[i] - half, positions[i] + half);
+    }
+    for (int i = 0; i < kBoxes; ++i)
+    {
+      for (int j = i + 1; j < kBoxes; ++j)
+      {
+        if (boxes[i].Intersects(boxes[j]))
+          ++brutePairs;
+      }
+    }
+  }
+  ReportStep("all pairs Box::Intersects per step", start, kSteps);
+
+  EXPECT_EQ(treePairs, brutePairs);
+  std::cout << "Pairs per step: " << treePairs / kSteps << std::endl;
+}
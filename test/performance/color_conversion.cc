@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "ignition/math/Color.hh"
+#include "ignition/math/ColorMap.hh"
+
+#include "report.hh"
+
+using namespace ignition;
+
+// Number of pixels in the test image, 1920x1080
+static const size_t kPixels = 1920 * 1080;
+
+// Number of times each conversion is run
+static const int kRepeats = 10;
+
+/////////////////////////////////////////////////
+/// \brief Time a conversion and print its throughput.
+/// \param[in] _name Name of the conversion.
+/// \param[in] _func Function that converts the whole image once.
+/// \return Throughput in megapixels per second.
+double Benchmark(const std::string &_name, const std::function<void()> &_func)
+{
+  // Warm up caches
+  _func();
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kRepeats; ++i)
+    _func();
+  return Report(_name, start, kPixels * kRepeats, "pixels");
+}
+
+/////////////////////////////////////////////////
+TEST(ColorConversion, Throughput)
+{
+  std::vector<float> rgba(4 * kPixels);
+  for (size_t i = 0; i < kPixels; ++i)
+  {
+    rgba[4*i] = (i % 256) / 255.0f;
+    rgba[4*i+1] = ((i / 256) % 256) / 255.0f;
+    rgba[4*i+2] = ((i * 7) % 256) / 255.0f;
+    rgba[4*i+3] = 1.0f;
+  }
+  std::vector<unsigned int> packed(kPixels);
+  std::vector<unsigned int> swizzled(kPixels);
+  std::vector<float> three(3 * kPixels);
+  std::vector<float> out(4 * kPixels);
+
+  EXPECT_GT(Benchmark("FloatToPacked", [&]()
+  {
+    math::Color::FloatToPacked(rgba.data(), packed.data(), kPixels);
+  }), 0.0);
+
+  EXPECT_GT(Benchmark("PackedToFloat", [&]()
+  {
+    math::Color::PackedToFloat(packed.data(), out.data(), kPixels,
+        math::Color::PIXEL_RGBA);
+  }), 0.0);
+
+  EXPECT_GT(Benchmark("ConvertPacked RGBA->BGRA", [&]()
+  {
+    math::Color::ConvertPacked(packed.data(), swizzled.data(), kPixels,
+        math::Color::PIXEL_RGBA, math::Color::PIXEL_BGRA);
+  }), 0.0);
+
+  EXPECT_GT(Benchmark("RGBAToHSV", [&]()
+  {
+    math::Color::RGBAToHSV(rgba.data(), three.data(), kPixels);
+  }), 0.0);
+
+  EXPECT_GT(Benchmark("HSVToRGBA", [&]()
+  {
+    math::Color::HSVToRGBA(three.data(), out.data(), kPixels);
+  }), 0.0);
+
+  EXPECT_GT(Benchmark("RGBAToYUV", [&]()
+  {
+    math::Color::RGBAToYUV(rgba.data(), three.data(), kPixels);
+  }), 0.0);
+
+  EXPECT_GT(Benchmark("YUVToRGBA", [&]()
+  {
+    math::Color::YUVToRGBA(three.data(), out.data(), kPixels);
+  }), 0.0);
+
+  // Per pixel conversion through Color, for comparison
+  EXPECT_GT(Benchmark("Color::AsRGBA", [&]()
+  {
+    for (size_t i = 0; i < kPixels; ++i)
+    {
+      packed[i] = math::Color(rgba[4*i], rgba[4*i+1], rgba[4*i+2],
+          rgba[4*i+3]).AsRGBA();
+    }
+  }), 0.0);
+
+  EXPECT_GT(Benchmark("Color::HSV", [&]()
+  {
+    for (size_t i = 0; i < kPixels; ++i)
+    {
+      math::Vector3f hsv = math::Color(rgba[4*i], rgba[4*i+1], rgba[4*i+2],
+          rgba[4*i+3]).HSV();
+      three[3*i] = hsv.X();
+      three[3*i+1] = hsv.Y();
+      three[3*i+2] = hsv.Z();
+    }
+  }), 0.0);
+
+  // Colorize a depth image with a lookup table and per pixel
+  std::vector<float> depth(kPixels);
+  for (size_t i = 0; i < kPixels; ++i)
+    depth[i] = (i % 1920) * (10.0f / 1920);
+  math::ColorMap map(math::ColorMap::HSV, 4096);
+  map.SetRange(0, 10);
+
+  EXPECT_GT(Benchmark("ColorMap::Apply", [&]()
+  {
+    map.Apply(depth.data(), packed.data(), kPixels);
+  }), 0.0);
+
+  EXPECT_GT(Benchmark("Color::SetFromHSV", [&]()
+  {
+    math::Color clr;
+    for (size_t i = 0; i < kPixels; ++i)
+    {
+      clr.SetFromHSV(depth[i] * 30, 1, 1);
+      packed[i] = clr.AsRGBA();
+    }
+  }), 0.0);
+}
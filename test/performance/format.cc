@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ignition/math/Format.hh"
+#include "ignition/math/Pose3.hh"
+
+#include "report.hh"
+
+using namespace ignition;
+
+// Number of poses written
+static const int kPoses = 200000;
+
+/////////////////////////////////////////////////
+TEST(Format, PoseLog)
+{
+  std::vector<math::Pose3d> poses;
+  poses.reserve(kPoses);
+  for (int i = 0; i < kPoses; ++i)
+  {
+    poses.push_back(math::Pose3d(i * 0.001, -i * 0.37, i * 1e-5,
+          0.1, -0.2, i * 1e-6));
+  }
+
+  char line[256];
+  size_t bytes = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (const auto &pose : poses)
+    bytes += math::format(line, sizeof(line), pose);
+  Report("format shortest", start, kPoses, "poses");
+  EXPECT_GT(bytes, 0u);
+
+  bytes = 0;
+  start = std::chrono::steady_clock::now();
+  for (const auto &pose : poses)
+    bytes += math::format(line, sizeof(line), pose, 6);
+  Report("format 6 decimals", start, kPoses, "poses");
+  EXPECT_GT(bytes, 0u);
+
+  bytes = 0;
+  start = std::chrono::steady_clock::now();
+  for (const auto &pose : poses)
+  {
+    const math::Vector3d rpy = pose.Rot().Euler();
+    bytes += std::snprintf(line, sizeof(line), "%.6f %.6f %.6f %.6f %.6f %.6f",
+        pose.Pos().X(), pose.Pos().Y(), pose.Pos().Z(),
+        rpy.X(), rpy.Y(), rpy.Z());
+  }
+  Report("snprintf %.6f", start, kPoses, "poses");
+  EXPECT_GT(bytes, 0u);
+
+  start = std::chrono::steady_clock::now();
+  std::ostringstream stream;
+  for (const auto &pose : poses)
+    stream << pose << "\n";
+  Report("operator<<", start, kPoses, "poses");
+  EXPECT_GT(stream.str().size(), 0u);
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ignition/math/KdTree.hh"
+#include "ignition/math/Kmeans.hh"
+#include "ignition/math/Rand.hh"
+
+#include "report.hh"
+
+using namespace ignition;
+
+// Number of points in the cloud
+static const int kPoints = 200000;
+
+// Number of queries
+static const int kQueries = 100000;
+
+/////////////////////////////////////////////////
+TEST(KdTree, Cloud)
+{
+  // Points on a noisy surface, as from a range sensor
+  std::vector<math::Vector3d> points(kPoints);
+  for (math::Vector3d &p : points)
+  {
+    const double x = math::Rand::DblUniform(-20, 20);
+    const double y = math::Rand::DblUniform(-20, 20);
+    p.Set(x, y, 0.1 * x * y / 20 + math::Rand::DblUniform(0, 0.05));
+  }
+  std::vector<math::Vector3d> queries(kQueries);
+  for (int i = 0; i < kQueries; ++i)
+    queries[i] = points[i] + math::Vector3d(0.01, -0.02, 0.03);
+
+  auto start = std::chrono::steady_clock::now();
+  math::KdTreed tree(points);
+  Report("Build points", start, kPoints, "points");
+
+  start = std::chrono::steady_clock::now();
+  size_t sum = 0;
+  for (const math::Vector3d &q : queries)
+    sum += tree.Nearest(q);
+  Report("Nearest", start, kQueries, "queries");
+  EXPECT_GT(sum, 0u);
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kQueries / 1000; ++i)
+  {
+    double best = math::INF_D;
+    for (const math::Vector3d &p : points)
+      best = std::min(best, p.Distance(queries[i]));
+    EXPECT_LT(best, 0.1);
+  }
+  Report("brute force Nearest", start, kQueries / 1000, "queries");
+
+  std::vector<size_t> indices;
+  std::vector<double> distances;
+  start = std::chrono::steady_clock::now();
+  tree.Nearest(queries.data(), kQueries, 10, indices, distances);
+  Report("batch Nearest 10", start, kQueries, "queries");
+
+  start = std::chrono::steady_clock::now();
+  tree.Nearest(queries.data(), kQueries, 10, indices, distances, 1.0);
+  Report("batch Nearest 10, epsilon 1", start, kQueries, "queries");
+
+  start = std::chrono::steady_clock::now();
+  for (const math::Vector3d &q : queries)
+    tree.Radius(q, 0.5, indices);
+  Report("Radius 0.5", start, kQueries, "queries");
+}
+
+/////////////////////////////////////////////////
+TEST(KdTree, Kmeans)
+{
+  std::vector<math::Vector3d> obs(kPoints / 4);
+  for (math::Vector3d &p : obs)
+  {
+    p.Set(math::Rand::DblUniform(-20, 20), math::Rand::DblUniform(-20, 20),
+          math::Rand::DblUniform(-20, 20));
+  }
+
+  math::Kmeans kmeans(obs);
+  std::vector<math::Vector3d> centroids;
+  std::vector<unsigned int> labels;
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(kmeans.Cluster(256, centroids, labels));
+  std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start;
+  std::cout << "Kmeans 256 clusters: " << elapsed.count() << " s"
+            << std::endl;
+}
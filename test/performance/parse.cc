@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <locale>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ignition/math/Helpers.hh"
+#include "ignition/math/Pose3.hh"
+
+#include "report.hh"
+
+using namespace ignition;
+
+// Number of poses in the test log
+static const int kPoses = 200000;
+
+/////////////////////////////////////////////////
+TEST(Parse, PoseLog)
+{
+  // CSV pose log, one pose per line
+  std::string log;
+  char line[256];
+  for (int i = 0; i < kPoses; ++i)
+  {
+    std::snprintf(line, sizeof(line), "%.9g,%.9g,%.9g,%.6g,%.6g,%.6g\n",
+        i * 0.001, -i * 0.37, i * 1e-5, 0.1, -0.2, i * 1e-6);
+    log += line;
+  }
+  const char *end = log.data() + log.size();
+
+  std::vector<math::Pose3d> poses(kPoses);
+  std::vector<double> values(6 * kPoses);
+
+  // Range parsers
+  auto start = std::chrono::steady_clock::now();
+  const char *pos = log.data();
+  int count = 0;
+  while (count < kPoses && math::Pose3d::Parse(pos, end, poses[count]))
+    ++count;
+  Report("Pose3d::Parse", start, log.size(), "bytes");
+  EXPECT_EQ(kPoses, count);
+  // Only the trailing new line is left
+  EXPECT_EQ(end - 1, pos);
+
+  start = std::chrono::steady_clock::now();
+  pos = log.data();
+  EXPECT_EQ(values.size(),
+      math::parseFloats(pos, end, values.data(), values.size()));
+  Report("parseFloats", start, log.size(), "bytes");
+
+  // One std::string per token with parseFloat
+  start = std::chrono::steady_clock::now();
+  std::vector<double> tokens;
+  tokens.reserve(6 * kPoses);
+  std::string token;
+  for (char c : log)
+  {
+    if (c == ',' || c == '\n')
+    {
+      tokens.push_back(math::parseFloat(token));
+      token.clear();
+    }
+    else
+    {
+      token += c;
+    }
+  }
+  Report("parseFloat(std::string)", start, log.size(), "bytes");
+  EXPECT_EQ(values.size(), tokens.size());
+
+  // Stream extraction
+  start = std::chrono::steady_clock::now();
+  std::string spaced(log);
+  for (char &c : spaced)
+    c = c == ',' ? ' ' : c;
+  std::istringstream stream(spaced);
+  stream.imbue(std::locale::classic());
+  math::Pose3d pose;
+  count = 0;
+  while (count < kPoses && stream >> pose)
+    ++count;
+  Report("operator>>", start, log.size(), "bytes");
+  EXPECT_EQ(kPoses, count);
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "ignition/math/PoseTrajectory.hh"
+#include "ignition/math/Rand.hh"
+
+#include "report.hh"
+
+using namespace ignition;
+
+// Number of samples in the trajectory
+static const int kSamples = 100000;
+
+// Number of queries
+static const int kQueries = 1000000;
+
+/////////////////////////////////////////////////
+TEST(PoseTrajectory, Lookup)
+{
+  math::PoseTrajectory trajectory(kSamples);
+  for (int i = 0; i < 2 * kSamples; ++i)
+  {
+    trajectory.Add(i * 0.01,
+        math::Pose3d(i * 0.1, -i * 0.2, 1.0, 0.0, 0.1, i * 1e-3));
+  }
+  const double startTime = trajectory.StartTime();
+  const double duration = trajectory.EndTime() - startTime;
+
+  // Sorted queries, as when replaying a log at a higher rate
+  std::vector<double> sorted(kQueries);
+  for (int i = 0; i < kQueries; ++i)
+    sorted[i] = startTime + duration * i / kQueries;
+
+  // Random queries
+  std::vector<double> random(kQueries);
+  for (double &t : random)
+    t = math::Rand::DblUniform(startTime, trajectory.EndTime());
+
+  std::vector<math::Pose3d> poses(kQueries);
+
+  // Linear search with manual interpolation
+  auto start = std::chrono::steady_clock::now();
+  int index = 0;
+  for (int i = 0; i < kQueries / 100; ++i)
+  {
+    const double t = random[i];
+    index = 0;
+    while (trajectory.Time(index + 1) < t)
+      ++index;
+    const double t0 = trajectory.Time(index);
+    const double s = (t - t0) / (trajectory.Time(index + 1) - t0);
+    const math::Pose3d p0 = trajectory.Pose(index);
+    const math::Pose3d p1 = trajectory.Pose(index + 1);
+    poses[i].Set(p0.Pos() + (p1.Pos() - p0.Pos()) * s,
+        math::Quaterniond::Slerp(s, p0.Rot(), p1.Rot(), true));
+  }
+  Report("linear search", start, kQueries / 100, "queries");
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kQueries; ++i)
+    EXPECT_TRUE(trajectory.Interpolate(random[i], poses[i]));
+  Report("Interpolate random", start, kQueries, "queries");
+
+  start = std::chrono::steady_clock::now();
+  EXPECT_EQ(static_cast<size_t>(kQueries), trajectory.Interpolate(
+        random.data(), kQueries, poses.data()));
+  Report("batch Interpolate random", start, kQueries, "queries");
+
+  start = std::chrono::steady_clock::now();
+  EXPECT_EQ(static_cast<size_t>(kQueries), trajectory.Interpolate(
+        sorted.data(), kQueries, poses.data()));
+  Report("batch Interpolate sorted", start, kQueries, "queries");
+
+  start = std::chrono::steady_clock::now();
+  EXPECT_EQ(static_cast<size_t>(kQueries), trajectory.Interpolate(
+        sorted.data(), kQueries, poses.data(),
+        math::PoseTrajectory::SPLINE));
+  Report("batch Interpolate sorted spline", start, kQueries, "queries");
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_TEST_PERFORMANCE_REPORT_HH_
+#define IGNITION_MATH_TEST_PERFORMANCE_REPORT_HH_
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+/////////////////////////////////////////////////
+/// \brief Get the time elapsed since a time point.
+/// \param[in] _start Time point.
+/// \return Elapsed time in seconds.
+inline double SecondsSince(const std::chrono::steady_clock::time_point &_start)
+{
+  const std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - _start;
+  return elapsed.count();
+}
+
+/////////////////////////////////////////////////
+/// \brief Print the number of operations per second, in millions.
+/// \param[in] _name Name of the operation.
+/// \param[in] _seconds Time taken by the operations.
+/// \param[in] _count Number of operations.
+/// \param[in] _unit Name of an operation, such as "queries".
+/// \return Millions of operations per second.
+inline double Report(const std::string &_name, const double _seconds,
+                     const double _count, const std::string &_unit)
+{
+  const double rate = _count * 1e-6 / _seconds;
+  std::cout << _name << ": " << rate << " M " << _unit << "/s" << std::endl;
+  return rate;
+}
+
+/////////////////////////////////////////////////
+/// \brief Print the number of operations per second, in millions.
+/// \param[in] _name Name of the operation.
+/// \param[in] _start Time when the operations started.
+/// \param[in] _count Number of operations.
+/// \param[in] _unit Name of an operation, such as "queries".
+/// \return Millions of operations per second.
+inline double Report(const std::string &_name,
+                     const std::chrono::steady_clock::time_point &_start,
+                     const double _count, const std::string &_unit)
+{
+  return Report(_name, SecondsSince(_start), _count, _unit);
+}
+
+/////////////////////////////////////////////////
+/// \brief Print the time taken by a step, in milliseconds.
+/// \param[in] _name Name of the step.
+/// \param[in] _seconds Time taken by all the steps.
+/// \param[in] _steps Number of steps.
+inline void ReportStep(const std::string &_name, const double _seconds,
+                       const int _steps)
+{
+  std::cout << _name << ": " << _seconds * 1e3 / _steps << " ms"
+            << std::endl;
+}
+
+/////////////////////////////////////////////////
+/// \brief Print the time taken by a step, in milliseconds.
+/// \param[in] _name Name of the step.
+/// \param[in] _start Time when the steps started.
+/// \param[in] _steps Number of steps.
+inline void ReportStep(const std::string &_name,
+                       const std::chrono::steady_clock::time_point &_start,
+                       const int _steps)
+{
+  ReportStep(_name, SecondsSince(_start), _steps);
+}
+
+#endif
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ignition/math/KdTree.hh"
+#include "ignition/math/Rand.hh"
+#include "ignition/math/SpaceFillingCurve.hh"
+
+#include "report.hh"
+
+using namespace ignition;
+
+// Number of points
+static const int kPoints = 1000000;
+
+/////////////////////////////////////////////////
+TEST(SpaceFillingCurve, Sort)
+{
+  const math::Box domain(0, 0, 0, 100, 100, 100);
+  std::vector<math::Vector3d> points(kPoints);
+  for (math::Vector3d &p : points)
+  {
+    p.Set(math::Rand::DblUniform(0, 100), math::Rand::DblUniform(0, 100),
+          math::Rand::DblUniform(0, 100));
+  }
+
+  std::vector<uint64_t> codes(kPoints);
+  auto start = std::chrono::steady_clock::now();
+  math::mortonCodes(points.data(), kPoints, domain, codes.data());
+  Report("Morton codes", start, kPoints, "points");
+
+  start = std::chrono::steady_clock::now();
+  math::hilbertCodes(points.data(), kPoints, domain, codes.data());
+  Report("Hilbert codes", start, kPoints, "points");
+
+  std::vector<size_t> order;
+  start = std::chrono::steady_clock::now();
+  math::sortCodes(codes.data(), kPoints, order);
+  Report("sortCodes", start, kPoints, "points");
+
+  std::vector<size_t> stdOrder(kPoints);
+  for (int i = 0; i < kPoints; ++i)
+    stdOrder[i] = i;
+  start = std::chrono::steady_clock::now();
+  std::stable_sort(stdOrder.begin(), stdOrder.end(),
+      [&codes](const size_t _a, const size_t _b)
+      {
+        return codes[_a] < codes[_b];
+      });
+  Report("std::stable_sort", start, kPoints, "points");
+  EXPECT_EQ(stdOrder, order);
+
+  // Nearest neighbor queries in random order and in curve order
+  std::vector<math::Vector3d> sorted(kPoints);
+  for (int i = 0; i < kPoints; ++i)
+    sorted[i] = points[order[i]];
+  const math::KdTreed tree(points);
+  size_t sum = 0;
+  start = std::chrono::steady_clock::now();
+  for (const math::Vector3d &p : points)
+    sum += tree.Nearest(p);
+  Report("KdTree queries in random order", start, kPoints, "queries");
+
+  size_t sortedSum = 0;
+  start = std::chrono::steady_clock::now();
+  for (const math::Vector3d &p : sorted)
+    sortedSum += tree.Nearest(p);
+  Report("KdTree queries in Hilbert order", start, kPoints, "queries");
+  EXPECT_EQ(sum, sortedSum);
+}
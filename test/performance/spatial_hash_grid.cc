@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "ignition/math/Rand.hh"
+#include "ignition/math/SpatialHashGrid.hh"
+
+#include "report.hh"
+
+using namespace ignition;
+
+// Number of particles
+static const int kParticles = 100000;
+
+// Number of queries
+static const int kQueries = 100000;
+
+/////////////////////////////////////////////////
+TEST(SpatialHashGrid, Particles)
+{
+  // Particles in a 46 m cube, about one per cubic meter
+  std::vector<math::Vector3d> points(kParticles);
+  for (math::Vector3d &p : points)
+  {
+    p.Set(math::Rand::DblUniform(0, 46), math::Rand::DblUniform(0, 46),
+          math::Rand::DblUniform(0, 46));
+  }
+
+  math::SpatialHashGrid grid(1.0);
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < 10; ++i)
+    grid.Build(points);
+  Report("Build points", start, 10 * kParticles, "points");
+
+  std::vector<size_t> indices;
+  size_t found = 0;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kQueries; ++i)
+    found += grid.Radius(points[i % kParticles], 1.0, indices);
+  Report("Radius queries", start, kQueries, "queries");
+
+  start = std::chrono::steady_clock::now();
+  size_t bruteFound = 0;
+  for (int i = 0; i < kQueries / 100; ++i)
+  {
+    const math::Vector3d &center = points[i % kParticles];
+    for (const math::Vector3d &p : points)
+    {
+      if (p.Distance(center) <= 1.0)
+        ++bruteFound;
+    }
+  }
+  Report("brute force radius queries", start, kQueries / 100, "queries");
+  EXPECT_GT(found, bruteFound);
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kQueries; ++i)
+    EXPECT_EQ(8u, grid.Nearest(points[i % kParticles], 8, indices));
+  Report("Nearest 8 queries", start, kQueries, "queries");
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ignition/math/BoxTree.hh"
+#include "ignition/math/Rand.hh"
+#include "ignition/math/SweepAndPrune.hh"
+
+#include "report.hh"
+
+using namespace ignition;
+
+// Number of boxes
+static const int kBoxes = 5000;
+
+// Number of simulation steps
+static const int kSteps = 20;
+
+/////////////////////////////////////////////////
+/// \brief Run the steps of a simulation of moving boxes.
+/// \param[in] _name Name of the broad phase.
+/// \param[in] _update Function which finds the pairs of the boxes of a
+/// step.
+/// \param[in] _jump True to move the boxes to random positions at each
+/// step, false for small motions.
+/// \return Total number of pairs.
+template<typename Update>
+size_t Simulate(const std::string &_name, Update _update, const bool _jump)
+{
+  // Unit boxes in a 60 m cube, moving up to 5 cm per step
+  math::Rand::Seed(1);
+  std::vector<math::Vector3d> positions(kBoxes);
+  std::vector<math::Vector3d> velocities(kBoxes);
+  for (int i = 0; i < kBoxes; ++i)
+  {
+    positions[i].Set(math::Rand::DblUniform(0, 60),
+        math::Rand::DblUniform(0, 60), math::Rand::DblUniform(0, 60));
+    velocities[i].Set(math::Rand::DblUniform(-0.05, 0.05),
+        math::Rand::DblUniform(-0.05, 0.05),
+        math::Rand::DblUniform(-0.05, 0.05));
+  }
+  const math::Vector3d half(0.5, 0.5, 0.5);
+
+  std::vector<math::Box> boxes(kBoxes);
+  size_t pairs = 0;
+  std::chrono::duration<double> elapsed(0);
+  for (int step = 0; step < kSteps; ++step)
+  {
+    for (int i = 0; i < kBoxes; ++i)
+    {
+      if (_jump)
+      {
+        positions[i].Set(math::Rand::DblUniform(0, 60),
+            math::Rand::DblUniform(0, 60), math::Rand::DblUniform(0, 60));
+      }
+      else
+      {
+        positions[i] += velocities[i];
+      }
+      boxes[i] = math::Box(positions[i] - half, positions[i] + half);
+    }
+
+    // Only time the broad phase
+    const auto start = std::chrono::steady_clock::now();
+    pairs += _update(boxes);
+    elapsed += std::chrono::steady_clock::now() - start;
+  }
+  ReportStep(_name + " per step", elapsed.count(), kSteps);
+  return pairs;
+}
+
+/////////////////////////////////////////////////
+TEST(SweepAndPrune, MovingBoxes)
+{
+  std::vector<std::pair<size_t, size_t>> pairs;
+  for (const bool jump : {false, true})
+  {
+    std::cout << (jump ? "Random positions" : "Small motions") << std::endl;
+
+    math::SweepAndPrune sap(math::SweepAndPrune::SWEEP_X);
+    const size_t sapPairs = Simulate("SweepAndPrune",
+        [&](const std::vector<math::Box> &_boxes)
+        {
+          return sap.Update(_boxes, pairs);
+        }, jump);
+
+    math::SweepAndPrune autoSap;
+    EXPECT_EQ(sapPairs, Simulate("SweepAndPrune SWEEP_AUTO",
+        [&](const std::vector<math::Box> &_boxes)
+        {
+          return autoSap.Update(_boxes, pairs);
+        }, jump));
+
+    // Sorting from scratch at each step
+    math::SweepAndPrune fullSort(math::SweepAndPrune::SWEEP_X);
+    EXPECT_EQ(sapPairs, Simulate("SweepAndPrune full sort",
+        [&](const std::vector<math::Box> &_boxes)
+        {
+          fullSort.Clear();
+          return fullSort.Update(_boxes, pairs);
+        }, jump));
+
+    math::BoxTree tree;
+    std::vector<size_t> ids;
+    EXPECT_EQ(sapPairs, Simulate("BoxTree",
+        [&](const std::vector<math::Box> &_boxes)
+        {
+          if (ids.empty())
+          {
+            for (const math::Box &box : _boxes)
+              ids.push_back(tree.Add(box));
+          }
+          for (size_t i = 0; i < _boxes.size(); ++i)
+            tree.Move(ids[i], _boxes[i]);
+          return tree.Pairs(pairs);
+        }, jump));
+  }
+}
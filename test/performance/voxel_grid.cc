@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ignition/math/Rand.hh"
+#include "ignition/math/VoxelGrid.hh"
+
+#include "report.hh"
+
+using namespace ignition;
+
+// Number of points in the cloud
+static const int kPoints = 1000000;
+
+/////////////////////////////////////////////////
+TEST(VoxelGrid, Lidar)
+{
+  // Points on a ring of walls around the sensor, in scan order
+  std::vector<math::Vector3d> points(kPoints);
+  for (int i = 0; i < kPoints; ++i)
+  {
+    const double angle = -IGN_PI + 2 * IGN_PI * i / kPoints;
+    const double range = math::Rand::DblUniform(10, 30);
+    points[i].Set(range * std::cos(angle), range * std::sin(angle),
+                  math::Rand::DblUniform(-1, 3));
+  }
+
+  math::VoxelGrid grid(0.5);
+  std::vector<math::Vector3d> output;
+  std::vector<size_t> voxels;
+  auto start = std::chrono::steady_clock::now();
+  const size_t count = grid.Filter(points.data(), points.size(), output);
+  Report("VoxelGrid centroid", start, kPoints, "points");
+
+  start = std::chrono::steady_clock::now();
+  EXPECT_EQ(count, grid.Filter(points.data(), points.size(), output,
+        voxels));
+  Report("VoxelGrid centroid with voxel indices", start, kPoints, "points");
+
+  grid.SetReduction(math::VoxelGrid::FIRST_POINT);
+  start = std::chrono::steady_clock::now();
+  EXPECT_EQ(count, grid.Filter(points.data(), points.size(), output));
+  Report("VoxelGrid first point", start, kPoints, "points");
+
+  // Hash map of voxel keys to sums
+  start = std::chrono::steady_clock::now();
+  std::unordered_map<uint64_t, std::pair<math::Vector3d, int>> map;
+  for (const math::Vector3d &p : points)
+  {
+    const uint64_t x = static_cast<uint64_t>(std::floor(p.X() / 0.5) + 1e5);
+    const uint64_t y = static_cast<uint64_t>(std::floor(p.Y() / 0.5) + 1e5);
+    const uint64_t z = static_cast<uint64_t>(std::floor(p.Z() / 0.5) + 1e5);
+    auto &entry = map[(x << 42) | (y << 21) | z];
+    entry.first += p;
+    ++entry.second;
+  }
+  std::vector<math::Vector3d> mapOutput;
+  for (const auto &entry : map)
+    mapOutput.push_back(entry.second.first / entry.second.second);
+  Report("std::unordered_map", start, kPoints, "points");
+  EXPECT_EQ(count, mapOutput.size());
+}